@@ -51,18 +51,21 @@ class arrayView {
   static_assert(std::is_arithmetic<T2>::value,
                 "arrayView<T1, T2> requires T2 to be an arithmetic type!");
 
-  typename vector<T2>::const_iterator begin_;
-  typename vector<T2>::const_iterator end_;
+  const T2 *begin_;
+  const T2 *end_;
   int momentumIndex_;
   int energyIndex_;
   int turbulenceIndex_;
 
  public:
   // constructor
-  arrayView(const typename vector<T2>::const_iterator &b,
-            const typename vector<T2>::const_iterator &e, const int &numSpecies)
-      : begin_(b),
-        end_(e),
+  // view can be of contiguous storage in a std::vector or a varArray
+  // an empty range is not dereferenced
+  template <typename It,
+            typename = std::enable_if_t<!std::is_arithmetic<It>::value>>
+  arrayView(const It &b, const It &e, const int &numSpecies)
+      : begin_(b == e ? nullptr : std::addressof(*b)),
+        end_(begin_ + std::distance(b, e)),
         momentumIndex_(numSpecies),
         energyIndex_(momentumIndex_ + 3),
         turbulenceIndex_(energyIndex_ + 1) {}
@@ -48,6 +48,7 @@ using std::map;
 
 // forward class declaration
 class plot3dBlock;
+class plot3dBlockRange;
 class decomposition;
 class inputState;
 class input;
@@ -173,17 +174,25 @@ class patch {
   int localBlock_;               // position of block on processor
   string bcName_;                // name of bc on patch
 
+  // private member functions
+  template <typename T>
+  void AssignCorners(const T &);
+
  public:
   // Constructor
   patch();
   patch(const int&, const int&, const int&, const int&, const int&, const int&,
-        const int&, const int&, const plot3dBlock&, const int&, const int&,
-        const array<bool, 4>&, const string&);
-  patch(const boundarySurface &surf, const plot3dBlock &blk, const int &bNum,
+        const int&, const int&, const int&, const int&, const array<bool, 4>&,
+        const string&);
+  // block can be a plot3dBlock or a plot3dBlockRange
+  template <typename T>
+  patch(const boundarySurface &surf, const T &blk, const int &bNum,
         const array<bool, 4> &border, int r = 0, int l = 0) :
       patch(surf.SurfaceType(), bNum, surf.IMin(), surf.IMax(), surf.JMin(),
-            surf.JMax(), surf.KMin(), surf.KMax(), blk, r, l, border,
-            surf.BCType()) {}
+            surf.JMax(), surf.KMin(), surf.KMax(), r, l, border,
+            surf.BCType()) {
+    this->AssignCorners(blk);
+  }
 
   // move constructor and assignment operator
   patch(patch&&) noexcept = default;
@@ -221,6 +230,50 @@ class patch {
   ~patch() noexcept {}
 };
 
+// member function to get the corner points of the patch from the block it is
+// on; only the four corner nodes of the block are accessed
+template <typename T>
+void patch::AssignCorners(const T &blk) {
+  // blk -- block that patch is on
+  if (boundary_ == 1 || boundary_ == 2) {  // patch on i-surface
+    // origin_ at jmin, kmin
+    origin_ = vector3d<double>(blk.Coords(constSurf_, d1Start_, d2Start_));
+
+    // corner1_ at jmax, kmin
+    corner1_ = vector3d<double>(blk.Coords(constSurf_, d1End_, d2Start_));
+
+    // corner2_ at jmin, kmax
+    corner2_ = vector3d<double>(blk.Coords(constSurf_, d1Start_, d2End_));
+
+    // corner12_ at jmax, kmax
+    corner12_ = vector3d<double>(blk.Coords(constSurf_, d1End_, d2End_));
+  } else if (boundary_ == 3 || boundary_ == 4) {  // patch on j-surface
+    // origin_ at kmin, imin
+    origin_ = vector3d<double>(blk.Coords(d2Start_, constSurf_, d1Start_));
+
+    // corner1_ at kmax, imin
+    corner1_ = vector3d<double>(blk.Coords(d2Start_, constSurf_, d1End_));
+
+    // corner2_ at kmin, imax
+    corner2_ = vector3d<double>(blk.Coords(d2End_, constSurf_, d1Start_));
+
+    // corner12_ at kmax, imax
+    corner12_ = vector3d<double>(blk.Coords(d2End_, constSurf_, d1End_));
+  } else {  // patch on k-surface
+    // origin_ at imin, jmin
+    origin_ = vector3d<double>(blk.Coords(d1Start_, d2Start_, constSurf_));
+
+    // corner1_ at imax, jmin
+    corner1_ = vector3d<double>(blk.Coords(d1End_, d2Start_, constSurf_));
+
+    // corner2_ at imin, jmax
+    corner2_ = vector3d<double>(blk.Coords(d1Start_, d2End_, constSurf_));
+
+    // corner12_ at imax, jmax
+    corner12_ = vector3d<double>(blk.Coords(d1End_, d2End_, constSurf_));
+  }
+}
+
 // A class to store the necessary information for the boundary
 // conditions of a block
 class boundaryConditions {
@@ -306,6 +359,7 @@ class boundaryConditions {
 
   void BordersSurface(const int&, array<bool, 4>&) const;
 
+  int PackSize() const;
   void PackBC(char*(&), const int&, int&) const;
   void UnpackBC(char*(&), const int&, int&);
 
@@ -437,6 +491,9 @@ class connection {
 vector<connection> GetConnectionBCs(const vector<boundaryConditions>&,
                                     const vector<plot3dBlock>&,
                                     const decomposition&, const input&);
+vector<connection> GetConnectionBCs(const vector<boundaryConditions>&,
+                                    const vector<plot3dBlockRange>&,
+                                    const decomposition&, const input&);
 vector<connection> GetConnectionBCsPar(const vector<boundaryConditions> &,
                                        const vector<plot3dBlock> &,
                                        const decomposition &, const input &,
@@ -444,9 +501,13 @@ vector<connection> GetConnectionBCsPar(const vector<boundaryConditions> &,
                                        const MPI_Datatype &);
 vector<boundaryConditions> GatherBCs(const vector<boundaryConditions> &,
                                      const decomposition &, const int &);
+vector<boundaryConditions> ScatterBCs(const vector<boundaryConditions> &,
+                                      const decomposition &, const int &);
+void BroadcastConnections(vector<connection> &, const MPI_Datatype &);
+void ReduceConnectionBorders(vector<connection> &);
 
 map<boundarySurface, pair<boundarySurface, int>> GetBlockInterConnBCs(
-    const vector<boundaryConditions> &, const vector<plot3dBlock> &,
+    const vector<boundaryConditions> &, const vector<plot3dBlockRange> &,
     const int &);
 
 ostream & operator<< (ostream &os, const boundaryConditions&);
@@ -0,0 +1,80 @@
+/*  This file is part of aither.
+    Copyright (C) 2015-19  Michael Nucci (mnucci@pm.me)
+
+    Aither is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Aither is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>. */
+
+
+#ifndef CHECKPOINT_MANAGER_HEADERDEF
+#define CHECKPOINT_MANAGER_HEADERDEF
+
+/* This class keeps an in-memory checkpoint of the solution on each processor.
+Every checkpointFrequency iterations each processor copies the state of its
+own blocks, along with the solution at time n and n-1, and the time step and
+gradients the boundary conditions use. After every iteration
+all processors check for nonphysical values, and if any are found the whole
+simulation is rolled back to the checkpoint and the cfl number is reduced.
+This avoids restarting a diverged simulation from a restart file.
+*/
+
+#include <vector>
+#include "blkMultiArray3d.hpp"
+#include "primitive.hpp"
+#include "conserved.hpp"
+#include "multiArray3d.hpp"
+#include "vector3d.hpp"
+#include "tensor.hpp"
+
+using std::vector;
+
+// forward class declaration
+class input;
+class gridLevel;
+class physics;
+
+class checkpointManager {
+  int rank_;
+  int iteration_;  // iteration checkpoint was taken at
+  int numRollbacks_;  // rollbacks to the current checkpoint
+  vector<blkMultiArray3d<primitive>> state_;
+  vector<blkMultiArray3d<conserved>> consVarsN_;
+  vector<blkMultiArray3d<conserved>> consVarsNm1_;
+  vector<multiArray3d<double>> dt_;
+  vector<multiArray3d<vector3d<double>>> pressureGrad_;
+  vector<multiArray3d<tensor<double>>> velocityGrad_;
+
+ public:
+  // Constructor
+  checkpointManager(const int &rank)
+      : rank_(rank), iteration_(-1), numRollbacks_(0) {}
+
+  // move constructor and assignment operator
+  checkpointManager(checkpointManager &&) noexcept = default;
+  checkpointManager &operator=(checkpointManager &&) noexcept = default;
+
+  // copy constructor and assignment operator
+  checkpointManager(const checkpointManager &) = default;
+  checkpointManager &operator=(const checkpointManager &) = default;
+
+  // Member functions
+  int Iteration() const { return iteration_; }
+  bool HasCheckpoint() const { return iteration_ >= 0; }
+  void Store(const gridLevel &level, const int &iter);
+  bool IsSolutionPhysical(const gridLevel &level) const;
+  int Rollback(gridLevel &level, input &inp, const physics &phys);
+
+  // Destructor
+  ~checkpointManager() noexcept {}
+};
+
+#endif
@@ -0,0 +1,44 @@
+/*  This file is part of aither.
+    Copyright (C) 2015-19  Michael Nucci (mnucci@pm.me)
+
+    Aither is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Aither is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>. */
+
+#ifndef COMPRESSIONHEADERDEF  // only if the macro COMPRESSIONHEADERDEF is not
+                              // defined execute these lines of code
+#define COMPRESSIONHEADERDEF  // define the macro
+
+/* Lossless compression of floating point fields for restart files. Each value
+is predicted from the previous value in the field and only the difference in
+bits (exclusive or) is kept. For smooth fields the sign, exponent, and leading
+mantissa bits cancel. The bytes of the differences are then shuffled so that
+all bytes of the same significance are contiguous, and the long runs of zeros
+in the upper bytes are run length encoded.
+
+Each compressed field starts with a small header giving the encoding and the
+number of values, so fields can be decompressed independently.
+*/
+
+#include <vector>
+#include <cstdint>
+
+using std::vector;
+
+// function definitions
+void EncodeRLE(const vector<unsigned char> &, vector<char> &);
+void DecodeRLE(const char *, const int64_t &, vector<unsigned char> &);
+vector<char> CompressField(const vector<double> &);
+vector<double> DecompressField(const char *, const int64_t &);
+int64_t CompressedFieldSize(const char *);
+
+#endif
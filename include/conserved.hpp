@@ -27,8 +27,9 @@ class conserved : public varArray {
   // constructor
   conserved(const int &numEqns, const int &numSpecies)
       : varArray(numEqns, numSpecies) {}
-  conserved(const vector<double>::const_iterator &b,
-            const vector<double>::const_iterator &e, const int &numSpecies)
+  template <typename It,
+            typename = std::enable_if_t<!std::is_arithmetic<It>::value>>
+  conserved(const It &b, const It &e, const int &numSpecies)
       : varArray(b, e, numSpecies) {}
 
   // member functions
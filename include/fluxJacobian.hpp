@@ -207,6 +207,7 @@ class fluxJacobian {
 
   fluxJacobian FlowMatMult(const fluxJacobian &) const;
   fluxJacobian TurbMatMult(const fluxJacobian &) const;
+  fluxJacobian MatMult(const fluxJacobian &) const;
 
   void FlowSwapRows(const int &r1, const int &r2) {
     SwapMatRows(this->begin(), flowSize_, r1, r2);
@@ -764,6 +765,10 @@ varArray RusanovScalarOffDiagonal(const primitiveView &, const varArrayView &,
                                   const double &, const double &,
                                   const double &, const physics &, const bool &,
                                   const bool &);
+fluxJacobian RusanovBlockOffDiagonalJacobian(
+    const primitiveView &, const unitVec3dMag<double> &, const double &,
+    const double &, const double &, const double &, const physics &,
+    const input &, const bool &, const tensor<double> &);
 varArray RusanovBlockOffDiagonal(const primitiveView &, const varArrayView &,
                                  const unitVec3dMag<double> &, const double &,
                                  const double &, const double &, const double &,
@@ -0,0 +1,76 @@
+/*  This file is part of aither.
+    Copyright (C) 2015-19  Michael Nucci (mnucci@pm.me)
+
+    Aither is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Aither is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>. */
+
+
+#ifndef GEOMETRY_CACHE_HEADERDEF
+#define GEOMETRY_CACHE_HEADERDEF
+
+/* These functions read and write a cache of the startup work that only depends
+on the geometry. ROOT stores the decomposition, the boundary conditions of the
+decomposed blocks, and the connections, so it can skip decomposing the grid
+and matching the connection boundaries. Each processor stores the nodes of its
+blocks and the wall distances of its blocks on all grid levels, so it can read
+its geometry in one contiguous piece and skip the wall distance search. The
+cache is keyed by a hash of the grid file contents, the block dimensions in
+the grid file header, the boundary conditions, the number of processors, and
+the settings the decomposed geometry depends on. The contents are hashed in
+parallel, each processor reading an equal share of the grid file. The cache
+is written to a temporary file and renamed once complete. If the cache can
+not be read, the geometry is recomputed.
+*/
+
+#include <cstdint>      // uint64_t
+#include <string>
+#include <vector>
+#include "mpi.h"        // parallelism
+#include "vector3d.hpp"
+
+using std::string;
+using std::vector;
+
+// forward class declarations
+class plot3dBlock;
+class boundaryConditions;
+class connection;
+class decomposition;
+class input;
+class mgSolution;
+
+// function declarations
+uint64_t HashBytes(const void *, const size_t &, uint64_t);
+uint64_t GridFileChecksum(const string &, const int &, const int &);
+uint64_t GeometryHash(const uint64_t &, const vector<vector3d<int>> &,
+                      const vector<boundaryConditions> &, const input &,
+                      const int &);
+bool AllProcessors(const bool &);
+bool ReadCacheSection(const MPI_File &, const MPI_Offset &, void *,
+                      const MPI_Aint &);
+bool OpenGeometryCache(const string &, MPI_File &, int &, int &,
+                       vector<int64_t> &);
+bool ReadGeometryCacheSetup(const string &, const uint64_t &, decomposition &,
+                            vector<boundaryConditions> &, vector<connection> &,
+                            const MPI_Datatype &);
+bool ReadGeometryCacheMesh(const string &, const vector<vector3d<int>> &,
+                           const decomposition &, const int &,
+                           vector<plot3dBlock> &);
+bool ReadGeometryCacheWallDist(const string &, mgSolution &, const int &);
+void WriteGeometryCache(const string &, const uint64_t &,
+                        const decomposition &,
+                        const vector<boundaryConditions> &,
+                        const vector<connection> &, const mgSolution &,
+                        const int &, const MPI_Datatype &);
+
+#endif
@@ -26,6 +26,7 @@
 #include "vector3d.hpp"
 #include "matMultiArray3d.hpp"
 #include "linearSolver.hpp"
+#include "haloExchange.hpp"
 #include "mpi.h"
 
 using std::string;
@@ -39,6 +40,7 @@ class decomposition;
 class input;
 class physics;
 class residual;
+class resid;
 class kdtree;
 
 class gridLevel {
@@ -46,6 +48,10 @@ class gridLevel {
   vector<connection> connections_;
   std::unique_ptr<linearSolver> solver_;
 
+  // swaps with other processors, reused every iteration
+  haloExchange stateExchange_;
+  haloExchange fieldExchange_;
+
   // during restriction, traverse fine grid values in lexigraphical order,
   // applying volume weight factor, and adding to coarse grid, also in
   // lexigraphical order -- can use multArray3d<>
@@ -61,9 +67,12 @@ class gridLevel {
  public:
   // Constructor
   gridLevel(const vector<plot3dBlock>& mesh,
-            const vector<boundaryConditions>& bcs, const decomposition& decomp,
-            const physics& phys, const vector<vector3d<int>>& origGridSizes,
-            const string& restartFile, input& inp, residual& first);
+            const vector<boundaryConditions>& bcs,
+            const vector<connection>& connections, const decomposition& decomp,
+            const physics& phys, const vector<vector3d<int>>& gridSizes,
+            const string& restartFile, input& inp, residual& first,
+            const int& rank, const MPI_Datatype& MPI_vec3d,
+            const MPI_Datatype& MPI_vec3dMag);
   gridLevel(const int& numBlocks) : blocks_(numBlocks), mgForcing_(numBlocks) {}
   gridLevel() : gridLevel(0) {}
 
@@ -80,6 +89,7 @@ class gridLevel {
   const vector<procBlock>& Blocks() const { return blocks_; }
   const procBlock& Block(const int &ii) const { return blocks_[ii]; }
   procBlock& Block(const int &ii) { return blocks_[ii]; }
+  bool ThreadOverBlocks() const;
 
   void CalcTimeStep(const input& inp);
   void ExplicitUpdate(const input& inp, const physics& phys, const int& mm,
@@ -88,9 +98,34 @@ class gridLevel {
                     residual& residL2, resid& residLinf);
   void GetBoundaryConditions(const input& inp, const physics& phys,
                              const int& rank);
+  void StartBoundaryConditions(const input& inp, const physics& phys,
+                               const int& rank);
+  void FinishBoundaryConditions(const input& inp, const physics& phys);
   void CalcResidual(const physics& phys, const input& inp, const int& rank,
                     const MPI_Datatype& MPI_tensorDouble,
                     const MPI_Datatype& MPI_vec3d);
+  void GetBoundaryConditionsAndResidual(const physics& phys, const input& inp,
+                                        const int& rank,
+                                        const MPI_Datatype& MPI_tensorDouble,
+                                        const MPI_Datatype& MPI_vec3d);
+  void GetBoundaryConditionsAndResidual(const physics& phys, const input& inp,
+                                        const int& rank,
+                                        const MPI_Datatype& MPI_tensorDouble,
+                                        const MPI_Datatype& MPI_vec3d,
+                                        vector<matMultiArray3d>& mainDiagonal);
+  void SwapAndCalcSrcTerms(const physics& phys, const input& inp,
+                           const int& rank,
+                           const MPI_Datatype& MPI_tensorDouble,
+                           const MPI_Datatype& MPI_vec3d,
+                           vector<matMultiArray3d>& mainDiagonal);
+  vector<blkMultiArray3d<varArray>> ImplicitRightHandSide(
+      const input& inp, const physics& phys) const;
+  std::array<bool, 3> InactiveMomentumDirections() const;
+  vector<blkMultiArray3d<varArray>> JacobianFreeProduct(
+      const vector<blkMultiArray3d<varArray>>& vec, const physics& phys,
+      const input& inp, const int& rank, const MPI_Datatype& MPI_tensorDouble,
+      const MPI_Datatype& MPI_vec3d);
+  vector<std::array<bool, 3>> RemoteConnectionDirections(const int& rank) const;
 
   int NumConnections() const { return connections_.size(); }
   const vector<connection>& Connections() const { return connections_; }
@@ -110,6 +145,8 @@ class gridLevel {
   const blkMultiArray3d<varArray>& Forcing(const int& ii) const {
     return mgForcing_[ii];
   }
+  void AssignForcing(const vector<blkMultiArray3d<varArray>>& forcing);
+  void ZeroForcing();
   const vector<multiArray3d<vector3d<int>>> &ToCoarse() const {
     return toCoarse_;
   }
@@ -117,11 +154,10 @@ class gridLevel {
     return volWeightFactor_;
   }
 
-  gridLevel SendGridLevel(const int& rank, const int& numProcBlock,
-                          const MPI_Datatype& MPI_vec3d,
-                          const MPI_Datatype& MPI_vec3dMag,
-                          const MPI_Datatype& MPI_connection,
-                          const input& inp) const;
+  gridLevel GatherGridLevel(const decomposition& decomp, const int& rank,
+                            const MPI_Datatype& MPI_vec3d,
+                            const MPI_Datatype& MPI_vec3dMag,
+                            const input& inp) const;
   void GetGridLevel(const gridLevel& local, const int& rank,
                     const MPI_Datatype& MPI_uncoupledScalar,
                     const MPI_Datatype& MPI_vec3d,
@@ -129,13 +165,13 @@ class gridLevel {
   void CalcWallDistance(const kdtree& tree);
   void AssignSolToTimeN(const physics& phys);
   void AssignSolToTimeNm1();
+  wallLoads WallLoads(const physics& phys,
+                      const vector3d<double>& momentPoint) const;
   void SwapWallDist(const int& rank, const int& numGhosts);
-  void SwapTurbVars(const int& rank, const int& numGhosts);
   void SwapViscosity(const int& rank, const int& numGhosts);
-  void SwapEddyViscAndGradients(const int& rank,
-                                const MPI_Datatype& MPI_tensorDouble,
-                                const MPI_Datatype& MPI_vec3d,
-                                const int& numGhosts);
+  void SwapFields(const vector<haloField>& fields, const int& rank,
+                  const MPI_Datatype& MPI_tensorDouble,
+                  const MPI_Datatype& MPI_vec3d, haloExchange& exchange);
   void AuxillaryAndWidths(const physics& phys);
   gridLevel Coarsen(const decomposition& decomp, const input& inp,
                     const physics& phys, const int& rank,
@@ -150,12 +186,18 @@ class gridLevel {
   void Prolongation(gridLevel& fine) const;
   void SubtractFromUpdate(const vector<blkMultiArray3d<varArray>>& coarseDu);
   vector<blkMultiArray3d<varArray>> Update() const { return solver_->X(); }
+  void AssignUpdate(const vector<blkMultiArray3d<varArray>>& update) {
+    solver_->AssignUpdate(update);
+  }
 
   // Destructor
   ~gridLevel() noexcept {}
 };
 
 // function declarations
+void CombineResiduals(const vector<residual> &, const vector<resid> &,
+                      residual &, resid &);
+
 template <typename T>
 void BlockProlongation(const T& coarse,
                        const multiArray3d<vector3d<int>>& toCoarse,
@@ -0,0 +1,309 @@
+/*  This file is part of aither.
+    Copyright (C) 2015-19  Michael Nucci (mnucci@pm.me)
+
+    Aither is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Aither is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>. */
+
+#ifndef HALOEXCHANGEHEADERDEF  // only if the macro HALOEXCHANGEHEADERDEF is
+                               // not defined execute these lines of code
+#define HALOEXCHANGEHEADERDEF  // define the macro
+
+/* This file contains the header and implementation for a class to exchange
+   ghost cells with connection partners on other processors without blocking.
+   All receives and sends are posted up front so that the exchanges with all
+   partners proceed concurrently, instead of each processor waiting on its
+   partners one connection at a time. Local work can be done while the slices
+   are in transit. The received slices are inserted into the ghost cells of
+   their arrays when the exchange is finished.
+
+   Two processors often share many connections, especially after blocks are
+   split by the decomposition. Instead of sending each connection slice as its
+   own message, all slices going to the same processor are packed into one
+   buffer and sent as one message. This cuts the number of messages per
+   exchange from the number of connections to the number of neighboring
+   processors, which matters when message latency dominates.
+
+   The connection geometry does not change during a simulation, so an
+   exchange is meant to be kept and reused for every swap of the same arrays.
+   The first time the exchange is used, the locations of the cells to send
+   and receive are found, and the buffers and persistent MPI requests for
+   each neighboring processor are created. Subsequent swaps pack directly
+   from the arrays into the buffers, start the persistent requests, and
+   unpack directly into the ghost cells. Swaps must therefore be posted in
+   the same order every time the exchange is used.
+
+   Since all processors loop over the connections in the same order, the
+   slices packed into a message are in the same order as the slices the
+   partner processor unpacks from it.
+ */
+
+#include <vector>       // vector
+#include <memory>       // unique_ptr
+#include <iostream>     // cerr, endl
+#include <cstdlib>      // exit
+#include <cstring>      // memcpy
+#include <numeric>      // iota
+#include <type_traits>  // is_standard_layout
+#include "mpi.h"
+#include "multiArray3d.hpp"        // ConnectionSlice, InsertConnectionSlice
+#include "boundaryConditions.hpp"  // connection
+
+using std::vector;
+using std::unique_ptr;
+using std::cerr;
+using std::endl;
+
+// abstract base class for the swap of a slice with the partner block of a
+// connection on another processor
+class haloSlot {
+  int partner_;
+  int tag_;
+  int offset_;  // location of slice in message buffers
+
+ public:
+  // constructor
+  haloSlot(const int &partner, const int &tag)
+      : partner_(partner), tag_(tag), offset_(0) {}
+
+  // member functions
+  int Partner() const { return partner_; }
+  int Tag() const { return tag_; }
+  int Offset() const { return offset_; }
+  void SetOffset(const int &offset) { offset_ = offset; }
+  virtual int NumDoubles() const = 0;
+  virtual void Pack(double *) const = 0;
+  virtual void Unpack(const double *) = 0;
+
+  // destructor
+  virtual ~haloSlot() noexcept {}
+};
+
+// swap of a slice of a multiArray3d<T>
+template <typename T>
+class haloArraySlot : public haloSlot {
+  static_assert(std::is_standard_layout<T>::value &&
+                    sizeof(T) % sizeof(double) == 0,
+                "haloArraySlot<T> requires T to be made of doubles!");
+
+  vector<int> sendLoc_;  // location of first element of cells to send
+  vector<int> recvLoc_;  // location of first element of cells to receive
+  int blkSize_;
+  multiArray3d<T> *array_;  // array to swap, set when posted
+
+ public:
+  // constructor
+  haloArraySlot(const multiArray3d<T> &, const connection &, const int &,
+                const int &);
+
+  // member functions
+  int CellDoubles() const { return blkSize_ * sizeof(T) / sizeof(double); }
+  int NumDoubles() const override {
+    return sendLoc_.size() * this->CellDoubles();
+  }
+  void SetArray(multiArray3d<T> &);
+  void Pack(double *) const override;
+  void Unpack(const double *) override;
+
+  // destructor
+  ~haloArraySlot() noexcept {}
+};
+
+// message buffers for a neighboring processor
+struct haloNeighbor {
+  int rank_;
+  int tag_;
+  vector<double> sendBuffer_;
+  vector<double> recvBuffer_;
+
+  haloNeighbor(const int &rank, const int &tag) : rank_(rank), tag_(tag) {}
+};
+
+class haloExchange {
+  vector<unique_ptr<haloSlot>> slots_;
+  vector<int> slotNeighbor_;  // index of neighbor for each slot
+  vector<haloNeighbor> neighbors_;
+  vector<MPI_Request> sendRequests_;
+  vector<MPI_Request> recvRequests_;
+  int numPosted_;
+  bool started_;
+
+  // private member functions
+  void InitNeighbors();
+
+ public:
+  // constructor
+  haloExchange() : numPosted_(0), started_(false) {}
+
+  // move constructor and assignment operator
+  haloExchange(haloExchange &&) noexcept = default;
+  haloExchange &operator=(haloExchange &&) noexcept = default;
+
+  // persistent requests can not be copied
+  haloExchange(const haloExchange &) = delete;
+  haloExchange &operator=(const haloExchange &) = delete;
+
+  // member functions
+  template <typename T>
+  void Post(multiArray3d<T> &, const connection &, const int &,
+            const MPI_Datatype &, const int &);
+  int NumSwaps() const { return slots_.size(); }
+  int NumNeighbors() const { return neighbors_.size(); }
+  int NumPending() const { return numPosted_; }
+  void Start();
+  void Finish();
+
+  // destructor
+  ~haloExchange() noexcept;
+};
+
+// ---------------------------------------------------------------------------
+// member function definitions
+
+// constructor -- find locations in array of cells to send to and receive from
+// partner block
+template <typename T>
+haloArraySlot<T>::haloArraySlot(const multiArray3d<T> &array,
+                                const connection &conn, const int &rank,
+                                const int &tag)
+    : haloSlot((rank == conn.RankFirst()) ? conn.RankSecond()
+                                          : conn.RankFirst(),
+               tag),
+      blkSize_(array.BlockSize()),
+      array_(nullptr) {
+  // array -- array on local processor to swap
+  // conn -- connection boundary information
+  // rank -- processor rank
+  // tag -- id for MPI swap
+
+  // array of cell indices with same layout as array to swap
+  multiArray3d<int> cells(array.NumINoGhosts(), array.NumJNoGhosts(),
+                          array.NumKNoGhosts(), array.GhostLayers());
+  std::iota(cells.begin(), cells.end(), 0);
+
+  // cells to send are the slice that would be sent to partner
+  const auto sendSlice = ConnectionSlice(cells, conn, rank);
+  for (const auto &cc : sendSlice) {
+    sendLoc_.push_back(cc * blkSize_);
+  }
+
+  // partner slice has same number of cells, but dimensions of partner block
+  auto is = 0, ie = 0;
+  auto js = 0, je = 0;
+  auto ks = 0, ke = 0;
+  if (rank == conn.RankFirst()) {
+    conn.SecondSliceIndices(is, ie, js, je, ks, ke, array.GhostLayers());
+  } else {
+    conn.FirstSliceIndices(is, ie, js, je, ks, ke, array.GhostLayers());
+  }
+  auto recvSlice = sendSlice;
+  recvSlice.SameSizeResize(ie - is, je - js, ke - ks);
+  std::iota(recvSlice.begin(), recvSlice.end(), 0);
+
+  // insert received cell numbers into ghost cells to find where they go
+  cells.Zero(-1);
+  InsertConnectionSlice(cells, recvSlice, conn, rank);
+  recvLoc_.assign(recvSlice.Size(), -1);
+  for (auto cc = 0; cc < cells.Size(); ++cc) {
+    if (cells(cc) >= 0) {
+      recvLoc_[cells(cc)] = cc * blkSize_;
+    }
+  }
+}
+
+// member function to set array to swap
+template <typename T>
+void haloArraySlot<T>::SetArray(multiArray3d<T> &array) {
+  // array -- array to pack from, and unpack into when swap is complete
+  if (array.BlockSize() != blkSize_) {
+    cerr << "ERROR: Error in haloArraySlot<T>::SetArray(). Block size of array "
+         << array.BlockSize() << " does not match block size of swap "
+         << blkSize_ << "!" << endl;
+    exit(EXIT_FAILURE);
+  }
+  array_ = &array;
+}
+
+// member function to pack cells to send into message buffer
+template <typename T>
+void haloArraySlot<T>::Pack(double *buffer) const {
+  // buffer -- start of slice in message buffer
+  MSG_ASSERT(array_ != nullptr, "no array to pack from");
+  const auto cellSize = blkSize_ * sizeof(T);
+  const auto cellDoubles = this->CellDoubles();
+  const auto *data = &(*array_->begin());
+  for (auto ii = 0U; ii < sendLoc_.size(); ++ii) {
+    std::memcpy(buffer + ii * cellDoubles,
+                static_cast<const void *>(data + sendLoc_[ii]), cellSize);
+  }
+}
+
+// member function to unpack received cells into ghost cells of array
+template <typename T>
+void haloArraySlot<T>::Unpack(const double *buffer) {
+  // buffer -- start of slice in message buffer
+  MSG_ASSERT(array_ != nullptr, "no array to unpack into");
+  const auto cellSize = blkSize_ * sizeof(T);
+  const auto cellDoubles = this->CellDoubles();
+  auto *data = &(*array_->begin());
+  for (auto ii = 0U; ii < recvLoc_.size(); ++ii) {
+    if (recvLoc_[ii] >= 0) {
+      std::memcpy(static_cast<void *>(data + recvLoc_[ii]),
+                  buffer + ii * cellDoubles, cellSize);
+    }
+  }
+  array_ = nullptr;
+}
+
+// member function to post the swap of an array slice with the partner block of
+// a connection on another processor -- slice is not sent until Start() is
+// called
+template <typename T>
+void haloExchange::Post(multiArray3d<T> &array, const connection &conn,
+                        const int &rank, const MPI_Datatype &MPI_arrData,
+                        const int &tag) {
+  // array -- array on local processor to swap
+  // conn -- connection boundary information
+  // rank -- processor rank
+  // MPI_arrData -- MPI datatype for passing data in array
+  // tag -- id for MPI swap
+
+  const auto ind = numPosted_;
+  if (ind == this->NumSwaps() && neighbors_.empty()) {
+    // first time exchange is used, find cells to swap
+    auto typeSize = 0;
+    MPI_Type_size(MPI_arrData, &typeSize);
+    if (typeSize != sizeof(T)) {
+      cerr << "ERROR: Error in haloExchange::Post(). MPI datatype does not "
+              "match array data!" << endl;
+      exit(EXIT_FAILURE);
+    }
+    slots_.push_back(std::make_unique<haloArraySlot<T>>(array, conn, rank, tag));
+  }
+
+  auto *slot = (ind < this->NumSwaps())
+                   ? dynamic_cast<haloArraySlot<T> *>(slots_[ind].get())
+                   : nullptr;
+  const auto partner =
+      (rank == conn.RankFirst()) ? conn.RankSecond() : conn.RankFirst();
+  if (started_ || slot == nullptr || slot->Partner() != partner ||
+      slot->Tag() != tag) {
+    cerr << "ERROR: Error in haloExchange::Post(). Swaps must be posted in "
+            "the same order each time the exchange is used!" << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  slot->SetArray(array);
+  numPosted_++;
+}
+
+#endif
@@ -26,6 +26,8 @@
 #include "boundaryConditions.hpp"
 #include "inputStates.hpp"
 #include "fluid.hpp"
+#include "inputOptions.hpp"
+#include "sampling.hpp"
 #include "macros.hpp"
 
 using std::vector;
@@ -74,6 +76,10 @@ class input {
   string matrixSolver_;  // matrix solver to solve Ax=b
   int matrixSweeps_;  // number of sweeps for matrix solver
   double matrixRelaxation_;  // relaxation parameter for matrix solver
+  bool matrixStoreOffDiagonal_;  // store off diagonal jacobians each iteration
+  string matrixPreconditioner_;  // relaxation preconditioner for gmres solver
+  int krylovVectors_;  // maximum number of krylov vectors for gmres solver
+  double krylovTolerance_;  // relative tolerance for gmres solver
   double timeIntTheta_;  // beam and warming time integration parameter
   double timeIntZeta_;  // beam and warming time integration parameter
   int nonlinearIterations_;  // number of nonlinear iterations for time accurate
@@ -98,12 +104,34 @@ class input {
   double freezingTemperature_;  // temperature below which reactions cease
   int mgLevels_;  // number of multigrid levels
   bool outputNodalVariables_;
+  bool asyncOutput_;  // write output while iterations continue
+  bool restartCompression_;  // compress restart files
+  string outputFormat_;  // plot3d function files or per block vtk files
+  string outputPrecision_;  // precision of vtk files
+  int checkpointFrequency_;  // how often to store in-memory checkpoints
+  double checkpointCflFactor_;  // cfl reduction on checkpoint rollback
+  int sampleFrequency_;  // how often to write samples
+  bool wallLoads_;  // integrate loads on viscous walls each iteration
+  vector3d<double> momentReferencePoint_;  // point to take moments about
+  double momentReferenceLength_;  // length for moment coefficients
+  double referenceArea_;  // area for force coefficients
+  double referenceVelocity_;  // velocity for force coefficients
+  bool geometryCache_;  // reuse cached wall distances between runs
   int mgPreSweeps_;  // pre-relaxation sweeps
   int mgPostSweeps_;  // post-relaxation sweeps
   string mgCycle_;  // multigrid cycle type
 
+  // methods resolved from input file strings
+  reconstructionMethod reconstructionMethod_;
+  limiterMethod limiterMethod_;
+  inviscidFluxMethod inviscidFluxMethod_;
+  viscousReconstructionMethod viscousReconstructionMethod_;
+  timeIntegrationMethod timeIntegrationMethod_;
+
   set<string> outputVariables_;  // variables to output
   set<string> wallOutputVariables_;  // wall variables to output
+  set<string> sampleVariables_;  // variables to sample
+  vector<sampleSet> samples_;  // cells to sample
 
   vector<icState> ics_;  // initial conditions
   vector<shared_ptr<inputState>> bcStates_;  // information for boundary conditions
@@ -117,6 +145,13 @@ class input {
   void CheckNonreflecting() const;
   void CheckChemistryMechanism() const;
   void CheckMultigrid() const;
+  void CheckNumberOfEquations() const;
+  void CheckOutputFormat() const;
+  void CheckCheckpoint() const;
+  void CheckSamples();
+  void CheckWallLoads() const;
+  void CheckMatrixStoreOffDiagonal() const;
+  void ResolveMethods();
   unique_ptr<turbModel> AssignTurbulenceModel() const;
   unique_ptr<eos> AssignEquationOfState() const;
   unique_ptr<transport> AssignTransportModel() const;
@@ -168,19 +203,32 @@ class input {
   vector<boundaryConditions> AllBC() const { return bc_; }
   int NumBC() const { return bc_.size(); }
 
-  string TimeIntegration() const { return timeIntegration_; }
+  const string &TimeIntegration() const { return timeIntegration_; }
+  timeIntegrationMethod TimeIntegrationMethod() const {
+    return timeIntegrationMethod_;
+  }
   bool IsMultilevelInTime() const { return timeIntegration_ == "bdf2"; }
   bool IsMultiSpecies() const { return this->NumSpecies() > 1; }
   bool NeedToStoreTimeN() const {
-    return this->IsImplicit() || this->TimeIntegration() == "rk4";
+    return this->IsImplicit() ||
+        timeIntegrationMethod_ == timeIntegrationMethod::rk4;
   }
 
   double CFL() const {return cfl_;}
   void CalcCFL(const int &i);
+  void ReduceCFL(const double &factor);
 
   double Kappa() const {return kappa_;}
-  string FaceReconstruction() const {return faceReconstruction_;}
-  string ViscousFaceReconstruction() const {return viscousFaceReconstruction_;}
+  const string &FaceReconstruction() const {return faceReconstruction_;}
+  const string &ViscousFaceReconstruction() const {
+    return viscousFaceReconstruction_;
+  }
+  reconstructionMethod ReconstructionMethod() const {
+    return reconstructionMethod_;
+  }
+  viscousReconstructionMethod ViscousReconstructionMethod() const {
+    return viscousReconstructionMethod_;
+  }
   bool UsingConstantReconstruction() const {
     return faceReconstruction_ == "constant";
   }
@@ -189,13 +237,42 @@ class input {
     return faceReconstruction_ == "weno" || faceReconstruction_ == "wenoZ";
   }
 
-  string Limiter() const {return limiter_;}
+  const string &Limiter() const {return limiter_;}
+  limiterMethod LimiterMethod() const {return limiterMethod_;}
 
   int OutputFrequency() const {return outputFrequency_;}
   int RestartFrequency() const {return restartFrequency_;}
   set<string> OutputVariables() const {return outputVariables_;}
   bool OutputNodalVariables() const { return outputNodalVariables_; }
+  bool AsyncOutput() const { return asyncOutput_; }
+  bool RestartCompression() const { return restartCompression_; }
+  string OutputFormat() const { return outputFormat_; }
+  bool IsVtkOutput() const { return outputFormat_ == "vtk"; }
+  string OutputPrecision() const { return outputPrecision_; }
   set<string> WallOutputVariables() const {return wallOutputVariables_;}
+  int CheckpointFrequency() const { return checkpointFrequency_; }
+  double CheckpointCflFactor() const { return checkpointCflFactor_; }
+  bool IsCheckpointing() const { return checkpointFrequency_ > 0; }
+  const vector<sampleSet> &Samples() const { return samples_; }
+  set<string> SampleVariables() const { return sampleVariables_; }
+  int SampleFrequency() const { return sampleFrequency_; }
+  bool WallLoads() const { return wallLoads_; }
+  bool GeometryCache() const { return geometryCache_; }
+  string GeometryCacheName() const { return gName_ + ".cache"; }
+  const vector3d<double> &MomentReferencePoint() const {
+    return momentReferencePoint_;
+  }
+  double MomentReferenceLength() const { return momentReferenceLength_; }
+  double ReferenceArea() const { return referenceArea_; }
+  double ReferenceVelocity() const {
+    return (referenceVelocity_ > 0.0) ? referenceVelocity_ : aRef_;
+  }
+  bool WriteSamples(const int &nn) const {
+    return !samples_.empty() && (nn + 1) % sampleFrequency_ == 0;
+  }
+  bool WriteCheckpoint(const int &nn) const {
+    return this->IsCheckpointing() && nn % checkpointFrequency_ == 0;
+  }
 
   bool WriteOutput(const int &nn) const {return (nn + 1) % outputFrequency_ == 0;}
   bool WriteRestart(const int &nn) const {
@@ -207,6 +284,16 @@ class input {
   string MatrixSolver() const {return matrixSolver_;}
   int MatrixSweeps() const {return matrixSweeps_;}
   double MatrixRelaxation() const {return matrixRelaxation_;}
+  // line implicit and ilu solvers always use stored off diagonals
+  bool MatrixStoreOffDiagonal() const {
+    return matrixStoreOffDiagonal_ || this->RelaxationSolver() == "blinesgs" ||
+           this->RelaxationSolver() == "bilu";
+  }
+  string MatrixPreconditioner() const {return matrixPreconditioner_;}
+  bool IsJacobianFree() const;
+  string RelaxationSolver() const;
+  int KrylovVectors() const {return krylovVectors_;}
+  double KrylovTolerance() const {return krylovTolerance_;}
   bool MatrixRequiresInitialization() const;
   unique_ptr<linearSolver> AssignLinearSolver(const gridLevel &) const;
 
@@ -223,7 +310,8 @@ class input {
 
   double DualTimeCFL() const {return dualTimeCFL_;}
 
-  string InviscidFlux() const {return inviscidFlux_;}
+  const string &InviscidFlux() const {return inviscidFlux_;}
+  inviscidFluxMethod InviscidFluxMethod() const {return inviscidFluxMethod_;}
 
   string DecompMethod() const {return decompMethod_;}
   string TurbulenceModel() const {return turbModel_;}
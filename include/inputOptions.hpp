@@ -0,0 +1,64 @@
+/*  This file is part of aither.
+    Copyright (C) 2015-19  Michael Nucci (mnucci@pm.me)
+
+    Aither is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Aither is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>. */
+
+#ifndef INPUTOPTIONSHEADERDEF  // only if the macro INPUTOPTIONSHEADERDEF is not
+                               // defined execute these lines of code
+#define INPUTOPTIONSHEADERDEF  // define the macro
+
+/* This header contains enumerations for the numerical methods that are
+   selected in the input file and queried inside the face and cell loops of the
+   solver. The input file strings are converted to these enumerations once when
+   the input file is read so that the kernels can be specialized on them at
+   compile time instead of comparing strings in their inner loops.
+ */
+
+// face reconstruction for inviscid fluxes
+enum class reconstructionMethod {
+  constant,  // first order
+  muscl,     // upwind, fromm, quick, central, thirdOrder
+  weno,
+  wenoZ
+};
+
+// limiter for MUSCL reconstruction
+enum class limiterMethod {
+  none,
+  vanAlbada,
+  minmod
+};
+
+// inviscid flux scheme
+enum class inviscidFluxMethod {
+  roe,
+  ausm
+};
+
+// face reconstruction for viscous fluxes
+enum class viscousReconstructionMethod {
+  central,
+  centralFourth
+};
+
+// time integration scheme
+enum class timeIntegrationMethod {
+  explicitEuler,
+  rk4,
+  implicitEuler,
+  crankNicholson,
+  bdf2
+};
+
+#endif
@@ -29,6 +29,7 @@
 #include "eos.hpp"
 #include "thermodynamic.hpp"
 #include "turbulence.hpp"
+#include "inputOptions.hpp"
 
 using std::vector;
 using std::string;
@@ -480,10 +481,11 @@ inviscidFlux AUSMFlux(const T1 &left, const T2 &right, const physics &phys,
   return ausm;
 }
 
-template <typename T1, typename T2>
+// flux scheme is a template parameter so that it is resolved at compile time
+template <inviscidFluxMethod F, typename T1, typename T2>
 inviscidFlux InviscidFlux(const T1 &left, const T2 &right,
                           const physics &phys,
-                          const vector3d<double> &area, const string &flux) {
+                          const vector3d<double> &area) {
   static_assert(std::is_same<primitive, T1>::value ||
                     std::is_same<primitiveView, T1>::value,
                 "T1 requires primitive or primativeView type");
@@ -491,18 +493,11 @@ inviscidFlux InviscidFlux(const T1 &left, const T2 &right,
                     std::is_same<primitiveView, T2>::value,
                 "T2 requires primitive or primativeView type");
   
-  inviscidFlux invFlux;
-  if (flux == "roe") {
-    invFlux = RoeFlux(left, right, phys, area);
-  } else if (flux == "ausm") {
-    invFlux = AUSMFlux(left, right, phys, area);
+  if (F == inviscidFluxMethod::ausm) {
+    return AUSMFlux(left, right, phys, area);
   } else {
-    cerr << "ERROR: inviscid flux type " << flux << " is not recognized!"
-         << endl;
-    cerr << "Choose 'roe' or 'ausm'" << endl;
-    exit(EXIT_FAILURE);
+    return RoeFlux(left, right, phys, area);
   }
-  return invFlux;
 }
 
 template <typename T1, typename T2>
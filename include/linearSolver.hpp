@@ -19,13 +19,19 @@
 
 #include <vector>                  // vector
 #include <string>                  // string
+#include <functional>              // function
 #include "matMultiArray3d.hpp"
 #include "blkMultiArray3d.hpp"
+#include "haloExchange.hpp"
 #include "macros.hpp"
 
 using std::string;
 using std::vector;
 
+// operator applied to a vector by the krylov solver
+using krylovOperator = std::function<vector<blkMultiArray3d<varArray>>(
+    const vector<blkMultiArray3d<varArray>> &)>;
+
 // forward class declarations
 class procBlock;
 class input;
@@ -38,9 +44,26 @@ class linearSolver {
   string solverType_;
   vector<matMultiArray3d> a_;
   vector<matMultiArray3d> aInv_;
+  haloExchange updateExchange_;
+  vector<vector<matMultiArray3d>> offDiagonal_;  // stored off diagonals
+  bool isOffDiagonalStored_;
+
  protected:
   vector<blkMultiArray3d<varArray>> x_;
 
+  varArray ImplicitLower(const procBlock &, const int &, const int &,
+                         const int &, const int &,
+                         const blkMultiArray3d<varArray> &, const physics &,
+                         const input &) const;
+  varArray ImplicitUpper(const procBlock &, const int &, const int &,
+                         const int &, const int &,
+                         const blkMultiArray3d<varArray> &, const physics &,
+                         const input &) const;
+  bool IsOffDiagonalStored() const { return isOffDiagonalStored_; }
+  const matMultiArray3d &OffDiagonal(const int &bb, const int &dir) const {
+    return offDiagonal_[bb][dir];
+  }
+
  public:
   // constructors
   linearSolver(const input &inp, const gridLevel &level);
@@ -50,8 +73,8 @@ class linearSolver {
   linearSolver& operator=(linearSolver&&) noexcept = default;
 
   // copy constructor and assignment operator
-  linearSolver(const linearSolver&) = default;
-  linearSolver& operator=(const linearSolver&) = default;
+  linearSolver(const linearSolver&) = delete;
+  linearSolver& operator=(const linearSolver&) = delete;
 
   // member functions
   int NumBlocks() const { return a_.size(); }
@@ -59,6 +82,7 @@ class linearSolver {
   const blkMultiArray3d<varArray> &X(const int &bb) const { return x_[bb]; }
 
   const vector<matMultiArray3d> &A() const { return a_; }
+  vector<matMultiArray3d> &A() { return a_; }
   const matMultiArray3d &A(const int &bb) const { return a_[bb]; }
   matMultiArray3d &A(const int &bb) { return a_[bb]; }
 
@@ -71,11 +95,16 @@ class linearSolver {
 
   void AddDiagonalTerms(const gridLevel &, const input &);
   void Invert();
+  void CalcOffDiagonal(const gridLevel &, const physics &, const input &);
+  void ResetOffDiagonal() { isOffDiagonalStored_ = false; }
   void InitializeMatrixUpdate(const gridLevel &, const input &,
                               const physics &);
   void SwapUpdate(const vector<connection> &, const int &, const int &);
   void SubtractFromUpdate(const vector<blkMultiArray3d<varArray>>& coarseDu);
   void AddToUpdate(const vector<blkMultiArray3d<varArray>>& correction);
+  void AssignUpdate(const vector<blkMultiArray3d<varArray>> &update) {
+    x_ = update;
+  }
   void ZeroA(const int &bb) { a_[bb].Zero(); }
   void Restriction(unique_ptr<linearSolver> &coarse,
                    const vector<connection> &conn,
@@ -95,14 +124,19 @@ class linearSolver {
 // --------------------------------------------------------------------------
 class lusgs : public linearSolver {
   vector<vector<vector3d<int>>> reorder_;
+  vector<vector<int>> planeStart_;  // start of each hyperplane in reorder_
 
   // private member functions
-  void LUSGS_Forward(const procBlock &, const vector<vector3d<int>> &,
-                     const physics &, const input &, const matMultiArray3d &,
-                     const int &, const blkMultiArray3d<varArray> &,
+  void LUSGS_Forward(const procBlock &, const int &,
+                     const vector<vector3d<int>> &, const vector<int> &,
+                     const physics &,
+                     const input &, const matMultiArray3d &, const int &,
+                     const blkMultiArray3d<varArray> &,
                      blkMultiArray3d<varArray> &) const;
-  void LUSGS_Backward(const procBlock &, const vector<vector3d<int>> &,
-                      const physics &, const input &, const matMultiArray3d &,
+  void LUSGS_Backward(const procBlock &, const int &,
+                      const vector<vector3d<int>> &, const vector<int> &,
+                      const physics &,
+                      const input &, const matMultiArray3d &,
                       const matMultiArray3d &, const int &,
                       const blkMultiArray3d<varArray> &,
                       blkMultiArray3d<varArray> &) const;
@@ -112,12 +146,12 @@ class lusgs : public linearSolver {
   lusgs(const input &inp, const gridLevel &level);
 
   // move constructor and assignment operator
-  lusgs(lusgs &&solver) noexcept : linearSolver(std::move(solver)) {}
+  lusgs(lusgs &&) noexcept = default;
   lusgs &operator=(lusgs &&) noexcept = default;
 
   // copy constructor and assignment operator
-  lusgs(const lusgs &solver) : linearSolver(solver) {}
-  lusgs &operator=(const lusgs &) = default;
+  lusgs(const lusgs &) = delete;
+  lusgs &operator=(const lusgs &) = delete;
 
   // member functions
   vector<blkMultiArray3d<varArray>> Relax(const gridLevel &, const physics &,
@@ -132,7 +166,7 @@ class lusgs : public linearSolver {
 class dplur : public linearSolver {
 
   // private member functions
-  void DPLUR(const procBlock &, const physics &, const input &,
+  void DPLUR(const procBlock &, const int &, const physics &, const input &,
              const matMultiArray3d &, const matMultiArray3d &,
              const blkMultiArray3d<varArray> &,
              blkMultiArray3d<varArray> &) const;
@@ -146,8 +180,8 @@ class dplur : public linearSolver {
   dplur &operator=(dplur &&) noexcept = default;
 
   // copy constructor and assignment operator
-  dplur(const dplur &solver) : linearSolver(solver) {}
-  dplur &operator=(const dplur &) = default;
+  dplur(const dplur &) = delete;
+  dplur &operator=(const dplur &) = delete;
 
   // member functions
   vector<blkMultiArray3d<varArray>> Relax(const gridLevel &, const physics &,
@@ -158,8 +192,88 @@ class dplur : public linearSolver {
   virtual ~dplur() noexcept {}
 };
 
+// --------------------------------------------------------------------------
+class ilu : public linearSolver {
+  vector<vector<vector3d<int>>> reorder_;
+  vector<vector<int>> planeStart_;  // start of each hyperplane in reorder_
+  vector<matMultiArray3d> iluInv_;  // inverse of factored diagonal
+
+  // private member functions
+  void Factor(const gridLevel &);
+  vector<blkMultiArray3d<varArray>> ApplyILU(
+      const gridLevel &, const physics &, const input &,
+      const vector<blkMultiArray3d<varArray>> &) const;
+
+ public:
+  // constructors
+  ilu(const input &inp, const gridLevel &level);
+
+  // move constructor and assignment operator
+  ilu(ilu &&) noexcept = default;
+  ilu &operator=(ilu &&) noexcept = default;
+
+  // copy constructor and assignment operator
+  ilu(const ilu &) = delete;
+  ilu &operator=(const ilu &) = delete;
+
+  // member functions
+  vector<blkMultiArray3d<varArray>> Relax(const gridLevel &, const physics &,
+                                          const input &, const int &,
+                                          const int &) override;
+
+  // destructor
+  virtual ~ilu() noexcept {}
+};
+
+// --------------------------------------------------------------------------
+class linesgs : public linearSolver {
+  vector<int> lineDir_;                      // line direction of each block
+  vector<vector<vector3d<int>>> lineOrder_;  // lines ordered by hyperplanes
+  vector<vector<int>> lineStart_;  // start of each hyperplane in lineOrder_
+  vector<matMultiArray3d> lineInv_;    // inverse of eliminated diagonal
+  vector<matMultiArray3d> lineUpper_;  // eliminated upper off diagonal
+
+  // private member functions
+  vector3d<int> LineCell(const int &, const vector3d<int> &,
+                         const int &) const;
+  varArray OffLine(const int &, const int &, const int &, const int &,
+                   const int &, const int &,
+                   const blkMultiArray3d<varArray> &, const input &) const;
+  void FactorLines(const gridLevel &);
+  void LineSweep(const procBlock &, const int &, const physics &,
+                 const input &, const bool &,
+                 const blkMultiArray3d<varArray> &,
+                 blkMultiArray3d<varArray> &) const;
+
+ public:
+  // constructors
+  linesgs(const input &inp, const gridLevel &level);
+
+  // move constructor and assignment operator
+  linesgs(linesgs &&) noexcept = default;
+  linesgs &operator=(linesgs &&) noexcept = default;
+
+  // copy constructor and assignment operator
+  linesgs(const linesgs &) = delete;
+  linesgs &operator=(const linesgs &) = delete;
+
+  // member functions
+  vector<blkMultiArray3d<varArray>> Relax(const gridLevel &, const physics &,
+                                          const input &, const int &,
+                                          const int &) override;
+
+  // destructor
+  virtual ~linesgs() noexcept {}
+};
+
 // ----------------------------------------------------------------------------
-// function definitions
+// function declarations
+double KrylovDot(const vector<blkMultiArray3d<varArray>> &,
+                 const vector<blkMultiArray3d<varArray>> &);
+vector<blkMultiArray3d<varArray>> Gmres(
+    const vector<blkMultiArray3d<varArray>> &, const krylovOperator &,
+    const krylovOperator &, const int &, const double &,
+    vector<blkMultiArray3d<varArray>> &);
 
 #endif
 
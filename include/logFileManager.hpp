@@ -26,10 +26,13 @@
 // forward class declaration
 class input;
 class resid;
+class physics;
+class wallLoads;
 
 class logFileManager {
   std::ofstream resid_;
   std::ofstream time_;
+  std::ofstream loads_;
   int rank_;
   residual l2First_;
   std::chrono::high_resolution_clock::time_point simStartTime_;
@@ -44,6 +47,8 @@ class logFileManager {
   const residual &L2First() const { return l2First_; }
   void WriteResiduals(const input &, const residual &, const resid &,
                       const double &, const int &, const int &);
+  void WriteLoads(const input &, const wallLoads &, const int &,
+                  const int &);
   void GetIterStart();
   void WriteTime(const int &nn);
 
@@ -54,6 +54,8 @@ class mgSolution {
   void Prolongation(const int&);
   double CycleAtLevel(const int&, const int&, const physics&, const input&,
                       const int&, const MPI_Datatype&, const MPI_Datatype&);
+  double NewtonKrylov(const int&, const physics&, const input&, const int&,
+                      const MPI_Datatype&, const MPI_Datatype&);
   vector<blkMultiArray3d<varArray>> Relax(const int&, const int&,
                                           const physics&, const input&,
                                           const int&);
@@ -85,19 +87,23 @@ class mgSolution {
 
   void ConstructFinestLevel(const vector<plot3dBlock>& mesh,
                             const vector<boundaryConditions>& bcs,
+                            const vector<connection>& connections,
                             const decomposition& decomp, const physics& phys,
+                            const vector<vector3d<int>>& gridSizes,
                             const string& restartFile, input& inp,
-                            residual& first);
+                            residual& first, const int& rank,
+                            const MPI_Datatype& MPI_vec3d,
+                            const MPI_Datatype& MPI_vec3dMag);
   void ConstructMultigrids(const decomposition& decomp, const input& inp,
                            const physics& phys, const int &rank,
                            const MPI_Datatype& MPI_connection,
                            const MPI_Datatype& MPI_vec3d,
                            const MPI_Datatype& MPI_vec3dMag);
-  mgSolution SendFinestGridLevel(const int& rank, const int& numProcBlock,
-                                 const MPI_Datatype& MPI_vec3d,
-                                 const MPI_Datatype& MPI_vec3dMag,
-                                 const MPI_Datatype& MPI_connection,
-                                 const input& inp) const;
+  mgSolution GatherFinestGridLevel(const decomposition& decomp,
+                                   const int& rank,
+                                   const MPI_Datatype& MPI_vec3d,
+                                   const MPI_Datatype& MPI_vec3dMag,
+                                   const input& inp) const;
   void GetFinestGridLevel(const mgSolution& local, const int& rank,
                           const MPI_Datatype& MPI_uncoupledScalar,
                           const MPI_Datatype& MPI_vec3d,
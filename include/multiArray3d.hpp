@@ -101,6 +101,7 @@ class multiArray3d {
   int EndK() const {return numK_ - numGhosts_;}
   int Start(const string &) const;
   int End(const string &) const;
+  int Stride(const string &) const;
   int GetLoc1D(const int &ii, const int &jj, const int &kk) const {
     MSG_ASSERT(ii >= this->StartI() && ii < this->EndI(),
                "i-index out of range");
@@ -202,6 +203,9 @@ class multiArray3d {
 
   void PackSwapUnpackMPI(const connection &, const MPI_Datatype &, const int &,
                          const int = 1);
+  int PackSizeMPI(const MPI_Datatype &) const;
+  void PackMPI(const MPI_Datatype &, vector<char> &) const;
+  void UnpackMPI(const MPI_Datatype &, vector<char> &);
 
   T GetElem(const int &ii, const int &jj, const int &kk) const;
 
@@ -822,18 +826,13 @@ void SwapSliceLocal(T &array1, const connection &conn, T &array2) {
   array2.PutSlice(slice1, conn1, array1.GhostLayers());
 }
 
-/* Function to swap slice using MPI. This is similar to the SwapSlice
-   function, but is called when the neighboring procBlocks are on different
-   processors.
-*/
+// Function to get the slice of an array that is sent to the partner block of
+// a connection on another processor
 template <typename T>
-void SwapSliceParallel(T &array, const connection &conn, const int &rank,
-                       const MPI_Datatype &MPI_arrData, const int tag) {
+T ConnectionSlice(const T &array, const connection &conn, const int &rank) {
   // array -- array on local processor to swap
   // conn -- connection boundary information
   // rank -- processor rank
-  // MPI_arrData -- MPI datatype for passing data in *this
-  // tag -- id for MPI swap (default 1)
 
   // Get indices for slice coming from block to swap
   auto is = 0, ie = 0;
@@ -845,16 +844,24 @@ void SwapSliceParallel(T &array, const connection &conn, const int &rank,
   } else if (rank == conn.RankSecond()) {  // local block second in connection
     conn.SecondSliceIndices(is, ie, js, je, ks, ke, array.GhostLayers());
   } else {
-    cerr << "ERROR: Error in SwapSliceParallel(). Processor rank does "
+    cerr << "ERROR: Error in ConnectionSlice(). Processor rank does "
             "not match either of connection ranks!" << endl;
     exit(EXIT_FAILURE);
   }
 
   // get local state slice to swap
-  auto slice = array.Slice({is, ie}, {js, je}, {ks, ke});
+  return array.Slice({is, ie}, {js, je}, {ks, ke});
+}
 
-  // swap state slices with partner block
-  slice.PackSwapUnpackMPI(conn, MPI_arrData, rank, tag);
+// Function to insert the slice received from the partner block of a connection
+// on another processor into the ghost cells of an array
+template <typename T>
+void InsertConnectionSlice(T &array, const T &slice, const connection &conn,
+                           const int &rank) {
+  // array -- array on local processor to insert slice into
+  // slice -- slice received from partner block
+  // conn -- connection boundary information
+  // rank -- processor rank
 
   // change connections to work with slice and ghosts
   auto connAdj = conn;
@@ -872,6 +879,29 @@ void SwapSliceParallel(T &array, const connection &conn, const int &rank,
   array.PutSlice(slice, connAdj, array.GhostLayers());
 }
 
+/* Function to swap slice using MPI. This is similar to the SwapSlice
+   function, but is called when the neighboring procBlocks are on different
+   processors.
+*/
+template <typename T>
+void SwapSliceParallel(T &array, const connection &conn, const int &rank,
+                       const MPI_Datatype &MPI_arrData, const int tag) {
+  // array -- array on local processor to swap
+  // conn -- connection boundary information
+  // rank -- processor rank
+  // MPI_arrData -- MPI datatype for passing data in *this
+  // tag -- id for MPI swap (default 1)
+
+  // get local state slice to swap
+  auto slice = ConnectionSlice(array, conn, rank);
+
+  // swap state slices with partner block
+  slice.PackSwapUnpackMPI(conn, MPI_arrData, rank, tag);
+
+  // insert state slice into procBlock
+  InsertConnectionSlice(array, slice, conn, rank);
+}
+
 template <typename T>
 void InsertSlice(T &array1, const T &array2, const connection &inter,
                  const int &d3) {
@@ -1036,6 +1066,22 @@ int multiArray3d<T>::PhysEnd(const string &dir) const {
   }
 }
 
+// distance in memory between neighboring elements in the given direction
+template <typename T>
+int multiArray3d<T>::Stride(const string &dir) const {
+  if (dir == "i") {
+    return blkSize_;
+  } else if (dir == "j") {
+    return blkSize_ * numI_;
+  } else if (dir == "k") {
+    return blkSize_ * numI_ * numJ_;
+  } else {
+    cerr << "ERROR: Error in multiArray3d::Stride. Direction " << dir
+         << " is not recognized!" << endl;
+    exit(EXIT_FAILURE);
+  }
+}
+
 
 template <typename T>
 T multiArray3d<T>::GetElem(const int &ii, const int &jj, const int &kk) const {
@@ -1435,19 +1481,10 @@ void multiArray3d<T>::PutSlice(const TT &array, const connection &inter,
   InsertSlice((*this), array, inter, d3);
 }
 
-/*Member function to pack an array into a buffer, swap it with its
-  connection partner, and then unpack it into an array.*/
+// Member function to get the size of the buffer needed to pack the array
 template <typename T>
-void multiArray3d<T>::PackSwapUnpackMPI(const connection &inter,
-                                        const MPI_Datatype &MPI_arrData,
-                                        const int &rank, const int tag) {
-  // inter -- connection boundary for the swap
+int multiArray3d<T>::PackSizeMPI(const MPI_Datatype &MPI_arrData) const {
   // MPI_arrData -- MPI datatype to pass data type in array
-  // rank -- processor rank
-  // tag -- id to send data with (default 1)
-
-  // swap with mpi_send_recv_replace
-  // pack data into buffer, but first get size
   auto bufSize = 0;
   auto tempSize = 0;
   // add size for states
@@ -1456,13 +1493,18 @@ void multiArray3d<T>::PackSwapUnpackMPI(const connection &inter,
   // add size for 5 ints for multiArray3d dims and num ghosts
   MPI_Pack_size(5, MPI_INT, MPI_COMM_WORLD, &tempSize);
   bufSize += tempSize;
+  return bufSize;
+}
 
-  // allocate buffer to pack data into
-  // use unique_ptr to manage memory; use underlying pointer for MPI calls
-  auto buffer = std::make_unique<char[]>(bufSize);
-  auto *rawBuffer = buffer.get();
+// Member function to pack the array into a buffer sized with PackSizeMPI
+template <typename T>
+void multiArray3d<T>::PackMPI(const MPI_Datatype &MPI_arrData,
+                              vector<char> &buffer) const {
+  // MPI_arrData -- MPI datatype to pass data type in array
+  // buffer -- buffer to pack data into
+  auto *rawBuffer = buffer.data();
+  const int bufSize = buffer.size();
 
-  // pack data into buffer
   auto numI = this->NumI();
   auto numJ = this->NumJ();
   auto numK = this->NumK();
@@ -1475,20 +1517,27 @@ void multiArray3d<T>::PackSwapUnpackMPI(const connection &inter,
   MPI_Pack(&numGhosts, 1, MPI_INT, rawBuffer, bufSize, &position,
            MPI_COMM_WORLD);
   MPI_Pack(&blkSize, 1, MPI_INT, rawBuffer, bufSize, &position, MPI_COMM_WORLD);
-  MPI_Pack(&(*std::begin(data_)), this->Size(), MPI_arrData, rawBuffer, bufSize,
-           &position, MPI_COMM_WORLD);
-
-  MPI_Status status;
-  if (rank == inter.RankFirst()) {  // send/recv with second entry in connection
-    MPI_Sendrecv_replace(rawBuffer, bufSize, MPI_PACKED, inter.RankSecond(),
-                         tag, inter.RankSecond(), tag, MPI_COMM_WORLD, &status);
-  } else {  // send/recv with first entry in connection
-    MPI_Sendrecv_replace(rawBuffer, bufSize, MPI_PACKED, inter.RankFirst(),
-                         tag, inter.RankFirst(), tag, MPI_COMM_WORLD, &status);
-  }
+  MPI_Pack(&(*std::cbegin(data_)), this->Size(), MPI_arrData, rawBuffer,
+           bufSize, &position, MPI_COMM_WORLD);
+}
 
-  // put slice back into multiArray3d
-  position = 0;
+// Member function to unpack a buffer packed with PackMPI into the array. The
+// array is resized to the dimensions of the packed array, which must have the
+// same number of elements.
+template <typename T>
+void multiArray3d<T>::UnpackMPI(const MPI_Datatype &MPI_arrData,
+                                vector<char> &buffer) {
+  // MPI_arrData -- MPI datatype to pass data type in array
+  // buffer -- buffer to unpack data from
+  auto *rawBuffer = buffer.data();
+  const int bufSize = buffer.size();
+
+  auto numI = 0;
+  auto numJ = 0;
+  auto numK = 0;
+  auto numGhosts = 0;
+  auto blkSize = 0;
+  auto position = 0;
   MPI_Unpack(rawBuffer, bufSize, &position, &numI, 1, MPI_INT,
              MPI_COMM_WORLD);
   MPI_Unpack(rawBuffer, bufSize, &position, &numJ, 1, MPI_INT,
@@ -1507,6 +1556,37 @@ void multiArray3d<T>::PackSwapUnpackMPI(const connection &inter,
              MPI_arrData, MPI_COMM_WORLD);
 }
 
+/*Member function to pack an array into a buffer, swap it with its
+  connection partner, and then unpack it into an array.*/
+template <typename T>
+void multiArray3d<T>::PackSwapUnpackMPI(const connection &inter,
+                                        const MPI_Datatype &MPI_arrData,
+                                        const int &rank, const int tag) {
+  // inter -- connection boundary for the swap
+  // MPI_arrData -- MPI datatype to pass data type in array
+  // rank -- processor rank
+  // tag -- id to send data with (default 1)
+
+  // swap with mpi_send_recv_replace
+  // pack data into buffer, but first get size
+  vector<char> buffer(this->PackSizeMPI(MPI_arrData));
+  this->PackMPI(MPI_arrData, buffer);
+
+  MPI_Status status;
+  if (rank == inter.RankFirst()) {  // send/recv with second entry in connection
+    MPI_Sendrecv_replace(buffer.data(), buffer.size(), MPI_PACKED,
+                         inter.RankSecond(), tag, inter.RankSecond(), tag,
+                         MPI_COMM_WORLD, &status);
+  } else {  // send/recv with first entry in connection
+    MPI_Sendrecv_replace(buffer.data(), buffer.size(), MPI_PACKED,
+                         inter.RankFirst(), tag, inter.RankFirst(), tag,
+                         MPI_COMM_WORLD, &status);
+  }
+
+  // put slice back into multiArray3d
+  this->UnpackMPI(MPI_arrData, buffer);
+}
+
 /* Function to swap slice using MPI. This is similar to the SwapSlice
    function, but is called when the neighboring procBlocks are on different
    processors.
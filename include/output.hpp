@@ -29,8 +29,13 @@ It also writes out a master file in Ensight format to name the Plot3D functions.
 #include <iostream>
 #include <vector>        // vector
 #include <string>        // string
+#include <cstdint>       // int64_t
+#include <functional>    // function
+#include <array>
 #include "multiArray3d.hpp"
 #include "blkMultiArray3d.hpp"
+#include "range.hpp"
+#include "mpi.h"
 
 using std::vector;
 using std::string;
@@ -53,6 +58,30 @@ class primitive;
 class residual;
 class gridLevel;
 
+// restart file data for the blocks on a processor, in file order
+struct restartData {
+  string header_;                    // header, written by ROOT
+  vector<MPI_Aint> displacements_;   // file offset of each contiguous section
+  vector<int> lengths_;              // number of bytes in each section; long
+                                     // sections are split to fit in an int
+  vector<char> data_;                // bytes to write
+  MPI_Offset fileSize_ = 0;          // size of complete file
+};
+
+// description of a chunk of a compressed restart file
+struct restartChunk {
+  int64_t level_;      // time level (0 is n, 1 is n-1)
+  int64_t parent_;     // parent block in grid file
+  int64_t start_[3];   // first cell of chunk in parent block
+  int64_t end_[3];     // one past last cell of chunk in parent block
+  int64_t offset_;     // offset of chunk in file
+  int64_t size_;       // number of bytes in chunk
+};
+
+// function to evaluate an output variable at all cells of a block
+using blockExtractor =
+    std::function<void(const procBlock &, const int &, vector<double> &)>;
+
 // function definitions
 template<typename T>
 void WriteBlockDims(ofstream &, const vector<T> &, int = 0);
@@ -64,6 +93,14 @@ void WriteWallFaceCenter(const string &, const vector<procBlock> &,
                          const double &);
 void WriteOutput(const vector<procBlock> &, const physics &, const int &,
                  const decomposition &, const input &);
+template <typename T>
+blockExtractor CellExtractor(const T &);
+blockExtractor SplitExtractor(const vector<procBlock> &,
+                              const vector<procBlock> &,
+                              const decomposition &, const bool &);
+vector<blockExtractor> FunExtractors(const physics &, const input &,
+                                     const blockExtractor &,
+                                     const blockExtractor &);
 void WriteFunFile(const vector<procBlock> &, const vector<procBlock> &,
                   const physics &, const decomposition &, const string &,
                   const input &);
@@ -76,20 +113,57 @@ void WriteNodeFun(const vector<procBlock> &, vector<procBlock> &,
 void WriteWallFun(const vector<procBlock> &, const physics &phys, const int &,
                   const input &);
 void WriteMeta(const input &, const int &, const bool &);
+void WriteVtkOutput(const vector<procBlock> &, const physics &, const int &,
+                    const decomposition &, const input &,
+                    const vector<vector3d<int>> &, const vector<int> &,
+                    const int &);
+string VtkByteOrder();
+string VtkFileName(const input &, const int &, const int &, const string &);
+void WriteVtsFile(const procBlock &, const physics &, const int &,
+                  const std::array<range, 3> &, const input &);
+void WriteVtkMeta(const input &, const int &, const decomposition &,
+                  const vector<vector3d<int>> &, const vector<int> &);
 void WriteWallMeta(const input &, const int &);
 
-void WriteRestart(const vector<procBlock> &, const physics &, const int &,
-                  const decomposition &, const input &, const residual &);
+restartData PackRestart(const vector<procBlock> &, const physics &,
+                        const int &, const decomposition &, const input &,
+                        const residual &, const vector<vector3d<int>> &);
+restartData PackCompressedRestart(const vector<procBlock> &, const physics &,
+                                  const int &, const decomposition &,
+                                  const input &, const residual &,
+                                  const vector<vector3d<int>> &, const int &);
+void AddFileSection(const MPI_Aint &, const MPI_Aint &, vector<MPI_Aint> &,
+                    vector<int> &);
+MPI_Datatype ByteBufferType(const MPI_Aint &);
+vector<string> RestartVariables(const input &);
+double RestartValue(const procBlock &, const int &, const int &, const int &,
+                    const string &, const input &, const physics &);
+double RestartValueNm1(const procBlock &, const int &, const int &,
+                       const int &, const string &, const input &,
+                       const physics &);
+string RestartHeader(const int &, const int &, const input &,
+                     const residual &, const vector<vector3d<int>> &,
+                     const int &, const int &);
+vector<vector<vector<double>>> ReadRestartCells(
+    const gridLevel &, const string &, const decomposition &,
+    const vector<vector3d<int>> &, const vector<vector<int64_t>> &,
+    const int &, const int &);
+vector<vector<vector<double>>> ReadCompressedRestartCells(
+    const gridLevel &, const string &, const decomposition &,
+    const vector<vector3d<int>> &, const vector<restartChunk> &, const int &,
+    const int &);
 void ReadRestart(gridLevel &, const string &, const decomposition &,
                  input &, const physics &, residual &,
-                 const vector<vector3d<int>> &);
+                 const vector<vector3d<int>> &, const int &);
 
-blkMultiArray3d<primitive> ReadSolFromRestart(ifstream &, const input &,
+blkMultiArray3d<primitive> ReadSolFromRestart(const vector<double> &,
+                                              const input &,
                                               const physics &,
                                               const vector<string> &,
                                               const int &, const int &,
                                               const int &, const int &);
-blkMultiArray3d<conserved> ReadSolNm1FromRestart(ifstream &, const input &,
+blkMultiArray3d<conserved> ReadSolNm1FromRestart(const vector<double> &,
+                                                 const input &,
                                                  const physics &,
                                                  const vector<string> &,
                                                  const int &, const int &,
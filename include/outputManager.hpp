@@ -0,0 +1,97 @@
+/*  This file is part of aither.
+    Copyright (C) 2015-19  Michael Nucci (mnucci@pm.me)
+
+    Aither is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Aither is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>. */
+
+#ifndef OUTPUT_MANAGER_HEADERDEF
+#define OUTPUT_MANAGER_HEADERDEF
+
+/* This class manages writing the function and restart files during a
+simulation. In asynchronous mode the solver only takes a snapshot of the data
+to write, and the write completes while the iterations continue. A write only
+waits on the previous write of the same kind if it has not finished yet.
+
+Function files are written on the ROOT processor by a background thread, so
+that the thread does not make MPI calls. VTK files are written the same way by
+each processor for its own blocks. Restart files are written by all
+processors with a nonblocking collective MPI-IO write that is completed before
+the next restart file is written.
+*/
+
+#include <vector>
+#include <string>
+#include <thread>
+#include <memory>
+#include "output.hpp"
+#include "procBlock.hpp"
+#include "input.hpp"
+#include "mpi.h"
+
+using std::vector;
+using std::string;
+
+// forward class declaration
+class physics;
+class decomposition;
+class residual;
+
+class outputManager {
+  bool isAsync_;
+  int rank_;
+
+  // function files
+  std::thread funWriter_;
+  vector<procBlock> funBlocks_;  // snapshot of blocks being written
+  std::unique_ptr<input> funInput_;  // snapshot of input being written
+  vector<int> vtkIters_;  // iterations of vtk outputs written by this run
+
+  // restart files
+  restartData restart_;
+  MPI_File restartFile_;
+  MPI_Datatype restartType_;
+  MPI_Request restartRequest_;
+  bool restartPending_;
+
+ public:
+  // Constructor
+  outputManager(const input &inp, const int &rank);
+
+  // move and copy not allowed because of pending writes
+  outputManager(outputManager &&) = delete;
+  outputManager &operator=(outputManager &&) = delete;
+  outputManager(const outputManager &) = delete;
+  outputManager &operator=(const outputManager &) = delete;
+
+  // Member functions
+  bool IsAsync() const { return isAsync_; }
+  void WriteOutput(const vector<procBlock> &blks, const physics &phys,
+                   const int &iter, const decomposition &decomp,
+                   const input &inp);
+  void WriteVtkOutput(const vector<procBlock> &blks, const physics &phys,
+                      const int &iter, const decomposition &decomp,
+                      const input &inp,
+                      const vector<vector3d<int>> &gridSizes);
+  void WriteRestart(const vector<procBlock> &blks, const physics &phys,
+                    const int &iter, const decomposition &decomp,
+                    const input &inp, const residual &residL2First,
+                    const vector<vector3d<int>> &gridSizes);
+  void FinishOutput();
+  void FinishRestart();
+  void Finish();
+
+  // Destructor
+  ~outputManager() noexcept;
+};
+
+#endif
@@ -23,9 +23,10 @@
 #include <iostream>
 #include <vector>                  // vector
 #include <string>                  // string
+#include <array>                   // array
 #include "mpi.h"                   // parallelism
 #include "vector3d.hpp"
-#include "blkMultiArray3d.hpp"
+#include "range.hpp"
 
 using std::vector;
 using std::string;
@@ -38,7 +39,7 @@ using std::ostream;
 // forward class declarations
 class boundaryConditions;
 class procBlock;
-class plot3dBlock;
+class plot3dBlockRange;
 class connection;
 class resid;
 class genArray;
@@ -81,19 +82,19 @@ class decomposition {
   int ParentBlock(const int &a) const {return parBlock_[a];}
   int LocalPosition(const int &a) const {return localPos_[a];}
   int NumProcs() const {return numProcs_;}
-  double IdealLoad(const vector<plot3dBlock>&) const;
-  double MaxLoad(const vector<plot3dBlock>&) const;
-  double MinLoad(const vector<plot3dBlock>&) const;
-  double ProcLoad(const vector<plot3dBlock>&, const int&) const;
-  double LoadRatio(const vector<plot3dBlock>&, const int&) const;
-  int MostOverloadedProc(const vector<plot3dBlock>&, double&) const;
-  int MostUnderloadedProc(const vector<plot3dBlock>&, double&) const;
+  double IdealLoad(const vector<plot3dBlockRange>&) const;
+  double MaxLoad(const vector<plot3dBlockRange>&) const;
+  double MinLoad(const vector<plot3dBlockRange>&) const;
+  double ProcLoad(const vector<plot3dBlockRange>&, const int&) const;
+  double LoadRatio(const vector<plot3dBlockRange>&, const int&) const;
+  int MostOverloadedProc(const vector<plot3dBlockRange>&, double&) const;
+  int MostUnderloadedProc(const vector<plot3dBlockRange>&, double&) const;
   int NumBlocksOnProc(const int&) const;
   vector<int> NumBlocksOnAllProc() const;
   int NumBlocks() const {return rank_.size();}
   void SendToProc(const int&, const int&, const int&);
   void Split(const int&, const int&, const string&);
-  int SendWholeOrSplit(const vector<plot3dBlock>&, const int&,
+  int SendWholeOrSplit(const vector<plot3dBlockRange>&, const int&,
                        const int&, int&, string&) const;
   int Size() const {return static_cast<int> (rank_.size());}
 
@@ -102,10 +103,13 @@ class decomposition {
   int SplitHistBlkUpper(const int &a) const {return splitHistBlkUp_[a];}
   int SplitHistIndex(const int &a) const {return splitHistIndex_[a];}
   string SplitHistDir(const int &a) const {return splitHistDir_[a];}
-  template <typename T>
-  void DecompArray(vector<blkMultiArray3d<T>> &) const;
-  void PrintDiagnostics(const vector<plot3dBlock>&) const;
+  vector<std::array<range, 3>> NodeRanges(
+      const vector<vector3d<int>> &) const;
+  void PrintDiagnostics(const vector<plot3dBlockRange>&) const;
   void Broadcast();
+  int PackSize() const;
+  void Pack(char*(&), const int&, int&) const;
+  void Unpack(char*(&), const int&, int&);
   int GlobalPos(const int &rank, const int &localPos) const;
 
   // Destructor
@@ -115,12 +119,11 @@ class decomposition {
 // function definitions
 ostream & operator<< (ostream &os, const decomposition&);
 
-decomposition ManualDecomposition(vector<plot3dBlock>&,
+decomposition ManualDecomposition(vector<plot3dBlockRange>&,
                                   vector<boundaryConditions>&, const int&);
-decomposition CubicDecomposition(vector<plot3dBlock>&,
+decomposition CubicDecomposition(vector<plot3dBlockRange>&,
                                  vector<boundaryConditions>&, const int&);
 
-void SendNumProcBlocks(const vector<int>&, int&);
 
 void SetDataTypesMPI(MPI_Datatype &, MPI_Datatype &, MPI_Datatype &,
                      MPI_Datatype &, MPI_Datatype &, MPI_Datatype &,
@@ -132,25 +135,7 @@ void FreeDataTypesMPI(MPI_Datatype &, MPI_Datatype &, MPI_Datatype &,
 void MaxLinf(resid*, resid*, int*, MPI_Datatype*);
 
 void BroadcastString(string& str);
-void BroadcastViscFaces(const MPI_Datatype&, vector<vector3d<double>> &);
-
-template <typename T>
-void decomposition::DecompArray(vector<blkMultiArray3d<T>> &arr) const {
-  // resize vector for split blocks
-  arr.resize(this->NumBlocks());
-
-  // split array by decomposition
-  for (auto ii = 0; ii < this->NumSplits(); ++ii) {
-    auto ind = this->SplitHistIndex(ii);
-    auto lower = this->SplitHistBlkLower(ii);
-    auto upper = this->SplitHistBlkUpper(ii);
-    auto dir = this->SplitHistDir(ii);
-    auto lowerArray = arr[lower].Slice(dir, {arr[lower].Start(dir), ind + 1});
-    auto upperArray = arr[lower].Slice(dir, {ind, arr[lower].End(dir)});
-
-    arr[lower] = lowerArray;
-    arr[upper] = upperArray;
-  }
-}
+void AllGatherViscFaces(const MPI_Datatype&, vector<vector3d<double>> &);
+void BroadcastGridSizes(vector<vector3d<int>> &);
 
 #endif
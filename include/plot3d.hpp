@@ -24,12 +24,18 @@
 
 #include <vector>
 #include <string>
+#include <fstream>
+#include <map>
+#include <array>
 #include "vector3d.hpp"
 #include "multiArray3d.hpp"
 
 using std::vector;
 using std::string;
 
+// forward class declarations
+class decomposition;
+
 //-------------------------------------------------------------------------
 // Class for an individual plot3d block
 class plot3dBlock {
@@ -106,9 +112,97 @@ class plot3dBlock {
   ~plot3dBlock() noexcept {}
 };
 
+//-------------------------------------------------------------------------
+// forward class declaration
+class plot3dBlockRange;
+
+/* Class to read the nodes of a plot3d grid file as they are needed. Only the
+header is read when the file is opened, so the grid can be decomposed and its
+connection boundaries matched on the ROOT processor without reading the
+coordinates of the whole grid. Nodes that have been read are kept, because
+the same patch corners are used many times while matching connections.
+*/
+class plot3dFile {
+  mutable std::ifstream file_;                 // open grid file
+  vector<vector3d<int>> blkSize_;              // number of nodes in each block
+  vector<std::streamoff> blkStart_;            // location of block in file
+  double lRef_;                                // reference length
+  double numCells_;                            // total number of cells
+  mutable std::map<std::array<int, 4>, vector3d<double>> nodes_;  // read nodes
+
+ public:
+  // constructor
+  plot3dFile(const string &, const double &);
+
+  // move and copy not allowed because of open file
+  plot3dFile(plot3dFile &&) = delete;
+  plot3dFile &operator=(plot3dFile &&) = delete;
+  plot3dFile(const plot3dFile &) = delete;
+  plot3dFile &operator=(const plot3dFile &) = delete;
+
+  // member functions
+  int NumBlocks() const { return blkSize_.size(); }
+  const vector<vector3d<int>> &BlockSizes() const { return blkSize_; }
+  double NumCells() const { return numCells_; }
+  vector3d<double> Coords(const int &, const int &, const int &,
+                          const int &) const;
+  vector<plot3dBlockRange> Blocks() const;
+
+  // destructor
+  ~plot3dFile() noexcept {}
+};
+
+//-------------------------------------------------------------------------
+// Class for the range of nodes in a block of a plot3d grid file. The
+// coordinates are read from the file only when they are needed.
+class plot3dBlockRange {
+  const plot3dFile *file_;  // grid file block is in
+  int parBlock_;            // block in grid file
+  vector3d<int> start_;     // first node in block of grid file
+  vector3d<int> size_;      // number of nodes in i, j, k directions
+
+ public:
+  // constructor
+  plot3dBlockRange(const plot3dFile &file, const int &parBlock,
+                   const vector3d<int> &start, const vector3d<int> &size) :
+      file_(&file), parBlock_(parBlock), start_(start), size_(size) {}
+  plot3dBlockRange() :
+      file_(nullptr), parBlock_(0), start_(0, 0, 0), size_(0, 0, 0) {}
+
+  // move constructor and assignment operator
+  plot3dBlockRange(plot3dBlockRange&&) noexcept = default;
+  plot3dBlockRange& operator=(plot3dBlockRange&&) noexcept = default;
+
+  // copy constructor and assignment operator
+  plot3dBlockRange(const plot3dBlockRange&) = default;
+  plot3dBlockRange& operator=(const plot3dBlockRange&) = default;
+
+  // member functions
+  int NumI() const { return size_.X(); }
+  int NumJ() const { return size_.Y(); }
+  int NumK() const { return size_.Z(); }
+  int NumCellsI() const { return size_.X() - 1; }
+  int NumCellsJ() const { return size_.Y() - 1; }
+  int NumCellsK() const { return size_.Z() - 1; }
+  int NumCells() const {
+    return this->NumCellsI() * this->NumCellsJ() * this->NumCellsK();
+  }
+  vector3d<double> Coords(const int &ii, const int &jj, const int &kk) const {
+    return file_->Coords(parBlock_, start_.X() + ii, start_.Y() + jj,
+                         start_.Z() + kk);
+  }
+
+  plot3dBlockRange Split(const string &, const int &);
+
+  // destructor
+  ~plot3dBlockRange() noexcept {}
+};
+
 //-------------------------------------------------------------------------
 // function declarations
-vector<plot3dBlock> ReadP3dGrid(const string &, const double &, double &);
+vector<plot3dBlock> ReadP3dGridPar(const string &, const double &,
+                                   const vector<vector3d<int>> &,
+                                   const decomposition &, const int &);
 double PyramidVolume(const vector3d<double> &, const vector3d<double> &,
                      const vector3d<double> &, const vector3d<double> &,
                      const vector3d<double> &);
@@ -64,8 +64,9 @@ class primitive : public varArray {
             typename = std::enable_if_t<std::is_base_of<varArray, T>::value ||
                                         std::is_same<conservedView, T>::value>>
   primitive(const T &, const physics &);
-  primitive(const vector<double>::const_iterator &b,
-            const vector<double>::const_iterator &e, const int &numSpecies)
+  template <typename It,
+            typename = std::enable_if_t<!std::is_arithmetic<It>::value>>
+  primitive(const It &b, const It &e, const int &numSpecies)
       : varArray(b, e, numSpecies) {}
 
   // move constructor and assignment operator
@@ -25,6 +25,7 @@
 #include <memory>
 #include <algorithm>
 #include <cstdlib>
+#include <array>
 #include "mpi.h"                   // parallelism
 #include "vector3d.hpp"            // vector3d
 #include "multiArray3d.hpp"        // multiArray3d
@@ -39,6 +40,7 @@
 #include "uncoupledScalar.hpp"     // uncoupledScalar
 #include "wallData.hpp"
 #include "utility.hpp"
+#include "inputOptions.hpp"
 
 using std::vector;
 using std::string;
@@ -57,10 +59,46 @@ class resid;
 class kdtree;
 class conserved;
 class matMultiArray3d;
+class haloExchange;
 class physics;
 class turbModel;
 class eos;
 
+// fields calculated during the residual calculation whose ghost cells at
+// connection boundaries can be swapped together
+enum class haloField {
+  turbulence,
+  eddyViscosity,
+  velocityGradient,
+  temperatureGradient,
+  densityGradient,
+  pressureGradient,
+  tkeGradient,
+  omegaGradient,
+  mixtureGradient
+};
+
+// fields overwritten by a residual calculation, stored so that a residual
+// evaluated at a perturbed state can be undone
+struct residualFields {
+  blkMultiArray3d<primitive> state;
+  blkMultiArray3d<residual> resid;
+  multiArray3d<uncoupledScalar> specRadius;
+  multiArray3d<tensor<double>> velocityGrad;
+  multiArray3d<vector3d<double>> temperatureGrad;
+  multiArray3d<vector3d<double>> densityGrad;
+  multiArray3d<vector3d<double>> pressureGrad;
+  multiArray3d<vector3d<double>> tkeGrad;
+  multiArray3d<vector3d<double>> omegaGrad;
+  multiArray3d<vector3d<double>> mixtureGrad;
+  multiArray3d<double> temperature;
+  multiArray3d<double> viscosity;
+  multiArray3d<double> eddyViscosity;
+  multiArray3d<double> f1;
+  multiArray3d<double> f2;
+  vector<wallData> walls;
+};
+
 class procBlock {
   blkMultiArray3d<primitive> state_;  // primitive vars at cell center
   blkMultiArray3d<conserved> consVarsN_;  // conserved vars at t=n
@@ -121,12 +159,20 @@ class procBlock {
   bool isMultiSpecies_;
 
   // private member functions
-  void CalcInvFluxI(const physics &, const input &, matMultiArray3d &);
-  void CalcInvFluxJ(const physics &, const input &, matMultiArray3d &);
-  void CalcInvFluxK(const physics &, const input &, matMultiArray3d &);
-
+  void CalcInvFlux(const string &, const physics &, const input &,
+                   matMultiArray3d &);
+  template <inviscidFluxMethod F>
+  void CalcInvFlux(const string &, const physics &, const input &,
+                   matMultiArray3d &);
+  template <inviscidFluxMethod F, reconstructionMethod R, limiterMethod L>
+  void CalcInvFluxPencils(const string &, const physics &, const input &,
+                          matMultiArray3d &);
+
+  template <viscousReconstructionMethod V>
   void CalcViscFluxI(const physics &, const input &, matMultiArray3d &);
+  template <viscousReconstructionMethod V>
   void CalcViscFluxJ(const physics &, const input &, matMultiArray3d &);
+  template <viscousReconstructionMethod V>
   void CalcViscFluxK(const physics &, const input &, matMultiArray3d &);
 
   void CalcCellDt(const int &, const int &, const int &, const double &);
@@ -137,6 +183,10 @@ class procBlock {
                            const int &, const int &);
   void RK4TimeAdvance(const conservedView &, const physics &, const int &,
                       const int &, const int &, const int &);
+  template <timeIntegrationMethod T>
+  void UpdateBlockCells(const input &, const physics &,
+                        const blkMultiArray3d<varArray> &, const int &,
+                        residual &, resid &);
   template <typename T>
   void AddToResidual(const int &, const int &, const int &, const T &);
   template <typename T>
@@ -234,6 +284,15 @@ class procBlock {
   conservedView ConsVarsNm1(const int &ii, const int &jj, const int &kk) const {
     return consVarsNm1_(ii, jj, kk);
   }
+  const blkMultiArray3d<conserved> &ConsVarsN() const { return consVarsN_; }
+  const blkMultiArray3d<conserved> &ConsVarsNm1() const { return consVarsNm1_; }
+  const multiArray3d<double> &TimeSteps() const { return dt_; }
+  const multiArray3d<vector3d<double>> &PressureGrads() const {
+    return pressureGrad_;
+  }
+  const multiArray3d<tensor<double>> &VelocityGrads() const {
+    return velocityGrad_;
+  }
 
   blkMultiArray3d<primitive> SliceState(const int &, const int &, const int &,
                                         const int &, const int &,
@@ -246,6 +305,8 @@ class procBlock {
                         const input &) const;
   double SolDeltaNm1Coeff(const int &, const int &, const int &,
                           const input &) const;
+  double ImplicitTimeDiagonal(const int &, const int &, const int &,
+                              const input &) const;
   varArray SolDeltaMmN(const int &, const int &, const int &, const input &,
                        const physics &) const;
   varArray SolDeltaNm1(const int &, const int &, const int &,
@@ -337,6 +398,8 @@ class procBlock {
   const double &WallDist(const int &ii, const int &jj, const int &kk) const {
     return wallDist_(ii, jj, kk);
   }
+  const multiArray3d<double> &WallDistances() const { return wallDist_; }
+  void AssignWallDistances(const multiArray3d<double> &wd) { wallDist_ = wd; }
 
   residualView Residual(const int &ii, const int &jj, const int &kk) const {
     return residual_(ii, jj, kk);
@@ -395,8 +458,15 @@ class procBlock {
   void UpdateBlock(const input &, const physics &,
                    const blkMultiArray3d<varArray> &, const int &, residual &,
                    resid &);
+  void PerturbState(const blkMultiArray3d<varArray> &, const physics &);
+  residualFields ResidualFields() const;
+  void RestoreResidualFields(residualFields &&);
 
   void CalcResidualNoSource(const physics &, const input &, matMultiArray3d &);
+  void StartResidualNoSource(const physics &, const input &, matMultiArray3d &,
+                             const std::array<bool, 3> &);
+  void FinishResidualNoSource(const physics &, const input &,
+                              matMultiArray3d &, const std::array<bool, 3> &);
   void CalcSrcTerms(const physics &, const input &, matMultiArray3d &);
 
   void ResetResidWS();
@@ -446,6 +516,8 @@ class procBlock {
   varArray ImplicitUpper(const int &, const int &, const int &,
                          const blkMultiArray3d<varArray> &, const physics &,
                          const input &) const;
+  void CalcOffDiagonalJacobians(const physics &, const input &,
+                                vector<matMultiArray3d> &) const;
 
   bool IsPhysical(const int &ii, const int &jj, const int &kk) const {
     return state_.IsPhysical(ii, jj, kk);
@@ -474,19 +546,19 @@ class procBlock {
   void Join(const procBlock &, const string &, vector<boundarySurface> &);
 
   void SwapStateSlice(const connection &, procBlock &);
-  void SwapStateSliceMPI(const connection &, const int &);
-  void SwapTurbSlice(const connection &, procBlock &);
-  void SwapTurbSliceMPI(const connection &, const int &);
+  void SwapStateSliceMPI(const connection &, const int &, haloExchange &);
   void SwapWallDistSlice(const connection &, procBlock &);
-  void SwapWallDistSliceMPI(const connection &, const int &);
-  void SwapEddyViscAndGradientSlice(const connection &, procBlock &);
-  void SwapEddyViscAndGradientSliceMPI(const connection &, const int &,
-                                       const MPI_Datatype &,
-                                       const MPI_Datatype &);
+  void SwapWallDistSliceMPI(const connection &, const int &, haloExchange &);
+  bool HasField(const haloField &) const;
+  void SwapFieldSlices(const vector<haloField> &, const connection &,
+                       procBlock &);
+  void SwapFieldSlicesMPI(const vector<haloField> &, const connection &,
+                          const int &, const MPI_Datatype &,
+                          const MPI_Datatype &, haloExchange &);
 
   void PackSendGeomMPI(const MPI_Datatype &, const MPI_Datatype &) const;
   void RecvUnpackGeomMPI(const MPI_Datatype &, const MPI_Datatype &,
-                         const input &);
+                         const input &, const int &, const int &);
   void PackSendSolMPI(const MPI_Datatype &, const MPI_Datatype &,
                       const MPI_Datatype &) const;
   void RecvUnpackSolMPI(const MPI_Datatype &, const MPI_Datatype &,
@@ -502,10 +574,19 @@ class procBlock {
   void CalcCellWidths();
   void GetStatesFromRestart(const blkMultiArray3d<primitive> &);
   void GetSolNm1FromRestart(const blkMultiArray3d<conserved> &);
+  void RestoreSolution(const blkMultiArray3d<primitive> &,
+                       const blkMultiArray3d<conserved> &,
+                       const blkMultiArray3d<conserved> &,
+                       const multiArray3d<double> &,
+                       const multiArray3d<vector3d<double>> &,
+                       const multiArray3d<tensor<double>> &, const physics &);
+  bool IsSolutionPhysical() const;
   // DEBUG
   const blkMultiArray3d<primitive> &States() const { return state_; }
 
   int WallDataIndex(const boundarySurface &) const;
+  int WallNormalDirection() const;
+  wallLoads WallLoads(const physics &, const vector3d<double> &) const;
   int WallDataSize() const {return wallData_.size();}
   bool HasWallData() const {return this->WallDataSize() > 0;}
   boundarySurface WallSurface(const int &ii) const {
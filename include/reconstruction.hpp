@@ -25,6 +25,7 @@
 #include "arrayView.hpp"
 #include "primitive.hpp"
 #include "limiter.hpp"
+#include "inputOptions.hpp"
 #include "macros.hpp"
 #include "utility.hpp"
 
@@ -106,11 +107,11 @@ R = ((Ui - Ui-1) / dP) / ((Ui+1 - Ui) / dM)
 Ui+1/2 = Ui + 0.25 * ((Ui - Ui-1) / dM) * ( (1-K) * L  + (1+K) * R * Linv )
 
 */
-template <typename T>
+template <limiterMethod L, typename T>
 primitive FaceReconMUSCL(const T &upwind2, const T &upwind1, const T &downwind1,
-                         const double &kappa, const string &lim,
-                         const double &uw2, const double &uw,
-                         const double &dw) {
+                         const double &kappa, const double &uw2,
+                         const double &uw, const double &dw) {
+  // L -- limiter to use, resolved at compile time
   // upwind2 -- upwind cell furthest from the face at which the primitive is
   //            being reconstructed.
   // upwind1 -- upwind cell nearest to the face at which the primitive is
@@ -134,18 +135,15 @@ primitive FaceReconMUSCL(const T &upwind2, const T &upwind1, const T &downwind1,
 
   primitive limiter;
   primitive invLimiter;
-  if (lim == "none") {
-    limiter = LimiterNone(r.Size(), r.NumSpecies());
-    invLimiter = limiter;
-  } else if (lim == "vanAlbada") {
+  if (L == limiterMethod::vanAlbada) {
     limiter = LimiterVanAlbada(r);
     invLimiter = LimiterVanAlbada(1.0 / r);
-  } else if (lim == "minmod") {
+  } else if (L == limiterMethod::minmod) {
     limiter = LimiterMinmod(r);
     invLimiter = LimiterMinmod(1.0 / r);
   } else {
-    cerr << "ERROR: Limiter " << lim << " is not recognized!" << endl;
-    exit(EXIT_FAILURE);
+    limiter = LimiterNone(r.Size(), r.NumSpecies());
+    invLimiter = limiter;
   }
 
   // calculate reconstructed state at face using MUSCL method with limiter
@@ -0,0 +1,152 @@
+/*  This file is part of aither.
+    Copyright (C) 2015-19  Michael Nucci (mnucci@pm.me)
+
+    Aither is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Aither is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>. */
+
+
+#ifndef SAMPLING_HEADERDEF
+#define SAMPLING_HEADERDEF
+
+/* This file contains the sampleSet and sampleManager classes, which are used
+to write time histories of the solution at a set of cells without writing out
+the whole solution.
+
+A sample set is specified in the input file as a point, a line of equally
+spaced points, or a surface given by a range of cells in a parent block of the
+grid. Cell ranges are zero based and inclusive.
+
+samples: <point(name=probe; location=[1.0, 0.5, 0.0]),
+          line(name=wake; start=[1.0, 0.0, 0.0]; end=[2.0, 0.0, 0.0]; points=50),
+          surface(name=exit; block=0; i=[0, 20]; j=40; k=[0, 10])>
+
+Points are sampled at the cell with the nearest center. At startup each
+processor finds the nearest of its own cells with a k-d tree, and the
+processor with the nearest cell owns the sample. When the samples are written
+each processor fills in the values it owns, and they are summed onto the ROOT
+processor, which writes one line per sample set to the file
+<simName>_<setName>.sample.
+*/
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <functional>
+#include <memory>
+#include "vector3d.hpp"
+
+using std::string;
+using std::vector;
+using std::ostream;
+using std::ifstream;
+using std::ofstream;
+
+// forward class declaration
+class input;
+class physics;
+class procBlock;
+class gridLevel;
+class decomposition;
+
+class sampleSet {
+  string type_ = "point";
+  string name_ = "undefined";
+  vector3d<double> start_ = {0.0, 0.0, 0.0};
+  vector3d<double> end_ = {0.0, 0.0, 0.0};
+  int numPoints_ = 1;
+  int block_ = -1;
+  vector3d<int> cellStart_ = {0, 0, 0};  // first cell of surface
+  vector3d<int> cellEnd_ = {0, 0, 0};    // one past last cell of surface
+
+ public:
+  // constructor
+  sampleSet() {}
+
+  // move constructor and assignment operator
+  sampleSet(sampleSet&&) noexcept = default;
+  sampleSet& operator=(sampleSet&&) noexcept = default;
+
+  // copy constructor and assignment operator
+  sampleSet(const sampleSet&) = default;
+  sampleSet& operator=(const sampleSet&) = default;
+
+  // member functions
+  void Read(string &str);
+  void Print(ostream &os) const;
+  const string &Type() const { return type_; }
+  const string &Name() const { return name_; }
+  bool IsSurface() const { return type_ == "surface"; }
+  int Block() const { return block_; }
+  const vector3d<int> &CellStart() const { return cellStart_; }
+  const vector3d<int> &CellEnd() const { return cellEnd_; }
+  int NumSamples() const;
+  vector3d<double> Location(const int &ii) const;
+
+  // destructor
+  ~sampleSet() noexcept {}
+};
+
+// function to evaluate a sample variable at a cell
+using sampleVariable =
+    std::function<double(const procBlock &, const int &, const int &,
+                         const int &)>;
+
+// cell owned by this processor that is sampled
+struct sampleCell {
+  int sample_;  // position of sample in all sample sets
+  int block_;   // local position of block
+  int i_;
+  int j_;
+  int k_;
+};
+
+class sampleManager {
+  int rank_;
+  vector<sampleSet> sets_;
+  vector<int> offsets_;  // position of first sample of each set
+  vector<string> varNames_;
+  vector<sampleVariable> vars_;
+  vector<sampleCell> cells_;  // samples owned by this processor
+  vector<std::unique_ptr<ofstream>> files_;
+
+ public:
+  // Constructor
+  sampleManager(const input &inp, const physics &phys, const gridLevel &level,
+                const decomposition &decomp,
+                const vector<vector3d<int>> &gridSizes, const int &rank);
+
+  // move constructor and assignment operator
+  sampleManager(sampleManager&&) noexcept = default;
+  sampleManager& operator=(sampleManager&&) noexcept = default;
+
+  // copy not allowed because of open files
+  sampleManager(const sampleManager&) = delete;
+  sampleManager& operator=(const sampleManager&) = delete;
+
+  // Member functions
+  int NumSamples() const { return offsets_.empty() ? 0 : offsets_.back(); }
+  bool HasSamples() const { return this->NumSamples() > 0; }
+  void Write(const gridLevel &level, const input &inp, const int &iter) const;
+
+  // Destructor
+  ~sampleManager() noexcept {}
+};
+
+// function declarations
+ostream &operator<<(ostream &, const sampleSet &);
+vector<sampleSet> ReadSampleList(ifstream &, string &);
+vector<sampleVariable> SampleVariables(const vector<string> &,
+                                       const physics &, const input &);
+
+#endif
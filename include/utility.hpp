@@ -43,6 +43,7 @@ class kdtree;
 class resid;
 class primitive;
 class varArray;
+class haloExchange;
 
 // function definitions
 tensor<double> VectorGradGG(const vector3d<double> &, const vector3d<double> &,
@@ -66,10 +67,12 @@ void SwapGeomSliceMPI(connection &inter, procBlock &blk, const int &tag,
                       const MPI_Datatype &MPI_vec3dMag);
 vector<vector3d<double>> GetViscousFaceCenters(const vector<procBlock> &);
 void SwapImplicitUpdate(vector<blkMultiArray3d<varArray>> &,
-                        const vector<connection> &, const int &, const int &);
+                        const vector<connection> &, const int &, const int &,
+                        haloExchange &);
 
 // function to reorder block by hyperplanes
 vector<vector3d<int>> HyperplaneReorder(const int &, const int &, const int &);
+vector<int> HyperplaneOffsets(const int &, const int &, const int &);
 
 vector3d<double> TauNormal(const tensor<double> &, const vector3d<double> &,
                            const double &, const double &,
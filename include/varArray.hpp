@@ -24,6 +24,7 @@
 #include <iterator>
 #include <cmath>
 #include <type_traits>
+#include <array>
 #include "macros.hpp"
 
 using std::ostream;
@@ -34,46 +35,71 @@ template <typename T1, typename T2>
 class arrayView;
 
 // Class to hold an array of variables. Length is equal to number of equations
-// being solved for.
+// being solved for. Data is stored inline in a fixed capacity array so that
+// temporaries created in the flux and relaxation loops never touch the heap.
+// The capacity is set at compile time with MAX_EQUATIONS and checked against
+// the number of equations when the input file is read.
 class varArray {
-  vector<double> data_;
+  std::array<double, MAX_EQUATIONS> data_;
+  int size_;
   int momentumIndex_;
   int energyIndex_;
   int turbulenceIndex_;
 
  public:
   // constructor
-  varArray() {}
+  varArray()
+      : size_(0), momentumIndex_(0), energyIndex_(3), turbulenceIndex_(4) {}
   varArray(const int &numEqns, const int &numSpecies, const double &val)
-      : data_(numEqns, val),
+      : size_(numEqns),
         momentumIndex_(numSpecies),
         energyIndex_(momentumIndex_ + 3),
         turbulenceIndex_(energyIndex_ + 1) {
     MSG_ASSERT(numEqns > numSpecies && numEqns >= 5,
                "number of equations should be greater than number of species");
+    MSG_ASSERT(numEqns <= MAX_EQUATIONS,
+               "number of equations exceeds compiled capacity");
+    std::fill_n(std::begin(data_), size_, val);
   }
   varArray(const int &numEqns, const int &numSpecies)
       : varArray(numEqns, numSpecies, 0.0) {}
-  varArray(const vector<double>::const_iterator &b,
-           const vector<double>::const_iterator &e, const int &numSpecies)
-      : data_(b, e),
+  template <typename It,
+            typename = std::enable_if_t<!std::is_arithmetic<It>::value>>
+  varArray(const It &b, const It &e, const int &numSpecies)
+      : size_(std::distance(b, e)),
         momentumIndex_(numSpecies),
         energyIndex_(momentumIndex_ + 3),
         turbulenceIndex_(energyIndex_ + 1) {
-    MSG_ASSERT(static_cast<int>(data_.size()) > numSpecies && data_.size() >= 5U,
+    MSG_ASSERT(size_ > numSpecies && size_ >= 5,
                "number of equations should be greater than number of species");
+    MSG_ASSERT(size_ <= MAX_EQUATIONS,
+               "number of equations exceeds compiled capacity");
+    std::copy(b, e, std::begin(data_));
   }
 
-  // move constructor and assignment operator
-  varArray(varArray&&) noexcept = default;
-  varArray& operator=(varArray&&) noexcept = default;
+  // copy constructor and assignment operator - only copy active portion
+  varArray(const varArray &other) noexcept
+      : size_(other.size_),
+        momentumIndex_(other.momentumIndex_),
+        energyIndex_(other.energyIndex_),
+        turbulenceIndex_(other.turbulenceIndex_) {
+    std::copy_n(std::begin(other.data_), size_, std::begin(data_));
+  }
+  varArray &operator=(const varArray &other) noexcept {
+    size_ = other.size_;
+    momentumIndex_ = other.momentumIndex_;
+    energyIndex_ = other.energyIndex_;
+    turbulenceIndex_ = other.turbulenceIndex_;
+    std::copy_n(std::begin(other.data_), size_, std::begin(data_));
+    return *this;
+  }
 
-  // copy constructor and assignment operator
-  varArray(const varArray&) = default;
-  varArray& operator=(const varArray&) = default;
+  // move constructor and assignment operator - no resources to steal
+  varArray(varArray &&other) noexcept : varArray(other) {}
+  varArray &operator=(varArray &&other) noexcept { return *this = other; }
 
   // member functions
-  int Size() const { return data_.size(); }
+  int Size() const { return size_; }
   int NumSpecies() const { return momentumIndex_; }
   int NumTurbulence() const { return this->Size() - turbulenceIndex_; }
   bool IsMultiSpecies() const { return this->NumSpecies() > 1; }
@@ -84,8 +110,8 @@ class varArray {
   int EnergyIndex() const { return energyIndex_; }
   int TurbulenceIndex() const { return turbulenceIndex_; }
   double SpeciesSum() const {
-    return std::accumulate(std::begin(data_),
-                           std::begin(data_) + this->NumSpecies(), 0.0);
+    return std::accumulate(this->begin(), this->begin() + this->NumSpecies(),
+                           0.0);
   }
 
   const double &SpeciesN(const int &ii) const {
@@ -102,26 +128,26 @@ class varArray {
     return (*this)[turbulenceIndex_ + ii];
   }
 
-  void Zero() { std::fill(std::begin(data_), std::end(data_), 0.0); }
+  void Zero() { std::fill(this->begin(), this->end(), 0.0); }
   double Sum() {
-    return std::accumulate(std::begin(data_), std::end(data_), 0.0);
+    return std::accumulate(this->begin(), this->end(), 0.0);
   }
   void SquareRoot() {
-    std::for_each(std::begin(data_), std::end(data_),
+    std::for_each(this->begin(), this->end(),
                   [](double &val) { val = sqrt(val); });
   }
   bool IsZero() const {
-    return std::all_of(std::begin(data_), std::end(data_),
+    return std::all_of(this->begin(), this->end(),
                        [](const double &val) { return val == 0.0; });
   }
   varArray Squared() const;
 
   // provide begin and end so std::begin and std::end can be used
   // use lower case to conform with std::begin, std::end
-  auto begin() noexcept {return data_.begin();}
-  const auto begin() const noexcept {return data_.begin();}
-  auto end() noexcept {return data_.end();}
-  const auto end() const noexcept {return data_.end();}
+  double *begin() noexcept { return data_.data(); }
+  const double *begin() const noexcept { return data_.data(); }
+  double *end() noexcept { return data_.data() + size_; }
+  const double *end() const noexcept { return data_.data() + size_; }
 
   arrayView<varArray, double> GetView() const;
 
@@ -130,7 +156,7 @@ class varArray {
   double & operator[](const int &r) { return data_[r]; }
 
   // destructor
-  virtual ~varArray() noexcept {}
+  ~varArray() noexcept {}
 };
 
 // --------------------------------------------------------------------------
@@ -554,8 +580,9 @@ class residual : public varArray {
   // constructor
   residual(const int &numEqns, const int &numSpecies)
       : varArray(numEqns, numSpecies) {}
-  residual(const vector<double>::const_iterator &b, 
-           const vector<double>::const_iterator &e, const int &numSpecies)
+  template <typename It,
+            typename = std::enable_if_t<!std::is_arithmetic<It>::value>>
+  residual(const It &b, const It &e, const int &numSpecies)
       : varArray(b, e, numSpecies) {}
 
   // move constructor and assignment operator
@@ -573,7 +600,7 @@ class residual : public varArray {
   arrayView<residual, double> GetView() const;
 
   // destructor
-  virtual ~residual() noexcept {}
+  ~residual() noexcept {}
 };
 
 
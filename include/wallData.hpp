@@ -61,6 +61,32 @@ struct wallVars {
               const int &);
 };
 
+// integrated loads on viscous walls
+class wallLoads {
+  vector3d<double> pressureForce_ = {0.0, 0.0, 0.0};
+  vector3d<double> viscousForce_ = {0.0, 0.0, 0.0};
+  vector3d<double> moment_ = {0.0, 0.0, 0.0};
+  double heatFlux_ = 0.0;  // heat transfer rate into walls
+
+ public:
+  // constructor
+  wallLoads() {}
+
+  // member functions
+  const vector3d<double> &PressureForce() const { return pressureForce_; }
+  const vector3d<double> &ViscousForce() const { return viscousForce_; }
+  vector3d<double> Force() const { return pressureForce_ + viscousForce_; }
+  const vector3d<double> &Moment() const { return moment_; }
+  double HeatFlux() const { return heatFlux_; }
+  void AddFace(const vector3d<double> &pressureForce,
+               const vector3d<double> &viscousForce,
+               const vector3d<double> &arm, const double &heatFlux);
+  void GlobalReduceMPI(const int &rank);
+
+  // operator overloads
+  wallLoads &operator+=(const wallLoads &);
+};
+
 class wallData {
   double inviscidForce_;
   double viscousForce_;
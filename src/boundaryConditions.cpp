@@ -422,26 +422,8 @@ vector<boundaryConditions> GatherBCs(const vector<boundaryConditions> &bc,
   } else {
     // send remote data
     for (auto lp = 0U; lp < bc.size(); ++lp) {
-      // add size for number of bc surfaces
       // determine size of buffer to send
-      auto sendBufSize = 0;
-      auto tempSize = 0;
-      MPI_Pack_size(3, MPI_INT, MPI_COMM_WORLD, &tempSize);
-      sendBufSize += tempSize;
-      // add size for BCs
-      // 8x because iMin, iMax, jMin, jMax, kMin, kMax, tags, string sizes
-      MPI_Pack_size(bc[lp].NumSurfaces() * 8, MPI_INT, MPI_COMM_WORLD,
-                    &tempSize);
-      sendBufSize += tempSize;
-
-      auto stringSize = 0;
-      for (auto jj = 0; jj < bc[lp].NumSurfaces(); ++jj) {
-        // add size for bc_ types (+1 for c_str end character)
-        MPI_Pack_size(bc[lp].GetBCTypes(jj).size() + 1, MPI_CHAR,
-                      MPI_COMM_WORLD, &tempSize);
-        stringSize += tempSize;
-      }
-      sendBufSize += stringSize;
+      const auto sendBufSize = bc[lp].PackSize();
 
       // allocate buffer to pack data into
       // use unique_ptr to manage memory; use underlying pointer with MPI calls
@@ -457,6 +439,107 @@ vector<boundaryConditions> GatherBCs(const vector<boundaryConditions> &bc,
   return allBCs;
 }
 
+/* Function to send the boundary conditions of each block from the ROOT
+processor to the processor that the block is on. This is the reverse of
+GatherBCs. The boundary conditions are returned in order of local position.
+*/
+vector<boundaryConditions> ScatterBCs(const vector<boundaryConditions> &allBCs,
+                                      const decomposition &decomp,
+                                      const int &rank) {
+  // allBCs -- boundary conditions of all blocks, only meaningful on ROOT
+  // decomp -- decomposition of grid onto processors
+  // rank -- processor rank
+
+  vector<boundaryConditions> bc(decomp.NumBlocksOnProc(rank));
+  if (rank == ROOTP) {
+    MSG_ASSERT(static_cast<int>(allBCs.size()) == decomp.NumBlocks(),
+               "BC and decomposition size mismatch");
+    for (auto gp = 0; gp < decomp.NumBlocks(); ++gp) {
+      const auto receivingRank = decomp.Rank(gp);
+      if (receivingRank == ROOTP) {  // data stays on rank 0
+        bc[decomp.LocalPosition(gp)] = allBCs[gp];
+      } else {  // pack and send to remote processor
+        const auto sendBufSize = allBCs[gp].PackSize();
+        auto sendBuffer = std::make_unique<char[]>(sendBufSize);
+        auto *rawSendBuffer = sendBuffer.get();
+        auto position = 0;
+        allBCs[gp].PackBC(rawSendBuffer, sendBufSize, position);
+        MPI_Send(rawSendBuffer, sendBufSize, MPI_PACKED, receivingRank, gp,
+                 MPI_COMM_WORLD);
+      }
+    }
+  } else {
+    // receive in order of global position to match sends from ROOT
+    for (auto gp = 0; gp < decomp.NumBlocks(); ++gp) {
+      if (decomp.Rank(gp) != rank) {
+        continue;
+      }
+      MPI_Status status;  // allocate MPI_Status structure
+      // probe message to get correct data size
+      auto recvBufSize = 0;
+      MPI_Probe(ROOTP, gp, MPI_COMM_WORLD, &status);
+      // use MPI_CHAR because sending buffer was allocated with chars
+      MPI_Get_count(&status, MPI_CHAR, &recvBufSize);
+      auto recvBuffer = std::make_unique<char[]>(recvBufSize);
+      auto *rawRecvBuffer = recvBuffer.get();
+      MPI_Recv(rawRecvBuffer, recvBufSize, MPI_PACKED, ROOTP, gp,
+               MPI_COMM_WORLD, &status);
+      auto position = 0;
+      bc[decomp.LocalPosition(gp)].UnpackBC(rawRecvBuffer, recvBufSize,
+                                            position);
+    }
+  }
+  return bc;
+}
+
+// Function to broadcast the connections found on ROOT to all processors
+void BroadcastConnections(vector<connection> &conn,
+                          const MPI_Datatype &MPI_connection) {
+  // conn -- connections, only meaningful on ROOT before call
+  // MPI_connection -- MPI_Datatype used for connection transmission
+
+  auto numConn = conn.size();
+  MPI_Bcast(&numConn, 1, MPI_INT, ROOTP, MPI_COMM_WORLD);
+  conn.resize(numConn);  // allocate space to receive connections
+
+  // broadcast all connections to all processors
+  MPI_Bcast(&(*std::begin(conn)), conn.size(), MPI_connection, ROOTP,
+            MPI_COMM_WORLD);
+}
+
+/* Function to combine the connection borders found on each processor. When
+geometry is swapped between processors, each processor only updates the
+borders for the side of the connection that it has. The borders are combined
+so that the connections match on all processors.
+*/
+void ReduceConnectionBorders(vector<connection> &conn) {
+  // conn -- connections with borders updated on this processor
+
+  vector<int> borders(conn.size() * 8);
+  for (auto ii = 0U; ii < conn.size(); ++ii) {
+    borders[ii * 8] = conn[ii].Dir1StartInterBorderFirst();
+    borders[ii * 8 + 1] = conn[ii].Dir1EndInterBorderFirst();
+    borders[ii * 8 + 2] = conn[ii].Dir2StartInterBorderFirst();
+    borders[ii * 8 + 3] = conn[ii].Dir2EndInterBorderFirst();
+    borders[ii * 8 + 4] = conn[ii].Dir1StartInterBorderSecond();
+    borders[ii * 8 + 5] = conn[ii].Dir1EndInterBorderSecond();
+    borders[ii * 8 + 6] = conn[ii].Dir2StartInterBorderSecond();
+    borders[ii * 8 + 7] = conn[ii].Dir2EndInterBorderSecond();
+  }
+  MPI_Allreduce(MPI_IN_PLACE, borders.data(), borders.size(), MPI_INT,
+                MPI_LOR, MPI_COMM_WORLD);
+  for (auto ii = 0U; ii < conn.size(); ++ii) {
+    for (auto bb = 0; bb < 4; ++bb) {
+      if (borders[ii * 8 + bb]) {
+        conn[ii].UpdateBorderFirst(bb);
+      }
+      if (borders[ii * 8 + bb + 4]) {
+        conn[ii].UpdateBorderSecond(bb);
+      }
+    }
+  }
+}
+
 /* Function to go through the boundary conditions and pair the connection
    BCs together and determine their orientation. This function first gathers
    the BCs and grids to rank 0, then finds the connection BCs. Finally it
@@ -484,25 +567,22 @@ vector<connection> GetConnectionBCsPar(const vector<boundaryConditions> &bc,
   }
 
   // broadcast connections to all procs
-  auto numConn = conn.size();
-  MPI_Bcast(&numConn, 1, MPI_INT, ROOTP, MPI_COMM_WORLD);
-  conn.resize(numConn);  // allocate space to receive connections
-
-  // broadcast all connections to all processors
-  MPI_Bcast(&(*std::begin(conn)), conn.size(), MPI_connection, ROOTP,
-            MPI_COMM_WORLD);
+  BroadcastConnections(conn, MPI_connection);
 
   return conn;
 }
 
 /* Function to go through the boundary conditions and pair the connection
-   BCs together and determine their orientation.*/
-vector<connection> GetConnectionBCs(const vector<boundaryConditions> &bc,
-                                    const vector<plot3dBlock> &grid,
-                                    const decomposition &decomp,
-                                    const input &inp) {
+   BCs together and determine their orientation. The patch of each connection
+   BC is found once, so only the corner nodes of the patches are taken from the
+   grid. The grid can be made of plot3dBlocks or plot3dBlockRanges.*/
+template <typename T>
+vector<connection> MatchConnectionBCs(const vector<boundaryConditions> &bc,
+                                      const vector<T> &grid,
+                                      const decomposition &decomp,
+                                      const input &inp) {
   // bc -- vector of boundaryConditions for all blocks
-  // grid -- vector of plot3Dblocks for entire computational mesh
+  // grid -- vector of blocks for entire computational mesh
   // decomp -- decomposition of grid onto processors
   // inp -- input variables
 
@@ -511,10 +591,10 @@ vector<connection> GetConnectionBCs(const vector<boundaryConditions> &bc,
   // Outer vector for each connection BC, inner vector for
   // information about connection
   vector<boundarySurface> isolatedConnections;
+  vector<patch> patches;  // patch of each connection
 
-  // Block number of bc, rank of block, local position on processor
-  vector<array<int, 3>> numRankPos;
-  vector<int> surfaceNums;  // surface number of connection
+  // Block number of bc
+  vector<int> blockNums;
 
   // loop over all blocks
   for (auto ii = 0U; ii < bc.size(); ii++) {
@@ -522,12 +602,26 @@ vector<connection> GetConnectionBCs(const vector<boundaryConditions> &bc,
     for (auto jj = 0; jj < bc[ii].NumSurfaces(); jj++) {
       // If boundary condition is connection, store data
       if (bc[ii].IsConnection(jj)) {
-        // block number of bc, rank, local position boundarySurface of bc
-        const array<int, 3> temp = {static_cast<int>(ii), decomp.Rank(ii),
-                                    decomp.LocalPosition(ii)};
-        numRankPos.push_back(temp);
-        isolatedConnections.push_back(bc[ii].GetSurface(jj));
-        surfaceNums.push_back(jj);
+        const auto surf = bc[ii].GetSurface(jj);
+
+        // Determine if surface borders any other surfaces
+        array<bool, 4> border = {false, false, false, false};
+        bc[ii].BordersSurface(jj, border);
+
+        // Get patch, block rank and local position are stored in patch
+        patch surfPatch(surf, grid[ii], ii, border, decomp.Rank(ii),
+                        decomp.LocalPosition(ii));
+        if (surfPatch.BCType() == "periodic") {
+          const auto &bcData = inp.BCData(surf.Tag());
+          if (bcData->StartTag() == surf.Tag()) {
+            // need to transform data if surface is startTag
+            surfPatch.Transform(bcData);
+          }
+        }
+
+        blockNums.push_back(ii);
+        isolatedConnections.push_back(surf);
+        patches.push_back(surfPatch);
       }
     }
   }
@@ -546,52 +640,21 @@ vector<connection> GetConnectionBCs(const vector<boundaryConditions> &bc,
       // Blocks and boundary surfaces between connections match
       // blocks between connection BCs match
       // or both are periodic
-      if ((isolatedConnections[ii].PartnerBlock() == numRankPos[jj][0] &&
+      if ((isolatedConnections[ii].PartnerBlock() == blockNums[jj] &&
            isolatedConnections[ii].PartnerSurface() ==
            isolatedConnections[jj].SurfaceType()) ||
           (isolatedConnections[ii].BCType() == "periodic" &&
            isolatedConnections[jj].BCType() == "periodic")) {
-        // Determine if surface borders any other surfaces
-        array<bool, 4> border = {false, false, false, false};
-        bc[numRankPos[ii][0]].BordersSurface(surfaceNums[ii], border);
-
-        // Get current patch
-        patch cPatch(isolatedConnections[ii], grid[numRankPos[ii][0]],
-                     numRankPos[ii][0], border, numRankPos[ii][1],
-                     numRankPos[ii][2]);
-        if (cPatch.BCType() == "periodic") {
-          const auto &bcData = inp.BCData(isolatedConnections[ii].Tag());
-          if (bcData->StartTag() == isolatedConnections[ii].Tag()) {
-            // need to transform data if surface is startTag
-            cPatch.Transform(bcData);
-          }
-        }
-
-        // Determine if surface borders any other surfaces
-        bc[numRankPos[jj][0]].BordersSurface(surfaceNums[jj], border);
-
-        // Get new patch (possible match)
-        patch nPatch(isolatedConnections[jj], grid[numRankPos[jj][0]],
-                     numRankPos[jj][0], border, numRankPos[jj][1],
-                     numRankPos[jj][2]);
-        if (nPatch.BCType() == "periodic") {
-          const auto &bcData = inp.BCData(isolatedConnections[jj].Tag());
-          if (bcData->StartTag() == isolatedConnections[jj].Tag()) {
-            // need to transform data if surface is startTag
-            nPatch.Transform(bcData);
-          }
-        }
-
-        // Test for match
-        connection match(cPatch, nPatch);
-        if (match.TestPatchMatch(cPatch, nPatch)) {  // match found
-          connections[ii / 2] = match;               // store connection pair
+        // Test for match between current patch and possible match
+        connection match(patches[ii], patches[jj]);
+        if (match.TestPatchMatch(patches[ii], patches[jj])) {  // match found
+          connections[ii / 2] = match;  // store connection pair
 
           // Swap matched connection BC to top portion of vector so
           // it is not searched again
           swap(isolatedConnections[jj], isolatedConnections[ii + 1]);
-          swap(numRankPos[jj], numRankPos[ii + 1]);
-          swap(surfaceNums[jj], surfaceNums[ii + 1]);
+          swap(blockNums[jj], blockNums[ii + 1]);
+          swap(patches[jj], patches[ii + 1]);
           break;  // exit innermost loop and search for next connection match
         }
       }
@@ -601,13 +664,29 @@ vector<connection> GetConnectionBCs(const vector<boundaryConditions> &bc,
   return connections;
 }
 
+// function to find the connections of a grid held in memory
+vector<connection> GetConnectionBCs(const vector<boundaryConditions> &bc,
+                                    const vector<plot3dBlock> &grid,
+                                    const decomposition &decomp,
+                                    const input &inp) {
+  return MatchConnectionBCs(bc, grid, decomp, inp);
+}
+
+// function to find the connections of a grid read from its grid file
+vector<connection> GetConnectionBCs(const vector<boundaryConditions> &bc,
+                                    const vector<plot3dBlockRange> &grid,
+                                    const decomposition &decomp,
+                                    const input &inp) {
+  return MatchConnectionBCs(bc, grid, decomp, inp);
+}
+
 /* Function to go through the boundary conditions and pair the connection
    BCs for a single block and determine their orientation */
 map<boundarySurface, pair<boundarySurface, int>> GetBlockInterConnBCs(
-    const vector<boundaryConditions> &bc, const vector<plot3dBlock> &grid,
+    const vector<boundaryConditions> &bc, const vector<plot3dBlockRange> &grid,
     const int &blk) {
   // bc -- vector of boundaryConditions for all blocks
-  // grid -- vector of plot3Dblocks for entire computational mesh
+  // grid -- vector of plot3dBlockRanges for entire computational mesh
   MSG_ASSERT(blk < static_cast<int>(bc.size()), "block out of range");
   MSG_ASSERT(blk < static_cast<int>(grid.size()), "block out of range");
 
@@ -2122,10 +2201,11 @@ patch::patch() {
 }
 
 // constructor with arguements passed
+// the corner points are assigned from the block the patch is on afterwards
 patch::patch(const int &bound, const int &b, const int &d1s, const int &d1e,
              const int &d2s, const int &d2e, const int &d3s, const int &d3e,
-             const plot3dBlock &blk, const int &r, const int &l,
-             const array<bool, 4> &border, const string &name) {
+             const int &r, const int &l, const array<bool, 4> &border,
+             const string &name) {
   // bound -- boundary number which patch is on (1-6)
   // b -- parent block number
   // d1s -- direction 1 starting index
@@ -2133,7 +2213,6 @@ patch::patch(const int &bound, const int &b, const int &d1s, const int &d1e,
   // d2s -- direction 2 starting index
   // d2e -- direction 2 ending index
   // d3s -- direction 3 surface index (constant surface that patch is on)
-  // blk -- plot3dBlock that patch is on
   // r -- rank of block
   // l -- local position of block
   // border -- flags indicating if patch borders an connection bc on sides 1/2
@@ -2155,20 +2234,6 @@ patch::patch(const int &bound, const int &b, const int &d1s, const int &d1e,
     d2Start_ = d3s;
     d2End_ = d3e;
     constSurf_ = d1s;
-
-    // get corner points
-    // origin_ at jmin, kmin
-    origin_ = vector3d<double>(blk.Coords(constSurf_, d1Start_, d2Start_));
-
-    // corner1_ at jmax, kmin
-    corner1_ = vector3d<double>(blk.Coords(constSurf_, d1End_, d2Start_));
-
-    // corner2_ at jmin, kmax
-    corner2_ = vector3d<double>(blk.Coords(constSurf_, d1Start_, d2End_));
-
-    // corner12_ at jmax, kmax
-    corner12_ = vector3d<double>(blk.Coords(constSurf_, d1End_, d2End_));
-
   } else if (bound == 3 ||
              bound == 4) {  // patch on j-surface - dir1 = k, dir2 = i
     d1Start_ = d3s;
@@ -2176,20 +2241,6 @@ patch::patch(const int &bound, const int &b, const int &d1s, const int &d1e,
     d2Start_ = d1s;
     d2End_ = d1e;
     constSurf_ = d2s;
-
-    // get corner points
-    // origin_ at kmin, imin
-    origin_ = vector3d<double>(blk.Coords(d2Start_, constSurf_, d1Start_));
-
-    // corner1_ at kmax, imin
-    corner1_ = vector3d<double>(blk.Coords(d2Start_, constSurf_, d1End_));
-
-    // corner2_ at kmin, imax
-    corner2_ = vector3d<double>(blk.Coords(d2End_, constSurf_, d1Start_));
-
-    // corner12_ at kmax, imax
-    corner12_ = vector3d<double>(blk.Coords(d2End_, constSurf_, d1End_));
-
   } else if (bound == 5 ||
              bound == 6) {  // patch on k-surface - dir1 = i, dir2 = j
     d1Start_ = d1s;
@@ -2197,20 +2248,6 @@ patch::patch(const int &bound, const int &b, const int &d1s, const int &d1e,
     d2Start_ = d2s;
     d2End_ = d2e;
     constSurf_ = d3s;
-
-    // get corner points
-    // origin_ at imin, jmin
-    origin_ = vector3d<double>(blk.Coords(d1Start_, d2Start_, constSurf_));
-
-    // corner1_ at imax, jmin
-    corner1_ = vector3d<double>(blk.Coords(d1End_, d2Start_, constSurf_));
-
-    // corner2_ at imin, jmax
-    corner2_ = vector3d<double>(blk.Coords(d1Start_, d2End_, constSurf_));
-
-    // corner12_ at imax, jmax
-    corner12_ = vector3d<double>(blk.Coords(d1End_, d2End_, constSurf_));
-
   } else {
     cerr << "ERROR: Error in patch::patch(). Boundary surface " << bound
          << " is not recognized!" << endl;
@@ -2326,6 +2363,28 @@ void boundaryConditions::PackBC(char *(&sendBuffer), const int &sendBufSize,
   }
 }
 
+/*Member function to find the size of the buffer needed to pack a
+ * boundaryConditions. Used with MPI send*/
+int boundaryConditions::PackSize() const {
+  // add size for number of bc surfaces
+  auto sendBufSize = 0;
+  auto tempSize = 0;
+  MPI_Pack_size(3, MPI_INT, MPI_COMM_WORLD, &tempSize);
+  sendBufSize += tempSize;
+  // add size for BCs
+  // 8x because iMin, iMax, jMin, jMax, kMin, kMax, tags, string sizes
+  MPI_Pack_size(this->NumSurfaces() * 8, MPI_INT, MPI_COMM_WORLD, &tempSize);
+  sendBufSize += tempSize;
+
+  for (auto jj = 0; jj < this->NumSurfaces(); ++jj) {
+    // add size for bc_ types (+1 for c_str end character)
+    MPI_Pack_size(this->GetBCTypes(jj).size() + 1, MPI_CHAR, MPI_COMM_WORLD,
+                  &tempSize);
+    sendBufSize += tempSize;
+  }
+  return sendBufSize;
+}
+
 /*Member function to unpack data from a buffer into a boundaryConditions. Used
  * with MPI receive*/
 void boundaryConditions::UnpackBC(char *(&recvBuffer), const int &recvBufSize,
@@ -0,0 +1,101 @@
+/*  This file is part of aither.
+    Copyright (C) 2015-19  Michael Nucci (mnucci@pm.me)
+
+    Aither is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Aither is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>. */
+
+
+#include <iostream>     // cout
+#include <cstdlib>      // exit()
+#include <vector>
+#include "checkpointManager.hpp"
+#include "gridLevel.hpp"
+#include "procBlock.hpp"
+#include "input.hpp"
+#include "macros.hpp"
+#include "mpi.h"
+
+using std::cout;
+using std::endl;
+using std::cerr;
+
+// member function to copy the solution of all blocks on this processor
+void checkpointManager::Store(const gridLevel &level, const int &iter) {
+  // solution was just restored from this checkpoint, so it is still valid
+  if (iter == iteration_) {
+    return;
+  }
+
+  state_.resize(level.NumBlocks());
+  consVarsN_.resize(level.NumBlocks());
+  consVarsNm1_.resize(level.NumBlocks());
+  dt_.resize(level.NumBlocks());
+  pressureGrad_.resize(level.NumBlocks());
+  velocityGrad_.resize(level.NumBlocks());
+  for (auto bb = 0; bb < level.NumBlocks(); ++bb) {
+    const auto &blk = level.Block(bb);
+    state_[bb] = blk.States();
+    consVarsN_[bb] = blk.ConsVarsN();
+    consVarsNm1_[bb] = blk.ConsVarsNm1();
+    dt_[bb] = blk.TimeSteps();
+    pressureGrad_[bb] = blk.PressureGrads();
+    velocityGrad_[bb] = blk.VelocityGrads();
+  }
+  iteration_ = iter;
+  numRollbacks_ = 0;
+}
+
+// member function to determine if the solution is physical on all processors
+bool checkpointManager::IsSolutionPhysical(const gridLevel &level) const {
+  auto isPhysical = 1;
+#pragma omp parallel for schedule(dynamic) reduction(min : isPhysical)
+  for (auto bb = 0; bb < level.NumBlocks(); ++bb) {
+    if (!level.Block(bb).IsSolutionPhysical()) {
+      isPhysical = 0;
+    }
+  }
+  MPI_Allreduce(MPI_IN_PLACE, &isPhysical, 1, MPI_INT, MPI_MIN,
+                MPI_COMM_WORLD);
+  return isPhysical == 1;
+}
+
+// member function to reset the solution to the checkpoint and reduce the cfl
+// number; returns the iteration to continue from
+int checkpointManager::Rollback(gridLevel &level, input &inp,
+                                 const physics &phys) {
+  constexpr auto maxRollbacks = 10;
+  if (!this->HasCheckpoint() || numRollbacks_ >= maxRollbacks) {
+    if (rank_ == ROOTP) {
+      cerr << "ERROR: Nonphysical solution detected and no more rollbacks "
+           << "are available. Solution could not be recovered after "
+           << numRollbacks_ << " rollbacks to iteration "
+           << iteration_ + inp.IterationStart() << "." << endl;
+    }
+    exit(EXIT_FAILURE);
+  }
+
+  for (auto bb = 0; bb < level.NumBlocks(); ++bb) {
+    level.Block(bb).RestoreSolution(state_[bb], consVarsN_[bb],
+                                    consVarsNm1_[bb], dt_[bb],
+                                    pressureGrad_[bb], velocityGrad_[bb], phys);
+  }
+  inp.ReduceCFL(inp.CheckpointCflFactor());
+  numRollbacks_++;
+
+  if (rank_ == ROOTP) {
+    cout << "WARNING: Nonphysical solution detected. Rolling back to "
+         << "iteration " << iteration_ + inp.IterationStart()
+         << " and reducing cflMax to " << inp.CFLMax() << endl;
+  }
+  return iteration_;
+}
@@ -0,0 +1,198 @@
+/*  This file is part of aither.
+    Copyright (C) 2015-19  Michael Nucci (mnucci@pm.me)
+
+    Aither is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Aither is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>. */
+
+#include <iostream>     // cerr
+#include <cstdlib>      // exit()
+#include <cstring>      // memcpy
+#include <vector>
+#include "compression.hpp"
+
+using std::cerr;
+using std::endl;
+
+// encoding of field
+enum class fieldEncoding : int32_t { raw = 0, shuffleRLE = 1 };
+
+// header at start of each compressed field
+struct fieldHeader {
+  int32_t encoding_;
+  int32_t bytesPerValue_;
+  int64_t numValues_;
+  int64_t encodedSize_;  // size of field after header
+};
+
+/* Function to run length encode bytes. A control byte less than 128 is
+followed by (control + 1) literal bytes. A control byte of 128 or more is
+followed by one byte that is repeated (control - 125) times.
+*/
+void EncodeRLE(const vector<unsigned char> &in, vector<char> &out) {
+  // in -- bytes to encode
+  // out -- encoded bytes are appended here
+  constexpr auto minRun = 3UL;
+  constexpr auto maxRun = 130UL;
+  constexpr auto maxLiteral = 128UL;
+  const auto size = in.size();
+  auto ii = 0UL;
+  while (ii < size) {
+    // find length of run starting at ii
+    auto run = 1UL;
+    while (ii + run < size && in[ii + run] == in[ii] && run < maxRun) {
+      run++;
+    }
+    if (run >= minRun) {
+      out.push_back(static_cast<char>(run + 125));
+      out.push_back(static_cast<char>(in[ii]));
+      ii += run;
+    } else {
+      // literal section continues until next run or max length
+      auto start = ii;
+      auto len = 0UL;
+      while (ii < size && len < maxLiteral) {
+        if (ii + 2 < size && in[ii] == in[ii + 1] && in[ii] == in[ii + 2]) {
+          break;
+        }
+        ii++;
+        len++;
+      }
+      out.push_back(static_cast<char>(len - 1));
+      out.insert(out.end(), in.begin() + start, in.begin() + start + len);
+    }
+  }
+}
+
+// function to decode run length encoded bytes
+void DecodeRLE(const char *in, const int64_t &inSize,
+               vector<unsigned char> &out) {
+  // in -- encoded bytes
+  // inSize -- number of encoded bytes
+  // out -- decoded bytes are appended here
+  constexpr auto maxLiteral = 128;
+  auto ii = 0L;
+  while (ii < inSize) {
+    const auto control = static_cast<unsigned char>(in[ii++]);
+    if (control < maxLiteral) {
+      const auto len = control + 1;
+      if (ii + len > inSize) {
+        cerr << "ERROR: Error in DecodeRLE(). Compressed field is corrupt!"
+             << endl;
+        exit(EXIT_FAILURE);
+      }
+      out.insert(out.end(), in + ii, in + ii + len);
+      ii += len;
+    } else {
+      if (ii >= inSize) {
+        cerr << "ERROR: Error in DecodeRLE(). Compressed field is corrupt!"
+             << endl;
+        exit(EXIT_FAILURE);
+      }
+      out.insert(out.end(), control - 125, static_cast<unsigned char>(in[ii++]));
+    }
+  }
+}
+
+// function to compress a field of doubles
+vector<char> CompressField(const vector<double> &field) {
+  // field -- values to compress
+  const auto numValues = static_cast<int64_t>(field.size());
+  constexpr auto bytes = static_cast<int>(sizeof(uint64_t));
+
+  // predict each value from previous value and shuffle bytes of differences
+  vector<unsigned char> shuffled(numValues * bytes);
+  uint64_t prev = 0;
+  for (auto ii = 0L; ii < numValues; ++ii) {
+    uint64_t bits = 0;
+    std::memcpy(&bits, &field[ii], bytes);
+    auto diff = bits ^ prev;
+    prev = bits;
+    for (auto bb = 0; bb < bytes; ++bb) {
+      shuffled[bb * numValues + ii] =
+          static_cast<unsigned char>(diff >> (8 * bb));
+    }
+  }
+
+  fieldHeader header{static_cast<int32_t>(fieldEncoding::shuffleRLE), bytes,
+                     numValues, 0};
+  vector<char> compressed(sizeof(header));
+  compressed.reserve(sizeof(header) + shuffled.size());
+  EncodeRLE(shuffled, compressed);
+
+  // store uncompressed if encoding does not help
+  if (compressed.size() >= sizeof(header) + field.size() * bytes) {
+    header.encoding_ = static_cast<int32_t>(fieldEncoding::raw);
+    compressed.resize(sizeof(header) + field.size() * bytes);
+    std::memcpy(compressed.data() + sizeof(header), field.data(),
+                field.size() * bytes);
+  }
+  header.encodedSize_ = compressed.size() - sizeof(header);
+  std::memcpy(compressed.data(), &header, sizeof(header));
+  return compressed;
+}
+
+// function to return the total size of a compressed field (including header)
+int64_t CompressedFieldSize(const char *compressed) {
+  fieldHeader header;
+  std::memcpy(&header, compressed, sizeof(header));
+  return sizeof(header) + header.encodedSize_;
+}
+
+// function to decompress a field of doubles
+vector<double> DecompressField(const char *compressed,
+                               const int64_t &numValues) {
+  // compressed -- start of compressed field (including header)
+  // numValues -- number of values expected in field
+  fieldHeader header;
+  std::memcpy(&header, compressed, sizeof(header));
+  constexpr auto bytes = static_cast<int>(sizeof(uint64_t));
+  if (header.numValues_ != numValues || header.bytesPerValue_ != bytes) {
+    cerr << "ERROR: Error in DecompressField(). Compressed field has "
+         << header.numValues_ << " values of " << header.bytesPerValue_
+         << " bytes, expected " << numValues << " values of " << bytes
+         << " bytes!" << endl;
+    exit(EXIT_FAILURE);
+  }
+  const auto data = compressed + sizeof(header);
+
+  vector<double> field(numValues);
+  if (header.encoding_ == static_cast<int32_t>(fieldEncoding::raw)) {
+    std::memcpy(field.data(), data, numValues * bytes);
+  } else if (header.encoding_ ==
+             static_cast<int32_t>(fieldEncoding::shuffleRLE)) {
+    vector<unsigned char> shuffled;
+    shuffled.reserve(numValues * bytes);
+    DecodeRLE(data, header.encodedSize_, shuffled);
+    if (static_cast<int64_t>(shuffled.size()) != numValues * bytes) {
+      cerr << "ERROR: Error in DecompressField(). Compressed field is corrupt!"
+           << endl;
+      exit(EXIT_FAILURE);
+    }
+    // unshuffle bytes and undo prediction
+    uint64_t prev = 0;
+    for (auto ii = 0L; ii < numValues; ++ii) {
+      uint64_t diff = 0;
+      for (auto bb = 0; bb < bytes; ++bb) {
+        diff |= static_cast<uint64_t>(shuffled[bb * numValues + ii])
+                << (8 * bb);
+      }
+      prev ^= diff;
+      std::memcpy(&field[ii], &prev, bytes);
+    }
+  } else {
+    cerr << "ERROR: Error in DecompressField(). Encoding " << header.encoding_
+         << " is not recognized!" << endl;
+    exit(EXIT_FAILURE);
+  }
+  return field;
+}
@@ -87,6 +87,18 @@ fluxJacobian fluxJacobian::TurbMatMult(const fluxJacobian &jac2) const {
   return result;
 }
 
+// member function to multiply both the flow and turbulence jacobians
+fluxJacobian fluxJacobian::MatMult(const fluxJacobian &jac2) const {
+  MSG_ASSERT(this->FlowSize() == jac2.FlowSize() &&
+                 this->TurbSize() == jac2.TurbSize(),
+             "Mismatch in flux jacobian size");
+  fluxJacobian result(this->FlowSize(), this->TurbSize());
+  MatrixMultiply(this->begin(), jac2.begin(), result.begin(), this->FlowSize());
+  MatrixMultiply(this->beginTurb(), jac2.beginTurb(), result.beginTurb(),
+                 this->TurbSize());
+  return result;
+}
+
 
 
 // non-member functions
@@ -161,13 +173,14 @@ varArray RusanovScalarOffDiagonal(const primitiveView &state,
     fluxChange - specRad.ArrayMult(update);
 }
 
-varArray RusanovBlockOffDiagonal(
-    const primitiveView &state, const varArrayView &update,
-    const unitVec3dMag<double> &fArea, const double &mu, const double &mut,
-    const double &f1, const double &dist, const physics &phys, const input &inp,
-    const bool &positive, const tensor<double> &vGrad) {
+// function to calculate the block off diagonal jacobian with the rusanov
+// approximation, including the thin shear layer viscous contribution
+fluxJacobian RusanovBlockOffDiagonalJacobian(
+    const primitiveView &state, const unitVec3dMag<double> &fArea,
+    const double &mu, const double &mut, const double &f1, const double &dist,
+    const physics &phys, const input &inp, const bool &positive,
+    const tensor<double> &vGrad) {
   // state -- primitive variables at off diagonal
-  // update -- conserved variable update at off diagonal
   // fArea -- face area vector on off diagonal boundary
   // mu -- laminar viscosity
   // mut -- turbulent viscosity
@@ -190,6 +203,28 @@ varArray RusanovBlockOffDiagonal(
                               positive, vGrad);
     positive ? jacobian -= viscJac : jacobian += viscJac;
   }
+  return jacobian;
+}
+
+varArray RusanovBlockOffDiagonal(
+    const primitiveView &state, const varArrayView &update,
+    const unitVec3dMag<double> &fArea, const double &mu, const double &mut,
+    const double &f1, const double &dist, const physics &phys, const input &inp,
+    const bool &positive, const tensor<double> &vGrad) {
+  // state -- primitive variables at off diagonal
+  // update -- conserved variable update at off diagonal
+  // fArea -- face area vector on off diagonal boundary
+  // mu -- laminar viscosity
+  // mut -- turbulent viscosity
+  // f1 -- first blending coefficient
+  // dist -- distance from cell center to cell center across face on diagonal
+  // phys -- physics models
+  // inp -- input variables
+  // positive -- flag to determine whether to add or subtract dissipation
+  // vGrad -- velocity gradient
+
+  const auto jacobian = RusanovBlockOffDiagonalJacobian(
+      state, fArea, mu, mut, f1, dist, phys, inp, positive, vGrad);
   return jacobian.ArrayMult(update);
 }
 
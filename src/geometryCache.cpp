@@ -0,0 +1,525 @@
+/*  This file is part of aither.
+    Copyright (C) 2015-19  Michael Nucci (mnucci@pm.me)
+
+    Aither is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Aither is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>. */
+
+
+#include <iostream>     // cout
+#include <fstream>      // ifstream
+#include <sstream>      // ostringstream
+#include <iomanip>      // setprecision
+#include <cstring>      // strncmp
+#include <cstdio>       // rename, remove
+#include <algorithm>    // copy
+#include <memory>       // make_unique
+#include <string>
+#include <vector>
+#include <sys/stat.h>   // stat
+#include "geometryCache.hpp"
+#include "plot3d.hpp"
+#include "boundaryConditions.hpp"
+#include "parallel.hpp"
+#include "input.hpp"
+#include "mgSolution.hpp"
+#include "gridLevel.hpp"
+#include "procBlock.hpp"
+#include "multiArray3d.hpp"
+#include "range.hpp"
+#include "output.hpp"
+#include "macros.hpp"
+#include "mpi.h"
+
+using std::cout;
+using std::endl;
+using std::cerr;
+using std::ifstream;
+using std::ios;
+using std::ostringstream;
+
+// identifies a geometry cache file and the version of its layout
+constexpr char cacheMagic[] = "aithergc";
+constexpr int cacheMagicSize = 8;
+constexpr int cacheVersion = 3;
+
+// location of the fields in the cache header; the packed setup data follows
+// the header, then the offset table, then the data of each processor
+constexpr MPI_Offset versionPos = cacheMagicSize;
+constexpr MPI_Offset hashPos = versionPos + sizeof(int);
+constexpr MPI_Offset sizesPos = hashPos + sizeof(uint64_t);
+constexpr MPI_Offset setupSizePos = sizesPos + 2 * sizeof(int);
+constexpr MPI_Offset setupPos = setupSizePos + sizeof(int64_t);
+
+// function to add bytes to an FNV-1a hash
+uint64_t HashBytes(const void *data, const size_t &size, uint64_t hash) {
+  const auto *bytes = static_cast<const unsigned char *>(data);
+  for (auto ii = 0U; ii < size; ++ii) {
+    hash ^= bytes[ii];
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+// function to find a checksum of the contents of the grid file; each
+// processor hashes an equal share of the file, and the hashes of the shares
+// are combined in order on ROOT; collective
+uint64_t GridFileChecksum(const string &gridName, const int &rank,
+                          const int &numProcs) {
+  // gridName -- name of grid file without extension
+  // rank -- processor rank
+  // numProcs -- number of processors
+
+  uint64_t hash = 14695981039346656037ULL;
+  const auto fileName = gridName + ".xyz";
+  MPI_File fh;
+  if (MPI_File_open(MPI_COMM_WORLD, fileName.c_str(), MPI_MODE_RDONLY,
+                    MPI_INFO_NULL, &fh) != MPI_SUCCESS) {
+    return hash;
+  }
+  MPI_Offset fileSize = 0;
+  MPI_File_get_size(fh, &fileSize);
+  const auto shareStart = fileSize / numProcs * rank;
+  const auto shareEnd =
+      rank == numProcs - 1 ? fileSize : fileSize / numProcs * (rank + 1);
+
+  // read share in pieces so the buffer stays small
+  constexpr MPI_Offset pieceSize = 1 << 26;
+  vector<char> buffer(std::min(pieceSize, shareEnd - shareStart));
+  for (auto pos = shareStart; pos < shareEnd; pos += pieceSize) {
+    const auto size = static_cast<int>(std::min(pieceSize, shareEnd - pos));
+    MPI_File_read_at(fh, pos, buffer.data(), size, MPI_CHAR,
+                     MPI_STATUS_IGNORE);
+    hash = HashBytes(buffer.data(), size, hash);
+  }
+  MPI_File_close(&fh);
+
+  vector<uint64_t> shareHashes(numProcs, 0);
+  MPI_Gather(&hash, 1, MPI_UINT64_T, shareHashes.data(), 1, MPI_UINT64_T,
+             ROOTP, MPI_COMM_WORLD);
+  const int64_t size = fileSize;
+  hash = HashBytes(&size, sizeof(size), 14695981039346656037ULL);
+  return HashBytes(shareHashes.data(), numProcs * sizeof(uint64_t), hash);
+}
+
+// function to hash everything the decomposed geometry and wall distances
+// depend on
+uint64_t GeometryHash(const uint64_t &gridChecksum,
+                      const vector<vector3d<int>> &gridSizes,
+                      const vector<boundaryConditions> &bcs, const input &inp,
+                      const int &numProcs) {
+  // gridChecksum -- checksum of grid file contents
+  // gridSizes -- number of nodes in each block of grid file
+  // bcs -- boundary conditions for all parent blocks
+  // inp -- input variables
+  // numProcs -- number of processors
+
+  auto hash = HashBytes(&gridChecksum, sizeof(gridChecksum),
+                        14695981039346656037ULL);
+
+  for (const auto &gs : gridSizes) {
+    const int dims[3] = {gs.X(), gs.Y(), gs.Z()};
+    hash = HashBytes(dims, sizeof(dims), hash);
+  }
+
+  ostringstream settings;
+  settings << std::setprecision(17);
+  for (const auto &bc : bcs) {
+    settings << bc;
+  }
+  settings << numProcs << " " << inp.DecompMethod() << " " << inp.LRef()
+           << " " << inp.MultigridLevels() << " " << inp.NumberGhostLayers();
+  const auto str = settings.str();
+  return HashBytes(str.data(), str.size(), hash);
+}
+
+// function to check that a condition holds on all processors; collective
+bool AllProcessors(const bool &condition) {
+  auto local = condition ? 1 : 0;
+  auto all = 0;
+  MPI_Allreduce(&local, &all, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+  return all == 1;
+}
+
+// function to read a section of the cache; returns false if the section is
+// not complete
+bool ReadCacheSection(const MPI_File &fh, const MPI_Offset &offset,
+                      void *data, const MPI_Aint &size) {
+  // fh -- open cache file
+  // offset -- location of section in file
+  // data -- buffer to read into
+  // size -- number of bytes in section
+
+  MPI_Offset fileSize = 0;
+  MPI_File_get_size(fh, &fileSize);
+  if (offset < 0 || offset + size > fileSize) {
+    return false;
+  } else if (size == 0) {
+    return true;
+  }
+  auto bufferType = ByteBufferType(size);
+  MPI_Status status;
+  const auto err = MPI_File_read_at(fh, offset, data, 1, bufferType, &status);
+  auto count = 0;
+  MPI_Get_count(&status, bufferType, &count);
+  MPI_Type_free(&bufferType);
+  return err == MPI_SUCCESS && count == 1;
+}
+
+// function to read the decomposition, the boundary conditions of the
+// decomposed blocks, and the connections from the cache; only called on ROOT;
+// returns false if the cache does not match the current geometry
+bool ReadGeometryCacheSetup(const string &fname, const uint64_t &hash,
+                            decomposition &decomp,
+                            vector<boundaryConditions> &bcs,
+                            vector<connection> &connections,
+                            const MPI_Datatype &MPI_connection) {
+  // fname -- name of cache file
+  // hash -- hash of current geometry
+  // decomp -- decomposition to assign
+  // bcs -- boundary conditions of decomposed blocks to assign
+  // connections -- connections to assign
+  // MPI_connection -- MPI datatype for connection
+
+  ifstream inFile(fname, ios::in | ios::binary);
+  char magic[cacheMagicSize];
+  auto version = 0;
+  uint64_t fileHash = 0;
+  int sizes[2] = {0, 0};
+  int64_t setupSize = 0;
+  if (!(inFile && inFile.read(magic, cacheMagicSize) &&
+        inFile.read(reinterpret_cast<char *>(&version), sizeof(version)) &&
+        inFile.read(reinterpret_cast<char *>(&fileHash), sizeof(fileHash)) &&
+        inFile.read(reinterpret_cast<char *>(sizes), sizeof(sizes)) &&
+        inFile.read(reinterpret_cast<char *>(&setupSize),
+                    sizeof(setupSize)))) {
+    return false;
+  }
+  if (strncmp(magic, cacheMagic, cacheMagicSize) != 0 ||
+      version != cacheVersion || fileHash != hash || setupSize <= 0) {
+    return false;
+  }
+
+  auto setup = std::make_unique<char[]>(setupSize);
+  if (!inFile.read(setup.get(), setupSize)) {
+    return false;
+  }
+
+  auto *rawSetup = setup.get();
+  const auto bufSize = static_cast<int>(setupSize);
+  auto position = 0;
+  decomp.Unpack(rawSetup, bufSize, position);
+  bcs.resize(decomp.NumBlocks());
+  for (auto &bc : bcs) {
+    bc.UnpackBC(rawSetup, bufSize, position);
+  }
+  auto numConnections = 0;
+  MPI_Unpack(rawSetup, bufSize, &position, &numConnections, 1, MPI_INT,
+             MPI_COMM_WORLD);
+  connections.resize(numConnections);
+  MPI_Unpack(rawSetup, bufSize, &position, connections.data(), numConnections,
+             MPI_connection, MPI_COMM_WORLD);
+  return sizes[1] == decomp.NumBlocks();
+}
+
+// function to open the cache and read its offset table; returns false on all
+// processors if the cache can not be read on any of them; collective
+bool OpenGeometryCache(const string &fname, MPI_File &fh, int &numLevels,
+                       int &numBlocks, vector<int64_t> &offsets) {
+  // fname -- name of cache file
+  // fh -- cache file to open
+  // numLevels -- number of grid levels stored in cache
+  // numBlocks -- number of decomposed blocks stored in cache
+  // offsets -- offset table of cache
+
+  const auto opened =
+      MPI_File_open(MPI_COMM_WORLD, fname.c_str(), MPI_MODE_RDONLY,
+                    MPI_INFO_NULL, &fh) == MPI_SUCCESS;
+  if (!AllProcessors(opened)) {
+    if (opened) {
+      MPI_File_close(&fh);
+    }
+    return false;
+  }
+
+  int sizes[2] = {0, 0};
+  int64_t setupSize = 0;
+  auto valid = ReadCacheSection(fh, sizesPos, sizes, sizeof(sizes)) &&
+               ReadCacheSection(fh, setupSizePos, &setupSize,
+                                sizeof(setupSize)) &&
+               sizes[0] > 0 && sizes[1] > 0 && setupSize > 0;
+  numLevels = sizes[0];
+  numBlocks = sizes[1];
+
+  // mesh offsets of all blocks, then wall distance offsets of all levels
+  if (valid) {
+    offsets.resize((numLevels + 1) * numBlocks);
+    valid = ReadCacheSection(fh, setupPos + setupSize, offsets.data(),
+                             offsets.size() * sizeof(int64_t));
+  }
+  if (!AllProcessors(valid)) {
+    MPI_File_close(&fh);
+    return false;
+  }
+  return true;
+}
+
+// function to read the nodes of all blocks on this processor from the cache;
+// returns false on all processors if the cache can not be read on any of
+// them; collective
+bool ReadGeometryCacheMesh(const string &fname,
+                           const vector<vector3d<int>> &gridSizes,
+                           const decomposition &decomp, const int &rank,
+                           vector<plot3dBlock> &mesh) {
+  // fname -- name of cache file
+  // gridSizes -- number of nodes in each block of grid file
+  // decomp -- decomposition of grid
+  // rank -- processor rank
+  // mesh -- nodes of blocks on this processor to assign
+
+  MPI_File fh;
+  auto numLevels = 0;
+  auto numBlocks = 0;
+  vector<int64_t> offsets;
+  if (!OpenGeometryCache(fname, fh, numLevels, numBlocks, offsets)) {
+    return false;
+  }
+
+  auto valid = numBlocks == decomp.NumBlocks();
+  const auto ranges = decomp.NodeRanges(gridSizes);
+  mesh.resize(decomp.NumBlocksOnProc(rank));
+  for (auto gp = 0; valid && gp < decomp.NumBlocks(); ++gp) {
+    if (decomp.Rank(gp) != rank) {
+      continue;
+    }
+    multiArray3d<vector3d<double>> coords(ranges[gp][0].Size(),
+                                          ranges[gp][1].Size(),
+                                          ranges[gp][2].Size(), 0);
+    vector<double> buffer(3 * coords.Size());
+    valid = ReadCacheSection(fh, offsets[gp], buffer.data(),
+                             buffer.size() * sizeof(double));
+    for (auto nn = 0; nn < coords.Size(); ++nn) {
+      coords(nn) = {buffer[3 * nn], buffer[3 * nn + 1], buffer[3 * nn + 2]};
+    }
+    mesh[decomp.LocalPosition(gp)] = plot3dBlock(coords);
+  }
+  MPI_File_close(&fh);
+  return AllProcessors(valid);
+}
+
+// function to read the wall distances of all blocks on this processor from
+// the cache; returns false on all processors if the cache can not be read on
+// any of them; collective
+bool ReadGeometryCacheWallDist(const string &fname, mgSolution &sol,
+                               const int &rank) {
+  // fname -- name of cache file
+  // sol -- solution to assign wall distances to
+  // rank -- processor rank
+
+  MPI_File fh;
+  auto numLevels = 0;
+  auto numBlocks = 0;
+  vector<int64_t> offsets;
+  if (!OpenGeometryCache(fname, fh, numLevels, numBlocks, offsets)) {
+    return false;
+  }
+
+  // read all levels before assigning any, so a bad cache leaves the
+  // solution unchanged
+  auto valid = numLevels == sol.NumGridLevels();
+  vector<vector<vector<double>>> wallDists(numLevels);
+  for (auto ll = 0; valid && ll < numLevels; ++ll) {
+    wallDists[ll].resize(sol[ll].NumBlocks());
+    for (auto bb = 0; valid && bb < sol[ll].NumBlocks(); ++bb) {
+      const auto &blk = sol[ll].Block(bb);
+      const auto gp = blk.GlobalPos();
+      auto &buffer = wallDists[ll][bb];
+      buffer.resize(blk.WallDistances().Size());
+      valid = gp < numBlocks &&
+              ReadCacheSection(fh, offsets[(ll + 1) * numBlocks + gp],
+                               buffer.data(), buffer.size() * sizeof(double));
+    }
+  }
+  MPI_File_close(&fh);
+  if (!AllProcessors(valid)) {
+    return false;
+  }
+
+  for (auto ll = 0; ll < numLevels; ++ll) {
+    for (auto bb = 0; bb < sol[ll].NumBlocks(); ++bb) {
+      auto &blk = sol[ll].Block(bb);
+      auto wallDist = blk.WallDistances();
+      std::copy(std::begin(wallDists[ll][bb]), std::end(wallDists[ll][bb]),
+                std::begin(wallDist));
+      blk.AssignWallDistances(wallDist);
+    }
+  }
+  return true;
+}
+
+// function to write the cache; ROOT writes the decomposition, boundary
+// conditions, and connections, and all processors write the nodes and wall
+// distances of their blocks
+void WriteGeometryCache(const string &fname, const uint64_t &hash,
+                        const decomposition &decomp,
+                        const vector<boundaryConditions> &bcs,
+                        const vector<connection> &connections,
+                        const mgSolution &sol, const int &rank,
+                        const MPI_Datatype &MPI_connection) {
+  // fname -- name of cache file
+  // hash -- hash of current geometry
+  // decomp -- decomposition of grid
+  // bcs -- boundary conditions of decomposed blocks (on ROOT)
+  // connections -- connections between decomposed blocks
+  // sol -- solution with wall distances
+  // rank -- processor rank
+  // MPI_connection -- MPI datatype for connection
+
+  const auto numBlocks = decomp.NumBlocks();
+  const auto numLevels = sol.NumGridLevels();
+
+  // pack setup data on ROOT
+  int64_t setupSize = 0;
+  std::unique_ptr<char[]> setup;
+  if (rank == ROOTP) {
+    auto bufSize = decomp.PackSize();
+    for (const auto &bc : bcs) {
+      bufSize += bc.PackSize();
+    }
+    auto tempSize = 0;
+    MPI_Pack_size(1, MPI_INT, MPI_COMM_WORLD, &tempSize);
+    bufSize += tempSize;
+    MPI_Pack_size(connections.size(), MPI_connection, MPI_COMM_WORLD,
+                  &tempSize);
+    bufSize += tempSize;
+
+    setup = std::make_unique<char[]>(bufSize);
+    auto *rawSetup = setup.get();
+    auto position = 0;
+    decomp.Pack(rawSetup, bufSize, position);
+    for (const auto &bc : bcs) {
+      bc.PackBC(rawSetup, bufSize, position);
+    }
+    const int numConnections = connections.size();
+    MPI_Pack(&numConnections, 1, MPI_INT, rawSetup, bufSize, &position,
+             MPI_COMM_WORLD);
+    MPI_Pack(connections.data(), numConnections, MPI_connection, rawSetup,
+             bufSize, &position, MPI_COMM_WORLD);
+    setupSize = position;
+  }
+  MPI_Bcast(&setupSize, 1, MPI_INT64_T, ROOTP, MPI_COMM_WORLD);
+
+  // pack nodes of finest level, then wall distances of all levels
+  vector<double> buffer;
+  for (auto bb = 0; bb < sol[0].NumBlocks(); ++bb) {
+    for (const auto &node : sol[0].Block(bb).Nodes()) {
+      buffer.push_back(node.X());
+      buffer.push_back(node.Y());
+      buffer.push_back(node.Z());
+    }
+  }
+  for (auto ll = 0; ll < numLevels; ++ll) {
+    for (auto bb = 0; bb < sol[ll].NumBlocks(); ++bb) {
+      const auto &wallDist = sol[ll].Block(bb).WallDistances();
+      buffer.insert(std::end(buffer), std::begin(wallDist),
+                    std::end(wallDist));
+    }
+  }
+
+  // find the location of this processor's data in the file
+  const auto tableSize = (numLevels + 1) * numBlocks;
+  const int64_t dataStart =
+      setupPos + setupSize + tableSize * sizeof(int64_t);
+  int64_t localSize = buffer.size() * sizeof(double);
+  int64_t localStart = 0;
+  MPI_Exscan(&localSize, &localStart, 1, MPI_INT64_T, MPI_SUM,
+             MPI_COMM_WORLD);
+  if (rank == ROOTP) {
+    localStart = 0;
+  }
+
+  // offsets of this processor's blocks, gathered on ROOT
+  vector<int64_t> offsets(tableSize, 0);
+  auto offset = dataStart + localStart;
+  for (auto bb = 0; bb < sol[0].NumBlocks(); ++bb) {
+    const auto &blk = sol[0].Block(bb);
+    offsets[blk.GlobalPos()] = offset;
+    offset += 3 * blk.Nodes().Size() * sizeof(double);
+  }
+  for (auto ll = 0; ll < numLevels; ++ll) {
+    for (auto bb = 0; bb < sol[ll].NumBlocks(); ++bb) {
+      const auto &blk = sol[ll].Block(bb);
+      offsets[(ll + 1) * numBlocks + blk.GlobalPos()] = offset;
+      offset += blk.WallDistances().Size() * sizeof(double);
+    }
+  }
+  if (rank == ROOTP) {
+    MPI_Reduce(MPI_IN_PLACE, offsets.data(), tableSize, MPI_INT64_T, MPI_SUM,
+               ROOTP, MPI_COMM_WORLD);
+  } else {
+    MPI_Reduce(offsets.data(), offsets.data(), tableSize, MPI_INT64_T,
+               MPI_SUM, ROOTP, MPI_COMM_WORLD);
+  }
+
+  // the cache is written to a temporary file that is renamed once it is
+  // complete, so an interrupted write never leaves a cache with a matching
+  // hash
+  const auto tempName = fname + ".tmp";
+  MPI_File fh;
+  if (MPI_File_open(MPI_COMM_WORLD, tempName.c_str(),
+                    MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL,
+                    &fh) != MPI_SUCCESS) {
+    if (rank == ROOTP) {
+      cerr << "WARNING: Could not write geometry cache " << fname << endl;
+    }
+    return;
+  }
+  MPI_File_set_size(fh, 0);
+
+  auto written = true;
+  if (rank == ROOTP) {
+    const int sizes[2] = {numLevels, numBlocks};
+    written =
+        MPI_File_write_at(fh, 0, cacheMagic, cacheMagicSize, MPI_CHAR,
+                          MPI_STATUS_IGNORE) == MPI_SUCCESS &&
+        MPI_File_write_at(fh, versionPos, &cacheVersion, 1, MPI_INT,
+                          MPI_STATUS_IGNORE) == MPI_SUCCESS &&
+        MPI_File_write_at(fh, hashPos, &hash, 1, MPI_UINT64_T,
+                          MPI_STATUS_IGNORE) == MPI_SUCCESS &&
+        MPI_File_write_at(fh, sizesPos, sizes, 2, MPI_INT,
+                          MPI_STATUS_IGNORE) == MPI_SUCCESS &&
+        MPI_File_write_at(fh, setupSizePos, &setupSize, 1, MPI_INT64_T,
+                          MPI_STATUS_IGNORE) == MPI_SUCCESS &&
+        MPI_File_write_at(fh, setupPos, setup.get(), setupSize, MPI_PACKED,
+                          MPI_STATUS_IGNORE) == MPI_SUCCESS &&
+        MPI_File_write_at(fh, setupPos + setupSize, offsets.data(),
+                          tableSize, MPI_INT64_T,
+                          MPI_STATUS_IGNORE) == MPI_SUCCESS;
+  }
+  auto bufferType = ByteBufferType(localSize);
+  written = MPI_File_write_at_all(fh, dataStart + localStart, buffer.data(),
+                                  1, bufferType,
+                                  MPI_STATUS_IGNORE) == MPI_SUCCESS &&
+            written;
+  MPI_Type_free(&bufferType);
+  MPI_File_close(&fh);
+
+  // file is closed on all processors before it is renamed
+  written = AllProcessors(written);
+  if (rank == ROOTP) {
+    if (!written || std::rename(tempName.c_str(), fname.c_str()) != 0) {
+      std::remove(tempName.c_str());
+      cerr << "WARNING: Could not write geometry cache " << fname << endl;
+    }
+  }
+  MPI_Barrier(MPI_COMM_WORLD);
+}
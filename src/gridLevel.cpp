@@ -18,6 +18,12 @@
 #include <cstdlib>      // exit()
 #include <vector>
 #include <string>
+#include <algorithm>    // min, max
+#include <cmath>        // sqrt
+#include <cfloat>       // DBL_EPSILON, DBL_MAX
+#ifdef _OPENMP
+#include <omp.h>        // omp_get_max_threads
+#endif
 #include "gridLevel.hpp"
 #include "utility.hpp"
 #include "parallel.hpp"
@@ -40,18 +46,29 @@ using std::string;
 using std::vector;
 
 // constructor
+// each processor constructs only its own blocks
 gridLevel::gridLevel(const vector<plot3dBlock>& mesh,
                      const vector<boundaryConditions>& bcs,
+                     const vector<connection>& connections,
                      const decomposition& decomp, const physics& phys,
-                     const vector<vector3d<int>>& origGridSizes,
-                     const string& restartFile, input& inp, residual& first) {
+                     const vector<vector3d<int>>& gridSizes,
+                     const string& restartFile, input& inp, residual& first,
+                     const int& rank, const MPI_Datatype& MPI_vec3d,
+                     const MPI_Datatype& MPI_vec3dMag)
+    : connections_(connections) {
+  // mesh -- plot3d blocks on this processor in order of local position
+  // bcs -- boundary conditions on this processor in order of local position
+  // connections -- connection boundaries for all blocks
+  // decomp -- decomposition of grid onto processors
+  // gridSizes -- number of nodes in each block of the grid file
+  // rank -- processor rank
   MSG_ASSERT(mesh.size() == bcs.size(), "block size mismatch");
-  connections_ = GetConnectionBCs(bcs, mesh, decomp, inp);
   blocks_.reserve(mesh.size());
   mgForcing_.reserve(mesh.size());
-  for (auto ll = 0U; ll < mesh.size(); ++ll) {
-    blocks_.emplace_back(mesh[ll], decomp.ParentBlock(ll), bcs[ll], ll,
-                         decomp.Rank(ll), decomp.LocalPosition(ll), inp);
+  for (auto lp = 0U; lp < mesh.size(); ++lp) {
+    const auto gp = decomp.GlobalPos(rank, lp);
+    blocks_.emplace_back(mesh[lp], decomp.ParentBlock(gp), bcs[lp], gp, rank,
+                         lp, inp);
     blocks_.back().InitializeStates(inp, phys);
     blocks_.back().AssignGhostCellsGeom();
     mgForcing_.emplace_back(
@@ -61,103 +78,86 @@ gridLevel::gridLevel(const vector<plot3dBlock>& mesh,
 
   // if restart, get data from restart file
   if (inp.IsRestart()) {
-    ReadRestart(*this, restartFile, decomp, inp, phys, first, origGridSizes);
+    ReadRestart(*this, restartFile, decomp, inp, phys, first, gridSizes, rank);
   }
 
-  // Swap geometry for interblock BCs - assumes all data on rank 0
-  for (auto& conn : connections_) {
+  // Swap geometry for interblock BCs
+  for (auto ii = 0; ii < this->NumConnections(); ++ii) {
+    auto& conn = connections_[ii];
     if (conn.IsInterblock()) {
-      SwapGeomSlice(conn, blocks_[conn.BlockFirst()],
-                    blocks_[conn.BlockSecond()]);
+      if (rank == conn.RankFirst() && rank == conn.RankSecond()) {
+        // all data is local
+        SwapGeomSlice(conn, blocks_[conn.LocalBlockFirst()],
+                      blocks_[conn.LocalBlockSecond()]);
+      } else if (rank == conn.RankFirst()) {
+        // first connection swapping with remote processor
+        SwapGeomSliceMPI(conn, blocks_[conn.LocalBlockFirst()], ii, MPI_vec3d,
+                         MPI_vec3dMag);
+      } else if (rank == conn.RankSecond()) {
+        // second connection swapping with remote processor
+        SwapGeomSliceMPI(conn, blocks_[conn.LocalBlockSecond()], ii, MPI_vec3d,
+                         MPI_vec3dMag);
+      }
     }
   }
+  ReduceConnectionBorders(connections_);
   // Get ghost cell edge data
   for (auto& block : blocks_) {
     block.AssignGhostCellsGeomEdge();
   }
 
   // Setup linear solver
-  if (inp.IsImplicit()) {
-    solver_ = inp.AssignLinearSolver(*this);
-  }
+  solver_ = inp.AssignLinearSolver(*this);
 }
 
-/* Function to send procBlocks to their appropriate processor. This function is
-called after the decomposition has been run. The procBlock data all
-resides on the ROOT processor. In this function, the ROOT processor packs the
-procBlocks and sends them to the appropriate processor. All the non-ROOT
-processors receive and unpack the data from ROOT. This is used to send the
-geometric block data from ROOT to all the processors at the beginning of the
-simulation.
+/* Function to gather procBlocks on the ROOT processor. This function is called
+after each processor has constructed its own procBlocks. All the non-ROOT
+processors pack their procBlocks and send them to the ROOT processor, which
+receives and unpacks them in order of global position. The returned gridLevel
+is only meaningful on the ROOT processor, where it is used to write out
+results.
 */
-gridLevel gridLevel::SendGridLevel(const int& rank, const int& numProcBlock,
-                                   const MPI_Datatype& MPI_vec3d,
-                                   const MPI_Datatype& MPI_vec3dMag,
-                                   const MPI_Datatype& MPI_connection,
-                                   const input& inp) const {
-  // *this -- global gridLevel, only meaningful on ROOT processor
+gridLevel gridLevel::GatherGridLevel(const decomposition& decomp,
+                                     const int& rank,
+                                     const MPI_Datatype& MPI_vec3d,
+                                     const MPI_Datatype& MPI_vec3dMag,
+                                     const input& inp) const {
+  // *this -- local gridLevel
+  // decomp -- decomposition of grid onto processors
   // rank -- proc rank, used to determine if process should send or receive
-  // numProcBlock -- number of procBlocks that the processor should have. (All
-  //                 processors may give different values).
   // MPI_vec3d -- MPI_Datatype used for vector3d<double>  transmission
   // MPI_vec3dMag -- MPI_Datatype used for unitVec3dMag<double>  transmission
-  // MPI_connection -- MPI_Datatype used for connection  transmission
   // input -- input variables
 
-  gridLevel local(numProcBlock);
   //------------------------------------------------------------------------
   //                                  ROOT
   //------------------------------------------------------------------------
-  if (rank == ROOTP) {  // may have to pack and send data
-    // loop over ALL blocks
-    for (const auto &global : blocks_) {
-      // no need to send data because it is already on root processor
-      if (global.Rank() == ROOTP) {
-        const auto lp = global.LocalPosition();
-        local.blocks_[lp] = global;
-        local.mgForcing_[lp] = blkMultiArray3d<varArray>(
-            global.NumI(), global.NumJ(), global.NumK(), 0,
-            global.NumEquations(), global.NumSpecies());
-      } else {  // send data to receiving processors
-        // pack and send procBlock
-        global.PackSendGeomMPI(MPI_vec3d, MPI_vec3dMag);
+  if (rank == ROOTP) {  // may have to recv and unpack data
+    gridLevel global(decomp.NumBlocks());
+    for (auto gp = 0; gp < decomp.NumBlocks(); ++gp) {
+      const auto sendingRank = decomp.Rank(gp);
+      if (sendingRank == ROOTP) {  // data already on root processor
+        global.blocks_[gp] = blocks_[decomp.LocalPosition(gp)];
+      } else {  // recv data from sending processors
+        global.blocks_[gp].RecvUnpackGeomMPI(MPI_vec3d, MPI_vec3dMag, inp,
+                                             sendingRank, gp);
       }
     }
-    //--------------------------------------------------------------------------
-    //                                NON - ROOT
-    //--------------------------------------------------------------------------
-  } else {  // receive and unpack data (non-root)
-    for (auto ii = 0; ii < numProcBlock; ++ii) {
-      // recv and unpack procBlock
-      procBlock tempBlock;
-      tempBlock.RecvUnpackGeomMPI(MPI_vec3d, MPI_vec3dMag, inp);
-
-      // add procBlock to output vector
-      const auto lp = tempBlock.LocalPosition();
-      local.blocks_[lp] = tempBlock;
-      local.mgForcing_[lp] = blkMultiArray3d<varArray>(
-          tempBlock.NumI(), tempBlock.NumJ(), tempBlock.NumK(), 0,
-          tempBlock.NumEquations(), tempBlock.NumSpecies());
-    }
+    global.connections_ = connections_;
+    return global;
   }
 
-  // now do connections -------------------------------------------------------
-  // first determine the number of connections and send that to all processors
-  if (rank == ROOTP) {
-    local.connections_ = connections_;
+  //--------------------------------------------------------------------------
+  //                                NON - ROOT
+  //--------------------------------------------------------------------------
+  // need to send data in order of global position to prevent deadlock
+  for (auto gp = 0; gp < decomp.NumBlocks(); ++gp) {
+    if (decomp.Rank(gp) == rank) {
+      blocks_[decomp.LocalPosition(gp)].PackSendGeomMPI(MPI_vec3d,
+                                                        MPI_vec3dMag);
+    }
   }
-  auto numCon = local.NumConnections();
-  MPI_Bcast(&numCon, 1, MPI_INT, ROOTP, MPI_COMM_WORLD);
-  local.connections_.resize(numCon);  // allocate space to receive connections
-
-  // broadcast all connections to all processors
-  MPI_Bcast(&(*std::begin(local.connections_)), local.connections_.size(),
-            MPI_connection, ROOTP, MPI_COMM_WORLD);
-
-  // now allocate memory for linear solver
-  local.solver_ = inp.AssignLinearSolver(local);
-
-  return local;
+  return gridLevel();
 }
 
 /* Function to send procBlocks to the root processor. In this function, the
@@ -217,45 +217,91 @@ void gridLevel::GetGridLevel(const gridLevel& local, const int& rank,
   }
 }
 
+// member function to determine if threads should be used to process blocks
+// concurrently. When there are fewer blocks than threads, the blocks are
+// processed one at a time and the threads are used within each block instead.
+bool gridLevel::ThreadOverBlocks() const {
+#ifdef _OPENMP
+  return this->NumBlocks() >= omp_get_max_threads();
+#else
+  return true;
+#endif
+}
+
 // function to calculate the distance to the nearest viscous wall of all
 // cell centers
 void gridLevel::CalcWallDistance(const kdtree &tree) {
-  for (auto &block : blocks_) {
-    block.CalcWallDistance(tree);
+#pragma omp parallel for schedule(dynamic)
+  for (auto bb = 0; bb < this->NumBlocks(); ++bb) {
+    blocks_[bb].CalcWallDistance(tree);
   }
 }
 
 void gridLevel::AssignSolToTimeN(const physics &phys) {
-  for (auto &block : blocks_) {
-    block.AssignSolToTimeN(phys);
+#pragma omp parallel for schedule(dynamic)
+  for (auto bb = 0; bb < this->NumBlocks(); ++bb) {
+    blocks_[bb].AssignSolToTimeN(phys);
+  }
+}
+
+// function to integrate the loads on all viscous walls of the grid level
+wallLoads gridLevel::WallLoads(const physics &phys,
+                               const vector3d<double> &momentPoint) const {
+  wallLoads loads;
+  for (auto &blk : blocks_) {
+    loads += blk.WallLoads(phys, momentPoint);
   }
+  return loads;
 }
 
 void gridLevel::AssignSolToTimeNm1() {
-  for (auto &block : blocks_) {
-    block.AssignSolToTimeNm1();
+#pragma omp parallel for schedule(dynamic)
+  for (auto bb = 0; bb < this->NumBlocks(); ++bb) {
+    blocks_[bb].AssignSolToTimeNm1();
   }
 }
 
 void gridLevel::CalcTimeStep(const input &inp) {
-  // states -- vector of all procBlocks on processor
   // inp -- input variables
-  for (auto &block : blocks_) {
+#pragma omp parallel for schedule(dynamic)
+  for (auto bb = 0; bb < this->NumBlocks(); ++bb) {
     // calculate time step
-    block.CalcBlockTimeStep(inp);
+    blocks_[bb].CalcBlockTimeStep(inp);
   }
 }
 
+// function to combine the residual norms calculated on each block into the
+// residual norms for the grid level
+void CombineResiduals(const vector<residual>& blockL2,
+                      const vector<resid>& blockLinf, residual& residL2,
+                      resid& residLinf) {
+  MSG_ASSERT(blockL2.size() == blockLinf.size(), "block size mismatch");
+  for (auto bb = 0U; bb < blockL2.size(); ++bb) {
+    residL2 += blockL2[bb];
+    if (blockLinf[bb].Linf() > residLinf.Linf()) {
+      residLinf = blockLinf[bb];
+    }
+  }
+}
 
 void gridLevel::ExplicitUpdate(const input& inp, const physics& phys,
                                const int& mm, residual& residL2,
                                resid& residLinf) {
   // create dummy update (not used in explicit update)
   blkMultiArray3d<varArray> du;
+
+  // residual norms are accumulated per block so blocks can be updated
+  // concurrently
+  vector<residual> blockL2(this->NumBlocks(),
+                           residual(residL2.Size(), residL2.NumSpecies()));
+  vector<resid> blockLinf(this->NumBlocks());
+
   // loop over all blocks and update
-  for (auto &block : blocks_) {
-    block.UpdateBlock(inp, phys, du, mm, residL2, residLinf);
+#pragma omp parallel for schedule(dynamic)
+  for (auto bb = 0; bb < this->NumBlocks(); ++bb) {
+    blocks_[bb].UpdateBlock(inp, phys, du, mm, blockL2[bb], blockLinf[bb]);
   }
+  CombineResiduals(blockL2, blockLinf, residL2, residLinf);
 }
 
 void gridLevel::SwapWallDist(const int& rank, const int& numGhosts) {
@@ -263,6 +309,7 @@ void gridLevel::SwapWallDist(const int& rank, const int& numGhosts) {
   // numGhosts -- number of ghost cells
 
   // loop over all connections and swap connection updates when necessary
+  haloExchange exchange;
   for (auto &conn : connections_) {
     if (conn.RankFirst() == rank && conn.RankSecond() == rank) {
       // both sides of connection are on this processor, swap w/o mpi
@@ -270,14 +317,18 @@ void gridLevel::SwapWallDist(const int& rank, const int& numGhosts) {
           conn, blocks_[conn.LocalBlockSecond()]);
     } else if (conn.RankFirst() == rank) {
       // rank matches rank of first side of connection, swap over mpi
-      blocks_[conn.LocalBlockFirst()].SwapWallDistSliceMPI(conn, rank);
+      blocks_[conn.LocalBlockFirst()].SwapWallDistSliceMPI(conn, rank,
+                                                           exchange);
     } else if (conn.RankSecond() == rank) {
       // rank matches rank of second side of connection, swap over mpi
-      blocks_[conn.LocalBlockSecond()].SwapWallDistSliceMPI(conn, rank);
+      blocks_[conn.LocalBlockSecond()].SwapWallDistSliceMPI(conn, rank,
+                                                            exchange);
     }
     // if rank doesn't match either side of connection, then do nothing and
     // move on to the next connection
   }
+  // wait for swaps over mpi to complete
+  exchange.Finish();
 }
 
 /* Function to populate ghost cells with proper cell states for inviscid flow
@@ -290,9 +341,26 @@ void gridLevel::GetBoundaryConditions(const input& inp, const physics& phys,
   // phys -- physics models
   // rank -- processor rank
 
+  this->StartBoundaryConditions(inp, phys, rank);
+  this->FinishBoundaryConditions(inp, phys);
+}
+
+/* Function to start populating ghost cells with proper cell states for
+inviscid flow calculation. The boundary condition ghost cells are assigned,
+connections on this processor are swapped, and swaps with other processors are
+posted. The ghost cells from other processors are not available until
+FinishBoundaryConditions is called.
+*/
+void gridLevel::StartBoundaryConditions(const input& inp, const physics& phys,
+                                        const int& rank) {
+  // inp -- all input variables
+  // phys -- physics models
+  // rank -- processor rank
+
   // loop over all blocks and assign inviscid ghost cells
-  for (auto &block : blocks_) {
-    block.AssignInviscidGhostCells(inp, phys);
+#pragma omp parallel for schedule(dynamic)
+  for (auto bb = 0; bb < this->NumBlocks(); ++bb) {
+    blocks_[bb].AssignInviscidGhostCells(inp, phys);
   }
 
   // loop over connections and swap ghost cells where needed
@@ -303,70 +371,90 @@ void gridLevel::GetBoundaryConditions(const input& inp, const physics& phys,
           conn, blocks_[conn.LocalBlockSecond()]);
     } else if (conn.RankFirst() == rank) {
       // rank matches rank of first side of connection, swap over mpi
-      blocks_[conn.LocalBlockFirst()].SwapStateSliceMPI(conn, rank);
+      blocks_[conn.LocalBlockFirst()].SwapStateSliceMPI(conn, rank,
+                                                        stateExchange_);
     } else if (conn.RankSecond() == rank) {
       // rank matches rank of second side of connection, swap over mpi
-      blocks_[conn.LocalBlockSecond()].SwapStateSliceMPI(conn, rank);
+      blocks_[conn.LocalBlockSecond()].SwapStateSliceMPI(conn, rank,
+                                                         stateExchange_);
     }
     // if rank doesn't match either side of connection, then do nothing and
     // move on to the next connection
   }
+  // send slices to other processors
+  stateExchange_.Start();
+}
+
+// Function to finish populating ghost cells for inviscid flow calculation
+// once the swaps with other processors are complete
+void gridLevel::FinishBoundaryConditions(const input& inp,
+                                         const physics& phys) {
+  // inp -- all input variables
+  // phys -- physics models
+
+  // wait for swaps over mpi to complete
+  stateExchange_.Finish();
 
   // loop over all blocks and get ghost cell edge data
-  for (auto &block : blocks_) {
-    block.AssignInviscidGhostCellsEdge(inp, phys);
+#pragma omp parallel for schedule(dynamic)
+  for (auto bb = 0; bb < this->NumBlocks(); ++bb) {
+    blocks_[bb].AssignInviscidGhostCellsEdge(inp, phys);
   }
 }
 
-void gridLevel::SwapTurbVars(const int& rank, const int& numGhosts) {
+// Function to determine the directions of each block that have connections
+// with blocks on other processors. Inviscid fluxes in these directions need
+// the ghost cells exchanged with other processors.
+vector<std::array<bool, 3>> gridLevel::RemoteConnectionDirections(
+    const int& rank) const {
   // rank -- processor rank
-  // numGhosts -- number of ghost cells
-
-  // loop over all connections and swap connection updates when necessary
+  vector<std::array<bool, 3>> remote(this->NumBlocks(), {false, false, false});
   for (auto &conn : connections_) {
-    if (conn.RankFirst() == rank && conn.RankSecond() == rank) {
-      // both sides of connection are on this processor, swap w/o mpi
-      blocks_[conn.LocalBlockFirst()].SwapTurbSlice(
-          conn, blocks_[conn.LocalBlockSecond()]);
-    } else if (conn.RankFirst() == rank) {
-      // rank matches rank of first side of connection, swap over mpi
-      blocks_[conn.LocalBlockFirst()].SwapTurbSliceMPI(conn, rank);
-    } else if (conn.RankSecond() == rank) {
-      // rank matches rank of second side of connection, swap over mpi
-      blocks_[conn.LocalBlockSecond()].SwapTurbSliceMPI(conn, rank);
+    if (conn.RankFirst() == rank && conn.RankSecond() != rank) {
+      // boundary surfaces 1 & 2 are i, 3 & 4 are j, 5 & 6 are k
+      remote[conn.LocalBlockFirst()][(conn.BoundaryFirst() - 1) / 2] = true;
+    } else if (conn.RankSecond() == rank && conn.RankFirst() != rank) {
+      remote[conn.LocalBlockSecond()][(conn.BoundarySecond() - 1) / 2] = true;
     }
-    // if rank doesn't match either side of connection, then do nothing and
-    // move on to the next connection
   }
+  return remote;
 }
 
-void gridLevel::SwapEddyViscAndGradients(const int& rank,
-                                         const MPI_Datatype& MPI_tensorDouble,
-                                         const MPI_Datatype& MPI_vec3d,
-                                         const int& numGhosts) {
+/* Function to swap the ghost cells of several fields at all connection
+boundaries. Swaps with other processors for all of the fields are sent
+together in one message per neighboring processor. The fields must be the same
+each time the exchange is used.
+*/
+void gridLevel::SwapFields(const vector<haloField>& fields, const int& rank,
+                           const MPI_Datatype& MPI_tensorDouble,
+                           const MPI_Datatype& MPI_vec3d,
+                           haloExchange& exchange) {
+  // fields -- fields to swap
   // rank -- processor rank
   // MPI_tensorDouble -- MPI datatype for tensor<double>
   // MPI_vec3d -- MPI datatype for vector3d<double>
-  // numGhosts -- number of ghost cells
+  // exchange -- exchange to swap fields over mpi with
 
   // loop over all connections and swap connection updates when necessary
   for (auto &conn : connections_) {
     if (conn.RankFirst() == rank && conn.RankSecond() == rank) {
       // both sides of connection are on this processor, swap w/o mpi
-      blocks_[conn.LocalBlockFirst()].SwapEddyViscAndGradientSlice(
-          conn, blocks_[conn.LocalBlockSecond()]);
+      blocks_[conn.LocalBlockFirst()].SwapFieldSlices(
+          fields, conn, blocks_[conn.LocalBlockSecond()]);
     } else if (conn.RankFirst() == rank) {
       // rank matches rank of first side of connection, swap over mpi
-      blocks_[conn.LocalBlockFirst()].SwapEddyViscAndGradientSliceMPI(
-          conn, rank, MPI_tensorDouble, MPI_vec3d);
+      blocks_[conn.LocalBlockFirst()].SwapFieldSlicesMPI(
+          fields, conn, rank, MPI_tensorDouble, MPI_vec3d, exchange);
     } else if (conn.RankSecond() == rank) {
       // rank matches rank of second side of connection, swap over mpi
-      blocks_[conn.LocalBlockSecond()].SwapEddyViscAndGradientSliceMPI(
-          conn, rank, MPI_tensorDouble, MPI_vec3d);
+      blocks_[conn.LocalBlockSecond()].SwapFieldSlicesMPI(
+          fields, conn, rank, MPI_tensorDouble, MPI_vec3d, exchange);
     }
     // if rank doesn't match either side of connection, then do nothing and
     // move on to the next connection
   }
+  // wait for swaps over mpi to complete
+  exchange.Finish();
 }
 
 void gridLevel::CalcResidual(const physics& phys, const input& inp,
@@ -379,26 +467,316 @@ void gridLevel::CalcResidual(const physics& phys, const input& inp,
   // MPI_tensorDouble -- MPI datatype for tensor<double>
   // MPI_vec3d -- MPI datatype for vector3d<double>
 
+  // flux and gradient calculations are threaded within each block, so only
+  // thread over blocks when there are enough of them to keep threads busy
+  const auto threadBlocks = this->ThreadOverBlocks();
+#pragma omp parallel for schedule(dynamic) if (threadBlocks)
   for (auto bb = 0; bb < this->NumBlocks(); ++bb) {
     // calculate residual
     blocks_[bb].CalcResidualNoSource(phys, inp, solver_->A(bb));
   }
-  // swap mut & gradients calculated during residual calculation
-  this->SwapEddyViscAndGradients(rank, MPI_tensorDouble, MPI_vec3d,
-                                 inp.NumberGhostLayers());
+  this->SwapAndCalcSrcTerms(phys, inp, rank, MPI_tensorDouble, MPI_vec3d,
+                            solver_->A());
+}
+
+/* Function to get the boundary conditions and calculate the residual. This is
+equivalent to calling GetBoundaryConditions and then CalcResidual, but the
+inviscid fluxes that do not use ghost cells from other processors are
+calculated while those ghost cells are being exchanged.
+*/
+void gridLevel::GetBoundaryConditionsAndResidual(
+    const physics& phys, const input& inp, const int& rank,
+    const MPI_Datatype& MPI_tensorDouble, const MPI_Datatype& MPI_vec3d) {
+  this->GetBoundaryConditionsAndResidual(phys, inp, rank, MPI_tensorDouble,
+                                         MPI_vec3d, solver_->A());
+}
+
+// Function to get the boundary conditions and calculate the residual, with the
+// flux jacobians added to the given main diagonal instead of the one of the
+// linear solver. If the main diagonal is empty, no flux jacobians are
+// calculated.
+void gridLevel::GetBoundaryConditionsAndResidual(
+    const physics& phys, const input& inp, const int& rank,
+    const MPI_Datatype& MPI_tensorDouble, const MPI_Datatype& MPI_vec3d,
+    vector<matMultiArray3d>& mainDiagonal) {
+  // phys -- physics models
+  // inp -- input variables
+  // rank -- processor rank
+  // MPI_tensorDouble -- MPI datatype for tensor<double>
+  // MPI_vec3d -- MPI datatype for vector3d<double>
+  // mainDiagonal -- main diagonal to add flux jacobians to
+
+  this->StartBoundaryConditions(inp, phys, rank);
+
+  // fluxes in directions with connections to other processors are deferred
+  // until the exchange is finished
+  const auto deferred = this->RemoteConnectionDirections(rank);
+  const auto threadBlocks = this->ThreadOverBlocks();
+#pragma omp parallel for schedule(dynamic) if (threadBlocks)
+  for (auto bb = 0; bb < this->NumBlocks(); ++bb) {
+    blocks_[bb].StartResidualNoSource(phys, inp, mainDiagonal[bb],
+                                      deferred[bb]);
+  }
 
-  if (inp.IsRANS()) {
-    // swap turbulence variables calculated during residual calculation
-    this->SwapTurbVars(rank, inp.NumberGhostLayers());
+  this->FinishBoundaryConditions(inp, phys);
+
+#pragma omp parallel for schedule(dynamic) if (threadBlocks)
+  for (auto bb = 0; bb < this->NumBlocks(); ++bb) {
+    blocks_[bb].FinishResidualNoSource(phys, inp, mainDiagonal[bb],
+                                       deferred[bb]);
   }
+  this->SwapAndCalcSrcTerms(phys, inp, rank, MPI_tensorDouble, MPI_vec3d,
+                            mainDiagonal);
+}
+
+// Function to swap the variables calculated during the residual calculation
+// and add the source terms to the residual
+void gridLevel::SwapAndCalcSrcTerms(const physics& phys, const input& inp,
+                                    const int& rank,
+                                    const MPI_Datatype& MPI_tensorDouble,
+                                    const MPI_Datatype& MPI_vec3d,
+                                    vector<matMultiArray3d>& mainDiagonal) {
+  // phys -- physics models
+  // inp -- input variables
+  // rank -- processor rank
+  // MPI_tensorDouble -- MPI datatype for tensor<double>
+  // MPI_vec3d -- MPI datatype for vector3d<double>
+  // mainDiagonal -- main diagonal to add source jacobians to
+
+  // swap mut, gradients & turbulence variables calculated during residual
+  // calculation
+  const vector<haloField> fields = {haloField::velocityGradient,
+                                    haloField::eddyViscosity,
+                                    haloField::turbulence};
+  this->SwapFields(fields, rank, MPI_tensorDouble, MPI_vec3d, fieldExchange_);
   if (inp.IsRANS() || phys.Chemistry()->IsReacting()) {
+#pragma omp parallel for schedule(dynamic)
     for (auto bb = 0; bb < this->NumBlocks(); ++bb) {
       // calculate source terms for residual
-      blocks_[bb].CalcSrcTerms(phys, inp, solver_->A(bb));
+      blocks_[bb].CalcSrcTerms(phys, inp, mainDiagonal[bb]);
+    }
+  }
+}
+
+// Function to calculate the right hand side of the implicit system, b in
+// A * x = b, shaped like the implicit update
+vector<blkMultiArray3d<varArray>> gridLevel::ImplicitRightHandSide(
+    const input& inp, const physics& phys) const {
+  const auto thetaInv = 1.0 / inp.Theta();
+  auto rhs = solver_->X();
+#pragma omp parallel for schedule(dynamic)
+  for (auto bb = 0; bb < this->NumBlocks(); ++bb) {
+    const auto& blk = blocks_[bb];
+    rhs[bb].Zero();
+    for (auto kk = blk.StartK(); kk < blk.EndK(); ++kk) {
+      for (auto jj = blk.StartJ(); jj < blk.EndJ(); ++jj) {
+        for (auto ii = blk.StartI(); ii < blk.EndI(); ++ii) {
+          rhs[bb].InsertBlock(ii, jj, kk,
+                              -thetaInv * blk.Residual(ii, jj, kk) +
+                                  blk.SolDeltaNm1(ii, jj, kk, inp) -
+                                  blk.SolDeltaMmN(ii, jj, kk, inp, phys));
+        }
+      }
+    }
+  }
+  return rhs;
+}
+
+/* Function to find the momentum directions that take no part in the solution.
+A direction is inactive when every node of the grid lies on one of two planes
+normal to it, to within round off (a single layer of cells, as used for 2D
+cases), and there is no velocity in that direction. The residual of an
+inactive momentum equation is only round off.
+*/
+std::array<bool, 3> gridLevel::InactiveMomentumDirections() const {
+  std::array<double, 3> minCoord = {DBL_MAX, DBL_MAX, DBL_MAX};
+  // maximum coordinates, maximum velocity components, and maximum speed
+  std::array<double, 7> maxVals = {-DBL_MAX, -DBL_MAX, -DBL_MAX, 0.0,
+                                   0.0,      0.0,      0.0};
+  for (const auto& blk : blocks_) {
+    const auto& nodes = blk.Nodes();
+    for (auto kk = 0; kk < nodes.NumK(); ++kk) {
+      for (auto jj = 0; jj < nodes.NumJ(); ++jj) {
+        for (auto ii = 0; ii < nodes.NumI(); ++ii) {
+          for (auto dd = 0; dd < 3; ++dd) {
+            minCoord[dd] = std::min(minCoord[dd], nodes.Coords(ii, jj, kk)[dd]);
+            maxVals[dd] = std::max(maxVals[dd], nodes.Coords(ii, jj, kk)[dd]);
+          }
+        }
+      }
+    }
+    for (auto kk = blk.StartK(); kk < blk.EndK(); ++kk) {
+      for (auto jj = blk.StartJ(); jj < blk.EndJ(); ++jj) {
+        for (auto ii = blk.StartI(); ii < blk.EndI(); ++ii) {
+          const auto vel = blk.State(ii, jj, kk).Velocity();
+          for (auto dd = 0; dd < 3; ++dd) {
+            maxVals[3 + dd] = std::max(maxVals[3 + dd], fabs(vel[dd]));
+          }
+          maxVals[6] = std::max(maxVals[6], vel.Mag());
+        }
+      }
+    }
+  }
+  MPI_Allreduce(MPI_IN_PLACE, minCoord.data(), minCoord.size(), MPI_DOUBLE,
+                MPI_MIN, MPI_COMM_WORLD);
+  MPI_Allreduce(MPI_IN_PLACE, maxVals.data(), maxVals.size(), MPI_DOUBLE,
+                MPI_MAX, MPI_COMM_WORLD);
+
+  // grid generators leave round off in the coordinates of the planes
+  auto extent = 0.0;
+  for (auto dd = 0; dd < 3; ++dd) {
+    extent = std::max(extent, maxVals[dd] - minCoord[dd]);
+  }
+  const auto tol = sqrt(DBL_EPSILON) * extent;
+
+  std::array<int, 3> onPlanes = {1, 1, 1};
+  for (const auto& blk : blocks_) {
+    const auto& nodes = blk.Nodes();
+    for (auto kk = 0; kk < nodes.NumK(); ++kk) {
+      for (auto jj = 0; jj < nodes.NumJ(); ++jj) {
+        for (auto ii = 0; ii < nodes.NumI(); ++ii) {
+          for (auto dd = 0; dd < 3; ++dd) {
+            const auto& coord = nodes.Coords(ii, jj, kk)[dd];
+            if (fabs(coord - minCoord[dd]) > tol &&
+                fabs(coord - maxVals[dd]) > tol) {
+              onPlanes[dd] = 0;
+            }
+          }
+        }
+      }
+    }
+  }
+  MPI_Allreduce(MPI_IN_PLACE, onPlanes.data(), onPlanes.size(), MPI_INT,
+                MPI_MIN, MPI_COMM_WORLD);
+
+  std::array<bool, 3> inactive;
+  for (auto dd = 0; dd < 3; ++dd) {
+    inactive[dd] = onPlanes[dd] == 1 &&
+                   maxVals[3 + dd] <= sqrt(DBL_EPSILON) * maxVals[6];
+  }
+  return inactive;
+}
+
+/* Function to calculate the product of the implicit matrix with a vector
+without forming the matrix. The implicit matrix is the jacobian of the right
+hand side, -db/dU, so its product with a vector is a directional derivative of
+the residual, which is approximated with a finite difference.
+
+A * v = V/t * v + (R(U + e * v) - R(U)) / (e * theta)
+
+Here V/t is the time term on the main diagonal, R is the residual, and e is a
+small step. The step is scaled with the size of the state and the vector so
+that the perturbation is well above round off. The residual is evaluated with
+the perturbed state without assembling any flux jacobians, and then all of the
+fields calculated with the residual are restored.
+*/
+vector<blkMultiArray3d<varArray>> gridLevel::JacobianFreeProduct(
+    const vector<blkMultiArray3d<varArray>>& vec, const physics& phys,
+    const input& inp, const int& rank, const MPI_Datatype& MPI_tensorDouble,
+    const MPI_Datatype& MPI_vec3d) {
+  // vec -- vector to multiply implicit matrix with
+  // phys -- physics models
+  // inp -- input variables
+  // rank -- processor rank
+  // MPI_tensorDouble -- MPI datatype for tensor<double>
+  // MPI_vec3d -- MPI datatype for vector3d<double>
+
+  MSG_ASSERT(static_cast<int>(vec.size()) == this->NumBlocks(),
+             "vector size mismatch");
+  auto prod = vec;
+  const auto vecNorm = sqrt(KrylovDot(vec, vec));
+  if (vecNorm == 0.0) {
+    return prod;
+  }
+
+  // norm of conserved variables over all processors
+  auto stateNorm = 0.0;
+  for (const auto& blk : blocks_) {
+    for (auto kk = blk.StartK(); kk < blk.EndK(); ++kk) {
+      for (auto jj = blk.StartJ(); jj < blk.EndJ(); ++jj) {
+        for (auto ii = blk.StartI(); ii < blk.EndI(); ++ii) {
+          const auto cons = blk.State(ii, jj, kk).ConsVars(phys);
+          for (auto vv = 0; vv < cons.Size(); ++vv) {
+            stateNorm += cons[vv] * cons[vv];
+          }
+        }
+      }
+    }
+  }
+  MPI_Allreduce(MPI_IN_PLACE, &stateNorm, 1, MPI_DOUBLE, MPI_SUM,
+                MPI_COMM_WORLD);
+  const auto step = sqrt(DBL_EPSILON) * (1.0 + sqrt(stateNorm)) / vecNorm;
+
+  // store unperturbed fields, and perturb state
+  vector<residualFields> unperturbed;
+  unperturbed.reserve(this->NumBlocks());
+  for (auto bb = 0; bb < this->NumBlocks(); ++bb) {
+    auto& blk = blocks_[bb];
+    unperturbed.push_back(blk.ResidualFields());
+
+    // time term uses the unperturbed spectral radius for dual time stepping
+    for (auto kk = blk.StartK(); kk < blk.EndK(); ++kk) {
+      for (auto jj = blk.StartJ(); jj < blk.EndJ(); ++jj) {
+        for (auto ii = blk.StartI(); ii < blk.EndI(); ++ii) {
+          prod[bb].InsertBlock(
+              ii, jj, kk,
+              blk.ImplicitTimeDiagonal(ii, jj, kk, inp) * vec[bb](ii, jj, kk));
+        }
+      }
+    }
+
+    auto du = vec[bb];
+    du *= step;
+    blk.PerturbState(du, phys);
+  }
+
+  // flux jacobians of perturbed residual are not needed, so an empty main
+  // diagonal is used
+  vector<matMultiArray3d> noDiagonal(this->NumBlocks());
+  this->GetBoundaryConditionsAndResidual(phys, inp, rank, MPI_tensorDouble,
+                                         MPI_vec3d, noDiagonal);
+
+  const auto coeff = 1.0 / (step * inp.Theta());
+#pragma omp parallel for schedule(dynamic)
+  for (auto bb = 0; bb < this->NumBlocks(); ++bb) {
+    auto& blk = blocks_[bb];
+    for (auto kk = blk.StartK(); kk < blk.EndK(); ++kk) {
+      for (auto jj = blk.StartJ(); jj < blk.EndJ(); ++jj) {
+        for (auto ii = blk.StartI(); ii < blk.EndI(); ++ii) {
+          const varArray dResid =
+              blk.Residual(ii, jj, kk) - unperturbed[bb].resid(ii, jj, kk);
+          prod[bb].InsertBlock(ii, jj, kk,
+                               prod[bb](ii, jj, kk) + coeff * dResid);
+        }
+      }
+    }
+    blk.RestoreResidualFields(std::move(unperturbed[bb]));
+  }
+  return prod;
+}
+
+void gridLevel::AssignForcing(
+    const vector<blkMultiArray3d<varArray>>& forcing) {
+  MSG_ASSERT(forcing.size() == mgForcing_.size(), "forcing size mismatch");
+  // forcing does not have ghost cells
+  for (auto bb = 0; bb < this->NumBlocks(); ++bb) {
+    auto& mgf = mgForcing_[bb];
+    for (auto kk = mgf.StartK(); kk < mgf.EndK(); ++kk) {
+      for (auto jj = mgf.StartJ(); jj < mgf.EndJ(); ++jj) {
+        for (auto ii = mgf.StartI(); ii < mgf.EndI(); ++ii) {
+          mgf.InsertBlock(ii, jj, kk, forcing[bb](ii, jj, kk));
+        }
+      }
     }
   }
 }
 
+void gridLevel::ZeroForcing() {
+  for (auto& mgf : mgForcing_) {
+    mgf.Zero();
+  }
+}
+
 void gridLevel::InvertDiagonal(const input& inp) {
   // add volume and time term and calculate inverse of main diagonal
   solver_->AddDiagonalTerms(*this, inp);
@@ -406,9 +784,12 @@ void gridLevel::InvertDiagonal(const input& inp) {
 }
 
 void gridLevel::ResetDiagonal() {
+#pragma omp parallel for schedule(dynamic)
   for (auto bb = 0; bb < this->NumBlocks(); ++bb) {
     solver_->ZeroA(bb);
   }
+  // off diagonals change with the solution
+  solver_->ResetOffDiagonal();
 }
 
 void gridLevel::InitializeMatrixUpdate(const input& inp, const physics& phys) {
@@ -418,22 +799,32 @@ void gridLevel::InitializeMatrixUpdate(const input& inp, const physics& phys) {
 void gridLevel::UpdateBlocks(const input& inp, const physics& phys,
                              const int& mm,
                              residual& residL2, resid& residLinf) {
+  // residual norms are accumulated per block so blocks can be updated
+  // concurrently
+  vector<residual> blockL2(this->NumBlocks(),
+                           residual(residL2.Size(), residL2.NumSpecies()));
+  vector<resid> blockLinf(this->NumBlocks());
+
   // Update blocks
+#pragma omp parallel for schedule(dynamic)
   for (auto bb = 0; bb < this->NumBlocks(); ++bb) {
     // Update solution
-    blocks_[bb].UpdateBlock(inp, phys, solver_->X(bb), mm, residL2, residLinf);
+    blocks_[bb].UpdateBlock(inp, phys, solver_->X(bb), mm, blockL2[bb],
+                            blockLinf[bb]);
 
     // Assign time n to time n-1 at end of nonlinear iterations
     if (inp.IsMultilevelInTime() && mm == inp.NonlinearIterations() - 1) {
       blocks_[bb].AssignSolToTimeNm1();
     }
   }
+  CombineResiduals(blockL2, blockLinf, residL2, residLinf);
 }
 
 void gridLevel::AuxillaryAndWidths(const physics& phys) {
-  for (auto& block : blocks_) {
-    block.UpdateAuxillaryVariables(phys, false);
-    block.CalcCellWidths();
+#pragma omp parallel for schedule(dynamic)
+  for (auto bb = 0; bb < this->NumBlocks(); ++bb) {
+    blocks_[bb].UpdateAuxillaryVariables(phys, false);
+    blocks_[bb].CalcCellWidths();
   }
 }
 
@@ -489,6 +880,7 @@ gridLevel gridLevel::Coarsen(const decomposition& decomp, const input& inp,
       }
     }
   }
+  ReduceConnectionBorders(coarse.connections_);
   // Get ghost cell edge data
   for (auto& block : coarse.blocks_) {
     block.AssignGhostCellsGeomEdge();
@@ -0,0 +1,126 @@
+/*  This file is part of aither.
+    Copyright (C) 2015-19  Michael Nucci (mnucci@pm.me)
+
+    Aither is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Aither is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>. */
+
+#include <vector>
+#include <iostream>  // cerr, endl
+#include <cstdlib>   // exit
+#include "haloExchange.hpp"
+
+using std::vector;
+using std::cerr;
+using std::endl;
+
+// member function to group swaps by neighboring processor, and create message
+// buffers and persistent requests for each neighbor
+void haloExchange::InitNeighbors() {
+  // slices sent to the same neighbor are packed in the order they were posted
+  slotNeighbor_.assign(slots_.size(), -1);
+  for (auto ss = 0U; ss < slots_.size(); ++ss) {
+    auto &slot = slots_[ss];
+    auto nn = 0U;
+    while (nn < neighbors_.size() && neighbors_[nn].rank_ != slot->Partner()) {
+      nn++;
+    }
+    if (nn == neighbors_.size()) {
+      // message to neighbor uses tag of first swap with neighbor, which is
+      // the same on both processors
+      neighbors_.emplace_back(slot->Partner(), slot->Tag());
+    }
+    slotNeighbor_[ss] = nn;
+    slot->SetOffset(neighbors_[nn].sendBuffer_.size());
+    neighbors_[nn].sendBuffer_.resize(slot->Offset() + slot->NumDoubles());
+  }
+
+  sendRequests_.assign(neighbors_.size(), MPI_REQUEST_NULL);
+  recvRequests_.assign(neighbors_.size(), MPI_REQUEST_NULL);
+  for (auto nn = 0U; nn < neighbors_.size(); ++nn) {
+    auto &neighbor = neighbors_[nn];
+    neighbor.recvBuffer_.resize(neighbor.sendBuffer_.size());
+    MPI_Recv_init(neighbor.recvBuffer_.data(), neighbor.recvBuffer_.size(),
+                  MPI_DOUBLE, neighbor.rank_, neighbor.tag_, MPI_COMM_WORLD,
+                  &recvRequests_[nn]);
+    MPI_Send_init(neighbor.sendBuffer_.data(), neighbor.sendBuffer_.size(),
+                  MPI_DOUBLE, neighbor.rank_, neighbor.tag_, MPI_COMM_WORLD,
+                  &sendRequests_[nn]);
+  }
+}
+
+// member function to pack all posted swaps into one message per neighboring
+// processor and start sending them
+void haloExchange::Start() {
+  if (started_ || numPosted_ == 0) {
+    return;
+  } else if (numPosted_ != this->NumSwaps()) {
+    cerr << "ERROR: Error in haloExchange::Start(). Only " << numPosted_
+         << " of " << this->NumSwaps() << " swaps were posted!" << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  if (neighbors_.empty()) {
+    this->InitNeighbors();
+  }
+
+  // slices occupy separate parts of the message buffers
+#pragma omp parallel for schedule(dynamic)
+  for (auto ss = 0; ss < this->NumSwaps(); ++ss) {
+    auto &neighbor = neighbors_[slotNeighbor_[ss]];
+    slots_[ss]->Pack(neighbor.sendBuffer_.data() + slots_[ss]->Offset());
+  }
+
+  MPI_Startall(recvRequests_.size(), recvRequests_.data());
+  MPI_Startall(sendRequests_.size(), sendRequests_.data());
+  started_ = true;
+}
+
+// member function to wait for all messages to complete and insert the
+// received slices into their arrays
+void haloExchange::Finish() {
+  if (numPosted_ == 0) {
+    return;
+  }
+  // messages not already started are sent now
+  this->Start();
+
+  // slices are inserted in the order they were posted so that ghost cells
+  // shared by multiple connections are assigned consistently
+  MPI_Waitall(recvRequests_.size(), recvRequests_.data(), MPI_STATUSES_IGNORE);
+  for (auto ss = 0; ss < this->NumSwaps(); ++ss) {
+    auto &neighbor = neighbors_[slotNeighbor_[ss]];
+    slots_[ss]->Unpack(neighbor.recvBuffer_.data() + slots_[ss]->Offset());
+  }
+
+  // send buffers can only be reused once sends are complete
+  MPI_Waitall(sendRequests_.size(), sendRequests_.data(), MPI_STATUSES_IGNORE);
+  numPosted_ = 0;
+  started_ = false;
+}
+
+// destructor -- free persistent requests
+haloExchange::~haloExchange() noexcept {
+  // exchanges may outlive MPI
+  auto finalized = 0;
+  MPI_Finalized(&finalized);
+  if (finalized) {
+    return;
+  }
+  this->Finish();
+  for (auto &req : sendRequests_) {
+    MPI_Request_free(&req);
+  }
+  for (auto &req : recvRequests_) {
+    MPI_Request_free(&req);
+  }
+}
@@ -73,6 +73,10 @@ input::input(const string &name, const string &resName) : simName_(name),
   matrixSweeps_ = 1;
   matrixRelaxation_ = 1.0;  // default is symmetric Gauss-Seidel
                             // with no overrelaxation
+  matrixStoreOffDiagonal_ = false;  // default to calculate on the fly
+  matrixPreconditioner_ = "lusgs";  // default to symmetric gauss-seidel sweep
+  krylovVectors_ = 10;
+  krylovTolerance_ = 0.01;
   timeIntTheta_ = 1.0;  // default results in implicit euler
   timeIntZeta_ = 0.0;  // default results in implicit euler
   nonlinearIterations_ = 1;  // default is 1 (steady)
@@ -98,13 +102,32 @@ input::input(const string &name, const string &resName) : simName_(name),
   freezingTemperature_ = 0.0;
   mgLevels_ = 1;
   outputNodalVariables_ = false;
+  asyncOutput_ = false;  // default to write output synchronously
+  restartCompression_ = false;  // default to uncompressed restart files
+  outputFormat_ = "plot3d";  // default to plot3d function files
+  outputPrecision_ = "double";  // default to double precision vtk files
+  checkpointFrequency_ = 0;  // default to no in-memory checkpoints
+  checkpointCflFactor_ = 0.5;  // halve cfl after each rollback
+  sampleFrequency_ = 1;  // default to sample every iteration
+  wallLoads_ = false;  // default to not integrate wall loads
+  momentReferencePoint_ = {0.0, 0.0, 0.0};
+  momentReferenceLength_ = 1.0;
+  referenceArea_ = 1.0;
+  referenceVelocity_ = -1.0;  // default to reference speed of sound
+  geometryCache_ = false;  // default to recompute wall distances
   mgPreSweeps_ = 2;
   mgPostSweeps_ = 1;
   mgCycle_ = "V";
+  reconstructionMethod_ = reconstructionMethod::constant;
+  limiterMethod_ = limiterMethod::none;
+  inviscidFluxMethod_ = inviscidFluxMethod::roe;
+  viscousReconstructionMethod_ = viscousReconstructionMethod::central;
+  timeIntegrationMethod_ = timeIntegrationMethod::explicitEuler;
 
   // default to primitive variables
   outputVariables_ = {"density", "vel_x", "vel_y", "vel_z", "pressure"};
   wallOutputVariables_ = {};
+  sampleVariables_ = {"density", "vel_x", "vel_y", "vel_z", "pressure"};
 
   // keywords in the input file that the parser is looking for to define
   // variables
@@ -125,6 +148,10 @@ input::input(const string &name, const string &resName) : simName_(name),
            "matrixSolver",
            "matrixSweeps",
            "matrixRelaxation",
+           "matrixStoreOffDiagonal",
+           "matrixPreconditioner",
+           "krylovVectors",
+           "krylovTolerance",
            "nonlinearIterations",
            "cflMax",
            "cflStep",
@@ -142,6 +169,21 @@ input::input(const string &name, const string &resName) : simName_(name),
            "transportModel",
            "outputVariables",
            "outputNodalVariables",
+           "asyncOutput",
+           "restartCompression",
+           "outputFormat",
+           "outputPrecision",
+           "checkpointFrequency",
+           "checkpointCflFactor",
+           "samples",
+           "sampleVariables",
+           "sampleFrequency",
+           "wallLoads",
+           "momentReferencePoint",
+           "momentReferenceLength",
+           "referenceArea",
+           "referenceVelocity",
+           "geometryCache",
            "wallOutputVariables",
            "initialConditions",
            "schmidtNumber",
@@ -349,6 +391,26 @@ void input::ReadInput(const int &rank) {
           if (rank == ROOTP) {
             cout << key << ": " << this->MatrixRelaxation() << endl;
           }
+        } else if (key == "matrixStoreOffDiagonal") {
+          matrixStoreOffDiagonal_ = tokens[1] == "yes" || tokens[1] == "true";
+          if (rank == ROOTP) {
+            cout << key << ": " << this->MatrixStoreOffDiagonal() << endl;
+          }
+        } else if (key == "matrixPreconditioner") {
+          matrixPreconditioner_ = tokens[1];
+          if (rank == ROOTP) {
+            cout << key << ": " << this->MatrixPreconditioner() << endl;
+          }
+        } else if (key == "krylovVectors") {
+          krylovVectors_ = stoi(tokens[1]);
+          if (rank == ROOTP) {
+            cout << key << ": " << this->KrylovVectors() << endl;
+          }
+        } else if (key == "krylovTolerance") {
+          krylovTolerance_ = stod(tokens[1]);
+          if (rank == ROOTP) {
+            cout << key << ": " << this->KrylovTolerance() << endl;
+          }
         } else if (key == "nonlinearIterations") {
           nonlinearIterations_ = stoi(tokens[1]);
           if (rank == ROOTP) {
@@ -459,6 +521,36 @@ void input::ReadInput(const int &rank) {
           if (rank == ROOTP) {
             cout << key << ": " << this->OutputNodalVariables() << endl;
           }
+        } else if (key == "asyncOutput") {
+          asyncOutput_ = tokens[1] == "yes" || tokens[1] == "true";
+          if (rank == ROOTP) {
+            cout << key << ": " << this->AsyncOutput() << endl;
+          }
+        } else if (key == "restartCompression") {
+          restartCompression_ = tokens[1] == "yes" || tokens[1] == "true";
+          if (rank == ROOTP) {
+            cout << key << ": " << this->RestartCompression() << endl;
+          }
+        } else if (key == "outputFormat") {
+          outputFormat_ = tokens[1];
+          if (rank == ROOTP) {
+            cout << key << ": " << this->OutputFormat() << endl;
+          }
+        } else if (key == "outputPrecision") {
+          outputPrecision_ = tokens[1];
+          if (rank == ROOTP) {
+            cout << key << ": " << this->OutputPrecision() << endl;
+          }
+        } else if (key == "checkpointFrequency") {
+          checkpointFrequency_ = stoi(tokens[1]);
+          if (rank == ROOTP) {
+            cout << key << ": " << this->CheckpointFrequency() << endl;
+          }
+        } else if (key == "checkpointCflFactor") {
+          checkpointCflFactor_ = stod(tokens[1]);
+          if (rank == ROOTP) {
+            cout << key << ": " << this->CheckpointCflFactor() << endl;
+          }
         } else if (key == "outputVariables") {
           // clear default variables from set
           outputVariables_.clear();
@@ -511,6 +603,72 @@ void input::ReadInput(const int &rank) {
             }
             cout << endl;
           }
+        } else if (key == "sampleVariables") {
+          // clear default variables from set
+          sampleVariables_.clear();
+          auto specifiedVars = ReadStringList(inFile, tokens[1]);
+          for (auto &vars : specifiedVars) {
+            sampleVariables_.insert(vars);
+          }
+          if (rank == ROOTP) {
+            cout << key << ": <";
+            auto count = 0U;
+            for (auto &vars : sampleVariables_) {
+              cout << vars
+                   << ((count == sampleVariables_.size() - 1) ? ">" : ", ");
+              count++;
+            }
+            cout << endl;
+          }
+        } else if (key == "sampleFrequency") {
+          sampleFrequency_ = stoi(tokens[1]);
+          if (rank == ROOTP) {
+            cout << key << ": " << this->SampleFrequency() << endl;
+          }
+        } else if (key == "wallLoads") {
+          wallLoads_ = tokens[1] == "yes" || tokens[1] == "true";
+          if (rank == ROOTP) {
+            cout << key << ": " << this->WallLoads() << endl;
+          }
+        } else if (key == "momentReferencePoint") {
+          momentReferencePoint_ = ReadVector(tokens[1]);
+          if (rank == ROOTP) {
+            cout << key << ": [" << this->MomentReferencePoint() << "]"
+                 << endl;
+          }
+        } else if (key == "momentReferenceLength") {
+          momentReferenceLength_ = stod(tokens[1]);
+          if (rank == ROOTP) {
+            cout << key << ": " << this->MomentReferenceLength() << endl;
+          }
+        } else if (key == "referenceArea") {
+          referenceArea_ = stod(tokens[1]);
+          if (rank == ROOTP) {
+            cout << key << ": " << this->ReferenceArea() << endl;
+          }
+        } else if (key == "referenceVelocity") {
+          referenceVelocity_ = stod(tokens[1]);
+          if (rank == ROOTP) {
+            cout << key << ": " << referenceVelocity_ << endl;
+          }
+        } else if (key == "geometryCache") {
+          geometryCache_ = tokens[1] == "yes" || tokens[1] == "true";
+          if (rank == ROOTP) {
+            cout << key << ": " << this->GeometryCache() << endl;
+          }
+        } else if (key == "samples") {
+          samples_ = ReadSampleList(inFile, tokens[1]);
+          if (rank == ROOTP) {
+            cout << key << ": <";
+            for (auto ii = 0U; ii < samples_.size(); ++ii) {
+              cout << samples_[ii];
+              if (ii == samples_.size() - 1) {
+                cout << ">" << endl;
+              } else {
+                cout << "," << endl << "          ";
+              }
+            }
+          }
         } else if (key == "initialConditions") {
           ics_ = ReadICList(inFile, tokens[1]);
           if (rank == ROOTP) {
@@ -622,6 +780,9 @@ void input::ReadInput(const int &rank) {
   // nondimensionalize freezing temperature
   freezingTemperature_ /= tRef_;
 
+  // convert method strings used in the solver kernels
+  this->ResolveMethods();
+
   // input file sanity checks
   this->CheckNonlinearIterations();
   this->CheckOutputVariables();
@@ -631,6 +792,12 @@ void input::ReadInput(const int &rank) {
   this->CheckNonreflecting();
   this->CheckChemistryMechanism();
   this->CheckMultigrid();
+  this->CheckNumberOfEquations();
+  this->CheckOutputFormat();
+  this->CheckCheckpoint();
+  this->CheckSamples();
+  this->CheckWallLoads();
+  this->CheckMatrixStoreOffDiagonal();
 
   if (rank == ROOTP) {
     cout << endl;
@@ -648,6 +815,16 @@ void input::CalcCFL(const int &ii) {
   cfl_ = std::min(cflStart_ + ii * cflStep_, cflMax_);
 }
 
+// member function to scale down the cfl ramp after a checkpoint rollback
+void input::ReduceCFL(const double &factor) {
+  cflStart_ *= factor;
+  cflStep_ *= factor;
+  cflMax_ *= factor;
+  if (dualTimeCFL_ > 0.0) {
+    dualTimeCFL_ *= factor;
+  }
+}
+
 // member function to determine number of turbulence equations
 int input::NumTurbEquations() const {
   return (this->IsRANS()) ? 2 : 0;
@@ -672,9 +849,9 @@ int input::NumEquations() const {
 
 // member function to determine of method is implicit or explicit
 bool input::IsImplicit() const {
-  if (timeIntegration_ == "implicitEuler" ||
-      timeIntegration_ == "crankNicholson" ||
-      timeIntegration_ == "bdf2") {
+  if (timeIntegrationMethod_ == timeIntegrationMethod::implicitEuler ||
+      timeIntegrationMethod_ == timeIntegrationMethod::crankNicholson ||
+      timeIntegrationMethod_ == timeIntegrationMethod::bdf2) {
     return true;
   } else {
     return false;
@@ -711,8 +888,9 @@ bool input::IsLES() const {
 
 // member function to determine if solution should use a block matrix
 bool input::IsBlockMatrix() const {
-  if (this->IsImplicit() && (matrixSolver_ == "bdplur" ||
-                             matrixSolver_ == "blusgs")) {
+  const auto relax = this->RelaxationSolver();
+  if (this->IsImplicit() && (relax == "bdplur" || relax == "blusgs" ||
+                             relax == "blinesgs" || relax == "bilu")) {
     return true;
   } else {
     return false;
@@ -843,15 +1021,22 @@ unique_ptr<chemistry> input::AssignChemistryModel() const {
 unique_ptr<linearSolver> input::AssignLinearSolver(
     const gridLevel &level) const {
   // define linear solver
+  // jacobian free solvers use the relaxation solver as the preconditioner
+  const auto relax = this->RelaxationSolver();
   unique_ptr<linearSolver> solver(nullptr);
-  if (matrixSolver_ == "lusgs" || matrixSolver_ == "blusgs") {
+  if (relax == "lusgs" || relax == "blusgs") {
     solver =
         unique_ptr<linearSolver>{std::make_unique<lusgs>(*this, level)};
-  } else if (matrixSolver_ == "dplur" || matrixSolver_ == "bdplur") {
+  } else if (relax == "dplur" || relax == "bdplur") {
     solver = unique_ptr<linearSolver>{std::make_unique<dplur>(*this, level)};
+  } else if (relax == "bilu") {
+    solver = unique_ptr<linearSolver>{std::make_unique<ilu>(*this, level)};
+  } else if (relax == "blinesgs") {
+    solver =
+        unique_ptr<linearSolver>{std::make_unique<linesgs>(*this, level)};
   } else {
     cerr << "ERROR: Error in input::AssignLinearSolver(). Linear "
-         << "solver " << matrixSolver_ << " is not recognized!" << endl;
+         << "solver " << relax << " is not recognized!" << endl;
     exit(EXIT_FAILURE);
   }
   return solver;
@@ -1051,6 +1236,188 @@ void input::CheckMultigrid() const {
   }
 }
 
+// member function to check validity of the requested samples
+void input::CheckSamples() {
+  if (sampleFrequency_ <= 0) {
+    cerr << "ERROR: sampleFrequency must be positive" << endl;
+    exit(EXIT_FAILURE);
+  }
+  const set<string> available = {"density", "vel_x", "vel_y", "vel_z",
+                                 "pressure", "temperature", "mach", "sos",
+                                 "tke", "sdr"};
+  auto sVars = sampleVariables_;
+  for (auto &var : sVars) {
+    if (available.find(var) == available.end()) {
+      cerr << "ERROR: Sample variable " << var << " is not available" << endl;
+      exit(EXIT_FAILURE);
+    }
+    if (!this->IsRANS() && (var == "tke" || var == "sdr")) {
+      cerr << "WARNING: Sample variable " << var
+           << " is not available for non-RANS simulations." << endl;
+      sampleVariables_.erase(var);
+    }
+  }
+}
+
+void input::CheckWallLoads() const {
+  if (referenceArea_ <= 0.0 || momentReferenceLength_ <= 0.0) {
+    cerr << "ERROR: referenceArea and momentReferenceLength must be positive"
+         << endl;
+    exit(EXIT_FAILURE);
+  }
+  if (wallLoads_ && !this->IsViscous()) {
+    cerr << "WARNING: wallLoads are only integrated over viscousWall "
+         << "boundaries, which require a viscous simulation" << endl;
+  }
+}
+
+// stored off diagonal jacobians are only exact when the off diagonal is linear
+// in the update, which is the case for the block rusanov jacobian
+void input::CheckMatrixStoreOffDiagonal() const {
+  if (matrixStoreOffDiagonal_ &&
+      (!this->IsBlockMatrix() || invFluxJac_ != "rusanov")) {
+    cerr << "ERROR: matrixStoreOffDiagonal requires a block matrix solver "
+         << "(blusgs, bdplur, bgmres, blinesgs, or bilu) and the rusanov "
+         << "inviscidFluxJacobian" << endl;
+    exit(EXIT_FAILURE);
+  }
+  const auto relax = this->RelaxationSolver();
+  if ((relax == "blinesgs" || relax == "bilu") && invFluxJac_ != "rusanov") {
+    cerr << "ERROR: matrix solver " << relax << " requires the rusanov "
+         << "inviscidFluxJacobian" << endl;
+    exit(EXIT_FAILURE);
+  }
+  if (matrixPreconditioner_ != "lusgs" && matrixPreconditioner_ != "dplur" &&
+      matrixPreconditioner_ != "ilu" && matrixPreconditioner_ != "linesgs") {
+    cerr << "ERROR: matrixPreconditioner " << matrixPreconditioner_
+         << " is not recognized! Options are lusgs, dplur, ilu, or linesgs"
+         << endl;
+    exit(EXIT_FAILURE);
+  }
+  if (this->IsJacobianFree() &&
+      (relax == "ilu" || relax == "linesgs")) {
+    cerr << "ERROR: matrixPreconditioner " << matrixPreconditioner_
+         << " requires the bgmres matrixSolver" << endl;
+    exit(EXIT_FAILURE);
+  }
+  if (krylovVectors_ < 2) {
+    cerr << "ERROR: krylovVectors must be at least 2" << endl;
+    exit(EXIT_FAILURE);
+  }
+  if (krylovTolerance_ <= 0.0 || krylovTolerance_ >= 1.0) {
+    cerr << "ERROR: krylovTolerance must be between 0 and 1" << endl;
+    exit(EXIT_FAILURE);
+  }
+}
+
+void input::CheckCheckpoint() const {
+  if (checkpointFrequency_ < 0) {
+    cerr << "ERROR: checkpointFrequency must be non-negative" << endl;
+    exit(EXIT_FAILURE);
+  }
+  if (checkpointCflFactor_ <= 0.0 || checkpointCflFactor_ >= 1.0) {
+    cerr << "ERROR: checkpointCflFactor must be between 0 and 1" << endl;
+    exit(EXIT_FAILURE);
+  }
+  // a rollback only reduces the cfl number, so a fixed time step without dual
+  // time stepping would repeat the diverged iterations unchanged
+  if (this->IsCheckpointing() && dt_ > 0.0 && dualTimeCFL_ <= 0.0) {
+    cerr << "ERROR: checkpointFrequency with a fixed timeStep requires "
+         << "dualTimeCFL, because rollbacks reduce the cfl number and do not "
+         << "change the time step" << endl;
+    exit(EXIT_FAILURE);
+  }
+}
+
+void input::CheckOutputFormat() const {
+  if (outputFormat_ != "plot3d" && outputFormat_ != "vtk") {
+    cerr << "ERROR: outputFormat must be 'plot3d' or 'vtk'" << endl;
+    exit(EXIT_FAILURE);
+  }
+  if (outputPrecision_ != "double" && outputPrecision_ != "single") {
+    cerr << "ERROR: outputPrecision must be 'double' or 'single'" << endl;
+    exit(EXIT_FAILURE);
+  }
+}
+
+// check that number of equations fits in the compiled state array capacity
+void input::CheckNumberOfEquations() const {
+  if (this->NumEquations() > MAX_EQUATIONS) {
+    cerr << "ERROR: Simulation requires " << this->NumEquations()
+         << " equations, but aither was compiled with support for a maximum "
+         << "of " << MAX_EQUATIONS << " equations. Reconfigure with "
+         << "-DMAX_EQUATIONS=" << this->NumEquations() << " or greater."
+         << endl;
+    exit(EXIT_FAILURE);
+  }
+}
+
+// convert the numerical method strings from the input file into enumerations
+// so that the solver kernels do not have to compare strings
+void input::ResolveMethods() {
+  if (this->UsingConstantReconstruction()) {
+    reconstructionMethod_ = reconstructionMethod::constant;
+  } else if (this->UsingMUSCLReconstruction()) {
+    reconstructionMethod_ = reconstructionMethod::muscl;
+  } else if (faceReconstruction_ == "weno") {
+    reconstructionMethod_ = reconstructionMethod::weno;
+  } else if (faceReconstruction_ == "wenoZ") {
+    reconstructionMethod_ = reconstructionMethod::wenoZ;
+  } else {
+    cerr << "ERROR: Face reconstruction method " << faceReconstruction_
+         << " is not recognized!" << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  if (limiter_ == "none") {
+    limiterMethod_ = limiterMethod::none;
+  } else if (limiter_ == "vanAlbada") {
+    limiterMethod_ = limiterMethod::vanAlbada;
+  } else if (limiter_ == "minmod") {
+    limiterMethod_ = limiterMethod::minmod;
+  } else {
+    cerr << "ERROR: Limiter " << limiter_ << " is not recognized!" << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  if (inviscidFlux_ == "roe") {
+    inviscidFluxMethod_ = inviscidFluxMethod::roe;
+  } else if (inviscidFlux_ == "ausm") {
+    inviscidFluxMethod_ = inviscidFluxMethod::ausm;
+  } else {
+    cerr << "ERROR: inviscid flux type " << inviscidFlux_
+         << " is not recognized!" << endl;
+    cerr << "Choose 'roe' or 'ausm'" << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  if (viscousFaceReconstruction_ == "central") {
+    viscousReconstructionMethod_ = viscousReconstructionMethod::central;
+  } else if (viscousFaceReconstruction_ == "centralFourth") {
+    viscousReconstructionMethod_ = viscousReconstructionMethod::centralFourth;
+  } else {
+    cerr << "ERROR: Viscous face reconstruction method "
+         << viscousFaceReconstruction_ << " is not recognized!" << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  if (timeIntegration_ == "explicitEuler") {
+    timeIntegrationMethod_ = timeIntegrationMethod::explicitEuler;
+  } else if (timeIntegration_ == "rk4") {
+    timeIntegrationMethod_ = timeIntegrationMethod::rk4;
+  } else if (timeIntegration_ == "implicitEuler") {
+    timeIntegrationMethod_ = timeIntegrationMethod::implicitEuler;
+  } else if (timeIntegration_ == "crankNicholson") {
+    timeIntegrationMethod_ = timeIntegrationMethod::crankNicholson;
+  } else if (timeIntegration_ == "bdf2") {
+    timeIntegrationMethod_ = timeIntegrationMethod::bdf2;
+  } else {
+    cerr << "ERROR: Time integration scheme " << timeIntegration_
+         << " is not recognized!" << endl;
+    exit(EXIT_FAILURE);
+  }
+}
+
 // check that chemistry mechanism is only used with reacting flow
 void input::CheckChemistryMechanism() const {
   if (chemistryMechanism_ == "none" && chemistryModel_ == "reacting") {
@@ -1117,11 +1484,27 @@ double input::ViscousCFLCoefficient() const {
   return coeff;
 }
 
+// member function to determine if the matrix is only applied through jacobian
+// free products of the residual
+bool input::IsJacobianFree() const {
+  return matrixSolver_ == "gmres" || matrixSolver_ == "bgmres";
+}
+
+// member function to get the solver used for relaxation sweeps; this is the
+// matrix solver, or the preconditioner of a jacobian free matrix solver
+string input::RelaxationSolver() const {
+  if (this->IsJacobianFree()) {
+    return (matrixSolver_ == "bgmres" ? "b" : "") + matrixPreconditioner_;
+  }
+  return matrixSolver_;
+}
+
 bool input::MatrixRequiresInitialization() const {
   // initialize matrix if using DPLUR / BDPLUR, or if using LUSGS / BLUSGS with
   // more than one sweep
-  return (matrixSolver_ == "dplur" || matrixSolver_ == "bdplur" ||
-          matrixSweeps_ > 1) ? true : false;
+  const auto relax = this->RelaxationSolver();
+  return (relax == "dplur" || relax == "bdplur" || matrixSweeps_ > 1) ? true
+                                                                      : false;
 }
 
 int input::NumberGhostLayers() const {
@@ -16,6 +16,7 @@
 
 #include <iostream>               // cout, cerr, endl
 #include <vector>
+#include <cmath>                  // sqrt, abs
 #include "linearSolver.hpp"
 #include "procBlock.hpp"
 #include "input.hpp"
@@ -24,6 +25,7 @@
 #include "gridLevel.hpp"
 #include "utility.hpp"
 #include "fluxJacobian.hpp"
+#include "mpi.h"
 
 using std::cout;
 using std::endl;
@@ -31,8 +33,9 @@ using std::cerr;
 using std::vector;
 
 // constructor
-linearSolver::linearSolver(const input &inp, const gridLevel &level) {
-  solverType_ = inp.MatrixSolver();
+linearSolver::linearSolver(const input &inp, const gridLevel &level)
+    : isOffDiagonalStored_(false) {
+  solverType_ = inp.RelaxationSolver();
   if (inp.IsImplicit()) {
     a_.reserve(level.NumBlocks());
     x_.reserve(level.NumBlocks());
@@ -62,16 +65,24 @@ vector<blkMultiArray3d<varArray>> linearSolver::AXmB(const gridLevel &level,
   vector<blkMultiArray3d<varArray>> axmb;
   axmb.reserve(this->NumBlocks());
   for (auto bb = 0; bb < this->NumBlocks(); ++bb) {
-    const auto &blk = level.Block(bb);
     axmb.emplace_back(x_[bb].NumINoGhosts(), x_[bb].NumJNoGhosts(),
                       x_[bb].NumKNoGhosts(), x_[bb].GhostLayers(),
                       x_[bb].BlockInfo());
+  }
+
+  const auto threadBlocks = level.ThreadOverBlocks();
+#pragma omp parallel for schedule(dynamic) if (threadBlocks)
+  for (auto bb = 0; bb < this->NumBlocks(); ++bb) {
+    const auto &blk = level.Block(bb);
+#pragma omp parallel for collapse(2) schedule(static)
     for (auto kk = blk.StartK(); kk < blk.EndK(); ++kk) {
       for (auto jj = blk.StartJ(); jj < blk.EndJ(); ++jj) {
         for (auto ii = blk.StartI(); ii < blk.EndI(); ++ii) {
           // calculate off diagonal terms on the fly
-          auto offDiagonal = blk.ImplicitLower(ii, jj, kk, x_[bb], phys, inp);
-          offDiagonal -= blk.ImplicitUpper(ii, jj, kk, x_[bb], phys, inp);
+          auto offDiagonal =
+              this->ImplicitLower(blk, bb, ii, jj, kk, x_[bb], phys, inp);
+          offDiagonal -=
+              this->ImplicitUpper(blk, bb, ii, jj, kk, x_[bb], phys, inp);
 
           // calculate 'b' terms - these change at subiteration level
           const auto solDeltaNm1 = blk.SolDeltaNm1(ii, jj, kk, inp);
@@ -92,6 +103,7 @@ vector<blkMultiArray3d<varArray>> linearSolver::AXmB(const gridLevel &level,
 vector<blkMultiArray3d<varArray>> linearSolver::Residual(
     const gridLevel &level, const physics &phys, const input &inp) const {
   auto resid = this->AXmB(level, phys, inp);
+#pragma omp parallel for schedule(dynamic)
   for (auto bb = 0; bb < level.NumBlocks(); ++bb) {
     const auto &blk = level.Block(bb);
     for (auto kk = blk.StartK(); kk < blk.EndK(); ++kk) {
@@ -120,6 +132,7 @@ void linearSolver::InitializeMatrixUpdate(const gridLevel &level,
              "cell number mismatch");
 
   // allocate multiarray for update
+#pragma omp parallel for schedule(dynamic)
   for (auto bb = 0; bb < level.NumBlocks(); ++bb) {
     const auto &blk = level.Block(bb);
     if (inp.MatrixRequiresInitialization()) {
@@ -152,18 +165,14 @@ void linearSolver::AddDiagonalTerms(const gridLevel &level, const input &inp) {
              "cell number mismatch");
 
   // loop over blocks in grid level
+#pragma omp parallel for schedule(dynamic)
   for (auto bb = 0; bb < level.NumBlocks(); ++bb) {
     const auto &blk = level.Block(bb);
     // loop over physical cells
     for (auto kk = blk.StartK(); kk < blk.EndK(); ++kk) {
       for (auto jj = blk.StartJ(); jj < blk.EndJ(); ++jj) {
         for (auto ii = blk.StartI(); ii < blk.EndI(); ++ii) {
-          auto diagVolTime = blk.SolDeltaNCoeff(ii, jj, kk, inp);
-          if (inp.DualTimeCFL() > 0.0) {  // use dual time stepping
-            // equal to volume / tau
-            diagVolTime +=
-                blk.SpectralRadius(ii, jj, kk).Max() / inp.DualTimeCFL();
-          }
+          const auto diagVolTime = blk.ImplicitTimeDiagonal(ii, jj, kk, inp);
 
           // add volume and time term
           a_[bb].MultiplyOnDiagonal(ii, jj, kk, inp.MatrixRelaxation());
@@ -176,7 +185,10 @@ void linearSolver::AddDiagonalTerms(const gridLevel &level, const input &inp) {
 
 void linearSolver::Invert() {
   aInv_ = a_;
-  for (auto &ai : aInv_) {
+  const auto numBlks = static_cast<int>(aInv_.size());
+#pragma omp parallel for schedule(dynamic)
+  for (auto bb = 0; bb < numBlks; ++bb) {
+    auto &ai = aInv_[bb];
     for (auto kk = ai.StartK(); kk < ai.EndK(); ++kk) {
       for (auto jj = ai.StartJ(); jj < ai.EndJ(); ++jj) {
         for (auto ii = ai.StartI(); ii < ai.EndI(); ++ii) {
@@ -187,9 +199,78 @@ void linearSolver::Invert() {
   }
 }
 
+// member function to calculate and store the off diagonal jacobians of all
+// blocks, so relaxation sweeps only need matrix-vector products. They are
+// only calculated once per nonlinear iteration.
+void linearSolver::CalcOffDiagonal(const gridLevel &level,
+                                   const physics &phys, const input &inp) {
+  // level -- grid level to calculate off diagonals for
+  // phys -- physics models
+  // inp -- input variables
+
+  if (!inp.MatrixStoreOffDiagonal() || isOffDiagonalStored_) {
+    return;
+  }
+
+  // allocate on first use - boundaries without a contribution stay zero
+  if (offDiagonal_.empty()) {
+    const fluxJacobian fluxJac(inp.NumFlowEquations(), inp.NumTurbEquations());
+    offDiagonal_.resize(level.NumBlocks());
+    for (auto bb = 0; bb < level.NumBlocks(); ++bb) {
+      const auto &blk = level.Block(bb);
+      offDiagonal_[bb].assign(
+          6, matMultiArray3d(blk.NumI(), blk.NumJ(), blk.NumK(), 0, fluxJac));
+    }
+  }
+
+#pragma omp parallel for schedule(dynamic)
+  for (auto bb = 0; bb < level.NumBlocks(); ++bb) {
+    level.Block(bb).CalcOffDiagonalJacobians(phys, inp, offDiagonal_[bb]);
+  }
+  isOffDiagonalStored_ = true;
+}
+
+// member function to calculate the product of the lower off diagonals with
+// the update, using the stored jacobians if available
+varArray linearSolver::ImplicitLower(const procBlock &blk, const int &bb,
+                                     const int &ii, const int &jj,
+                                     const int &kk,
+                                     const blkMultiArray3d<varArray> &x,
+                                     const physics &phys,
+                                     const input &inp) const {
+  if (!isOffDiagonalStored_) {
+    return blk.ImplicitLower(ii, jj, kk, x, phys, inp);
+  }
+  const auto &offDiag = offDiagonal_[bb];
+  varArray L(inp.NumEquations(), inp.NumSpecies());
+  L += offDiag[0].ArrayMult(ii, jj, kk, x(ii - 1, jj, kk));
+  L += offDiag[1].ArrayMult(ii, jj, kk, x(ii, jj - 1, kk));
+  L += offDiag[2].ArrayMult(ii, jj, kk, x(ii, jj, kk - 1));
+  return L;
+}
+
+// member function to calculate the product of the upper off diagonals with
+// the update, using the stored jacobians if available
+varArray linearSolver::ImplicitUpper(const procBlock &blk, const int &bb,
+                                     const int &ii, const int &jj,
+                                     const int &kk,
+                                     const blkMultiArray3d<varArray> &x,
+                                     const physics &phys,
+                                     const input &inp) const {
+  if (!isOffDiagonalStored_) {
+    return blk.ImplicitUpper(ii, jj, kk, x, phys, inp);
+  }
+  const auto &offDiag = offDiagonal_[bb];
+  varArray U(inp.NumEquations(), inp.NumSpecies());
+  U += offDiag[3].ArrayMult(ii, jj, kk, x(ii + 1, jj, kk));
+  U += offDiag[4].ArrayMult(ii, jj, kk, x(ii, jj + 1, kk));
+  U += offDiag[5].ArrayMult(ii, jj, kk, x(ii, jj, kk + 1));
+  return U;
+}
+
 void linearSolver::SwapUpdate(const vector<connection> &conn, const int &rank,
                               const int &numGhost) {
-  SwapImplicitUpdate(x_, conn, rank, numGhost);
+  SwapImplicitUpdate(x_, conn, rank, numGhost, updateExchange_);
 }
 
 void linearSolver::SubtractFromUpdate(
@@ -226,10 +307,14 @@ lusgs::lusgs(const input &inp, const gridLevel &level)
     : linearSolver(inp, level) {
   // calculate order by hyperplanes for each block
   reorder_.resize(level.NumBlocks());
+  planeStart_.resize(level.NumBlocks());
   for (auto bb = 0; bb < level.NumBlocks(); ++bb) {
     reorder_[bb] =
         HyperplaneReorder(level.Block(bb).NumI(), level.Block(bb).NumJ(),
                           level.Block(bb).NumK());
+    planeStart_[bb] =
+        HyperplaneOffsets(level.Block(bb).NumI(), level.Block(bb).NumJ(),
+                          level.Block(bb).NumK());
   }
 }
 
@@ -338,14 +423,17 @@ variabes (FD(Unj)) which is known due to sweeping along hyperplanes.
 For viscous simulations, the viscous contribution to the spectral radius K is
 used, and everything else remains the same.
  */
-void lusgs::LUSGS_Forward(const procBlock &blk,
+void lusgs::LUSGS_Forward(const procBlock &blk, const int &bb,
                           const vector<vector3d<int>> &reorder,
+                          const vector<int> &planeStart,
                           const physics &phys, const input &inp,
                           const matMultiArray3d &aInv, const int &sweep,
                           const blkMultiArray3d<varArray> &forcing,
                           blkMultiArray3d<varArray> &x) const {
   // blk -- block to solve on
+  // bb -- index of block in grid level
   // reorder -- order of cells to visit (this should be ordered in hyperplanes)
+  // planeStart -- start of each hyperplane in reorder
   // phys -- physics models
   // inp -- all input variables
   // aInv -- inverse of main diagonal
@@ -357,40 +445,51 @@ void lusgs::LUSGS_Forward(const procBlock &blk,
 
   //--------------------------------------------------------------------
   // forward sweep over all physical cells
-  for (auto nn = 0; nn < blk.NumCells(); ++nn) {
-    // indices for variables without ghost cells
-    const auto ii = reorder[nn].X();
-    const auto jj = reorder[nn].Y();
-    const auto kk = reorder[nn].Z();
-
-    // calculate lower and upper off diagonals on the fly
-    // normal at lower boundaries needs to be reversed, so add instead
-    // of subtract L
-    auto offDiagonal = blk.ImplicitLower(ii, jj, kk, x, phys, inp);
-    if (sweep > 0 || inp.MatrixRequiresInitialization()) {
-      offDiagonal -= blk.ImplicitUpper(ii, jj, kk, x, phys, inp);
-    }
-
-    // calculate 'b' terms - these change at subiteration level
-    const auto solDeltaNm1 = blk.SolDeltaNm1(ii, jj, kk, inp);
-    const auto solDeltaMmN = blk.SolDeltaMmN(ii, jj, kk, inp, phys);
-    const auto b = -thetaInv * blk.Residual(ii, jj, kk) + forcing(ii, jj, kk) +
-                   solDeltaNm1 - solDeltaMmN;
-
-    // calculate intermediate update
-    x.InsertBlock(ii, jj, kk, aInv.ArrayMult(ii, jj, kk, b + offDiagonal));
+  // cells on a hyperplane only depend on cells of other hyperplanes, so each
+  // hyperplane is split among threads with a barrier before the next one
+  const auto numPlanes = static_cast<int>(planeStart.size()) - 1;
+#pragma omp parallel
+  for (auto pp = 0; pp < numPlanes; ++pp) {
+#pragma omp for schedule(static)
+    for (auto nn = planeStart[pp]; nn < planeStart[pp + 1]; ++nn) {
+      // indices for variables without ghost cells
+      const auto ii = reorder[nn].X();
+      const auto jj = reorder[nn].Y();
+      const auto kk = reorder[nn].Z();
+
+      // calculate lower and upper off diagonals on the fly
+      // normal at lower boundaries needs to be reversed, so add instead
+      // of subtract L
+      auto offDiagonal =
+          this->ImplicitLower(blk, bb, ii, jj, kk, x, phys, inp);
+      if (sweep > 0 || inp.MatrixRequiresInitialization()) {
+        offDiagonal -= this->ImplicitUpper(blk, bb, ii, jj, kk, x, phys, inp);
+      }
+
+      // calculate 'b' terms - these change at subiteration level
+      const auto solDeltaNm1 = blk.SolDeltaNm1(ii, jj, kk, inp);
+      const auto solDeltaMmN = blk.SolDeltaMmN(ii, jj, kk, inp, phys);
+      const auto b = -thetaInv * blk.Residual(ii, jj, kk) +
+                     forcing(ii, jj, kk) + solDeltaNm1 - solDeltaMmN;
+
+      // calculate intermediate update
+      x.InsertBlock(ii, jj, kk, aInv.ArrayMult(ii, jj, kk, b + offDiagonal));
+    }
   }  // end forward sweep
 }
 
-void lusgs::LUSGS_Backward(const procBlock &blk,
+void lusgs::LUSGS_Backward(const procBlock &blk, const int &bb,
                            const vector<vector3d<int>> &reorder,
+                           const vector<int> &planeStart,
                            const physics &phys, const input &inp,
                            const matMultiArray3d &aInv,
                            const matMultiArray3d &a, const int &sweep,
                            const blkMultiArray3d<varArray> &forcing,
                            blkMultiArray3d<varArray> &x) const {
   // blk -- block to solve on
+  // bb -- index of block in grid level
   // reorder -- order of cells to visit (this should be ordered in hyperplanes)
+  // planeStart -- start of each hyperplane in reorder
   // phys -- physics models
   // inp -- all input variables
   // aInv -- inverse of main diagonal
@@ -401,28 +500,33 @@ void lusgs::LUSGS_Backward(const procBlock &blk,
 
   const auto thetaInv = 1.0 / inp.Theta();
 
-  // backward sweep over all physical cells
-  for (auto nn = blk.NumCells() - 1; nn >= 0; --nn) {
-    // indices for variables without ghost cells
-    const auto ii = reorder[nn].X();
-    const auto jj = reorder[nn].Y();
-    const auto kk = reorder[nn].Z();
-
-    // calculate upper off diagonals on the fly
-    const auto U = blk.ImplicitUpper(ii, jj, kk, x, phys, inp);
-
-    // calculate update
-    const auto xold = x.GetCopy(ii, jj, kk);
-    if (sweep > 0 || inp.MatrixRequiresInitialization()) {
-      const auto L = blk.ImplicitLower(ii, jj, kk, x, phys, inp);
-          // calculate 'b' terms - these change at subiteration level
-      const auto solDeltaNm1 = blk.SolDeltaNm1(ii, jj, kk, inp);
-      const auto solDeltaMmN = blk.SolDeltaMmN(ii, jj, kk, inp, phys);
-      const auto b = -thetaInv * blk.Residual(ii, jj, kk) +
-                     forcing(ii, jj, kk) + solDeltaNm1 - solDeltaMmN;
-      x.InsertBlock(ii, jj, kk, aInv.ArrayMult(ii, jj, kk, b + L - U));
-    } else {
-      x.InsertBlock(ii, jj, kk, xold - aInv.ArrayMult(ii, jj, kk, U));
+  // backward sweep over all physical cells, one hyperplane at a time
+  const auto numPlanes = static_cast<int>(planeStart.size()) - 1;
+#pragma omp parallel
+  for (auto pp = numPlanes - 1; pp >= 0; --pp) {
+#pragma omp for schedule(static)
+    for (auto nn = planeStart[pp]; nn < planeStart[pp + 1]; ++nn) {
+      // indices for variables without ghost cells
+      const auto ii = reorder[nn].X();
+      const auto jj = reorder[nn].Y();
+      const auto kk = reorder[nn].Z();
+
+      // calculate upper off diagonals on the fly
+      const auto U = this->ImplicitUpper(blk, bb, ii, jj, kk, x, phys, inp);
+
+      // calculate update
+      const auto xold = x.GetCopy(ii, jj, kk);
+      if (sweep > 0 || inp.MatrixRequiresInitialization()) {
+        const auto L = this->ImplicitLower(blk, bb, ii, jj, kk, x, phys, inp);
+        // calculate 'b' terms - these change at subiteration level
+        const auto solDeltaNm1 = blk.SolDeltaNm1(ii, jj, kk, inp);
+        const auto solDeltaMmN = blk.SolDeltaMmN(ii, jj, kk, inp, phys);
+        const auto b = -thetaInv * blk.Residual(ii, jj, kk) +
+                       forcing(ii, jj, kk) + solDeltaNm1 - solDeltaMmN;
+        x.InsertBlock(ii, jj, kk, aInv.ArrayMult(ii, jj, kk, b + L - U));
+      } else {
+        x.InsertBlock(ii, jj, kk, xold - aInv.ArrayMult(ii, jj, kk, U));
+      }
     }
   }  // end backward sweep
 }
@@ -439,6 +543,13 @@ vector<blkMultiArray3d<varArray>> lusgs::Relax(const gridLevel &level,
   MSG_ASSERT(level.Block(0).NumCells() == this->A(0).NumBlocks(),
              "cell number mismatch");
 
+  // off diagonals are constant over all sweeps of a nonlinear iteration
+  this->CalcOffDiagonal(level, phys, inp);
+
+  // sweeps are threaded within each block, so only thread over blocks when
+  // there are enough of them to keep threads busy
+  const auto threadBlocks = level.ThreadOverBlocks();
+
   // start sweeps through domain
   const auto numG = level.Block(0).NumGhosts();
   for (auto ii = 0; ii < sweeps; ++ii) {
@@ -446,19 +557,22 @@ vector<blkMultiArray3d<varArray>> lusgs::Relax(const gridLevel &level,
     this->SwapUpdate(level.Connections(), rank, numG);
 
     // forward lu-sgs sweep
+#pragma omp parallel for schedule(dynamic) if (threadBlocks)
     for (auto bb = 0; bb < level.NumBlocks(); ++bb) {
-      this->LUSGS_Forward(level.Block(bb), reorder_[bb], phys, inp,
-                          this->AInv(bb), ii, level.Forcing(bb), x_[bb]);
+      this->LUSGS_Forward(level.Block(bb), bb, reorder_[bb], planeStart_[bb],
+                          phys, inp, this->AInv(bb), ii, level.Forcing(bb),
+                          x_[bb]);
     }
 
     // swap updates for ghost cells
     this->SwapUpdate(level.Connections(), rank, numG);
 
     // backward lu-sgs sweep
+#pragma omp parallel for schedule(dynamic) if (threadBlocks)
     for (auto bb = 0; bb < level.NumBlocks(); ++bb) {
-      this->LUSGS_Backward(level.Block(bb), reorder_[bb], phys, inp,
-                           this->AInv(bb), this->A(bb), ii, level.Forcing(bb),
-                           x_[bb]);
+      this->LUSGS_Backward(level.Block(bb), bb, reorder_[bb], planeStart_[bb],
+                           phys, inp, this->AInv(bb), this->A(bb), ii,
+                           level.Forcing(bb), x_[bb]);
     }
   }
 
@@ -470,11 +584,13 @@ vector<blkMultiArray3d<varArray>> lusgs::Relax(const gridLevel &level,
 }
 
 // function to calculate the implicit update via the DP-LUR method
-void dplur::DPLUR(const procBlock &blk, const physics &phys, const input &inp,
-                  const matMultiArray3d &aInv, const matMultiArray3d &a,
+void dplur::DPLUR(const procBlock &blk, const int &bb, const physics &phys,
+                  const input &inp, const matMultiArray3d &aInv,
+                  const matMultiArray3d &a,
                   const blkMultiArray3d<varArray> &forcing,
                   blkMultiArray3d<varArray> &x) const {
   // blk -- block to solve on
+  // bb -- index of block in grid level
   // phys --  physics models
   // inp -- all input variables
   // aInv -- inverse of main diagonal
@@ -485,12 +601,15 @@ void dplur::DPLUR(const procBlock &blk, const physics &phys, const input &inp,
   const auto thetaInv = 1.0 / inp.Theta();
   // copy old update
   const auto xold = x;
+#pragma omp parallel for collapse(2) schedule(static)
   for (auto kk = blk.StartK(); kk < blk.EndK(); ++kk) {
     for (auto jj = blk.StartJ(); jj < blk.EndJ(); ++jj) {
       for (auto ii = blk.StartI(); ii < blk.EndI(); ++ii) {
         // calculate off diagonal terms on the fly
-        auto offDiagonal = blk.ImplicitLower(ii, jj, kk, xold, phys, inp);
-        offDiagonal -= blk.ImplicitUpper(ii, jj, kk, xold, phys, inp);
+        auto offDiagonal =
+            this->ImplicitLower(blk, bb, ii, jj, kk, xold, phys, inp);
+        offDiagonal -=
+            this->ImplicitUpper(blk, bb, ii, jj, kk, xold, phys, inp);
         // calculate 'b' terms - these change at subiteration level
         const auto solDeltaNm1 = blk.SolDeltaNm1(ii, jj, kk, inp);
         const auto solDeltaMmN = blk.SolDeltaMmN(ii, jj, kk, inp, phys);
@@ -515,6 +634,13 @@ vector<blkMultiArray3d<varArray>> dplur::Relax(const gridLevel &level,
              "number of blocks mismatch");
   MSG_ASSERT(level.Block(0).NumCells() == this->A(0).NumBlocks(),
              "cell number mismatch");
+  // off diagonals are constant over all sweeps of a nonlinear iteration
+  this->CalcOffDiagonal(level, phys, inp);
+
+  // sweeps are threaded within each block, so only thread over blocks when
+  // there are enough of them to keep threads busy
+  const auto threadBlocks = level.ThreadOverBlocks();
+
   // start sweeps through domain
   const auto numG = level.Block(0).NumGhosts();
   for (auto ii = 0; ii < sweeps; ++ii) {
@@ -522,14 +648,621 @@ vector<blkMultiArray3d<varArray>> dplur::Relax(const gridLevel &level,
     this->SwapUpdate(level.Connections(), rank, numG);
 
     // dplur sweep
+#pragma omp parallel for schedule(dynamic) if (threadBlocks)
+    for (auto bb = 0; bb < level.NumBlocks(); ++bb) {
+      this->DPLUR(level.Block(bb), bb, phys, inp, this->AInv(bb),
+                  this->A(bb), level.Forcing(bb), x_[bb]);
+    }
+  }
+  // calculate matrix residual
+  // swap updates for ghost cells
+  this->SwapUpdate(level.Connections(), rank, numG);
+  auto matrixResid = this->Residual(level, phys, inp);
+  return matrixResid;
+}
+
+// constructor
+ilu::ilu(const input &inp, const gridLevel &level)
+    : linearSolver(inp, level) {
+  // calculate order by hyperplanes for each block
+  reorder_.resize(level.NumBlocks());
+  planeStart_.resize(level.NumBlocks());
+  for (auto bb = 0; bb < level.NumBlocks(); ++bb) {
+    const auto &blk = level.Block(bb);
+    reorder_[bb] = HyperplaneReorder(blk.NumI(), blk.NumJ(), blk.NumK());
+    planeStart_[bb] = HyperplaneOffsets(blk.NumI(), blk.NumJ(), blk.NumK());
+  }
+
+  if (inp.IsImplicit()) {
+    const fluxJacobian fluxJac(inp.NumFlowEquations(), inp.NumTurbEquations());
+    iluInv_.reserve(level.NumBlocks());
+    for (auto bb = 0; bb < level.NumBlocks(); ++bb) {
+      const auto &blk = level.Block(bb);
+      iluInv_.emplace_back(blk.NumI(), blk.NumJ(), blk.NumK(), 0, fluxJac);
+    }
+  } else {
+    iluInv_.resize(level.NumBlocks());
+  }
+}
+
+/* Member function to calculate the implicit update with a block incomplete
+LU factorization with zero fill in, ILU(0).
+
+The stored diagonal and the six stored off diagonal jacobians of each cell
+form the assembled first order implicit matrix A, which has a 7 point block
+stencil. ILU(0) approximates A by the product of lower and upper triangular
+factors that keep the sparsity of A.
+
+A ~= M = (D* - L) * D*^-1 * (D* + U)
+
+Here L and U are the off diagonals of A, and D* is the factored diagonal. For
+a 7 point stencil the only fill in that lands on the sparsity of A is on the
+diagonal, so only D* needs to be stored. It is calculated with the following
+recurrence, where the sum is over the lower neighbors of cell i.
+
+D*_i = D_i - (sum over j) L_ij * D*_j^-1 * U_ji
+
+Unlike LUSGS, the product of the factors accounts for the coupling between
+the lower and upper neighbors of each cell, so the linear system converges in
+fewer sweeps. The factorization and the triangular solves both only depend on
+the lower (or upper) neighbors, so they are level scheduled along the
+hyperplanes used by LUSGS, and the cells of each hyperplane are handled in
+parallel. Each sweep solves M * dx = r with the current matrix residual and
+adds dx to the update. The coupling across block boundaries is in the matrix
+residual, so the blocks are factored independently. The factorization is
+done once per nonlinear iteration when the off diagonals are calculated.
+*/
+vector<blkMultiArray3d<varArray>> ilu::Relax(const gridLevel &level,
+                                             const physics &phys,
+                                             const input &inp,
+                                             const int &rank,
+                                             const int &sweeps) {
+  MSG_ASSERT(level.NumBlocks() == this->NumBlocks(),
+             "number of blocks mismatch");
+  MSG_ASSERT(level.Block(0).NumCells() == this->A(0).NumBlocks(),
+             "cell number mismatch");
+
+  // factorization depends on the off diagonals, so it is redone when they are
+  // recalculated at the start of each nonlinear iteration
+  const auto isNewMatrix = !this->IsOffDiagonalStored();
+  this->CalcOffDiagonal(level, phys, inp);
+  if (isNewMatrix) {
+    this->Factor(level);
+  }
+
+  // start sweeps through domain
+  const auto numG = level.Block(0).NumGhosts();
+  for (auto ii = 0; ii < sweeps; ++ii) {
+    // swap updates for ghost cells
+    this->SwapUpdate(level.Connections(), rank, numG);
+
+    // correct update with solution of factored system
+    const auto matrixResid = this->Residual(level, phys, inp);
+    this->AddToUpdate(this->ApplyILU(level, phys, inp, matrixResid));
+  }
+
+  // calculate matrix residual
+  // swap updates for ghost cells
+  this->SwapUpdate(level.Connections(), rank, numG);
+  auto matrixResid = this->Residual(level, phys, inp);
+  return matrixResid;
+}
+
+// member function to calculate the factored diagonal of the block ILU(0)
+// factorization of the implicit matrix
+void ilu::Factor(const gridLevel &level) {
+  const auto threadBlocks = level.ThreadOverBlocks();
+#pragma omp parallel for schedule(dynamic) if (threadBlocks)
+  for (auto bb = 0; bb < level.NumBlocks(); ++bb) {
+    const auto &blk = level.Block(bb);
+    const auto &reorder = reorder_[bb];
+    const auto &planeStart = planeStart_[bb];
+    const auto numPlanes = static_cast<int>(planeStart.size()) - 1;
+    const vector3d<int> start(blk.StartI(), blk.StartJ(), blk.StartK());
+
+    // factored diagonal only depends on lower neighbors in previous
+    // hyperplanes
+#pragma omp parallel
+    for (auto pp = 0; pp < numPlanes; ++pp) {
+#pragma omp for schedule(static)
+      for (auto nn = planeStart[pp]; nn < planeStart[pp + 1]; ++nn) {
+        const auto ii = reorder[nn].X();
+        const auto jj = reorder[nn].Y();
+        const auto kk = reorder[nn].Z();
+
+        // lower neighbors across block boundaries are not part of factors
+        auto diag = this->A(bb).Jacobian(ii, jj, kk);
+        for (auto dd = 0; dd < 3; ++dd) {
+          if (reorder[nn][dd] == start[dd]) {
+            continue;
+          }
+          const auto pi = dd == 0 ? ii - 1 : ii;
+          const auto pj = dd == 1 ? jj - 1 : jj;
+          const auto pk = dd == 2 ? kk - 1 : kk;
+          diag += this->OffDiagonal(bb, dd).Jacobian(ii, jj, kk).MatMult(
+              iluInv_[bb].Jacobian(pi, pj, pk).MatMult(
+                  this->OffDiagonal(bb, dd + 3).Jacobian(pi, pj, pk)));
+        }
+        diag.Inverse();
+        iluInv_[bb].InsertJacobian(ii, jj, kk, diag);
+      }
+    }
+  }
+}
+
+// member function to solve the block ILU(0) factored system with forward and
+// backward substitution along hyperplanes
+vector<blkMultiArray3d<varArray>> ilu::ApplyILU(
+    const gridLevel &level, const physics &phys, const input &inp,
+    const vector<blkMultiArray3d<varArray>> &rhs) const {
+  // ghost cells of solution are zero, so off diagonals across block
+  // boundaries do not contribute
+  vector<blkMultiArray3d<varArray>> sol;
+  sol.reserve(rhs.size());
+  for (const auto &rb : rhs) {
+    sol.emplace_back(rb.NumINoGhosts(), rb.NumJNoGhosts(), rb.NumKNoGhosts(),
+                     rb.GhostLayers(), rb.BlockInfo());
+  }
+  const auto threadBlocks = level.ThreadOverBlocks();
+
+#pragma omp parallel for schedule(dynamic) if (threadBlocks)
+  for (auto bb = 0; bb < this->NumBlocks(); ++bb) {
+    const auto &blk = level.Block(bb);
+    const auto &reorder = reorder_[bb];
+    const auto &planeStart = planeStart_[bb];
+    const auto numPlanes = static_cast<int>(planeStart.size()) - 1;
+#pragma omp parallel
+    {
+      // forward substitution - (D* - L) * x* = rhs
+      for (auto pp = 0; pp < numPlanes; ++pp) {
+#pragma omp for schedule(static)
+        for (auto nn = planeStart[pp]; nn < planeStart[pp + 1]; ++nn) {
+          const auto ii = reorder[nn].X();
+          const auto jj = reorder[nn].Y();
+          const auto kk = reorder[nn].Z();
+          const auto L =
+              this->ImplicitLower(blk, bb, ii, jj, kk, sol[bb], phys, inp);
+          sol[bb].InsertBlock(
+              ii, jj, kk,
+              iluInv_[bb].ArrayMult(ii, jj, kk, L + rhs[bb](ii, jj, kk)));
+        }
+      }
+
+      // backward substitution - (D* + U) * x = D* * x*
+      for (auto pp = numPlanes - 1; pp >= 0; --pp) {
+#pragma omp for schedule(static)
+        for (auto nn = planeStart[pp]; nn < planeStart[pp + 1]; ++nn) {
+          const auto ii = reorder[nn].X();
+          const auto jj = reorder[nn].Y();
+          const auto kk = reorder[nn].Z();
+          const auto U =
+              this->ImplicitUpper(blk, bb, ii, jj, kk, sol[bb], phys, inp);
+          sol[bb].InsertBlock(ii, jj, kk,
+                              sol[bb].GetCopy(ii, jj, kk) -
+                                  iluInv_[bb].ArrayMult(ii, jj, kk, U));
+        }
+      }
+    }
+  }
+  return sol;
+}
+
+// constructor
+linesgs::linesgs(const input &inp, const gridLevel &level)
+    : linearSolver(inp, level) {
+  lineDir_.resize(level.NumBlocks());
+  lineOrder_.resize(level.NumBlocks());
+  lineStart_.resize(level.NumBlocks());
+  for (auto bb = 0; bb < level.NumBlocks(); ++bb) {
+    const auto &blk = level.Block(bb);
+    lineDir_[bb] = blk.WallNormalDirection();
+
+    // lines are indexed by the two directions normal to the line direction,
+    // and are ordered by hyperplanes in those directions
+    const auto numP = lineDir_[bb] == 0 ? blk.NumJ() : blk.NumI();
+    const auto numQ = lineDir_[bb] == 2 ? blk.NumJ() : blk.NumK();
+    lineOrder_[bb] = HyperplaneReorder(numP, numQ, 1);
+    lineStart_[bb] = HyperplaneOffsets(numP, numQ, 1);
+  }
+
+  if (inp.IsImplicit()) {
+    const fluxJacobian fluxJac(inp.NumFlowEquations(), inp.NumTurbEquations());
+    lineInv_.reserve(level.NumBlocks());
+    for (auto bb = 0; bb < level.NumBlocks(); ++bb) {
+      const auto &blk = level.Block(bb);
+      lineInv_.emplace_back(blk.NumI(), blk.NumJ(), blk.NumK(), 0, fluxJac);
+    }
+  } else {
+    lineInv_.resize(level.NumBlocks());
+  }
+  lineUpper_ = lineInv_;
+}
+
+/* Member function to calculate the implicit update with the line implicit
+Symmetric Gauss-Seidel method.
+
+On grids resolving a boundary layer the cells near the wall have very high
+aspect ratios. The off diagonal terms of A across the faces parallel to the
+wall then dominate the others, so point relaxation methods such as LUSGS and
+DPLUR converge slowly. This method instead solves for all cells along lines of
+constant index in the wall normal direction at once.
+
+(D + L_l + U_l) * x_l = b_l - L_o * x - U_o * x
+
+Here L_l and U_l are the off diagonals along the line, and L_o and U_o are
+the off diagonals in the other two directions, which are lagged on the right
+hand side. The left hand side is block tridiagonal and is solved exactly
+with the block Thomas algorithm. The lines are swept forward and then
+backward along hyperplanes of the other two directions, so neighboring lines
+use the latest update. Lines on the same hyperplane are independent and are
+solved in parallel.
+
+The line direction of each block is normal to its viscous walls. If there
+are no walls, the direction with the largest face areas is used. The block
+off diagonal jacobians are stored, and the lines are factored once per
+nonlinear iteration.
+*/
+vector<blkMultiArray3d<varArray>> linesgs::Relax(const gridLevel &level,
+                                                 const physics &phys,
+                                                 const input &inp,
+                                                 const int &rank,
+                                                 const int &sweeps) {
+  MSG_ASSERT(level.NumBlocks() == this->NumBlocks(),
+             "number of blocks mismatch");
+  MSG_ASSERT(level.Block(0).NumCells() == this->A(0).NumBlocks(),
+             "cell number mismatch");
+
+  // line factorization depends on the off diagonals, so it is redone when
+  // they are recalculated at the start of each nonlinear iteration
+  const auto isNewMatrix = !this->IsOffDiagonalStored();
+  this->CalcOffDiagonal(level, phys, inp);
+  if (isNewMatrix) {
+    this->FactorLines(level);
+  }
+
+  // sweeps are threaded within each block, so only thread over blocks when
+  // there are enough of them to keep threads busy
+  const auto threadBlocks = level.ThreadOverBlocks();
+
+  // start sweeps through domain
+  const auto numG = level.Block(0).NumGhosts();
+  for (auto ii = 0; ii < sweeps; ++ii) {
+    // swap updates for ghost cells
+    this->SwapUpdate(level.Connections(), rank, numG);
+
+    // forward line sweep
+#pragma omp parallel for schedule(dynamic) if (threadBlocks)
     for (auto bb = 0; bb < level.NumBlocks(); ++bb) {
-      this->DPLUR(level.Block(bb), phys, inp, this->AInv(bb), this->A(bb),
-                  level.Forcing(bb), x_[bb]);
+      this->LineSweep(level.Block(bb), bb, phys, inp, true, level.Forcing(bb),
+                      x_[bb]);
+    }
+
+    // swap updates for ghost cells
+    this->SwapUpdate(level.Connections(), rank, numG);
+
+    // backward line sweep
+#pragma omp parallel for schedule(dynamic) if (threadBlocks)
+    for (auto bb = 0; bb < level.NumBlocks(); ++bb) {
+      this->LineSweep(level.Block(bb), bb, phys, inp, false, level.Forcing(bb),
+                      x_[bb]);
     }
   }
+
   // calculate matrix residual
   // swap updates for ghost cells
   this->SwapUpdate(level.Connections(), rank, numG);
   auto matrixResid = this->Residual(level, phys, inp);
   return matrixResid;
 }
+
+// member function to return the cell indices of a given position along a line
+vector3d<int> linesgs::LineCell(const int &bb, const vector3d<int> &line,
+                                const int &pos) const {
+  if (lineDir_[bb] == 0) {
+    return {pos, line.X(), line.Y()};
+  } else if (lineDir_[bb] == 1) {
+    return {line.X(), pos, line.Y()};
+  } else {
+    return {line.X(), line.Y(), pos};
+  }
+}
+
+// member function to calculate the off diagonal terms that are not part of the
+// line solve; these come from the neighboring lines, and from across the block
+// boundaries at the ends of the line
+varArray linesgs::OffLine(const int &bb, const int &ii, const int &jj,
+                          const int &kk, const int &pos, const int &numCells,
+                          const blkMultiArray3d<varArray> &x,
+                          const input &inp) const {
+  varArray off(inp.NumEquations(), inp.NumSpecies());
+  for (auto dd = 0; dd < 3; ++dd) {
+    const auto isLine = dd == lineDir_[bb];
+    const auto di = dd == 0 ? 1 : 0;
+    const auto dj = dd == 1 ? 1 : 0;
+    const auto dk = dd == 2 ? 1 : 0;
+    if (!isLine || pos == 0) {
+      off += this->OffDiagonal(bb, dd).ArrayMult(ii, jj, kk,
+                                                 x(ii - di, jj - dj, kk - dk));
+    }
+    if (!isLine || pos == numCells - 1) {
+      off -= this->OffDiagonal(bb, dd + 3)
+                 .ArrayMult(ii, jj, kk, x(ii + di, jj + dj, kk + dk));
+    }
+  }
+  return off;
+}
+
+// member function to factor the block tridiagonal matrices along each line
+// with the forward elimination of the block Thomas algorithm
+void linesgs::FactorLines(const gridLevel &level) {
+  const auto threadBlocks = level.ThreadOverBlocks();
+#pragma omp parallel for schedule(dynamic) if (threadBlocks)
+  for (auto bb = 0; bb < level.NumBlocks(); ++bb) {
+    const auto &blk = level.Block(bb);
+    const auto dir = lineDir_[bb];
+    const auto &lower = this->OffDiagonal(bb, dir);
+    const auto &upper = this->OffDiagonal(bb, dir + 3);
+    const auto numCells =
+        dir == 0 ? blk.NumI() : (dir == 1 ? blk.NumJ() : blk.NumK());
+    const auto numLines = static_cast<int>(lineOrder_[bb].size());
+
+    // lines are independent
+#pragma omp parallel for schedule(static)
+    for (auto nn = 0; nn < numLines; ++nn) {
+      vector3d<int> prev;
+      for (auto cc = 0; cc < numCells; ++cc) {
+        const auto ind = this->LineCell(bb, lineOrder_[bb][nn], cc);
+        const auto ii = ind.X();
+        const auto jj = ind.Y();
+        const auto kk = ind.Z();
+
+        // eliminate lower off diagonal with previous cell on line
+        auto diag = this->A(bb).Jacobian(ii, jj, kk);
+        if (cc > 0) {
+          diag += lower.Jacobian(ii, jj, kk).MatMult(
+              lineUpper_[bb].Jacobian(prev.X(), prev.Y(), prev.Z()));
+        }
+        diag.Inverse();
+        lineUpper_[bb].InsertJacobian(
+            ii, jj, kk, diag.MatMult(upper.Jacobian(ii, jj, kk)));
+        lineInv_[bb].InsertJacobian(ii, jj, kk, diag);
+        prev = ind;
+      }
+    }
+  }
+}
+
+// member function to sweep over all lines of a block, solving each one with
+// the block Thomas algorithm
+void linesgs::LineSweep(const procBlock &blk, const int &bb,
+                        const physics &phys, const input &inp,
+                        const bool &isForward,
+                        const blkMultiArray3d<varArray> &forcing,
+                        blkMultiArray3d<varArray> &x) const {
+  // blk -- block to solve on
+  // bb -- index of block in grid level
+  // phys -- physics models
+  // inp -- all input variables
+  // isForward -- flag to sweep over lines in forward order
+  // forcing -- forcing term for rhs
+  // x -- variables to be solved for
+
+  const auto thetaInv = 1.0 / inp.Theta();
+  const auto dir = lineDir_[bb];
+  const auto &lower = this->OffDiagonal(bb, dir);
+  const auto numCells =
+      dir == 0 ? blk.NumI() : (dir == 1 ? blk.NumJ() : blk.NumK());
+  const auto &lineOrder = lineOrder_[bb];
+  const auto &lineStart = lineStart_[bb];
+
+  // lines on a hyperplane only depend on lines of other hyperplanes, so each
+  // hyperplane is split among threads with a barrier before the next one
+  const auto numPlanes = static_cast<int>(lineStart.size()) - 1;
+#pragma omp parallel
+  for (auto np = 0; np < numPlanes; ++np) {
+    const auto pp = isForward ? np : numPlanes - 1 - np;
+#pragma omp for schedule(static)
+    for (auto nn = lineStart[pp]; nn < lineStart[pp + 1]; ++nn) {
+      // forward elimination - intermediate solution is stored in x
+      vector3d<int> prev;
+      for (auto cc = 0; cc < numCells; ++cc) {
+        const auto ind = this->LineCell(bb, lineOrder[nn], cc);
+        const auto ii = ind.X();
+        const auto jj = ind.Y();
+        const auto kk = ind.Z();
+
+        // calculate 'b' terms - these change at subiteration level
+        const auto solDeltaNm1 = blk.SolDeltaNm1(ii, jj, kk, inp);
+        const auto solDeltaMmN = blk.SolDeltaMmN(ii, jj, kk, inp, phys);
+        auto rhs = -thetaInv * blk.Residual(ii, jj, kk) + forcing(ii, jj, kk) +
+                   solDeltaNm1 - solDeltaMmN +
+                   this->OffLine(bb, ii, jj, kk, cc, numCells, x, inp);
+        if (cc > 0) {
+          rhs += lower.ArrayMult(ii, jj, kk, x(prev.X(), prev.Y(), prev.Z()));
+        }
+        x.InsertBlock(ii, jj, kk, lineInv_[bb].ArrayMult(ii, jj, kk, rhs));
+        prev = ind;
+      }
+
+      // back substitution
+      for (auto cc = numCells - 2; cc >= 0; --cc) {
+        const auto ind = this->LineCell(bb, lineOrder[nn], cc);
+        const auto ii = ind.X();
+        const auto jj = ind.Y();
+        const auto kk = ind.Z();
+        const auto next = this->LineCell(bb, lineOrder[nn], cc + 1);
+        x.InsertBlock(ii, jj, kk,
+                      x.GetCopy(ii, jj, kk) -
+                          lineUpper_[bb].ArrayMult(
+                              ii, jj, kk, x(next.X(), next.Y(), next.Z())));
+      }
+    }
+  }
+}
+
+/* Function to solve a linear system with the Generalized Minimal RESidual
+(GMRES) method.
+
+GMRES builds an orthonormal basis of the Krylov subspace from the right hand
+side, and chooses the solution in this subspace that minimizes the norm of the
+residual. Only products of the matrix with a vector are needed, so the matrix
+does not need to be formed. The Krylov vectors are right preconditioned, so
+that the residual minimized is that of the unpreconditioned system. The
+preconditioned vectors are stored (flexible GMRES), so the preconditioner does
+not need to be linear. The initial guess is zero, and the iteration stops when
+the residual norm is reduced by the given tolerance or the maximum number of
+vectors is reached. The inner products are global over all processors.
+*/
+vector<blkMultiArray3d<varArray>> Gmres(
+    const vector<blkMultiArray3d<varArray>> &rhs,
+    const krylovOperator &matVec, const krylovOperator &precondition,
+    const int &maxVecs, const double &tol,
+    vector<blkMultiArray3d<varArray>> &resid) {
+  // rhs -- right hand side of linear system
+  // matVec -- product of matrix with a vector
+  // precondition -- approximate solution of linear system with a vector as
+  //                 its right hand side
+  // maxVecs -- maximum number of krylov vectors
+  // tol -- relative reduction in residual norm to stop at
+  // resid -- residual of linear system at solution
+
+  vector<blkMultiArray3d<varArray>> sol;
+  sol.reserve(rhs.size());
+  for (const auto &rb : rhs) {
+    sol.emplace_back(rb.NumINoGhosts(), rb.NumJNoGhosts(), rb.NumKNoGhosts(),
+                     rb.GhostLayers(), rb.BlockInfo());
+  }
+  resid = rhs;
+  const auto beta = sqrt(KrylovDot(rhs, rhs));
+  if (beta == 0.0) {
+    return sol;
+  }
+
+  // krylov basis, preconditioned basis, hessenberg matrix, givens rotations
+  vector<vector<blkMultiArray3d<varArray>>> v, z;
+  v.reserve(maxVecs + 1);
+  z.reserve(maxVecs);
+  vector<vector<double>> h(maxVecs + 1, vector<double>(maxVecs, 0.0));
+  vector<double> cs(maxVecs, 0.0), sn(maxVecs, 0.0), g(maxVecs + 1, 0.0);
+  g[0] = beta;
+
+  v.push_back(rhs);
+  for (auto &vb : v[0]) {
+    vb *= 1.0 / beta;
+  }
+
+  // unrotated hessenberg matrix is kept to calculate the final residual
+  auto hOrig = h;
+  auto numVecs = 0;
+  for (auto jj = 0; jj < maxVecs; ++jj) {
+    // precondition the krylov vector scaled to the size of the right hand
+    // side, so the preconditioner sees a vector of physical size
+    auto scaledV = v[jj];
+    for (auto &sv : scaledV) {
+      sv *= beta;
+    }
+    z.push_back(precondition(scaledV));
+    for (auto &zb : z[jj]) {
+      zb *= 1.0 / beta;
+    }
+    auto w = matVec(z[jj]);
+
+    // modified gram-schmidt orthogonalization
+    for (auto ii = 0; ii <= jj; ++ii) {
+      h[ii][jj] = KrylovDot(w, v[ii]);
+      for (auto bb = 0U; bb < w.size(); ++bb) {
+        w[bb] -= h[ii][jj] * v[ii][bb];
+      }
+    }
+    h[jj + 1][jj] = sqrt(KrylovDot(w, w));
+    for (auto ii = 0; ii <= jj + 1; ++ii) {
+      hOrig[ii][jj] = h[ii][jj];
+    }
+
+    // apply previous rotations to new column of hessenberg matrix
+    for (auto ii = 0; ii < jj; ++ii) {
+      const auto temp = cs[ii] * h[ii][jj] + sn[ii] * h[ii + 1][jj];
+      h[ii + 1][jj] = -sn[ii] * h[ii][jj] + cs[ii] * h[ii + 1][jj];
+      h[ii][jj] = temp;
+    }
+
+    // calculate new rotation to eliminate subdiagonal
+    const auto denom = sqrt(h[jj][jj] * h[jj][jj] +
+                            h[jj + 1][jj] * h[jj + 1][jj]);
+    cs[jj] = h[jj][jj] / denom;
+    sn[jj] = h[jj + 1][jj] / denom;
+    const auto hNext = h[jj + 1][jj];
+    h[jj][jj] = denom;
+    h[jj + 1][jj] = 0.0;
+    g[jj + 1] = -sn[jj] * g[jj];
+    g[jj] *= cs[jj];
+    numVecs = jj + 1;
+
+    // exact solution found in current subspace
+    if (hNext == 0.0) {
+      break;
+    }
+    for (auto &wb : w) {
+      wb *= 1.0 / hNext;
+    }
+    v.push_back(std::move(w));
+
+    // residual reduced enough
+    if (std::abs(g[jj + 1]) <= tol * beta) {
+      break;
+    }
+  }
+
+  // solve upper triangular system for coefficients of krylov vectors
+  vector<double> y(numVecs, 0.0);
+  for (auto ii = numVecs - 1; ii >= 0; --ii) {
+    y[ii] = g[ii];
+    for (auto kk = ii + 1; kk < numVecs; ++kk) {
+      y[ii] -= h[ii][kk] * y[kk];
+    }
+    y[ii] /= h[ii][ii];
+  }
+
+  // solution is combination of preconditioned vectors, and residual is
+  // rhs - A * sol = rhs - V * H * y
+  for (auto jj = 0; jj < numVecs; ++jj) {
+    for (auto bb = 0U; bb < sol.size(); ++bb) {
+      sol[bb] += y[jj] * z[jj][bb];
+    }
+  }
+  for (auto ii = 0U; ii < v.size(); ++ii) {
+    auto coeff = 0.0;
+    for (auto jj = 0; jj < numVecs; ++jj) {
+      coeff += hOrig[ii][jj] * y[jj];
+    }
+    for (auto bb = 0U; bb < resid.size(); ++bb) {
+      resid[bb] -= coeff * v[ii][bb];
+    }
+  }
+  return sol;
+}
+
+// function to calculate the inner product of two vectors over the physical
+// cells of all blocks on all processors
+double KrylovDot(const vector<blkMultiArray3d<varArray>> &a,
+                 const vector<blkMultiArray3d<varArray>> &b) {
+  MSG_ASSERT(a.size() == b.size(), "vector size mismatch");
+  auto dot = 0.0;
+  const auto numBlks = static_cast<int>(a.size());
+  for (auto bb = 0; bb < numBlks; ++bb) {
+#pragma omp parallel for collapse(2) schedule(static) reduction(+ : dot)
+    for (auto kk = a[bb].PhysStartK(); kk < a[bb].PhysEndK(); ++kk) {
+      for (auto jj = a[bb].PhysStartJ(); jj < a[bb].PhysEndJ(); ++jj) {
+        for (auto ii = a[bb].PhysStartI(); ii < a[bb].PhysEndI(); ++ii) {
+          const auto ab = a[bb](ii, jj, kk);
+          const auto bv = b[bb](ii, jj, kk);
+          for (auto vv = 0; vv < ab.Size(); ++vv) {
+            dot += ab[vv] * bv[vv];
+          }
+        }
+      }
+    }
+  }
+  MPI_Allreduce(MPI_IN_PLACE, &dot, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+  return dot;
+}
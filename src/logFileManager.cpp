@@ -23,6 +23,7 @@
 #include "input.hpp"
 #include "output.hpp"
 #include "resid.hpp"
+#include "wallData.hpp"
 #include "varArray.hpp"
 #include "macros.hpp"
 
@@ -60,6 +61,26 @@ logFileManager::logFileManager(const input &inp, const int &rank)
   }
   time_ << std::left << std::setw(7) << "Step" << std::setw(16) << "Iter-Time"
         << std::setw(16) << "Sim-Time" << endl;
+
+  // open wall loads file
+  if (inp.WallLoads()) {
+    if (inp.IsRestart()) {
+      loads_.open(inp.SimNameRoot() + ".loads", std::ios::app);
+    } else {
+      loads_.open(inp.SimNameRoot() + ".loads", std::ios::out);
+    }
+    if (loads_.fail()) {
+      cerr << "ERROR: Could not open wall loads file!" << endl;
+      exit(EXIT_FAILURE);
+    }
+    loads_ << std::left << std::setw(7) << "Step" << std::setw(8) << "NL-Iter";
+    for (auto &name : {"Fp-X", "Fp-Y", "Fp-Z", "Fv-X", "Fv-Y", "Fv-Z", "M-X",
+                       "M-Y", "M-Z", "Heat-Rate", "CF-X", "CF-Y", "CF-Z",
+                       "CM-X", "CM-Y", "CM-Z"}) {
+      loads_ << std::setw(12) << name;
+    }
+    loads_ << endl;
+  }
 }
 
 // destructor
@@ -69,6 +90,46 @@ logFileManager::~logFileManager() {
   }
   resid_.close();
   time_.close();
+  if (loads_.is_open()) {
+    loads_.close();
+  }
+}
+
+// function to write out dimensional wall loads and coefficients
+void logFileManager::WriteLoads(const input &inp, const wallLoads &loads,
+                                const int &nn, const int &mm) {
+  if (rank_ != ROOTP || !loads_.is_open()) {
+    return;
+  }
+
+  // viscous stresses are nondimensionalized like pressure, and heat flux like
+  // the energy flux
+  const auto lRef = inp.LRef();
+  const auto forceRef = inp.RRef() * inp.ARef() * inp.ARef() * lRef * lRef;
+  const auto heatRef = forceRef * inp.ARef();
+  const auto pressureForce = loads.PressureForce() * forceRef;
+  const auto viscousForce = loads.ViscousForce() * forceRef;
+  const auto moment = loads.Moment() * forceRef * lRef;
+
+  // coefficients use reference density, velocity, and area
+  const auto vRef = inp.ReferenceVelocity();
+  const auto qRef = 0.5 * inp.RRef() * vRef * vRef * inp.ReferenceArea();
+  const auto forceCoeff = (pressureForce + viscousForce) / qRef;
+  const auto momentCoeff = moment / (qRef * inp.MomentReferenceLength());
+
+  loads_ << std::left << std::setw(7) << nn << std::setw(8) << mm
+         << std::setprecision(4) << std::scientific;
+  for (auto &vec : {pressureForce, viscousForce, moment}) {
+    loads_ << std::setw(12) << vec.X() << std::setw(12) << vec.Y()
+           << std::setw(12) << vec.Z();
+  }
+  loads_ << std::setw(12) << loads.HeatFlux() * heatRef;
+  for (auto &vec : {forceCoeff, momentCoeff}) {
+    loads_ << std::setw(12) << vec.X() << std::setw(12) << vec.Y()
+           << std::setw(12) << vec.Z();
+  }
+  loads_ << endl;
+  loads_.unsetf(std::ios::fixed | std::ios::scientific);
 }
 
 // function to write out residual information
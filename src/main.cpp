@@ -26,6 +26,10 @@
 #include <xmmintrin.h>
 #endif
 
+#ifdef _OPENMP
+#include <omp.h>         // omp_get_max_threads
+#endif
+
 #include "plot3d.hpp"
 #include "vector3d.hpp"
 #include "input.hpp"
@@ -41,11 +45,15 @@
 #include "resid.hpp"
 #include "multiArray3d.hpp"
 #include "kdtree.hpp"
+#include "geometryCache.hpp"
 #include "fluxJacobian.hpp"
 #include "utility.hpp"
 #include "matMultiArray3d.hpp"
 #include "mgSolution.hpp"
 #include "logFileManager.hpp"
+#include "outputManager.hpp"
+#include "checkpointManager.hpp"
+#include "sampling.hpp"
 
 using std::cout;
 using std::cerr;
@@ -57,10 +65,18 @@ int main(int argc, char *argv[]) {
   // of processors and rank of each processor
   auto numProcs = 1;
   auto rank = 0;
-  MPI_Init(&argc, &argv);
+  // blocks on each processor may be processed by multiple threads, but only
+  // the main thread makes MPI calls
+  int threadSupport = MPI_THREAD_SINGLE;
+  MPI_Init_thread(&argc, &argv, MPI_THREAD_FUNNELED, &threadSupport);
   MPI_Comm_size(MPI_COMM_WORLD, &numProcs);
   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
 
+  auto numThreads = 1;
+#ifdef _OPENMP
+  numThreads = omp_get_max_threads();
+#endif
+
   // Get MPI version
   auto version = 3;
   auto subversion = 0;
@@ -71,6 +87,11 @@ int main(int argc, char *argv[]) {
     cout << "Compiled on " << __DATE__ << " at " << __TIME__ << endl;
     cout << "Using MPI Version " << version << "." << subversion << endl;
     cout << "Using " << numProcs << " processors" << endl;
+    cout << "Using " << numThreads << " threads per processor" << endl;
+    if (numThreads > 1 && threadSupport < MPI_THREAD_FUNNELED) {
+      cerr << "WARNING: MPI library does not support MPI_THREAD_FUNNELED"
+           << endl;
+    }
   }
   MPI_Barrier(MPI_COMM_WORLD);
 
@@ -100,11 +121,22 @@ int main(int argc, char *argv[]) {
   auto totalCells = 0.0;
   input inp(inputFile, restartFile);
   decomposition decomp;
-  auto numProcBlock = 0;
 
   // Parse input file
   inp.ReadInput(rank);
   logFileManager logs(inp, rank);
+  outputManager outputs(inp, rank);
+  checkpointManager checkpoints(rank);
+
+  // With checkpoints, nonphysical values are detected after each iteration
+  // and the solution is rolled back, so the solver must not stop on a NAN
+  if (inp.IsCheckpointing()) {
+#ifdef __linux__
+    fedisableexcept(FE_DIVBYZERO | FE_INVALID);
+#elif __APPLE__
+    _MM_SET_EXCEPTION_MASK(_MM_GET_EXCEPTION_MASK() | _MM_MASK_INVALID);
+#endif
+  }
 
   // nondimensionalize fluid data
   inp.NondimensionalizeFluid();
@@ -115,61 +147,110 @@ int main(int argc, char *argv[]) {
   // Nondimensionalize BC & IC data
   inp.NondimensionalizeStateData(phys.EoS());
 
-  mgSolution solution;  // only keep finest grid level globally
-  vector<vector3d<double>> viscFaces;
+  vector<boundaryConditions> bcs;
+  vector<connection> connections;
+  vector<vector3d<int>> gridSizes;
+  uint64_t geomHash = 0;
+  auto isCached = 0;
+
+  // Set MPI datatypes
+  MPI_Datatype MPI_vec3d, MPI_procBlockInts, MPI_connection, MPI_DOUBLE_5INT,
+      MPI_vec3dMag, MPI_uncoupledScalar, MPI_tensorDouble;
+  SetDataTypesMPI(MPI_vec3d, MPI_procBlockInts, MPI_connection, MPI_DOUBLE_5INT,
+                  MPI_vec3dMag, MPI_uncoupledScalar, MPI_tensorDouble);
+
+  // checksum of grid file contents is part of the geometry cache key
+  const auto gridChecksum =
+      inp.GeometryCache() ? GridFileChecksum(inp.GridName(), rank, numProcs)
+                          : 0;
 
   if (rank == ROOTP) {
     cout << "Number of equations: " << inp.NumEquations() << endl << endl;
 
-    // Read grid
-    auto mesh = ReadP3dGrid(inp.GridName(), inp.LRef(), totalCells);
+    // Read grid file header
+    // coordinates are only read from the grid file where they are needed
+    const plot3dFile gridFile(inp.GridName(), inp.LRef());
+    // get original grid sizes (before decomposition)
+    gridSizes = gridFile.BlockSizes();
+    totalCells = gridFile.NumCells();
     // Get BCs for blocks
-    auto bcs = inp.AllBC();
-
-    // Decompose grid
-    if (inp.DecompMethod() == "manual") {
-      decomp = ManualDecomposition(mesh, bcs, numProcs);
-    } else if (inp.DecompMethod() == "cubic") {
-      decomp = CubicDecomposition(mesh, bcs, numProcs);
-    } else {
-      cerr << "ERROR: Domain decomposition method " << inp.DecompMethod()
-           << " is not recognized!" << endl;
-      exit(EXIT_FAILURE);
+    bcs = inp.AllBC();
+
+    // reuse decomposition and connections from a previous run with the same
+    // geometry
+    if (inp.GeometryCache()) {
+      geomHash = GeometryHash(gridChecksum, gridSizes, bcs, inp, numProcs);
+      isCached = ReadGeometryCacheSetup(inp.GeometryCacheName(), geomHash,
+                                        decomp, bcs, connections,
+                                        MPI_connection);
+      if (isCached) {
+        cout << "Decomposition and connections read from geometry cache "
+             << inp.GeometryCacheName() << endl << endl;
+      } else {
+        bcs = inp.AllBC();
+      }
     }
 
-    solution.ConstructFinestLevel(mesh, bcs, decomp, phys, restartFile, inp,
-                                  logs.L2First());
-
-    // Get face centers of faces with viscous wall BC
-    viscFaces = GetViscousFaceCenters(solution.Finest().Blocks());
+    if (!isCached) {
+      // the grid is decomposed from the block dimensions, and the connection
+      // boundaries are matched from the corners of their patches; each
+      // processor reads its own blocks below
+      auto mesh = gridFile.Blocks();
+
+      // Decompose grid
+      if (inp.DecompMethod() == "manual") {
+        decomp = ManualDecomposition(mesh, bcs, numProcs);
+      } else if (inp.DecompMethod() == "cubic") {
+        decomp = CubicDecomposition(mesh, bcs, numProcs);
+      } else {
+        cerr << "ERROR: Domain decomposition method " << inp.DecompMethod()
+             << " is not recognized!" << endl;
+        exit(EXIT_FAILURE);
+      }
 
-    cout << "Solution Initialized" << endl << endl;
-    //---------------------------------------------------------------------
+      connections = GetConnectionBCs(bcs, mesh, decomp, inp);
+    }
   }
 
-  // Set MPI datatypes
-  MPI_Datatype MPI_vec3d, MPI_procBlockInts, MPI_connection, MPI_DOUBLE_5INT,
-      MPI_vec3dMag, MPI_uncoupledScalar, MPI_tensorDouble;
-  SetDataTypesMPI(MPI_vec3d, MPI_procBlockInts, MPI_connection, MPI_DOUBLE_5INT,
-                  MPI_vec3dMag, MPI_uncoupledScalar, MPI_tensorDouble);
-
   // Broadcast decomposition to all processors
   decomp.Broadcast();
-
-  // Send number of procBlocks to all processors
-  SendNumProcBlocks(decomp.NumBlocksOnAllProc(), numProcBlock);
-
-  // Send finest gridLevel to appropriate processor
-  auto localSolution = solution.SendFinestGridLevel(
-      rank, numProcBlock, MPI_vec3d, MPI_vec3dMag, MPI_connection, inp);
+  BroadcastGridSizes(gridSizes);
+  BroadcastConnections(connections, MPI_connection);
+  MPI_Bcast(&geomHash, 1, MPI_UINT64_T, ROOTP, MPI_COMM_WORLD);
+  MPI_Bcast(&isCached, 1, MPI_INT, ROOTP, MPI_COMM_WORLD);
+
+  // Send BCs to appropriate processor
+  const auto localBCs = ScatterBCs(bcs, decomp, rank);
+
+  // Read portion of grid on each processor and construct finest gridLevel
+  mgSolution localSolution(inp);
+  {
+    vector<plot3dBlock> localMesh;
+    if (isCached) {
+      isCached = ReadGeometryCacheMesh(inp.GeometryCacheName(), gridSizes,
+                                       decomp, rank, localMesh);
+      if (!isCached && rank == ROOTP) {
+        cerr << "WARNING: Geometry cache " << inp.GeometryCacheName()
+             << " could not be read, grid is read from grid file" << endl;
+      }
+    }
+    if (!isCached) {
+      localMesh = ReadP3dGridPar(inp.GridName(), inp.LRef(), gridSizes,
+                                 decomp, rank);
+    }
+    localSolution.ConstructFinestLevel(
+        localMesh, localBCs, connections, decomp, phys, gridSizes, restartFile,
+        inp, logs.L2First(), rank, MPI_vec3d, MPI_vec3dMag);
+  }
   localSolution.ConstructMultigrids(decomp, inp, phys, rank, MPI_connection,
                                     MPI_vec3d, MPI_vec3dMag);
 
   // Update auxillary variables (temperature, viscosity, etc), cell widths
   localSolution.AuxillaryAndWidths(phys);
 
-  // Broadcast viscous face centers to all processors
-  BroadcastViscFaces(MPI_vec3d, viscFaces);
+  if (rank == ROOTP) {
+    cout << "Solution Initialized" << endl << endl;
+  }
 
   // Create operation
   MPI_Op MPI_MAX_LINF;
@@ -181,26 +262,56 @@ int main(int argc, char *argv[]) {
 
   const auto wallStart = std::chrono::high_resolution_clock::now();
 
-  if (rank == ROOTP) {
-    cout << "Starting wall distance calculation..." << endl;
-    cout << "Building k-d tree..." << endl;
+  // reuse wall distances from a previous run with the same geometry
+  if (isCached) {
+    isCached = ReadGeometryCacheWallDist(inp.GeometryCacheName(),
+                                         localSolution, rank);
+    if (rank == ROOTP) {
+      if (isCached) {
+        cout << "Wall distances read from geometry cache "
+             << inp.GeometryCacheName() << endl;
+      } else {
+        cerr << "WARNING: Geometry cache " << inp.GeometryCacheName()
+             << " could not be read, wall distances are recomputed" << endl;
+      }
+    }
   }
+  if (!isCached) {
+    if (rank == ROOTP) {
+      cout << "Starting wall distance calculation..." << endl;
+      cout << "Building k-d tree..." << endl;
+    }
 
-  // Construct k-d tree for wall distance calculation
-  // Using finest grid level faces for all levels
-  kdtree tree(viscFaces);
+    // Get face centers of faces with viscous wall BC on all processors
+    auto viscFaces = GetViscousFaceCenters(localSolution.Finest().Blocks());
+    AllGatherViscFaces(MPI_vec3d, viscFaces);
 
-  if (rank == ROOTP) {
-    const auto kdEnd = std::chrono::high_resolution_clock::now();
-    const std::chrono::duration<double> kdDuration = kdEnd - wallStart;
-    cout << "K-d tree complete after " << kdDuration.count() << " seconds"
-         << endl;
-  }
+    // Construct k-d tree for wall distance calculation
+    // Using finest grid level faces for all levels
+    kdtree tree(viscFaces);
 
-  if (tree.Size() > 0) {
-    localSolution.CalcWallDistance(tree);
-    localSolution.SwapWallDist(rank, inp.NumberGhostLayers());
+    if (rank == ROOTP) {
+      const auto kdEnd = std::chrono::high_resolution_clock::now();
+      const std::chrono::duration<double> kdDuration = kdEnd - wallStart;
+      cout << "K-d tree complete after " << kdDuration.count() << " seconds"
+           << endl;
+    }
+
+    if (tree.Size() > 0) {
+      localSolution.CalcWallDistance(tree);
+      localSolution.SwapWallDist(rank, inp.NumberGhostLayers());
+    }
+
+    if (inp.GeometryCache()) {
+      WriteGeometryCache(inp.GeometryCacheName(), geomHash, decomp, bcs,
+                         connections, localSolution, rank, MPI_connection);
+      if (rank == ROOTP) {
+        cout << "Geometry written to geometry cache "
+             << inp.GeometryCacheName() << endl;
+      }
+    }
   }
+  bcs.clear();
 
   MPI_Barrier(MPI_COMM_WORLD);
   if (rank == ROOTP) {
@@ -210,18 +321,31 @@ int main(int argc, char *argv[]) {
          << " seconds" << endl << endl;
   }
 
-  //-----------------------------------------------------------------------
-  // Send/recv solutions - necessary to get wall distances
-  solution.GetFinestGridLevel(localSolution, rank, MPI_uncoupledScalar,
-                              MPI_vec3d, MPI_tensorDouble, inp);
-
-  if (rank == ROOTP) {
-    // Write out cell centers grid file
-    WriteCellCenter(inp.GridName(), solution.Finest().Blocks(), decomp, inp);
+  // Locate sampled cells on each processor
+  sampleManager samples(inp, phys, localSolution.Finest(), decomp, gridSizes,
+                        rank);
 
-    // Write out initial results
-    WriteOutput(solution.Finest().Blocks(), phys, inp.IterationStart(), decomp,
-                inp);
+  //-----------------------------------------------------------------------
+  if (inp.IsVtkOutput()) {
+    // Write out initial results - each processor writes its own blocks
+    outputs.WriteVtkOutput(localSolution.Finest().Blocks(), phys,
+                           inp.IterationStart(), decomp, inp, gridSizes);
+  } else {
+    // Gather finest gridLevel on ROOT only while the output is written
+    auto solution = localSolution.GatherFinestGridLevel(
+        decomp, rank, MPI_vec3d, MPI_vec3dMag, inp);
+    // Send/recv solutions - necessary to get wall distances
+    solution.GetFinestGridLevel(localSolution, rank, MPI_uncoupledScalar,
+                                MPI_vec3d, MPI_tensorDouble, inp);
+
+    if (rank == ROOTP) {
+      // Write out cell centers grid file
+      WriteCellCenter(inp.GridName(), solution.Finest().Blocks(), decomp, inp);
+
+      // Write out initial results
+      WriteOutput(solution.Finest().Blocks(), phys, inp.IterationStart(),
+                  decomp, inp);
+    }
   }
 
   // ----------------------------------------------------------------------
@@ -232,6 +356,11 @@ int main(int argc, char *argv[]) {
     MPI_Barrier(MPI_COMM_WORLD);
     logs.GetIterStart();
 
+    // Store in-memory checkpoint of solution
+    if (inp.WriteCheckpoint(nn)) {
+      checkpoints.Store(localSolution.Finest(), nn);
+    }
+
     // Calculate cfl number
     inp.CalcCFL(nn);
 
@@ -274,33 +403,71 @@ int main(int argc, char *argv[]) {
         logs.WriteResiduals(inp, residL2, residLinf, matrixResid,
                             nn + inp.IterationStart(), mm);
       }
+
+      // Integrate loads on viscous walls
+      if (inp.WallLoads()) {
+        auto loads = localSolution.Finest().WallLoads(
+            phys, inp.MomentReferencePoint() / inp.LRef());
+        loads.GlobalReduceMPI(rank);
+        logs.WriteLoads(inp, loads, nn + inp.IterationStart(), mm);
+      }
     }  // loop for nonlinear iterations ---------------------------------------
 
-    // write out function file
-    if (inp.WriteOutput(nn) || inp.WriteRestart(nn)) {
-      // Send/recv solutions
-      solution.GetFinestGridLevel(localSolution, rank, MPI_uncoupledScalar,
-                                  MPI_vec3d, MPI_tensorDouble, inp);
+    // roll back to last checkpoint if solution has become nonphysical
+    if (inp.IsCheckpointing() &&
+        !checkpoints.IsSolutionPhysical(localSolution.Finest())) {
+      nn = checkpoints.Rollback(localSolution[localSolution.FinestIndex()],
+                                inp, phys) - 1;
+      continue;
+    }
 
-      if (rank == ROOTP && inp.WriteOutput(nn)) {
+    // write out samples
+    if (inp.WriteSamples(nn)) {
+      samples.Write(localSolution.Finest(), inp, nn + inp.IterationStart() + 1);
+    }
+
+    // write out function file
+    if (inp.WriteOutput(nn)) {
+      if (rank == ROOTP) {
         cout << "writing out function file at iteration "
              << nn + inp.IterationStart()<< endl;
-        // Write out function file
-        WriteOutput(solution.Finest().Blocks(), phys,
-                    (nn + inp.IterationStart() + 1), decomp, inp);
       }
-      if (rank == ROOTP && inp.WriteRestart(nn)) {
+      if (inp.IsVtkOutput()) {
+        // each processor writes its own blocks
+        outputs.WriteVtkOutput(localSolution.Finest().Blocks(), phys,
+                               (nn + inp.IterationStart() + 1), decomp, inp,
+                               gridSizes);
+      } else {
+        // Gather finest gridLevel on ROOT only while the output is written
+        auto solution = localSolution.GatherFinestGridLevel(
+            decomp, rank, MPI_vec3d, MPI_vec3dMag, inp);
+        // Send/recv solutions
+        solution.GetFinestGridLevel(localSolution, rank, MPI_uncoupledScalar,
+                                    MPI_vec3d, MPI_tensorDouble, inp);
+
+        if (rank == ROOTP) {
+          // Write out function file
+          outputs.WriteOutput(solution.Finest().Blocks(), phys,
+                              (nn + inp.IterationStart() + 1), decomp, inp);
+        }
+      }
+    }
+    // write out restart file - each processor writes its own blocks
+    if (inp.WriteRestart(nn)) {
+      if (rank == ROOTP) {
         cout << "writing out restart file at iteration "
              << nn + inp.IterationStart()<< endl;
-        // Write out restart file
-        WriteRestart(solution.Finest().Blocks(), phys,
-                     (nn + inp.IterationStart() + 1), decomp, inp,
-                     logs.L2First());
       }
+      outputs.WriteRestart(localSolution.Finest().Blocks(), phys,
+                           (nn + inp.IterationStart() + 1), decomp, inp,
+                           logs.L2First(), gridSizes);
     }
     logs.WriteTime(nn);
   }  // loop for time step -----------------------------------------------------
 
+  // wait for any output still being written
+  outputs.Finish();
+
   if (rank == ROOTP) {
     cout << endl << "Program Complete" << endl;
     PrintTime();
@@ -25,6 +25,7 @@
 #include "plot3d.hpp"
 #include "physicsModels.hpp"
 #include "output.hpp"
+#include "linearSolver.hpp"
 #include "resid.hpp"
 #include "vector3d.hpp"
 #include "macros.hpp"
@@ -43,33 +44,27 @@ mgSolution::mgSolution(const int &numLevels, const int &cycle) {
 // member functions
 void mgSolution::ConstructFinestLevel(
     const vector<plot3dBlock>& mesh, const vector<boundaryConditions>& bcs,
-    const decomposition& decomp, const physics& phys,
-   const string& restartFile,
-    input& inp, residual& first) {
+    const vector<connection>& connections, const decomposition& decomp,
+    const physics& phys, const vector<vector3d<int>>& gridSizes,
+    const string& restartFile, input& inp, residual& first, const int& rank,
+    const MPI_Datatype& MPI_vec3d, const MPI_Datatype& MPI_vec3dMag) {
   MSG_ASSERT(solution_.size() == 0U,
              "should only be called once to initialize");
-  // inputs correspond to finest mesh
-  // get original grid sizes (before decomposition)
-  vector<vector3d<int>> gridSizes;
-  gridSizes.reserve(mesh.size());
-  for (const auto& msh : mesh) {
-    gridSizes.emplace_back(msh.NumCellsI(), msh.NumCellsJ(), msh.NumCellsK());
-  }
-
-  solution_.emplace_back(mesh, bcs, decomp, phys, gridSizes, restartFile, inp,
-                         first);
+  // inputs correspond to blocks of finest mesh on this processor
+  solution_.emplace_back(mesh, bcs, connections, decomp, phys, gridSizes,
+                         restartFile, inp, first, rank, MPI_vec3d,
+                         MPI_vec3dMag);
 }
 
-mgSolution mgSolution::SendFinestGridLevel(const int& rank,
-                                           const int& numProcBlock,
-                                           const MPI_Datatype& MPI_vec3d,
-                                           const MPI_Datatype& MPI_vec3dMag,
-                                           const MPI_Datatype& MPI_connection,
-                                           const input& inp) const {
-  mgSolution local(inp);
-  local.solution_.emplace_back(this->Finest().SendGridLevel(
-      rank, numProcBlock, MPI_vec3d, MPI_vec3dMag, MPI_connection, inp));
-  return local;
+mgSolution mgSolution::GatherFinestGridLevel(const decomposition& decomp,
+                                             const int& rank,
+                                             const MPI_Datatype& MPI_vec3d,
+                                             const MPI_Datatype& MPI_vec3dMag,
+                                             const input& inp) const {
+  mgSolution global(1, mgCycleIndex_);
+  global.solution_.emplace_back(this->Finest().GatherGridLevel(
+      decomp, rank, MPI_vec3d, MPI_vec3dMag, inp));
+  return global;
 }
 
 void mgSolution::GetFinestGridLevel(const mgSolution& local, const int& rank,
@@ -206,6 +201,103 @@ double mgSolution::CycleAtLevel(const int& fl, const int& mm,
   return l2Resid / totalSize;
 }
 
+/* Function to solve the implicit system with jacobian free newton krylov. The
+krylov solver is gmres, and the matrix is only applied through finite
+difference products of the residual. The gmres solver is preconditioned with
+the multigrid cycle of the relaxation solver. The preconditioner approximately
+solves A * x = v by using v - b as the forcing on the finest level, because the
+relaxation solvers solve A * x = b + forcing.
+
+The momentum equations in the out of plane direction of a 2D case only have a
+round off residual. Finite difference products amplify that round off into a
+large spurious velocity, so these equations are removed from the krylov
+vectors and their update is zero.
+*/
+double mgSolution::NewtonKrylov(const int& mm, const physics& phys,
+                                const input& inp, const int& rank,
+                                const MPI_Datatype& MPI_tensorDouble,
+                                const MPI_Datatype& MPI_vec3d) {
+  // mm -- nonlinear iteration
+  // phys -- physics models
+  // inp -- input variables
+  // rank -- processor rank
+  // MPI_tensorDouble -- MPI datatype for tensor<double>
+  // MPI_vec3d -- MPI datatype for vector3d<double>
+
+  const auto fl = this->FinestIndex();
+  auto& finest = solution_[fl];
+
+  const auto inactive = finest.InactiveMomentumDirections();
+  const auto zeroInactive = [&](vector<blkMultiArray3d<varArray>>& vec) {
+    for (auto& vb : vec) {
+      for (auto kk = vb.StartK(); kk < vb.EndK(); ++kk) {
+        for (auto jj = vb.StartJ(); jj < vb.EndJ(); ++jj) {
+          for (auto ii = vb.StartI(); ii < vb.EndI(); ++ii) {
+            for (auto dd = 0; dd < 3; ++dd) {
+              if (inactive[dd]) {
+                vb(ii, jj, kk, inp.NumSpecies() + dd) = 0.0;
+              }
+            }
+          }
+        }
+      }
+    }
+  };
+
+  auto rhs = finest.ImplicitRightHandSide(inp, phys);
+  zeroInactive(rhs);
+
+  const krylovOperator precondition =
+      [&](const vector<blkMultiArray3d<varArray>>& vec) {
+        auto forcing = vec;
+        for (auto bb = 0U; bb < forcing.size(); ++bb) {
+          forcing[bb] -= rhs[bb];
+        }
+        finest.AssignForcing(forcing);
+        auto zero = finest.Update();
+        for (auto& zb : zero) {
+          zb.Zero();
+        }
+        finest.AssignUpdate(zero);
+        this->CycleAtLevel(fl, mm, phys, inp, rank, MPI_tensorDouble,
+                           MPI_vec3d);
+        auto update = finest.Update();
+        zeroInactive(update);
+        return update;
+      };
+  const krylovOperator matVec =
+      [&](const vector<blkMultiArray3d<varArray>>& vec) {
+        auto prod = finest.JacobianFreeProduct(vec, phys, inp, rank,
+                                               MPI_tensorDouble, MPI_vec3d);
+        zeroInactive(prod);
+        return prod;
+      };
+
+  vector<blkMultiArray3d<varArray>> matrixResid;
+  const auto update = Gmres(rhs, matVec, precondition, inp.KrylovVectors(),
+                            inp.KrylovTolerance(), matrixResid);
+  finest.ZeroForcing();
+  finest.AssignUpdate(update);
+
+  // calculate l2 norm of matrix residual
+  auto l2Resid = 0.0;
+  auto totalSize = 0;
+  for (const auto& mr : matrixResid) {
+    for (auto kk = mr.PhysStartK(); kk < mr.PhysEndK(); ++kk) {
+      for (auto jj = mr.PhysStartJ(); jj < mr.PhysEndJ(); ++jj) {
+        for (auto ii = mr.PhysStartI(); ii < mr.PhysEndI(); ++ii) {
+          const auto val = mr(ii, jj, kk);
+          for (auto vv = 0; vv < val.Size(); ++vv) {
+            l2Resid += val[vv] * val[vv];
+          }
+          totalSize += val.Size();
+        }
+      }
+    }
+  }
+  return l2Resid / totalSize;
+}
+
 double mgSolution::ImplicitUpdate(const input& inp,
                                   const physics& phys, const int& mm,
                                   const int& rank,
@@ -225,12 +317,18 @@ double mgSolution::ImplicitUpdate(const input& inp,
   const auto fl = this->FinestIndex();
   solution_[fl].InvertDiagonal(inp);
 
-  // initialize matrix update
-  solution_[fl].InitializeMatrixUpdate(inp, phys);
+  if (inp.IsJacobianFree()) {
+    // Solve Ax=b with gmres preconditioned by multigrid relaxation
+    matrixError =
+        this->NewtonKrylov(mm, phys, inp, rank, MPI_tensorDouble, MPI_vec3d);
+  } else {
+    // initialize matrix update
+    solution_[fl].InitializeMatrixUpdate(inp, phys);
 
-  // Solve Ax=b with supported solver and multigrid
-  matrixError =
-      this->CycleAtLevel(fl, mm, phys, inp, rank, MPI_tensorDouble, MPI_vec3d);
+    // Solve Ax=b with supported solver and multigrid
+    matrixError = this->CycleAtLevel(fl, mm, phys, inp, rank, MPI_tensorDouble,
+                                     MPI_vec3d);
+  }
 
   // Update blocks
   solution_[fl].UpdateBlocks(inp, phys, mm, residL2, residLinf);
@@ -249,11 +347,9 @@ double mgSolution::Iterate(const input& inp, const physics& phys,
                            const int& rank, residual& residL2,
                            resid& residLinf) {
   const auto fl = this->FinestIndex();
-  // Get boundary conditions for all blocks
-  solution_[fl].GetBoundaryConditions(inp, phys, rank);
-
-  // Calculate residual (RHS)
-  solution_[fl].CalcResidual(phys, inp, rank, MPI_tensorDouble, MPI_vec3d);
+  // Get boundary conditions for all blocks and calculate residual (RHS)
+  solution_[fl].GetBoundaryConditionsAndResidual(phys, inp, rank,
+                                                 MPI_tensorDouble, MPI_vec3d);
 
   // Calculate time step
   solution_[fl].CalcTimeStep(inp);
@@ -17,10 +17,16 @@
 #include <iostream>
 #include <iomanip>
 #include <fstream>
+#include <sstream>
 #include <vector>
 #include <string>
 #include <utility>  // pair
+#include <algorithm>  // sort
 #include <cmath>
+#include <cstdint>  // int64_t
+#include <climits>  // INT_MAX
+#include <cstring>  // memcpy
+#include <array>
 #include "output.hpp"
 #include "vector3d.hpp"  // vector3d
 #include "multiArray3d.hpp"  // multiArray3d
@@ -37,6 +43,9 @@
 #include "varArray.hpp"            // residual
 #include "utility.hpp"
 #include "gridLevel.hpp"
+#include "range.hpp"
+#include "compression.hpp"
+#include "macros.hpp"
 
 using std::cout;
 using std::endl;
@@ -206,6 +215,376 @@ void WriteWallFaceCenter(const string &gridName, const vector<procBlock> &vars,
 
 //----------------------------------------------------------------------
 // function to write out variables in function file format
+// function to make an extractor from a function of a single cell
+template <typename T>
+blockExtractor CellExtractor(const T &cellValue) {
+  return [cellValue](const procBlock &blk, const int &, vector<double> &values) {
+    auto pos = 0;
+    for (auto kk = blk.StartK(); kk < blk.EndK(); kk++) {
+      for (auto jj = blk.StartJ(); jj < blk.EndJ(); jj++) {
+        for (auto ii = blk.StartI(); ii < blk.EndI(); ii++) {
+          values[pos++] = cellValue(blk, ii, jj, kk);
+        }
+      }
+    }
+  };
+}
+
+/* Function to make an extractor for the rank or global position of the cells of
+a recombined block. The split block of each cell is constant between split
+planes, so it is only found once for each box of cells between planes.
+*/
+blockExtractor SplitExtractor(const vector<procBlock> &vars,
+                              const vector<procBlock> &recombVars,
+                              const decomposition &decomp, const bool &rank) {
+  // vars -- decomposed blocks
+  // recombVars -- recombined blocks to write out
+  // decomp -- decomposition of grid onto processors
+  // rank -- flag to extract rank instead of global position
+  return [&vars, &recombVars, &decomp, rank](
+      const procBlock &blk, const int &ll, vector<double> &values) {
+    const vector3d<int> start(blk.StartI(), blk.StartJ(), blk.StartK());
+    const vector3d<int> end(blk.EndI(), blk.EndJ(), blk.EndK());
+    const auto numParents = static_cast<int>(recombVars.size());
+    vector<vector3d<int>> lower(numParents + decomp.NumSplits(), start);
+    vector<vector<int>> planes(3);
+    for (auto dd = 0; dd < 3; ++dd) {
+      planes[dd] = {start[dd], end[dd]};
+    }
+    for (auto ss = 0; ss < decomp.NumSplits(); ++ss) {
+      const auto dir = decomp.SplitHistDir(ss) == "i"
+                           ? 0
+                           : (decomp.SplitHistDir(ss) == "j" ? 1 : 2);
+      auto &split = lower[numParents + ss];
+      split = lower[decomp.SplitHistBlkLower(ss)];
+      split[dir] += decomp.SplitHistIndex(ss);
+      if (decomp.ParentBlock(numParents + ss) == ll &&
+          split[dir] > start[dir] && split[dir] < end[dir]) {
+        planes[dir].push_back(split[dir]);
+      }
+    }
+    for (auto &pl : planes) {
+      std::sort(std::begin(pl), std::end(pl));
+      pl.erase(std::unique(std::begin(pl), std::end(pl)), std::end(pl));
+    }
+
+    const auto numI = blk.NumI();
+    const auto numJ = blk.NumJ();
+    for (auto kb = 0U; kb < planes[2].size() - 1; ++kb) {
+      for (auto jb = 0U; jb < planes[1].size() - 1; ++jb) {
+        for (auto ib = 0U; ib < planes[0].size() - 1; ++ib) {
+          const auto &split =
+              vars[SplitBlockNumber(recombVars, decomp, ll, planes[0][ib],
+                                    planes[1][jb], planes[2][kb])];
+          const auto value = rank ? split.Rank() : split.GlobalPos();
+          for (auto kk = planes[2][kb]; kk < planes[2][kb + 1]; kk++) {
+            for (auto jj = planes[1][jb]; jj < planes[1][jb + 1]; jj++) {
+              for (auto ii = planes[0][ib]; ii < planes[0][ib + 1]; ii++) {
+                values[((kk - start.Z()) * numJ + jj - start.Y()) * numI +
+                       ii - start.X()] = value;
+              }
+            }
+          }
+        }
+      }
+    }
+  };
+}
+
+/* Function to resolve the output variables into extractors once per file. Each
+extractor evaluates its variable at all cells of a block, so the variable
+names are not compared for each cell. The rank and global position of a cell
+depend on whether the blocks are recombined, so those extractors are supplied
+by the caller.
+*/
+vector<blockExtractor> FunExtractors(const physics &phys, const input &inp,
+                                     const blockExtractor &rankExtractor,
+                                     const blockExtractor &globalPosExtractor) {
+  // phys -- physics models
+  // inp -- input variables
+  // rankExtractor -- extractor for rank of each cell
+  // globalPosExtractor -- extractor for global position of each cell
+
+  // dimensional scaling factors
+  const auto rRef = inp.RRef();
+  const auto aRef = inp.ARef();
+  const auto lRef = inp.LRef();
+  const auto tRef = inp.TRef();
+  const auto muRef = phys.Transport()->MuRef();
+  const auto pRef = rRef * aRef * aRef;
+  const auto eRef = aRef * aRef;
+  const auto cpRef = aRef * aRef / tRef;
+  const auto sdrRef = aRef * aRef * rRef / muRef;
+  const auto velGradRef = aRef / lRef;
+  const auto tempGradRef = tRef / lRef;
+  const auto densityGradRef = rRef / lRef;
+  const auto pressGradRef = rRef * aRef * aRef / lRef;
+  const auto tkeGradRef = aRef * aRef / lRef;
+  const auto omegaGradRef = aRef * aRef * rRef / (muRef * lRef);
+  const auto residMassRef = rRef * aRef * lRef * lRef;
+  const auto residMomRef = rRef * aRef * aRef * lRef * lRef;
+  const auto residEnergyRef = rRef * pow(aRef, 3.0) * lRef * lRef;
+  const auto residSdrRef =
+      rRef * rRef * pow(aRef, 4.0) * lRef * lRef / muRef;
+
+  vector<blockExtractor> extractors;
+  extractors.reserve(inp.OutputVariables().size());
+  for (auto &var : inp.OutputVariables()) {
+    if (var == "density") {
+      extractors.push_back(CellExtractor([=](const procBlock &blk,
+                                             const int &ii, const int &jj,
+                                             const int &kk) {
+        return blk.State(ii, jj, kk).Rho() * rRef;
+      }));
+    } else if (var == "vel_x") {
+      extractors.push_back(CellExtractor([=](const procBlock &blk,
+                                             const int &ii, const int &jj,
+                                             const int &kk) {
+        return blk.State(ii, jj, kk).U() * aRef;
+      }));
+    } else if (var == "vel_y") {
+      extractors.push_back(CellExtractor([=](const procBlock &blk,
+                                             const int &ii, const int &jj,
+                                             const int &kk) {
+        return blk.State(ii, jj, kk).V() * aRef;
+      }));
+    } else if (var == "vel_z") {
+      extractors.push_back(CellExtractor([=](const procBlock &blk,
+                                             const int &ii, const int &jj,
+                                             const int &kk) {
+        return blk.State(ii, jj, kk).W() * aRef;
+      }));
+    } else if (var == "pressure") {
+      extractors.push_back(CellExtractor([=](const procBlock &blk,
+                                             const int &ii, const int &jj,
+                                             const int &kk) {
+        return blk.State(ii, jj, kk).P() * pRef;
+      }));
+    } else if (var == "mach") {
+      extractors.push_back(CellExtractor([&phys](const procBlock &blk,
+                                                 const int &ii, const int &jj,
+                                                 const int &kk) {
+        const auto state = blk.State(ii, jj, kk);
+        return state.Velocity().Mag() / state.SoS(phys);
+      }));
+    } else if (var == "sos") {
+      extractors.push_back(CellExtractor([=, &phys](const procBlock &blk,
+                                                    const int &ii,
+                                                    const int &jj,
+                                                    const int &kk) {
+        return blk.State(ii, jj, kk).SoS(phys) * aRef;
+      }));
+    } else if (var == "dt") {
+      const auto dtRef = aRef * lRef;
+      extractors.push_back(CellExtractor([=](const procBlock &blk,
+                                             const int &ii, const int &jj,
+                                             const int &kk) {
+        return blk.Dt(ii, jj, kk) / dtRef;
+      }));
+    } else if (var == "temperature") {
+      extractors.push_back(CellExtractor([=](const procBlock &blk,
+                                             const int &ii, const int &jj,
+                                             const int &kk) {
+        return blk.Temperature(ii, jj, kk) * tRef;
+      }));
+    } else if (var == "energy") {
+      extractors.push_back(CellExtractor([=, &phys](const procBlock &blk,
+                                                    const int &ii,
+                                                    const int &jj,
+                                                    const int &kk) {
+        return blk.State(ii, jj, kk).Energy(phys) * eRef;
+      }));
+    } else if (var == "enthalpy") {
+      extractors.push_back(CellExtractor([=, &phys](const procBlock &blk,
+                                                    const int &ii,
+                                                    const int &jj,
+                                                    const int &kk) {
+        return blk.State(ii, jj, kk).Enthalpy(phys) * eRef;
+      }));
+    } else if (var == "cp" || var == "cv") {
+      const auto isCp = var == "cp";
+      extractors.push_back([=, &phys](const procBlock &blk, const int &,
+                                      vector<double> &values) {
+        // reuse mass fraction storage for all cells
+        vector<double> mf(blk.NumSpecies());
+        auto pos = 0;
+        for (auto kk = blk.StartK(); kk < blk.EndK(); kk++) {
+          for (auto jj = blk.StartJ(); jj < blk.EndJ(); jj++) {
+            for (auto ii = blk.StartI(); ii < blk.EndI(); ii++) {
+              const auto state = blk.State(ii, jj, kk);
+              const auto totalRho = state.Rho();
+              for (auto ss = 0U; ss < mf.size(); ++ss) {
+                mf[ss] = state.RhoN(ss) / totalRho;
+              }
+              const auto &t = blk.Temperature(ii, jj, kk);
+              values[pos++] = (isCp ? phys.Thermodynamic()->Cp(t, mf)
+                                    : phys.Thermodynamic()->Cv(t, mf)) *
+                              cpRef;
+            }
+          }
+        }
+      });
+    } else if (var == "rank") {
+      extractors.push_back(rankExtractor);
+    } else if (var == "globalPosition") {
+      extractors.push_back(globalPosExtractor);
+    } else if (var == "viscosityRatio") {
+      extractors.push_back(CellExtractor([](const procBlock &blk,
+                                            const int &ii, const int &jj,
+                                            const int &kk) {
+        return blk.IsTurbulent()
+                   ? blk.EddyViscosity(ii, jj, kk) / blk.Viscosity(ii, jj, kk)
+                   : 0.0;
+      }));
+    } else if (var == "turbulentViscosity") {
+      extractors.push_back(CellExtractor([=](const procBlock &blk,
+                                             const int &ii, const int &jj,
+                                             const int &kk) {
+        return blk.EddyViscosity(ii, jj, kk) * muRef;
+      }));
+    } else if (var == "viscosity") {
+      extractors.push_back(CellExtractor([=](const procBlock &blk,
+                                             const int &ii, const int &jj,
+                                             const int &kk) {
+        return blk.Viscosity(ii, jj, kk) * muRef;
+      }));
+    } else if (var == "tke") {
+      extractors.push_back(CellExtractor([=](const procBlock &blk,
+                                             const int &ii, const int &jj,
+                                             const int &kk) {
+        return blk.State(ii, jj, kk).Tke() * eRef;
+      }));
+    } else if (var == "sdr") {
+      extractors.push_back(CellExtractor([=](const procBlock &blk,
+                                             const int &ii, const int &jj,
+                                             const int &kk) {
+        return blk.State(ii, jj, kk).Omega() * sdrRef;
+      }));
+    } else if (var == "f1") {
+      extractors.push_back(CellExtractor([](const procBlock &blk,
+                                            const int &ii, const int &jj,
+                                            const int &kk) {
+        return blk.F1(ii, jj, kk);
+      }));
+    } else if (var == "f2") {
+      extractors.push_back(CellExtractor([](const procBlock &blk,
+                                            const int &ii, const int &jj,
+                                            const int &kk) {
+        return blk.F2(ii, jj, kk);
+      }));
+    } else if (var == "wallDistance") {
+      extractors.push_back(CellExtractor([=](const procBlock &blk,
+                                             const int &ii, const int &jj,
+                                             const int &kk) {
+        return blk.WallDist(ii, jj, kk) * lRef;
+      }));
+    } else if (var.substr(0, 8) == "velGrad_" && var.size() == 10 &&
+               string("uvw").find(var[8]) != string::npos &&
+               string("xyz").find(var[9]) != string::npos) {
+      // tensor is stored with velocity component as column
+      const auto col = static_cast<int>(string("uvw").find(var[8]));
+      const auto row = static_cast<int>(string("xyz").find(var[9]));
+      extractors.push_back(CellExtractor([=](const procBlock &blk,
+                                             const int &ii, const int &jj,
+                                             const int &kk) {
+        const auto grad = blk.VelGrad(ii, jj, kk);
+        const vector3d<double> gradRow = row == 0
+                                             ? grad.X()
+                                             : (row == 1 ? grad.Y() : grad.Z());
+        return gradRow[col] * velGradRef;
+      }));
+    } else if (var.size() > 2 && var[var.size() - 2] == '_' &&
+               string("xyz").find(var.back()) != string::npos &&
+               (var.substr(0, var.size() - 2) == "tempGrad" ||
+                var.substr(0, var.size() - 2) == "densityGrad" ||
+                var.substr(0, var.size() - 2) == "pressGrad" ||
+                var.substr(0, var.size() - 2) == "tkeGrad" ||
+                var.substr(0, var.size() - 2) == "omegaGrad")) {
+      const auto name = var.substr(0, var.size() - 2);
+      const auto dd = static_cast<int>(string("xyz").find(var.back()));
+      if (name == "tempGrad") {
+        extractors.push_back(CellExtractor([=](const procBlock &blk,
+                                               const int &ii, const int &jj,
+                                               const int &kk) {
+          return blk.TempGrad(ii, jj, kk)[dd] * tempGradRef;
+        }));
+      } else if (name == "densityGrad") {
+        extractors.push_back(CellExtractor([=](const procBlock &blk,
+                                               const int &ii, const int &jj,
+                                               const int &kk) {
+          return blk.DensityGrad(ii, jj, kk)[dd] * densityGradRef;
+        }));
+      } else if (name == "pressGrad") {
+        extractors.push_back(CellExtractor([=](const procBlock &blk,
+                                               const int &ii, const int &jj,
+                                               const int &kk) {
+          return blk.PressureGrad(ii, jj, kk)[dd] * pressGradRef;
+        }));
+      } else if (name == "tkeGrad") {
+        extractors.push_back(CellExtractor([=](const procBlock &blk,
+                                               const int &ii, const int &jj,
+                                               const int &kk) {
+          return blk.TkeGrad(ii, jj, kk)[dd] * tkeGradRef;
+        }));
+      } else {
+        extractors.push_back(CellExtractor([=](const procBlock &blk,
+                                               const int &ii, const int &jj,
+                                               const int &kk) {
+          return blk.OmegaGrad(ii, jj, kk)[dd] * omegaGradRef;
+        }));
+      }
+    } else if (var.substr(0, 6) == "resid_") {
+      const auto eqn = var.substr(6, string::npos);
+      auto ind = 0;
+      auto scale = 0.0;
+      if (eqn == "mass") {
+        ind = 0;
+        scale = residMassRef;
+      } else if (eqn == "mom_x" || eqn == "mom_y" || eqn == "mom_z") {
+        ind = eqn == "mom_x" ? 1 : (eqn == "mom_y" ? 2 : 3);
+        scale = residMomRef;
+      } else if (eqn == "energy" || eqn == "tke") {
+        ind = eqn == "energy" ? 4 : 5;
+        scale = residEnergyRef;
+      } else if (eqn == "sdr") {
+        ind = 6;
+        scale = residSdrRef;
+      } else {
+        cerr << "ERROR: Variable " << var
+             << " to write to function file is not defined!" << endl;
+        exit(EXIT_FAILURE);
+      }
+      extractors.push_back(CellExtractor([=](const procBlock &blk,
+                                             const int &ii, const int &jj,
+                                             const int &kk) {
+        return blk.Residual(ii, jj, kk, ind) * scale;
+      }));
+    } else if (var.substr(0, 3) == "mf_" &&
+               inp.HaveSpecies(var.substr(3, string::npos))) {
+      const auto ind = inp.SpeciesIndex(var.substr(3, string::npos));
+      extractors.push_back(CellExtractor([=](const procBlock &blk,
+                                             const int &ii, const int &jj,
+                                             const int &kk) {
+        return blk.State(ii, jj, kk).MassFractionN(ind);
+      }));
+    } else if (var.substr(0, 3) == "vf_" &&
+               inp.HaveSpecies(var.substr(3, string::npos))) {
+      const auto ind = inp.SpeciesIndex(var.substr(3, string::npos));
+      extractors.push_back(CellExtractor([=, &phys](const procBlock &blk,
+                                                    const int &ii,
+                                                    const int &jj,
+                                                    const int &kk) {
+        return blk.State(ii, jj, kk).VolumeFractions(phys.Transport())[ind];
+      }));
+    } else {
+      cerr << "ERROR: Variable " << var
+           << " to write to function file is not defined!" << endl;
+      exit(EXIT_FAILURE);
+    }
+  }
+  return extractors;
+}
+
 void WriteFunFile(const vector<procBlock> &vars,
                   const vector<procBlock> &recombVars, const physics &phys,
                   const decomposition &decomp, const string &writeName,
@@ -222,213 +601,23 @@ void WriteFunFile(const vector<procBlock> &vars,
 
   WriteBlockDims(outFile, recombVars, inp.NumVarsOutput());
 
+  // resolve output variables once for all blocks
+  const auto extractors =
+      FunExtractors(phys, inp, SplitExtractor(vars, recombVars, decomp, true),
+                    SplitExtractor(vars, recombVars, decomp, false));
+
   // write out variables
-  auto ll = 0;
-  for (auto &blk : recombVars) {  // loop over all blocks
+  vector<double> values;
+  for (auto ll = 0U; ll < recombVars.size(); ++ll) {  // loop over all blocks
+    const auto &blk = recombVars[ll];
+    values.resize(blk.NumI() * blk.NumJ() * blk.NumK());
     // loop over the number of variables to write out
-    for (auto &var : inp.OutputVariables()) {
-      // write out dimensional variables -- loop over physical cells
-      for (auto kk = blk.StartK(); kk < blk.EndK(); kk++) {
-        for (auto jj = blk.StartJ(); jj < blk.EndJ(); jj++) {
-          for (auto ii = blk.StartI(); ii < blk.EndI(); ii++) {
-            auto value = 0.0;
-            if (var == "density") {
-              value = blk.State(ii, jj, kk).Rho();
-              value *= inp.RRef();
-            } else if (var == "vel_x") {
-              value = blk.State(ii, jj, kk).U();
-              value *= inp.ARef();
-            } else if (var == "vel_y") {
-              value = blk.State(ii, jj, kk).V();
-              value *= inp.ARef();
-            } else if (var == "vel_z") {
-              value = blk.State(ii, jj, kk).W();
-              value *= inp.ARef();
-            } else if (var == "pressure") {
-              value = blk.State(ii, jj, kk).P();
-              value *= inp.RRef() * inp.ARef() * inp.ARef();
-            } else if (var == "mach") {
-              auto vel = blk.State(ii, jj, kk).Velocity();
-              value = vel.Mag() / blk.State(ii, jj, kk).SoS(phys);
-            } else if (var == "sos") {
-              value = blk.State(ii, jj, kk).SoS(phys);
-              value *= inp.ARef();
-            } else if (var == "dt") {
-              value = blk.Dt(ii, jj, kk);
-              value /= inp.ARef() * inp.LRef();
-            } else if (var == "temperature") {
-              value = blk.Temperature(ii, jj, kk);
-              value *= inp.TRef();
-            } else if (var == "energy") {
-              value = blk.State(ii, jj, kk).Energy(phys);
-              value *= inp.ARef() * inp.ARef();
-            } else if (var == "enthalpy") {
-              value = blk.State(ii, jj, kk).Enthalpy(phys);
-              value *= inp.ARef() * inp.ARef();
-            } else if (var == "cp") {
-              value = phys.Thermodynamic()->Cp(
-                  blk.Temperature(ii, jj, kk),
-                  blk.State(ii, jj, kk).MassFractions());
-              value *= inp.ARef() * inp.ARef() / inp.TRef();
-            } else if (var == "cv") {
-              value = phys.Thermodynamic()->Cv(
-                  blk.Temperature(ii, jj, kk),
-                  blk.State(ii, jj, kk).MassFractions());
-              value *= inp.ARef() * inp.ARef() / inp.TRef();
-            } else if (var == "rank") {
-              value = vars[SplitBlockNumber(recombVars, decomp,
-                                            ll, ii, jj, kk)].Rank();
-            } else if (var == "globalPosition") {
-              value = vars[SplitBlockNumber(recombVars, decomp,
-                                            ll, ii, jj, kk)].GlobalPos();
-            } else if (var == "viscosityRatio") {
-              value = blk.IsTurbulent() ?
-                  blk.EddyViscosity(ii, jj, kk) /
-                  blk.Viscosity(ii, jj, kk)
-                  : 0.0;
-            } else if (var == "turbulentViscosity") {
-              value = blk.EddyViscosity(ii, jj, kk);
-              value *= phys.Transport()->MuRef();
-            } else if (var == "viscosity") {
-              value = blk.Viscosity(ii, jj, kk);
-              value *= phys.Transport()->MuRef();
-            } else if (var == "tke") {
-              value = blk.State(ii, jj, kk).Tke();
-              value *= inp.ARef() * inp.ARef();
-            } else if (var == "sdr") {
-              value = blk.State(ii, jj, kk).Omega();
-              value *= inp.ARef() * inp.ARef() * inp.RRef() /
-                       phys.Transport()->MuRef();
-            } else if (var == "f1") {
-              value = blk.F1(ii, jj, kk);
-            } else if (var == "f2") {
-              value = blk.F2(ii, jj, kk);
-            } else if (var == "wallDistance") {
-              value = blk.WallDist(ii, jj, kk);
-              value *= inp.LRef();
-            } else if (var == "velGrad_ux") {
-              value = blk.VelGrad(ii, jj, kk).XX();
-              value *= inp.ARef() / inp.LRef();
-            } else if (var == "velGrad_vx") {
-              value = blk.VelGrad(ii, jj, kk).XY();
-              value *= inp.ARef() / inp.LRef();
-            } else if (var == "velGrad_wx") {
-              value = blk.VelGrad(ii, jj, kk).XZ();
-              value *= inp.ARef() / inp.LRef();
-            } else if (var == "velGrad_uy") {
-              value = blk.VelGrad(ii, jj, kk).YX();
-              value *= inp.ARef() / inp.LRef();
-            } else if (var == "velGrad_vy") {
-              value = blk.VelGrad(ii, jj, kk).YY();
-              value *= inp.ARef() / inp.LRef();
-            } else if (var == "velGrad_wy") {
-              value = blk.VelGrad(ii, jj, kk).YZ();
-              value *= inp.ARef() / inp.LRef();
-            } else if (var == "velGrad_uz") {
-              value = blk.VelGrad(ii, jj, kk).ZX();
-              value *= inp.ARef() / inp.LRef();
-            } else if (var == "velGrad_vz") {
-              value = blk.VelGrad(ii, jj, kk).ZY();
-              value *= inp.ARef() / inp.LRef();
-            } else if (var == "velGrad_wz") {
-              value = blk.VelGrad(ii, jj, kk).ZZ();
-              value *= inp.ARef() / inp.LRef();
-            } else if (var == "tempGrad_x") {
-              value = blk.TempGrad(ii, jj, kk).X();
-              value *= inp.TRef() / inp.LRef();
-            } else if (var == "tempGrad_y") {
-              value = blk.TempGrad(ii, jj, kk).Y();
-              value *= inp.TRef() / inp.LRef();
-            } else if (var == "tempGrad_z") {
-              value = blk.TempGrad(ii, jj, kk).Z();
-              value *= inp.TRef() / inp.LRef();
-            } else if (var == "densityGrad_x") {
-              value = blk.DensityGrad(ii, jj, kk).X();
-              value *= inp.RRef() / inp.LRef();
-            } else if (var == "densityGrad_y") {
-              value = blk.DensityGrad(ii, jj, kk).Y();
-              value *= inp.RRef() / inp.LRef();
-            } else if (var == "densityGrad_z") {
-              value = blk.DensityGrad(ii, jj, kk).Z();
-              value *= inp.RRef() / inp.LRef();
-            } else if (var == "pressGrad_x") {
-              value = blk.PressureGrad(ii, jj, kk).X();
-              value *= inp.RRef() * inp.ARef() * inp.ARef() / inp.LRef();
-            } else if (var == "pressGrad_y") {
-              value = blk.PressureGrad(ii, jj, kk).Y();
-              value *= inp.RRef() * inp.ARef() * inp.ARef() / inp.LRef();
-            } else if (var == "pressGrad_z") {
-              value = blk.PressureGrad(ii, jj, kk).Z();
-              value *= inp.RRef() * inp.ARef() * inp.ARef() / inp.LRef();
-            } else if (var == "tkeGrad_x") {
-              value = blk.TkeGrad(ii, jj, kk).X();
-              value *= inp.ARef() * inp.ARef() / inp.LRef();
-            } else if (var == "tkeGrad_y") {
-              value = blk.TkeGrad(ii, jj, kk).Y();
-              value *= inp.ARef() * inp.ARef() / inp.LRef();
-            } else if (var == "tkeGrad_z") {
-              value = blk.TkeGrad(ii, jj, kk).Z();
-              value *= inp.ARef() * inp.ARef() / inp.LRef();
-            } else if (var == "omegaGrad_x") {
-              value = blk.OmegaGrad(ii, jj, kk).X();
-              value *= inp.ARef() * inp.ARef() * inp.RRef() /
-                  (phys.Transport()->MuRef() * inp.LRef());
-            } else if (var == "omegaGrad_y") {
-              value = blk.OmegaGrad(ii, jj, kk).Y();
-              value *= inp.ARef() * inp.ARef() * inp.RRef() /
-                  (phys.Transport()->MuRef() * inp.LRef());
-            } else if (var == "omegaGrad_z") {
-              value = blk.OmegaGrad(ii, jj, kk).Z();
-              value *= inp.ARef() * inp.ARef() * inp.RRef() /
-                  (phys.Transport()->MuRef() * inp.LRef());
-            } else if (var == "resid_mass") {
-              value = blk.Residual(ii, jj, kk, 0);
-              value *= inp.RRef() * inp.ARef() * inp.LRef() * inp.LRef();
-            } else if (var == "resid_mom_x") {
-              value = blk.Residual(ii, jj, kk, 1);
-              value *= inp.RRef() * inp.ARef() * inp.ARef() * inp.LRef() *
-                  inp.LRef();
-            } else if (var == "resid_mom_y") {
-              value = blk.Residual(ii, jj, kk, 2);
-              value *= inp.RRef() * inp.ARef() * inp.ARef() * inp.LRef() *
-                  inp.LRef();
-            } else if (var == "resid_mom_z") {
-              value = blk.Residual(ii, jj, kk, 3);
-              value *= inp.RRef() * inp.ARef() * inp.ARef() * inp.LRef() *
-                  inp.LRef();
-            } else if (var == "resid_energy") {
-              value = blk.Residual(ii, jj, kk, 4);
-              value *= inp.RRef() * pow(inp.ARef(), 3.0) * inp.LRef() *
-                  inp.LRef();
-            } else if (var == "resid_tke") {
-              value = blk.Residual(ii, jj, kk, 5);
-              value *= inp.RRef() * pow(inp.ARef(), 3.0) * inp.LRef() *
-                  inp.LRef();
-            } else if (var == "resid_sdr") {
-              value = blk.Residual(ii, jj, kk, 6);
-              value *= inp.RRef() * inp.RRef() * pow(inp.ARef(), 4.0) *
-                  inp.LRef() * inp.LRef() / phys.Transport()->MuRef();
-            } else if (var.substr(0, 3) == "mf_" &&
-                       inp.HaveSpecies(var.substr(3, string::npos))) {
-              auto ind = inp.SpeciesIndex(var.substr(3, string::npos));
-              value = blk.State(ii, jj, kk).MassFractionN(ind);
-            } else if (var.substr(0, 3) == "vf_" &&
-                       inp.HaveSpecies(var.substr(3, string::npos))) {
-              auto ind = inp.SpeciesIndex(var.substr(3, string::npos));
-              value =
-                  blk.State(ii, jj, kk).VolumeFractions(phys.Transport())[ind];
-            } else {
-              cerr << "ERROR: Variable " << var
-                   << " to write to function file is not defined!" << endl;
-              exit(EXIT_FAILURE);
-            }
-
-            outFile.write(reinterpret_cast<char *>(&value), sizeof(value));
-          }
-        }
-      }
+    for (const auto &extract : extractors) {
+      // write out dimensional variables for all physical cells of block
+      extract(blk, ll, values);
+      outFile.write(reinterpret_cast<char *>(values.data()),
+                    values.size() * sizeof(double));
     }
-    ll++;
   }
 
   // close plot3d function file
@@ -587,176 +776,1004 @@ void WriteOutput(const vector<procBlock> &vars, const physics &phys,
   }
 }
 
-// function to write out restart variables
-void WriteRestart(const vector<procBlock> &splitVars, const physics &phys,
-                  const int &solIter, const decomposition &decomp,
-                  const input &inp, const residual &residL2First) {
-  // recombine blocks into original structure
-  auto vars = Recombine(splitVars, decomp);
+/* Function to write out the blocks on a processor in VTK format. Each processor
+writes each of its blocks to a binary VTK XML structured grid file (.vts) with
+the data appended in raw form. The ROOT processor writes the small index files
+that ParaView opens: a parallel structured grid file (.pvts) for each block of
+the grid file that joins the pieces it was split into, a multiblock file (.vtm)
+that collects these, and a collection file (.pvd) of the outputs written so far.
+No data is communicated between processors, and no MPI calls are made.
+*/
+void WriteVtkOutput(const vector<procBlock> &blks, const physics &phys,
+                    const int &solIter, const decomposition &decomp,
+                    const input &inp, const vector<vector3d<int>> &gridSizes,
+                    const vector<int> &outputIters, const int &rank) {
+  // blks -- blocks on this processor
+  // gridSizes -- number of nodes in each block of the grid file
+  // outputIters -- iterations of all outputs written, including this one
+  // rank -- processor rank
+  const auto ranges = decomp.NodeRanges(gridSizes);
+  for (const auto &blk : blks) {
+    WriteVtsFile(blk, phys, solIter, ranges[blk.GlobalPos()], inp);
+  }
+  if (rank == ROOTP) {
+    WriteVtkMeta(inp, solIter, decomp, gridSizes, outputIters);
+  }
+}
 
-  // open binary restart file
-  const string fPostfix = ".rst";
-  const auto writeName =
-      inp.SimNameRoot() + "_" + to_string(solIter) + fPostfix;
-  ofstream outFile(writeName, ios::out | ios::binary);
+// function to get the byte order string for vtk files
+string VtkByteOrder() {
+  const uint16_t one = 1;
+  unsigned char first = 0;
+  std::memcpy(&first, &one, sizeof(first));
+  return first == 1 ? "LittleEndian" : "BigEndian";
+}
 
-  // check to see if file opened correctly
+// function to get the name of the vtk file for a block
+string VtkFileName(const input &inp, const int &solIter, const int &blk,
+                   const string &postfix) {
+  return inp.SimNameRoot() + "_" + to_string(solIter) + "_" + to_string(blk) +
+         postfix;
+}
+
+// function to write out a block in vtk structured grid format
+void WriteVtsFile(const procBlock &blk, const physics &phys,
+                  const int &solIter, const std::array<range, 3> &rng,
+                  const input &inp) {
+  // blk -- block to write out
+  // phys -- physics models
+  // solIter -- iteration number
+  // rng -- range of nodes of block in its parent block
+  // inp -- input variables
+  const auto isSingle = inp.OutputPrecision() == "single";
+  const string type = isSingle ? "Float32" : "Float64";
+  const uint64_t bytes = isSingle ? sizeof(float) : sizeof(double);
+
+  const auto writeName = VtkFileName(inp, solIter, blk.GlobalPos(), ".vts");
+  ofstream outFile(writeName, ios::out | ios::binary);
   if (outFile.fail()) {
-    cerr << "ERROR: Restart file " << writeName << " did not open correctly!!!"
+    cerr << "ERROR: VTK file " << writeName << " did not open correctly!!!"
          << endl;
     exit(EXIT_FAILURE);
   }
 
+  std::ostringstream extent;
+  extent << rng[0].Start() << " " << rng[0].End() - 1 << " " << rng[1].Start()
+         << " " << rng[1].End() - 1 << " " << rng[2].Start() << " "
+         << rng[2].End() - 1;
+  const auto numCells = static_cast<uint64_t>(blk.NumI()) * blk.NumJ() *
+                        blk.NumK();
+  const auto numNodes = static_cast<uint64_t>(blk.NumI() + 1) *
+                        (blk.NumJ() + 1) * (blk.NumK() + 1);
+
+  // write header, each array is preceded by its size in the appended data
+  outFile << "<?xml version=\"1.0\"?>" << endl;
+  outFile << "<VTKFile type=\"StructuredGrid\" version=\"1.0\" byte_order=\""
+          << VtkByteOrder() << "\" header_type=\"UInt64\">" << endl;
+  outFile << "  <StructuredGrid WholeExtent=\"" << extent.str() << "\">"
+          << endl;
+  outFile << "    <Piece Extent=\"" << extent.str() << "\">" << endl;
+  outFile << "      <CellData>" << endl;
+  uint64_t offset = 0;
+  for (auto &var : inp.OutputVariables()) {
+    outFile << "        <DataArray type=\"" << type << "\" Name=\"" << var
+            << "\" format=\"appended\" offset=\"" << offset << "\"/>" << endl;
+    offset += sizeof(uint64_t) + numCells * bytes;
+  }
+  outFile << "      </CellData>" << endl;
+  outFile << "      <Points>" << endl;
+  outFile << "        <DataArray type=\"" << type
+          << "\" NumberOfComponents=\"3\" format=\"appended\" offset=\""
+          << offset << "\"/>" << endl;
+  outFile << "      </Points>" << endl;
+  outFile << "    </Piece>" << endl;
+  outFile << "  </StructuredGrid>" << endl;
+  outFile << "  <AppendedData encoding=\"raw\">" << endl << "_";
+
+  // write array in requested precision
+  vector<float> singleValues;
+  const auto writeArray = [&](const vector<double> &values) {
+    uint64_t size = values.size() * bytes;
+    outFile.write(reinterpret_cast<char *>(&size), sizeof(size));
+    if (isSingle) {
+      singleValues.assign(std::begin(values), std::end(values));
+      outFile.write(reinterpret_cast<char *>(singleValues.data()), size);
+    } else {
+      outFile.write(reinterpret_cast<const char *>(values.data()), size);
+    }
+  };
+
+  // cell data
+  const auto rank = blk.Rank();
+  const auto globalPos = blk.GlobalPos();
+  const auto extractors = FunExtractors(
+      phys, inp,
+      CellExtractor([rank](const procBlock &, const int &, const int &,
+                           const int &) { return rank; }),
+      CellExtractor([globalPos](const procBlock &, const int &, const int &,
+                                const int &) { return globalPos; }));
+  vector<double> values(numCells);
+  for (const auto &extract : extractors) {
+    extract(blk, blk.GlobalPos(), values);
+    writeArray(values);
+  }
+
+  // node coordinates (dimensionalized)
+  values.resize(3 * numNodes);
+  uint64_t pos = 0;
+  for (auto kk = 0; kk <= blk.NumK(); kk++) {
+    for (auto jj = 0; jj <= blk.NumJ(); jj++) {
+      for (auto ii = 0; ii <= blk.NumI(); ii++) {
+        const auto coords = blk.Node(ii, jj, kk) * inp.LRef();
+        values[pos++] = coords.X();
+        values[pos++] = coords.Y();
+        values[pos++] = coords.Z();
+      }
+    }
+  }
+  writeArray(values);
+
+  outFile << endl << "  </AppendedData>" << endl;
+  outFile << "</VTKFile>" << endl;
+  outFile.close();
+}
+
+// function to write out vtk index files
+void WriteVtkMeta(const input &inp, const int &solIter,
+                  const decomposition &decomp,
+                  const vector<vector3d<int>> &gridSizes,
+                  const vector<int> &outputIters) {
+  // inp -- input variables
+  // solIter -- iteration number
+  // decomp -- decomposition of grid onto processors
+  // gridSizes -- number of nodes in each block of the grid file
+  // outputIters -- iterations of all outputs written, including this one
+  const auto byteOrder = VtkByteOrder();
+  const string type = inp.OutputPrecision() == "single" ? "Float32" : "Float64";
+  const auto ranges = decomp.NodeRanges(gridSizes);
+  const auto openFile = [](const string &name, ofstream &file) {
+    file.open(name, ios::out);
+    if (file.fail()) {
+      cerr << "ERROR: VTK file " << name << " did not open correctly!!!"
+           << endl;
+      exit(EXIT_FAILURE);
+    }
+  };
+
+  // write parallel structured grid file joining pieces of each parent block
+  const auto numParents = static_cast<int>(gridSizes.size());
+  for (auto pp = 0; pp < numParents; ++pp) {
+    ofstream pFile;
+    openFile(VtkFileName(inp, solIter, pp, ".pvts"), pFile);
+    pFile << "<?xml version=\"1.0\"?>" << endl;
+    pFile << "<VTKFile type=\"PStructuredGrid\" version=\"1.0\" byte_order=\""
+          << byteOrder << "\" header_type=\"UInt64\">" << endl;
+    pFile << "  <PStructuredGrid WholeExtent=\"0 " << gridSizes[pp].X() - 1
+          << " 0 " << gridSizes[pp].Y() - 1 << " 0 " << gridSizes[pp].Z() - 1
+          << "\" GhostLevel=\"0\">" << endl;
+    pFile << "    <PCellData>" << endl;
+    for (auto &var : inp.OutputVariables()) {
+      pFile << "      <PDataArray type=\"" << type << "\" Name=\"" << var
+            << "\"/>" << endl;
+    }
+    pFile << "    </PCellData>" << endl;
+    pFile << "    <PPoints>" << endl;
+    pFile << "      <PDataArray type=\"" << type
+          << "\" NumberOfComponents=\"3\"/>" << endl;
+    pFile << "    </PPoints>" << endl;
+    for (auto gp = 0; gp < decomp.NumBlocks(); ++gp) {
+      if (decomp.ParentBlock(gp) != pp) {
+        continue;
+      }
+      const auto &rng = ranges[gp];
+      pFile << "    <Piece Extent=\"" << rng[0].Start() << " "
+            << rng[0].End() - 1 << " " << rng[1].Start() << " "
+            << rng[1].End() - 1 << " " << rng[2].Start() << " "
+            << rng[2].End() - 1 << "\" Source=\""
+            << VtkFileName(inp, solIter, gp, ".vts") << "\"/>" << endl;
+    }
+    pFile << "  </PStructuredGrid>" << endl;
+    pFile << "</VTKFile>" << endl;
+    pFile.close();
+  }
+
+  // write multiblock file collecting parent blocks
+  const auto multiName =
+      inp.SimNameRoot() + "_" + to_string(solIter) + ".vtm";
+  ofstream mFile;
+  openFile(multiName, mFile);
+  mFile << "<?xml version=\"1.0\"?>" << endl;
+  mFile << "<VTKFile type=\"vtkMultiBlockDataSet\" version=\"1.0\" "
+        << "byte_order=\"" << byteOrder << "\" header_type=\"UInt64\">"
+        << endl;
+  mFile << "  <vtkMultiBlockDataSet>" << endl;
+  for (auto pp = 0; pp < numParents; ++pp) {
+    mFile << "    <DataSet index=\"" << pp << "\" name=\"block_" << pp
+          << "\" file=\"" << VtkFileName(inp, solIter, pp, ".pvts") << "\"/>"
+          << endl;
+  }
+  mFile << "  </vtkMultiBlockDataSet>" << endl;
+  mFile << "</VTKFile>" << endl;
+  mFile.close();
+
+  // write collection file of all outputs written
+  // steady outputs are indexed by iteration, time accurate outputs by time
+  ofstream cFile;
+  openFile(inp.SimNameRoot() + ".pvd", cFile);
+  cFile << "<?xml version=\"1.0\"?>" << endl;
+  cFile << "<VTKFile type=\"Collection\" version=\"1.0\" byte_order=\""
+        << byteOrder << "\" header_type=\"UInt64\">" << endl;
+  cFile << "  <Collection>" << endl;
+  for (const auto &nn : outputIters) {
+    const auto timestep = inp.IsTimeAccurate() ? nn * inp.Dt() : nn;
+    cFile << "    <DataSet timestep=\"" << timestep << "\" file=\""
+          << inp.SimNameRoot() << "_" << nn << ".vtm\"/>" << endl;
+  }
+  cFile << "  </Collection>" << endl;
+  cFile << "</VTKFile>" << endl;
+  cFile.close();
+}
+
+/* Function to add a contiguous section of a file to the sections accessed by a
+processor. The block lengths of an MPI datatype are ints, so a section longer
+than the largest int is split into several sections.
+*/
+void AddFileSection(const MPI_Aint &disp, const MPI_Aint &length,
+                    vector<MPI_Aint> &displacements, vector<int> &lengths) {
+  // disp -- offset of section in file (bytes)
+  // length -- length of section (bytes)
+  // displacements -- offsets of sections to add to
+  // lengths -- lengths of sections to add to
+  for (MPI_Aint pos = 0; pos < length; pos += INT_MAX) {
+    displacements.push_back(disp + pos);
+    lengths.push_back(static_cast<int>(
+        std::min(length - pos, static_cast<MPI_Aint>(INT_MAX))));
+  }
+}
+
+/* Function to create an MPI datatype describing a contiguous buffer of bytes.
+MPI counts are ints, so a buffer larger than the largest int can not be given
+to an MPI call as a count of bytes. Instead it is described as a single
+element made of 1 GB pieces and a remainder. The datatype is committed, and
+must be freed by the caller.
+*/
+MPI_Datatype ByteBufferType(const MPI_Aint &size) {
+  // size -- number of bytes in buffer
+  constexpr MPI_Aint pieceSize = 1 << 30;
+  const auto numPieces = static_cast<int>(size / pieceSize);
+  MPI_Datatype pieceType, bulkType, bufferType;
+  MPI_Type_contiguous(pieceSize, MPI_BYTE, &pieceType);
+  MPI_Type_contiguous(numPieces, pieceType, &bulkType);
+  int lengths[2] = {1, static_cast<int>(size % pieceSize)};
+  MPI_Aint displacements[2] = {0, numPieces * pieceSize};
+  MPI_Datatype types[2] = {bulkType, MPI_BYTE};
+  MPI_Type_create_struct(2, lengths, displacements, types, &bufferType);
+  MPI_Type_commit(&bufferType);
+  MPI_Type_free(&pieceType);
+  MPI_Type_free(&bulkType);
+  return bufferType;
+}
+
+// function to get the names of the variables in the restart file
+vector<string> RestartVariables(const input &inp) {
+  vector<string> restartVars = {"density", "vel_x", "vel_y", "vel_z",
+                                "pressure"};
+  if (inp.IsRANS()) {
+    restartVars.push_back("tke");
+    restartVars.push_back("sdr");
+  }
+  for (auto ii = 0; ii < inp.NumSpecies(); ++ii) {
+    auto var = "mf_" + inp.Fluid(ii).Name();
+    restartVars.push_back(var);
+  }
+  return restartVars;
+}
+
+// function to get the dimensional value of a restart variable at time n
+double RestartValue(const procBlock &blk, const int &ii, const int &jj,
+                    const int &kk, const string &var, const input &inp,
+                    const physics &phys) {
+  auto value = 0.0;
+  if (var == "density") {
+    value = blk.State(ii, jj, kk).Rho();
+    value *= inp.RRef();
+  } else if (var == "vel_x") {
+    value = blk.State(ii, jj, kk).U();
+    value *= inp.ARef();
+  } else if (var == "vel_y") {
+    value = blk.State(ii, jj, kk).V();
+    value *= inp.ARef();
+  } else if (var == "vel_z") {
+    value = blk.State(ii, jj, kk).W();
+    value *= inp.ARef();
+  } else if (var == "pressure") {
+    value = blk.State(ii, jj, kk).P();
+    value *= inp.RRef() * inp.ARef() * inp.ARef();
+  } else if (var == "tke") {
+    value = blk.State(ii, jj, kk).Tke();
+    value *= inp.ARef() * inp.ARef();
+  } else if (var == "sdr") {
+    value = blk.State(ii, jj, kk).Omega();
+    value *= inp.ARef() * inp.ARef() * inp.RRef() / phys.Transport()->MuRef();
+  } else if (var.substr(0, 3) == "mf_" &&
+             inp.HaveSpecies(var.substr(3, string::npos))) {
+    auto ind = inp.SpeciesIndex(var.substr(3, string::npos));
+    value = blk.State(ii, jj, kk).MassFractionN(ind);
+  } else {
+    cerr << "ERROR: Variable " << var
+         << " to write to restart file is not defined!" << endl;
+    exit(EXIT_FAILURE);
+  }
+  return value;
+}
+
+// function to get the dimensional value of a restart variable at time n-1
+// these variables are conserved variables
+double RestartValueNm1(const procBlock &blk, const int &ii, const int &jj,
+                       const int &kk, const string &var, const input &inp,
+                       const physics &phys) {
+  auto value = 0.0;
+  if (var == "density") {
+    value = blk.ConsVarsNm1(ii, jj, kk)[0];
+    value *= inp.RRef();
+  } else if (var == "vel_x") {  // conserved var is rho-u
+    value = blk.ConsVarsNm1(ii, jj, kk)[1];
+    value *= inp.ARef() * inp.RRef();
+  } else if (var == "vel_y") {  // conserved var is rho-v
+    value = blk.ConsVarsNm1(ii, jj, kk)[2];
+    value *= inp.ARef() * inp.RRef();
+  } else if (var == "vel_z") {  // conserved var is rho-w
+    value = blk.ConsVarsNm1(ii, jj, kk)[3];
+    value *= inp.ARef() * inp.RRef();
+  } else if (var == "pressure") {  // conserved var is rho-E
+    value = blk.ConsVarsNm1(ii, jj, kk)[4];
+    value *= inp.ARef() * inp.ARef() * inp.RRef();
+  } else if (var == "tke") {  // conserved var is rho-tke
+    value = blk.ConsVarsNm1(ii, jj, kk)[5];
+    value *= inp.ARef() * inp.ARef() * inp.RRef();
+  } else if (var == "sdr") {  // conserved var is rho-sdr
+    value = blk.ConsVarsNm1(ii, jj, kk)[6];
+    value *= inp.ARef() * inp.ARef() * inp.RRef() * inp.RRef() /
+             phys.Transport()->MuRef();
+  } else if (var.substr(0, 3) == "mf_" &&
+             inp.HaveSpecies(var.substr(3, string::npos))) {
+    auto ind = inp.SpeciesIndex(var.substr(3, string::npos));
+    value = blk.ConsVarsNm1(ii, jj, kk).MassFractionN(ind);
+  } else {
+    cerr << "ERROR: Variable " << var
+         << " to write to restart file is not defined!" << endl;
+    exit(EXIT_FAILURE);
+  }
+  return value;
+}
+
+/* Function to assemble the header of the restart file. This does not include
+the block offset index or chunk table that follow it. The header starts with
+the file format version. It is laid out so that versions of aither that
+predate it read zero time levels and a single species named by the magic
+string, and stop because that species is not defined.
+*/
+string RestartHeader(const int &numSols, const int &solIter,
+                     const input &inp, const residual &residL2First,
+                     const vector<vector3d<int>> &gridSizes,
+                     const int &numVars, const int &format) {
+  std::ostringstream header(ios::out | ios::binary);
+  // write format version; legacy files start with the number of time levels
+  // which is never zero
+  auto legacyMarker = 0;
+  header.write(reinterpret_cast<char *>(&legacyMarker), sizeof(legacyMarker));
+  auto version = RESTART_VERSION;
+  header.write(reinterpret_cast<char *>(&version), sizeof(version));
+  auto fmt = format;
+  header.write(reinterpret_cast<char *>(&fmt), sizeof(fmt));
+  auto numMagic = 1;
+  header.write(reinterpret_cast<char *>(&numMagic), sizeof(numMagic));
+  const string magic = RESTART_MAGIC;
+  auto magicSize = magic.size();
+  header.write(reinterpret_cast<char *>(&magicSize), sizeof(magicSize));
+  header.write(magic.c_str(), magicSize * sizeof(char));
+
   // write number of time steps contained in file
-  auto numSols = inp.IsMultilevelInTime() ? 2 : 1;
-  outFile.write(reinterpret_cast<char *>(&numSols), sizeof(numSols));
+  auto nSols = numSols;
+  header.write(reinterpret_cast<char *>(&nSols), sizeof(nSols));
 
   // write iteration number
-  outFile.write(const_cast<char *>(reinterpret_cast<const char *>(&solIter)),
-                sizeof(solIter));
+  header.write(const_cast<char *>(reinterpret_cast<const char *>(&solIter)),
+               sizeof(solIter));
 
   // write number of equations
   auto numEqns = inp.NumEquations();
-  outFile.write(reinterpret_cast<char *>(&numEqns), sizeof(numEqns));
+  header.write(reinterpret_cast<char *>(&numEqns), sizeof(numEqns));
 
   // write number of species
   auto numSpecies = inp.NumSpecies();
-  outFile.write(reinterpret_cast<char *>(&numSpecies), sizeof(numSpecies));
+  header.write(reinterpret_cast<char *>(&numSpecies), sizeof(numSpecies));
 
   // write species names (including sizes)
   for (auto ii = 0; ii < numSpecies; ++ii) {
     auto specName = inp.Fluid(ii).Name();
     auto specSize = specName.size();
-    outFile.write(reinterpret_cast<char *>(&specSize), sizeof(specSize));
-    outFile.write(specName.c_str(), specSize * sizeof(char));
+    header.write(reinterpret_cast<char *>(&specSize), sizeof(specSize));
+    header.write(specName.c_str(), specSize * sizeof(char));
   }
 
   // write residual values
-  outFile.write(
+  header.write(
       const_cast<char *>(reinterpret_cast<const char *>(&residL2First[0])),
       residL2First.Size() * sizeof(residL2First[0]));
 
+  // write block dimensions of original blocks
+  auto numBlks = static_cast<int>(gridSizes.size());
+  header.write(reinterpret_cast<char *>(&numBlks), sizeof(numBlks));
+  for (const auto &gs : gridSizes) {
+    for (auto dd = 0; dd < 3; ++dd) {
+      auto numCells = gs[dd] - 1;
+      header.write(reinterpret_cast<char *>(&numCells), sizeof(numCells));
+    }
+    auto nv = numVars;
+    header.write(reinterpret_cast<char *>(&nv), sizeof(nv));
+  }
+  return header.str();
+}
+
+// function to write out restart variables
+/* Function to pack the restart file data of the blocks on a processor. The
+data is packed in the order it appears in the restart file, along with the
+file offsets of each contiguous row of cells. The data is in the order of the
+original (undecomposed) blocks, so the decomposition does not affect the
+file.
+*/
+restartData PackRestart(const vector<procBlock> &blks, const physics &phys,
+                        const int &solIter, const decomposition &decomp,
+                        const input &inp, const residual &residL2First,
+                        const vector<vector3d<int>> &gridSizes) {
+  // blks -- blocks on this processor
+  // gridSizes -- number of nodes in each block of the grid file
+
+  // write number of time steps contained in file
+  auto numSols = inp.IsMultilevelInTime() ? 2 : 1;
+
   // variables to write to restart file
-  vector<string> restartVars = {"density", "vel_x", "vel_y", "vel_z",
-                                "pressure"};
-  if (inp.IsRANS()) {
-    restartVars.push_back("tke");
-    restartVars.push_back("sdr");
+  const auto restartVars = RestartVariables(inp);
+  const auto numVars = static_cast<int>(restartVars.size());
+
+  // header is assembled on all processors because its size is needed to find
+  // the data offsets
+  std::ostringstream header(ios::out | ios::binary);
+  header << RestartHeader(numSols, solIter, inp, residL2First, gridSizes,
+                          numVars, INDEXED_RESTART);
+  const auto numBlks = static_cast<int>(gridSizes.size());
+
+  // find offset of each original block in file; each time level holds all
+  // variables for all cells of all blocks, and follows the header and the
+  // block offset index
+  const auto headerSize = static_cast<MPI_Aint>(header.tellp()) +
+                          numSols * numBlks * sizeof(int64_t);
+  vector<MPI_Aint> blockOffset(numBlks);
+  MPI_Aint offset = headerSize;
+  for (auto ii = 0; ii < numBlks; ++ii) {
+    blockOffset[ii] = offset;
+    offset += static_cast<MPI_Aint>(sizeof(double)) * numVars *
+              (gridSizes[ii].X() - 1) * (gridSizes[ii].Y() - 1) *
+              (gridSizes[ii].Z() - 1);
   }
-  for (auto ii = 0; ii < numSpecies; ++ii) {
-    auto var = "mf_" + inp.Fluid(ii).Name();
-    restartVars.push_back(var);
+  const auto solSize = offset - headerSize;
+
+  // write block offset index so blocks can be read without reading the
+  // rest of the file
+  for (auto nn = 0; nn < numSols; ++nn) {
+    for (const auto &bo : blockOffset) {
+      int64_t index = bo + nn * solSize;
+      header.write(reinterpret_cast<char *>(&index), sizeof(index));
+    }
   }
 
-  WriteBlockDims(outFile, vars, restartVars.size());
+  restartData restart;
+  restart.header_ = header.str();
+  restart.fileSize_ = headerSize + numSols * solSize;
+
+  // each row of cells in a block is contiguous in the file; sort the rows by
+  // file offset because blocks split from the same parent are interleaved
+  struct restartRow {
+    MPI_Aint disp_;
+    int block_;
+    int jj_;
+    int kk_;
+  };
+  const auto ranges = decomp.NodeRanges(gridSizes);
+  vector<restartRow> rows;
+  for (auto lp = 0U; lp < blks.size(); ++lp) {
+    const auto gp = blks[lp].GlobalPos();
+    const auto &size = gridSizes[blks[lp].ParentBlock()];
+    const auto &rng = ranges[gp];
+    for (auto kk = blks[lp].StartK(); kk < blks[lp].EndK(); ++kk) {
+      for (auto jj = blks[lp].StartJ(); jj < blks[lp].EndJ(); ++jj) {
+        const auto parentCell =
+            (static_cast<MPI_Aint>(kk + rng[2].Start()) * (size.Y() - 1) +
+             jj + rng[1].Start()) * (size.X() - 1) + rng[0].Start();
+        rows.push_back({blockOffset[blks[lp].ParentBlock()] +
+                            parentCell * numVars *
+                                static_cast<MPI_Aint>(sizeof(double)),
+                        static_cast<int>(lp), jj, kk});
+      }
+    }
+  }
+  std::sort(std::begin(rows), std::end(rows),
+            [](const auto &r1, const auto &r2) { return r1.disp_ < r2.disp_; });
 
-  // write out variables
-  for (auto &blk : vars) {  // loop over all blocks
-    // write out dimensional variables -- loop over physical cells
-    for (auto kk = blk.StartK(); kk < blk.EndK(); kk++) {
-      for (auto jj = blk.StartJ(); jj < blk.EndJ(); jj++) {
-        for (auto ii = blk.StartI(); ii < blk.EndI(); ii++) {
-          // loop over the number of variables to write out
-          for (auto &var : restartVars) {
-            auto value = 0.0;
-            if (var == "density") {
-              value = blk.State(ii, jj, kk).Rho();
-              value *= inp.RRef();
-            } else if (var == "vel_x") {
-              value = blk.State(ii, jj, kk).U();
-              value *= inp.ARef();
-            } else if (var == "vel_y") {
-              value = blk.State(ii, jj, kk).V();
-              value *= inp.ARef();
-            } else if (var == "vel_z") {
-              value = blk.State(ii, jj, kk).W();
-              value *= inp.ARef();
-            } else if (var == "pressure") {
-              value = blk.State(ii, jj, kk).P();
-              value *= inp.RRef() * inp.ARef() * inp.ARef();
-            } else if (var == "tke") {
-              value = blk.State(ii, jj, kk).Tke();
-              value *= inp.ARef() * inp.ARef();
-            } else if (var == "sdr") {
-              value = blk.State(ii, jj, kk).Omega();
-              value *= inp.ARef() * inp.ARef() * inp.RRef() /
-                       phys.Transport()->MuRef();
-            } else if (var.substr(0, 3) == "mf_" &&
-                       inp.HaveSpecies(var.substr(3, string::npos))) {
-              auto ind = inp.SpeciesIndex(var.substr(3, string::npos));
-              value = blk.State(ii, jj, kk).MassFractionN(ind);
-            } else {
-              cerr << "ERROR: Variable " << var
-                   << " to write to restart file is not defined!" << endl;
-              exit(EXIT_FAILURE);
-            }
+  // pack data in file order
+  size_t bufSize = 0;
+  for (const auto &row : rows) {
+    bufSize += blks[row.block_].NumI() * numVars * sizeof(double);
+  }
+  auto &buffer = restart.data_;
+  buffer.reserve(bufSize * numSols);
+  const auto pack = [&buffer](const double &value) {
+    const auto bytes = reinterpret_cast<const char *>(&value);
+    buffer.insert(std::end(buffer), bytes, bytes + sizeof(value));
+  };
+  auto &displacements = restart.displacements_;
+  auto &lengths = restart.lengths_;
+  displacements.reserve(rows.size() * numSols);
+  lengths.reserve(rows.size() * numSols);
+
+  for (auto nn = 0; nn < numSols; ++nn) {
+    for (const auto &row : rows) {
+      const auto &blk = blks[row.block_];
+      const auto jj = row.jj_;
+      const auto kk = row.kk_;
+      AddFileSection(row.disp_ + nn * solSize,
+                     blk.NumI() * numVars * sizeof(double), displacements,
+                     lengths);
+      // write out dimensional variables
+      for (auto ii = blk.StartI(); ii < blk.EndI(); ii++) {
+        // loop over the number of variables to write out
+        for (auto &var : restartVars) {
+          pack(nn == 0 ? RestartValue(blk, ii, jj, kk, var, inp, phys)
+                       : RestartValueNm1(blk, ii, jj, kk, var, inp, phys));
+        }
+      }
+    }
+  }
+
+  return restart;
+}
 
-            outFile.write(reinterpret_cast<char *>(&value), sizeof(value));
+/* Function to pack a compressed restart file for the blocks on a processor.
+Each variable of each block at each time level is compressed separately (see
+compression.hpp). The compressed variables of one block at one time level form
+a chunk. The header of the file ends with a table describing each chunk: the
+time level, the parent block, the range of cells of the parent block, and the
+location of the chunk in the file. The chunks of each processor are contiguous
+in the file. Because the chunks are described by the cells of the original
+blocks, the file can be read with any decomposition.
+*/
+restartData PackCompressedRestart(const vector<procBlock> &blks,
+                                  const physics &phys, const int &solIter,
+                                  const decomposition &decomp,
+                                  const input &inp,
+                                  const residual &residL2First,
+                                  const vector<vector3d<int>> &gridSizes,
+                                  const int &rank) {
+  // blks -- blocks on this processor
+  // gridSizes -- number of nodes in each block of the grid file
+  // rank -- processor rank
+
+  const auto numSols = inp.IsMultilevelInTime() ? 2 : 1;
+  const auto restartVars = RestartVariables(inp);
+  const auto numVars = static_cast<int>(restartVars.size());
+  const auto numBlks = static_cast<int>(blks.size());
+
+  // compress each variable of each block at each time level
+  const auto numChunks = numSols * numBlks;
+  vector<vector<char>> chunkData(numChunks);
+#pragma omp parallel for schedule(dynamic)
+  for (auto cc = 0; cc < numChunks; ++cc) {
+    const auto nn = cc / numBlks;
+    const auto &blk = blks[cc % numBlks];
+    vector<double> field(blk.NumCells());
+    for (auto &var : restartVars) {
+      auto pos = 0;
+      for (auto kk = blk.StartK(); kk < blk.EndK(); ++kk) {
+        for (auto jj = blk.StartJ(); jj < blk.EndJ(); ++jj) {
+          for (auto ii = blk.StartI(); ii < blk.EndI(); ++ii) {
+            field[pos++] = nn == 0
+                               ? RestartValue(blk, ii, jj, kk, var, inp, phys)
+                               : RestartValueNm1(blk, ii, jj, kk, var, inp,
+                                                 phys);
           }
         }
       }
+      const auto compressed = CompressField(field);
+      chunkData[cc].insert(std::end(chunkData[cc]), std::begin(compressed),
+                           std::end(compressed));
     }
   }
 
-  // write out 2nd solution
-  if (numSols == 2) {
-    // these variables are conserved variables
-    for (auto &blk : vars) {  // loop over all blocks
-      // write out dimensional variables -- loop over physical cells
-      for (auto kk = blk.StartK(); kk < blk.EndK(); kk++) {
-        for (auto jj = blk.StartJ(); jj < blk.EndJ(); jj++) {
-          for (auto ii = blk.StartI(); ii < blk.EndI(); ii++) {
-            // loop over the number of variables to write out
-            for (auto &var : restartVars) {
-              auto value = 0.0;
-              if (var == "density") {
-                value = blk.ConsVarsNm1(ii, jj, kk)[0];
-                value *= inp.RRef();
-              } else if (var == "vel_x") {  // conserved var is rho-u
-                value = blk.ConsVarsNm1(ii, jj, kk)[1];
-                value *= inp.ARef() * inp.RRef();
-              } else if (var == "vel_y") {  // conserved var is rho-v
-                value = blk.ConsVarsNm1(ii, jj, kk)[2];
-                value *= inp.ARef() * inp.RRef();
-              } else if (var == "vel_z") {  // conserved var is rho-w
-                value = blk.ConsVarsNm1(ii, jj, kk)[3];
-                value *= inp.ARef() * inp.RRef();
-              } else if (var == "pressure") {  // conserved var is rho-E
-                value = blk.ConsVarsNm1(ii, jj, kk)[4];
-                value *= inp.ARef() * inp.ARef() * inp.RRef();
-              } else if (var == "tke") {  // conserved var is rho-tke
-                value = blk.ConsVarsNm1(ii, jj, kk)[5];
-                value *= inp.ARef() * inp.ARef() * inp.RRef();
-              } else if (var == "sdr") {  // conserved var is rho-sdr
-                value = blk.ConsVarsNm1(ii, jj, kk)[6];
-                value *= inp.ARef() * inp.ARef() * inp.RRef() * inp.RRef() /
-                         phys.Transport()->MuRef();
-              } else if (var.substr(0, 3) == "mf_" &&
-                         inp.HaveSpecies(var.substr(3, string::npos))) {
-                auto ind = inp.SpeciesIndex(var.substr(3, string::npos));
-                value = blk.ConsVarsNm1(ii, jj, kk).MassFractionN(ind);
-              } else {
-                cerr << "ERROR: Variable " << var
-                     << " to write to restart file is not defined!" << endl;
-                exit(EXIT_FAILURE);
-              }
+  // find the location of this processor's chunks in the file
+  int64_t localSize = 0;
+  for (const auto &cd : chunkData) {
+    localSize += cd.size();
+  }
+  int64_t localStart = 0;
+  MPI_Exscan(&localSize, &localStart, 1, MPI_INT64_T, MPI_SUM,
+             MPI_COMM_WORLD);
+  if (rank == ROOTP) {
+    localStart = 0;
+  }
+  int64_t totalSize = 0;
+  MPI_Allreduce(&localSize, &totalSize, 1, MPI_INT64_T, MPI_SUM,
+                MPI_COMM_WORLD);
+  auto totalChunks = 0;
+  MPI_Allreduce(&numChunks, &totalChunks, 1, MPI_INT, MPI_SUM,
+                MPI_COMM_WORLD);
+
+  auto header = RestartHeader(numSols, solIter, inp, residL2First, gridSizes,
+                              numVars, COMPRESSED_RESTART);
+  const auto headerSize = static_cast<int64_t>(header.size()) +
+                          sizeof(int64_t) +
+                          totalChunks * sizeof(restartChunk);
+
+  // describe chunks of this processor
+  const auto ranges = decomp.NodeRanges(gridSizes);
+  vector<restartChunk> chunks(numChunks);
+  auto offset = headerSize + localStart;
+  for (auto cc = 0; cc < numChunks; ++cc) {
+    const auto &blk = blks[cc % numBlks];
+    const auto &rng = ranges[blk.GlobalPos()];
+    auto &chunk = chunks[cc];
+    chunk.level_ = cc / numBlks;
+    chunk.parent_ = blk.ParentBlock();
+    for (auto dd = 0; dd < 3; ++dd) {
+      chunk.start_[dd] = rng[dd].Start();
+      chunk.end_[dd] = rng[dd].End() - 1;
+    }
+    chunk.offset_ = offset;
+    chunk.size_ = chunkData[cc].size();
+    offset += chunk.size_;
+  }
 
-              outFile.write(reinterpret_cast<char *>(&value), sizeof(value));
+  // gather chunk table on ROOT and add it to header
+  vector<int> chunkBytes(decomp.NumProcs(), 0);
+  const auto localBytes = static_cast<int>(numChunks * sizeof(restartChunk));
+  MPI_Gather(&localBytes, 1, MPI_INT, chunkBytes.data(), 1, MPI_INT, ROOTP,
+             MPI_COMM_WORLD);
+  vector<int> chunkDisp(decomp.NumProcs(), 0);
+  for (auto pp = 1; pp < decomp.NumProcs(); ++pp) {
+    chunkDisp[pp] = chunkDisp[pp - 1] + chunkBytes[pp - 1];
+  }
+  vector<restartChunk> allChunks(rank == ROOTP ? totalChunks : 0);
+  MPI_Gatherv(chunks.data(), localBytes, MPI_BYTE, allChunks.data(),
+              chunkBytes.data(), chunkDisp.data(), MPI_BYTE, ROOTP,
+              MPI_COMM_WORLD);
+  if (rank == ROOTP) {
+    int64_t nChunks = totalChunks;
+    header.append(reinterpret_cast<char *>(&nChunks), sizeof(nChunks));
+    header.append(reinterpret_cast<char *>(allChunks.data()),
+                  allChunks.size() * sizeof(restartChunk));
+  }
+
+  restartData restart;
+  restart.header_ = header;
+  restart.fileSize_ = headerSize + totalSize;
+  AddFileSection(headerSize + localStart, localSize, restart.displacements_,
+                 restart.lengths_);
+  restart.data_.reserve(localSize);
+  for (const auto &cd : chunkData) {
+    restart.data_.insert(std::end(restart.data_), std::begin(cd),
+                         std::end(cd));
+  }
+  return restart;
+}
+
+/* Function to read the cells of the blocks on a processor from an uncompressed
+restart file. The rows of cells of each block are read with a single
+collective MPI-IO read. The cells of each block at each time level are
+returned, with the restart variables of each cell contiguous.
+*/
+vector<vector<vector<double>>> ReadRestartCells(
+    const gridLevel &vars, const string &restartName,
+    const decomposition &decomp, const vector<vector3d<int>> &gridSizes,
+    const vector<vector<int64_t>> &blockOffset, const int &numVars,
+    const int &numLevels) {
+  // vars -- blocks on this processor
+  // restartName -- restart file name
+  // gridSizes -- number of nodes in each block of the grid file
+  // blockOffset -- file offset of each parent block at each time level
+  // numVars -- number of variables in restart file
+  // numLevels -- number of time levels to read
+
+  // find the rows of cells of the blocks on this processor; each row is
+  // contiguous in the file. Sort the rows by file offset because blocks split
+  // from the same parent are interleaved
+  struct restartRow {
+    MPI_Aint disp_;
+    int level_;
+    int block_;
+    int pos_;  // position of row in solution of block
+  };
+  const auto ranges = decomp.NodeRanges(gridSizes);
+  vector<restartRow> rows;
+  for (auto nn = 0; nn < numLevels; ++nn) {
+    for (auto lp = 0; lp < vars.NumBlocks(); ++lp) {
+      const auto &blk = vars.Block(lp);
+      const auto &size = gridSizes[blk.ParentBlock()];
+      const auto &rng = ranges[blk.GlobalPos()];
+      for (auto kk = 0; kk < blk.NumK(); ++kk) {
+        for (auto jj = 0; jj < blk.NumJ(); ++jj) {
+          const auto parentCell =
+              (static_cast<MPI_Aint>(kk + rng[2].Start()) * (size.Y() - 1) +
+               jj + rng[1].Start()) * (size.X() - 1) + rng[0].Start();
+          rows.push_back({blockOffset[nn][blk.ParentBlock()] +
+                              parentCell * numVars *
+                                  static_cast<MPI_Aint>(sizeof(double)),
+                          nn, lp, (kk * blk.NumJ() + jj) * blk.NumI()});
+        }
+      }
+    }
+  }
+  std::sort(std::begin(rows), std::end(rows),
+            [](const auto &r1, const auto &r2) { return r1.disp_ < r2.disp_; });
+
+  const auto rowSize = [&vars, &numVars](const restartRow &row) {
+    return static_cast<size_t>(vars.Block(row.block_).NumI()) * numVars;
+  };
+  vector<MPI_Aint> displacements;
+  vector<int> lengths;
+  displacements.reserve(rows.size());
+  lengths.reserve(rows.size());
+  size_t bufSize = 0;
+  for (const auto &row : rows) {
+    AddFileSection(row.disp_, rowSize(row) * sizeof(double), displacements,
+                   lengths);
+    bufSize += rowSize(row);
+  }
+
+  // each processor reads only the rows of cells of its own blocks
+  MPI_File resFile;
+  if (MPI_File_open(MPI_COMM_WORLD, restartName.c_str(), MPI_MODE_RDONLY,
+                    MPI_INFO_NULL, &resFile) != MPI_SUCCESS) {
+    cerr << "ERROR: Error in ReadRestart(). Restart file " << restartName
+         << " did not open correctly!!!" << endl;
+    exit(EXIT_FAILURE);
+  }
+  MPI_Datatype fileType;
+  MPI_Type_create_hindexed(displacements.size(), lengths.data(),
+                           displacements.data(), MPI_BYTE, &fileType);
+  MPI_Type_commit(&fileType);
+  MPI_File_set_view(resFile, 0, MPI_BYTE, fileType, "native", MPI_INFO_NULL);
+  vector<double> buffer(bufSize);
+  auto bufferType = ByteBufferType(bufSize * sizeof(double));
+  MPI_File_read_all(resFile, buffer.data(), 1, bufferType, MPI_STATUS_IGNORE);
+  MPI_File_close(&resFile);
+  MPI_Type_free(&fileType);
+  MPI_Type_free(&bufferType);
+
+  // unpack rows into solution of each block
+  vector<vector<vector<double>>> blockData(
+      numLevels, vector<vector<double>>(vars.NumBlocks()));
+  for (auto nn = 0; nn < numLevels; ++nn) {
+    for (auto lp = 0; lp < vars.NumBlocks(); ++lp) {
+      blockData[nn][lp].resize(vars.Block(lp).NumCells() * numVars);
+    }
+  }
+  auto bufPos = std::cbegin(buffer);
+  for (const auto &row : rows) {
+    std::copy(bufPos, bufPos + rowSize(row),
+              std::begin(blockData[row.level_][row.block_]) +
+                  row.pos_ * numVars);
+    bufPos += rowSize(row);
+  }
+  return blockData;
+}
+
+/* Function to read the cells of the blocks on a processor from a compressed
+restart file. Each processor reads only the chunks that overlap its blocks,
+and the chunks are decompressed in parallel. The cells of each block at each
+time level are returned, with the restart variables of each cell contiguous.
+*/
+vector<vector<vector<double>>> ReadCompressedRestartCells(
+    const gridLevel &vars, const string &restartName,
+    const decomposition &decomp, const vector<vector3d<int>> &gridSizes,
+    const vector<restartChunk> &chunks, const int &numVars,
+    const int &numLevels) {
+  // vars -- blocks on this processor
+  // restartName -- restart file name
+  // gridSizes -- number of nodes in each block of the grid file
+  // chunks -- chunk table of restart file
+  // numVars -- number of variables in restart file
+  // numLevels -- number of time levels to read
+
+  // cells of parent block covered by each block on this processor
+  const auto ranges = decomp.NodeRanges(gridSizes);
+  const auto cellStart = [&vars, &ranges](const int &lp, const int &dd) {
+    return ranges[vars.Block(lp).GlobalPos()][dd].Start();
+  };
+  const auto overlaps = [&vars, &cellStart](const restartChunk &chunk,
+                                            const int &lp) {
+    if (chunk.parent_ != vars.Block(lp).ParentBlock()) {
+      return false;
+    }
+    const vector3d<int> num(vars.Block(lp).NumI(), vars.Block(lp).NumJ(),
+                            vars.Block(lp).NumK());
+    for (auto dd = 0; dd < 3; ++dd) {
+      if (chunk.start_[dd] >= cellStart(lp, dd) + num[dd] ||
+          chunk.end_[dd] <= cellStart(lp, dd)) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  // find chunks that overlap the blocks on this processor
+  vector<int> needed;
+  for (auto cc = 0U; cc < chunks.size(); ++cc) {
+    if (chunks[cc].level_ >= numLevels) {
+      continue;
+    }
+    for (auto lp = 0; lp < vars.NumBlocks(); ++lp) {
+      if (overlaps(chunks[cc], lp)) {
+        needed.push_back(cc);
+        break;
+      }
+    }
+  }
+  std::sort(std::begin(needed), std::end(needed),
+            [&chunks](const auto &c1, const auto &c2) {
+              return chunks[c1].offset_ < chunks[c2].offset_;
+            });
+
+  // cells in both chunk and block, in parent block indices
+  const auto overlapStart = [&cellStart](const restartChunk &chunk,
+                                         const int &lp) {
+    return vector3d<int>(std::max<int>(chunk.start_[0], cellStart(lp, 0)),
+                         std::max<int>(chunk.start_[1], cellStart(lp, 1)),
+                         std::max<int>(chunk.start_[2], cellStart(lp, 2)));
+  };
+  const auto overlapEnd = [&vars, &cellStart](const restartChunk &chunk,
+                                              const int &lp) {
+    const auto &blk = vars.Block(lp);
+    return vector3d<int>(
+        std::min<int>(chunk.end_[0], cellStart(lp, 0) + blk.NumI()),
+        std::min<int>(chunk.end_[1], cellStart(lp, 1) + blk.NumJ()),
+        std::min<int>(chunk.end_[2], cellStart(lp, 2) + blk.NumK()));
+  };
+
+  // every cell on this processor must be covered by a chunk, otherwise a
+  // truncated chunk table would leave cells at their initial values
+  for (auto nn = 0; nn < numLevels; ++nn) {
+    for (auto lp = 0; lp < vars.NumBlocks(); ++lp) {
+      const auto &blk = vars.Block(lp);
+      vector<bool> covered(blk.NumCells(), false);
+      for (const auto &cc : needed) {
+        if (chunks[cc].level_ != nn || !overlaps(chunks[cc], lp)) {
+          continue;
+        }
+        const auto start = overlapStart(chunks[cc], lp);
+        const auto end = overlapEnd(chunks[cc], lp);
+        for (auto kk = start.Z(); kk < end.Z(); ++kk) {
+          for (auto jj = start.Y(); jj < end.Y(); ++jj) {
+            for (auto ii = start.X(); ii < end.X(); ++ii) {
+              covered[((kk - cellStart(lp, 2)) * blk.NumJ() + jj -
+                       cellStart(lp, 1)) * blk.NumI() + ii -
+                      cellStart(lp, 0)] = true;
             }
           }
         }
       }
+      if (std::count(std::begin(covered), std::end(covered), true) !=
+          blk.NumCells()) {
+        cerr << "ERROR: Problem with restart file. Chunk table does not "
+             << "cover all cells of block " << blk.ParentBlock()
+             << " at time level " << nn << "!" << endl;
+        exit(EXIT_FAILURE);
+      }
     }
   }
 
-  // close restart file
-  outFile.close();
+  vector<MPI_Aint> displacements;
+  vector<int> lengths;
+  vector<int64_t> bufPos;
+  displacements.reserve(needed.size());
+  lengths.reserve(needed.size());
+  int64_t bufSize = 0;
+  for (const auto &cc : needed) {
+    AddFileSection(chunks[cc].offset_, chunks[cc].size_, displacements,
+                   lengths);
+    bufPos.push_back(bufSize);
+    bufSize += chunks[cc].size_;
+  }
+
+  // each processor reads only the chunks that it needs
+  MPI_File resFile;
+  if (MPI_File_open(MPI_COMM_WORLD, restartName.c_str(), MPI_MODE_RDONLY,
+                    MPI_INFO_NULL, &resFile) != MPI_SUCCESS) {
+    cerr << "ERROR: Error in ReadRestart(). Restart file " << restartName
+         << " did not open correctly!!!" << endl;
+    exit(EXIT_FAILURE);
+  }
+  MPI_Datatype fileType;
+  MPI_Type_create_hindexed(displacements.size(), lengths.data(),
+                           displacements.data(), MPI_BYTE, &fileType);
+  MPI_Type_commit(&fileType);
+  MPI_File_set_view(resFile, 0, MPI_BYTE, fileType, "native", MPI_INFO_NULL);
+  vector<char> buffer(bufSize);
+  auto bufferType = ByteBufferType(bufSize);
+  MPI_File_read_all(resFile, buffer.data(), 1, bufferType, MPI_STATUS_IGNORE);
+  MPI_File_close(&resFile);
+  MPI_Type_free(&fileType);
+  MPI_Type_free(&bufferType);
+
+  vector<vector<vector<double>>> blockData(
+      numLevels, vector<vector<double>>(vars.NumBlocks()));
+  for (auto nn = 0; nn < numLevels; ++nn) {
+    for (auto lp = 0; lp < vars.NumBlocks(); ++lp) {
+      blockData[nn][lp].resize(vars.Block(lp).NumCells() * numVars);
+    }
+  }
+
+  // decompress chunks and copy overlapping cells into blocks; chunks at the
+  // same time level do not overlap, so each cell is written by one chunk
+#pragma omp parallel for schedule(dynamic)
+  for (auto nc = 0; nc < static_cast<int>(needed.size()); ++nc) {
+    const auto &chunk = chunks[needed[nc]];
+    const vector3d<int> chunkNum(chunk.end_[0] - chunk.start_[0],
+                                 chunk.end_[1] - chunk.start_[1],
+                                 chunk.end_[2] - chunk.start_[2]);
+    const auto numCells = static_cast<int64_t>(chunkNum.X()) * chunkNum.Y() *
+                          chunkNum.Z();
+    const auto *pos = buffer.data() + bufPos[nc];
+    for (auto vv = 0; vv < numVars; ++vv) {
+      if (pos + CompressedFieldSize(pos) >
+          buffer.data() + bufPos[nc] + chunk.size_) {
+        cerr << "ERROR: Problem with restart file. Chunk is corrupt!" << endl;
+        exit(EXIT_FAILURE);
+      }
+      const auto field = DecompressField(pos, numCells);
+      pos += CompressedFieldSize(pos);
+
+      for (auto lp = 0; lp < vars.NumBlocks(); ++lp) {
+        if (!overlaps(chunk, lp)) {
+          continue;
+        }
+        const auto &blk = vars.Block(lp);
+        auto &data = blockData[chunk.level_][lp];
+        // loop over cells in both chunk and block, in parent block indices
+        const auto start = overlapStart(chunk, lp);
+        const auto end = overlapEnd(chunk, lp);
+        for (auto kk = start.Z(); kk < end.Z(); ++kk) {
+          for (auto jj = start.Y(); jj < end.Y(); ++jj) {
+            for (auto ii = start.X(); ii < end.X(); ++ii) {
+              const auto chunkCell =
+                  ((kk - chunk.start_[2]) * chunkNum.Y() + jj -
+                   chunk.start_[1]) * chunkNum.X() + ii - chunk.start_[0];
+              const auto blkCell =
+                  ((kk - cellStart(lp, 2)) * blk.NumJ() + jj -
+                   cellStart(lp, 1)) * blk.NumI() + ii - cellStart(lp, 0);
+              data[blkCell * numVars + vv] = field[chunkCell];
+            }
+          }
+        }
+      }
+    }
+  }
+  return blockData;
 }
 
+/* Function to read a restart file into the blocks on a processor. Every
+processor reads the header and the block offset index, and then reads only the
+cells of its own blocks with a collective MPI-IO read. Because the file is in
+the order of the original blocks, it can be read with a different number of
+processors or decomposition than it was written with.
+*/
 void ReadRestart(gridLevel &vars, const string &restartName,
                  const decomposition &decomp, input &inp, const physics &phys,
                  residual &residL2First,
-                 const vector<vector3d<int>> &gridSizes) {
+                 const vector<vector3d<int>> &gridSizes, const int &rank) {
+  // vars -- blocks on this processor
+  // gridSizes -- number of nodes in each block of the grid file
+  // rank -- processor rank
+
   // open binary restart file
   ifstream fName(restartName, ios::in | ios::binary);
 
@@ -766,14 +1783,50 @@ void ReadRestart(gridLevel &vars, const string &restartName,
          << " did not open correctly!!!" << endl;
     exit(EXIT_FAILURE);
   }
+  const auto isRoot = rank == ROOTP;
 
   // read the number of time levels in file
-  cout << "Reading restart file..." << endl;
+  if (isRoot) {
+    cout << "Reading restart file..." << endl;
+  }
+  // files with a format version start with a zero in place of the number of
+  // time levels; legacy files store the blocks directly after the header
   auto numSols = 0;
   fName.read(reinterpret_cast<char *>(&numSols), sizeof(numSols));
-  cout << "Number of time levels: " << numSols << endl;
+  auto version = 1;
+  auto format = INDEXED_RESTART;
+  if (numSols == 0) {
+    auto numMagic = 0;
+    size_t magicSize = 0;
+    fName.read(reinterpret_cast<char *>(&version), sizeof(version));
+    fName.read(reinterpret_cast<char *>(&format), sizeof(format));
+    fName.read(reinterpret_cast<char *>(&numMagic), sizeof(numMagic));
+    fName.read(reinterpret_cast<char *>(&magicSize), sizeof(magicSize));
+    const string expectedMagic = RESTART_MAGIC;
+    string magic(expectedMagic.size(), ' ');
+    if (magicSize == expectedMagic.size()) {
+      fName.read(&magic[0], magicSize * sizeof(char));
+    }
+    if (fName.fail() || numMagic != 1 || magic != expectedMagic) {
+      cerr << "ERROR: Problem with restart file. File is not an aither "
+           << "restart file!" << endl;
+      exit(EXIT_FAILURE);
+    }
+    if (version > RESTART_VERSION ||
+        (format != INDEXED_RESTART && format != COMPRESSED_RESTART)) {
+      cerr << "ERROR: Restart file format version " << version
+           << " is not supported by this version of aither. Versions up to "
+           << RESTART_VERSION << " are supported." << endl;
+      exit(EXIT_FAILURE);
+    }
+    fName.read(reinterpret_cast<char *>(&numSols), sizeof(numSols));
+  }
+  if (isRoot) {
+    cout << "Restart file format version: " << version << endl;
+    cout << "Number of time levels: " << numSols << endl;
+  }
 
-  if (inp.IsMultilevelInTime() && numSols != 2) {
+  if (isRoot && inp.IsMultilevelInTime() && numSols != 2) {
     cerr << "WARNING: Using multilevel time integration scheme, but only one "
          << "time level found in restart file" << endl;
   }
@@ -781,18 +1834,24 @@ void ReadRestart(gridLevel &vars, const string &restartName,
   // iteration number
   auto iterNum = 0;
   fName.read(reinterpret_cast<char *>(&iterNum), sizeof(iterNum));
-  cout << "Data from iteration: " << iterNum << endl;
+  if (isRoot) {
+    cout << "Data from iteration: " << iterNum << endl;
+  }
   inp.SetIterationStart(iterNum);
 
   // read the number of equations
   auto numEqns = 0;
   fName.read(reinterpret_cast<char *>(&numEqns), sizeof(numEqns));
-  cout << "Number of equations: " << numEqns << endl;
+  if (isRoot) {
+    cout << "Number of equations: " << numEqns << endl;
+  }
 
   // read the number of species
   auto numSpecies = 0;
   fName.read(reinterpret_cast<char *>(&numSpecies), sizeof(numSpecies));
-  cout << "Number of species: " << numSpecies << endl;
+  if (isRoot) {
+    cout << "Number of species: " << numSpecies << endl;
+  }
 
   // read species names (including sizes)
   vector<string> speciesNames(numSpecies);
@@ -830,8 +1889,9 @@ void ReadRestart(gridLevel &vars, const string &restartName,
     fName.read(reinterpret_cast<char *>(&numJ), sizeof(numJ));
     fName.read(reinterpret_cast<char *>(&numK), sizeof(numK));
     fName.read(reinterpret_cast<char *>(&numVars), sizeof(numVars));
-    if (numI != gridSizes[ii].X() || numJ != gridSizes[ii].Y() ||
-        numK != gridSizes[ii].Z() || numVars - 1 != numEqns) {
+    // grid sizes are in nodes, restart file sizes are in cells
+    if (numI != gridSizes[ii].X() - 1 || numJ != gridSizes[ii].Y() - 1 ||
+        numK != gridSizes[ii].Z() - 1 || numVars - 1 != numEqns) {
       cerr << "ERROR: Problem with restart file. Block size does not match "
            << "grid, or number of variables in block does not match number of "
            << "equations!" << endl;
@@ -851,51 +1911,117 @@ void ReadRestart(gridLevel &vars, const string &restartName,
     restartVars.push_back(var);
   }
 
-  // loop over blocks and initialize
-  cout << "Reading solution from time n..." << endl;
-  vector<blkMultiArray3d<primitive>> solN(numBlks);
-  for (auto ii = 0U; ii < solN.size(); ++ii) {
-    solN[ii] =
-        ReadSolFromRestart(fName, inp, phys, restartVars, gridSizes[ii].X(),
-                           gridSizes[ii].Y(), gridSizes[ii].Z(), numSpecies);
+  const auto numVars = static_cast<int>(restartVars.size());
+
+  // find the offset of each block in the file from the block offset index.
+  // legacy restart files store the blocks directly after the header.
+  // compressed restart files have a chunk table instead of the index
+  const auto headerEnd = static_cast<int64_t>(fName.tellg());
+  fName.seekg(0, ios::end);
+  const auto fileSize = static_cast<int64_t>(fName.tellg());
+  fName.seekg(headerEnd);
+  vector<int64_t> blockSize(numBlks);
+  for (auto ii = 0; ii < numBlks; ++ii) {
+    blockSize[ii] = static_cast<int64_t>(sizeof(double)) * numVars *
+                    (gridSizes[ii].X() - 1) * (gridSizes[ii].Y() - 1) *
+                    (gridSizes[ii].Z() - 1);
   }
-  // decompose solution
-  decomp.DecompArray(solN);
+  vector<vector<int64_t>> blockOffset(numSols, vector<int64_t>(numBlks));
+  vector<restartChunk> chunks;
+  const auto isCompressed = format == COMPRESSED_RESTART;
+  if (isCompressed) {
+    int64_t numChunks = 0;
+    fName.read(reinterpret_cast<char *>(&numChunks), sizeof(numChunks));
+    if (fName.fail() || numChunks < 0) {
+      cerr << "ERROR: Problem with restart file. Chunk table is corrupt!"
+           << endl;
+      exit(EXIT_FAILURE);
+    }
+    chunks.resize(numChunks);
+    fName.read(reinterpret_cast<char *>(chunks.data()),
+               numChunks * sizeof(restartChunk));
+    for (const auto &chunk : chunks) {
+      if (fName.fail() || chunk.level_ < 0 || chunk.level_ >= numSols ||
+          chunk.parent_ < 0 || chunk.parent_ >= numBlks ||
+          chunk.offset_ < headerEnd ||
+          chunk.offset_ + chunk.size_ > fileSize) {
+        cerr << "ERROR: Problem with restart file. Chunk table is not "
+             << "consistent with file!" << endl;
+        exit(EXIT_FAILURE);
+      }
+    }
+  } else {
+    if (version == 1) {
+      auto offset = headerEnd;
+      for (auto &levelOffset : blockOffset) {
+        for (auto ii = 0; ii < numBlks; ++ii) {
+          levelOffset[ii] = offset;
+          offset += blockSize[ii];
+        }
+      }
+    } else {
+      for (auto &levelOffset : blockOffset) {
+        fName.read(reinterpret_cast<char *>(levelOffset.data()),
+                   numBlks * sizeof(int64_t));
+      }
+    }
+    for (const auto &levelOffset : blockOffset) {
+      for (auto ii = 0; ii < numBlks; ++ii) {
+        if (fName.fail() || levelOffset[ii] < headerEnd ||
+            levelOffset[ii] + blockSize[ii] > fileSize) {
+          cerr << "ERROR: Problem with restart file. Block offsets are not "
+               << "consistent with file size!" << endl;
+          exit(EXIT_FAILURE);
+        }
+      }
+    }
+  }
+
+  // close restart file, solution is read below with MPI-IO
+  fName.close();
+
+  // only read the time n-1 solution if it is used
+  const auto numLevels = (inp.IsMultilevelInTime() && numSols == 2) ? 2 : 1;
 
-  // assign to procBlocks
-  for (auto ii = 0U; ii < solN.size(); ++ii) {
-    vars.Block(ii).GetStatesFromRestart(solN[ii]);
+  const auto blockData =
+      isCompressed
+          ? ReadCompressedRestartCells(vars, restartName, decomp, gridSizes,
+                                       chunks, numVars, numLevels)
+          : ReadRestartCells(vars, restartName, decomp, gridSizes,
+                             blockOffset, numVars, numLevels);
+
+  // loop over blocks and initialize
+  if (isRoot) {
+    cout << "Reading solution from time n..." << endl;
+  }
+  for (auto lp = 0; lp < vars.NumBlocks(); ++lp) {
+    auto &blk = vars.Block(lp);
+    blk.GetStatesFromRestart(ReadSolFromRestart(
+        blockData[0][lp], inp, phys, restartVars, blk.NumI(), blk.NumJ(),
+        blk.NumK(), numSpecies));
   }
 
   if (inp.IsMultilevelInTime()) {
-    if (numSols == 2) {
-      cout << "Reading solution from time n-1..." << endl;
-      vector<blkMultiArray3d<conserved>> solNm1(numBlks);
-      for (auto ii = 0U; ii < solNm1.size(); ++ii) {
-        solNm1[ii] = ReadSolNm1FromRestart(fName, inp, phys, restartVars,
-                                           gridSizes[ii].X(), gridSizes[ii].Y(),
-                                           gridSizes[ii].Z(), numSpecies);
+    if (numLevels == 2) {
+      if (isRoot) {
+        cout << "Reading solution from time n-1..." << endl;
       }
-      // decompose solution
-      decomp.DecompArray(solNm1);
-
-      // assign to procBlocks
-      for (auto ii = 0U; ii < solNm1.size(); ++ii) {
-        vars.Block(ii).GetSolNm1FromRestart(solNm1[ii]);
+      for (auto lp = 0; lp < vars.NumBlocks(); ++lp) {
+        auto &blk = vars.Block(lp);
+        blk.GetSolNm1FromRestart(ReadSolNm1FromRestart(
+            blockData[1][lp], inp, phys, restartVars, blk.NumI(), blk.NumJ(),
+            blk.NumK(), numSpecies));
       }
-
     } else {
-      cerr << "WARNING: Using multilevel time integration scheme, but only one "
-           << "time level found in restart file" << endl;
       // assign solution at time n to n-1
       vars.AssignSolToTimeN(phys);
       vars.AssignSolToTimeNm1();
     }
   }
 
-  // close restart file
-  fName.close();
-  cout << "Done with restart file" << endl << endl;
+  if (isRoot) {
+    cout << "Done with restart file" << endl << endl;
+  }
 }
 
 
@@ -1175,7 +2301,7 @@ int SplitBlockNumber(const vector<procBlock> &vars, const decomposition &decomp,
 }
 
 blkMultiArray3d<primitive> ReadSolFromRestart(
-    ifstream &resFile, const input &inp, const physics &phys,
+    const vector<double> &data, const input &inp, const physics &phys,
     const vector<string> &restartVars, const int &numI, const int &numJ,
     const int &numK, const int &numSpecies) {
   // intialize multiArray3d
@@ -1184,6 +2310,7 @@ blkMultiArray3d<primitive> ReadSolFromRestart(
   blkMultiArray3d<primitive> sol(numI, numJ, numK, 0, numEqns, numSpecies);
 
   // read the primitive variables
+  auto pos = 0U;
   // read dimensional variables -- loop over physical cells
   for (auto kk = sol.StartK(); kk < sol.EndK(); kk++) {
     for (auto jj = sol.StartJ(); jj < sol.EndJ(); jj++) {
@@ -1193,38 +2320,37 @@ blkMultiArray3d<primitive> ReadSolFromRestart(
         // loop over the number of variables to read
         for (auto &var : restartVars) {
           if (var == "density") {
-            resFile.read(reinterpret_cast<char *>(&rho), sizeof(rho));
+            rho = data[pos++];
             rho /= inp.RRef();
           } else if (var == "vel_x") {
             auto n = value.MomentumXIndex();
-            resFile.read(reinterpret_cast<char *>(&value[n]), sizeof(value[n]));
+            value[n] = data[pos++];
             value[n] /= inp.ARef();
           } else if (var == "vel_y") {
             auto n = value.MomentumYIndex();
-            resFile.read(reinterpret_cast<char *>(&value[n]), sizeof(value[n]));
+            value[n] = data[pos++];
             value[n] /= inp.ARef();
           } else if (var == "vel_z") {
             auto n = value.MomentumZIndex();
-            resFile.read(reinterpret_cast<char *>(&value[n]), sizeof(value[n]));
+            value[n] = data[pos++];
             value[n] /= inp.ARef();
           } else if (var == "pressure") {
             auto n = value.EnergyIndex();
-            resFile.read(reinterpret_cast<char *>(&value[n]), sizeof(value[n]));
+            value[n] = data[pos++];
             value[n] /= inp.RRef() * inp.ARef() * inp.ARef();
           } else if (var == "tke") {
             auto n = value.TurbulenceIndex();
-            resFile.read(reinterpret_cast<char *>(&value[n]), sizeof(value[n]));
+            value[n] = data[pos++];
             value[n] /= inp.ARef() * inp.ARef();
           } else if (var == "sdr") {
             auto n = value.TurbulenceIndex() + 1;
-            resFile.read(reinterpret_cast<char *>(&value[n]), sizeof(value[n]));
+            value[n] = data[pos++];
             value[n] /= inp.ARef() * inp.ARef() * inp.RRef() /
                         phys.Transport()->MuRef();
           } else if (var.substr(0, 3) == "mf_" &&
                      inp.HaveSpecies(var.substr(3, string::npos))) {
             auto n = inp.SpeciesIndex(var.substr(3, string::npos));
-            auto mf = 0.0;
-            resFile.read(reinterpret_cast<char *>(&mf), sizeof(mf));
+            auto mf = data[pos++];
             value[n] = rho * mf;
           } else {
             cerr << "ERROR: Variable " << var
@@ -1240,7 +2366,7 @@ blkMultiArray3d<primitive> ReadSolFromRestart(
 }
 
 blkMultiArray3d<conserved> ReadSolNm1FromRestart(
-    ifstream &resFile, const input &inp, const physics &phys,
+    const vector<double> &data, const input &inp, const physics &phys,
     const vector<string> &restartVars, const int &numI, const int &numJ,
     const int &numK, const int &numSpecies) {
   // intialize multiArray3d
@@ -1249,6 +2375,7 @@ blkMultiArray3d<conserved> ReadSolNm1FromRestart(
   blkMultiArray3d<conserved> sol(numI, numJ, numK, 0, numEqns, numSpecies);
 
   // data is conserved variables
+  auto pos = 0U;
   // read dimensional variables -- loop over physical cells
   for (auto kk = sol.StartK(); kk < sol.EndK(); kk++) {
     for (auto jj = sol.StartJ(); jj < sol.EndJ(); jj++) {
@@ -1258,38 +2385,37 @@ blkMultiArray3d<conserved> ReadSolNm1FromRestart(
         // loop over the number of variables to read
         for (auto &var : restartVars) {
           if (var == "density") {
-            resFile.read(reinterpret_cast<char *>(&rho), sizeof(rho));
+            rho = data[pos++];
             rho /= inp.RRef();
           } else if (var == "vel_x") {  // conserved var is rho-u
             auto n = value.MomentumXIndex();
-            resFile.read(reinterpret_cast<char *>(&value[n]), sizeof(value[n]));
+            value[n] = data[pos++];
             value[n] /= inp.ARef() * inp.RRef();
           } else if (var == "vel_y") {  // conserved var is rho-v
             auto n = value.MomentumYIndex();
-            resFile.read(reinterpret_cast<char *>(&value[n]), sizeof(value[n]));
+            value[n] = data[pos++];
             value[n] /= inp.ARef() * inp.RRef();
           } else if (var == "vel_z") {  // conserved var is rho-w
             auto n = value.MomentumZIndex();
-            resFile.read(reinterpret_cast<char *>(&value[n]), sizeof(value[n]));
+            value[n] = data[pos++];
             value[n] /= inp.ARef() * inp.RRef();
           } else if (var == "pressure") {  // conserved var is rho-E
             auto n = value.EnergyIndex();
-            resFile.read(reinterpret_cast<char *>(&value[n]), sizeof(value[n]));
+            value[n] = data[pos++];
             value[n] /= inp.RRef() * inp.ARef() * inp.ARef();
           } else if (var == "tke") {  // conserved var is rho-tke
             auto n = value.TurbulenceIndex();
-            resFile.read(reinterpret_cast<char *>(&value[n]), sizeof(value[n]));
+            value[n] = data[pos++];
             value[n] /= inp.ARef() * inp.ARef() * inp.RRef();
           } else if (var == "sdr") {  // conserved var is rho-sdr
             auto n = value.TurbulenceIndex() + 1;
-            resFile.read(reinterpret_cast<char *>(&value[n]), sizeof(value[n]));
+            value[n] = data[pos++];
             value[n] /= inp.ARef() * inp.ARef() * inp.RRef() * inp.RRef() /
                         phys.Transport()->MuRef();
           } else if (var.substr(0, 3) == "mf_" &&
                      inp.HaveSpecies(var.substr(3, string::npos))) {
             auto n = inp.SpeciesIndex(var.substr(3, string::npos));
-            auto mf = 0.0;
-            resFile.read(reinterpret_cast<char *>(&mf), sizeof(mf));
+            auto mf = data[pos++];
             value[n] = rho * mf;
           } else {
             cerr << "ERROR: Variable " << var
@@ -0,0 +1,221 @@
+/*  This file is part of aither.
+    Copyright (C) 2015-19  Michael Nucci (mnucci@pm.me)
+
+    Aither is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Aither is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>. */
+
+#include <iostream>     // cout
+#include <cstdlib>      // exit()
+#include <string>
+#include <vector>
+#include "outputManager.hpp"
+#include "output.hpp"
+#include "input.hpp"
+#include "physicsModels.hpp"
+#include "parallel.hpp"
+#include "varArray.hpp"
+#include "macros.hpp"
+
+using std::cout;
+using std::endl;
+using std::cerr;
+using std::to_string;
+
+// constructor
+outputManager::outputManager(const input &inp, const int &rank)
+    : isAsync_(inp.AsyncOutput()),
+      rank_(rank),
+      restartFile_(MPI_FILE_NULL),
+      restartType_(MPI_DATATYPE_NULL),
+      restartRequest_(MPI_REQUEST_NULL),
+      restartPending_(false) {
+  if (rank_ == ROOTP && inp.IsVtkOutput() &&
+      (inp.OutputNodalVariables() || inp.NumWallVarsOutput() > 0)) {
+    cerr << "WARNING: Nodal and wall variables are not written with vtk "
+         << "output. Only cell variables are written." << endl;
+  }
+}
+
+/* Member function to write out the function files. Only called on the ROOT
+processor. In asynchronous mode the blocks and input are copied, and the files
+are written by a background thread.
+*/
+void outputManager::WriteOutput(const vector<procBlock> &blks,
+                                const physics &phys, const int &iter,
+                                const decomposition &decomp,
+                                const input &inp) {
+  // blks -- blocks to write, gathered on ROOT
+  // phys -- physics models
+  // iter -- iteration number
+  // decomp -- decomposition of grid onto processors
+  // inp -- input variables
+
+  if (!isAsync_) {
+    ::WriteOutput(blks, phys, iter, decomp, inp);
+    return;
+  }
+
+  // wait for previous write before overwriting snapshot
+  this->FinishOutput();
+  funBlocks_ = blks;
+  funInput_ = std::make_unique<input>(inp);
+  // physics models and decomposition are not changed during the simulation
+  funWriter_ = std::thread([this, &phys, &decomp, iter]() {
+    ::WriteOutput(funBlocks_, phys, iter, decomp, *funInput_);
+  });
+}
+
+/* Member function to write out the blocks on each processor in VTK format.
+Called on all processors. In asynchronous mode the blocks and input are copied,
+and the files are written by a background thread on each processor.
+*/
+void outputManager::WriteVtkOutput(const vector<procBlock> &blks,
+                                   const physics &phys, const int &iter,
+                                   const decomposition &decomp,
+                                   const input &inp,
+                                   const vector<vector3d<int>> &gridSizes) {
+  // blks -- blocks on this processor
+  // phys -- physics models
+  // iter -- iteration number
+  // decomp -- decomposition of grid onto processors
+  // inp -- input variables
+  // gridSizes -- number of nodes in each block of the grid file
+
+  // collection file lists the outputs that have actually been written
+  vtkIters_.push_back(iter);
+
+  if (!isAsync_) {
+    ::WriteVtkOutput(blks, phys, iter, decomp, inp, gridSizes, vtkIters_,
+                     rank_);
+    return;
+  }
+
+  // wait for previous write before overwriting snapshot
+  this->FinishOutput();
+  funBlocks_ = blks;
+  funInput_ = std::make_unique<input>(inp);
+  // physics models, decomposition, and grid sizes are not changed during the
+  // simulation
+  funWriter_ = std::thread([this, &phys, &decomp, &gridSizes, iter,
+                            iters = vtkIters_]() {
+    ::WriteVtkOutput(funBlocks_, phys, iter, decomp, *funInput_, gridSizes,
+                     iters, rank_);
+  });
+}
+
+/* Member function to write out a restart file. Called on all processors. The
+ROOT processor writes the header, and each processor writes the data of its
+own blocks with a collective write. In asynchronous mode the write is
+nonblocking and is completed before the next restart file is written.
+*/
+void outputManager::WriteRestart(const vector<procBlock> &blks,
+                                 const physics &phys, const int &iter,
+                                 const decomposition &decomp,
+                                 const input &inp,
+                                 const residual &residL2First,
+                                 const vector<vector3d<int>> &gridSizes) {
+  // blks -- blocks on this processor
+  // phys -- physics models
+  // iter -- iteration number
+  // decomp -- decomposition of grid onto processors
+  // inp -- input variables
+  // residL2First -- residuals to normalize by
+  // gridSizes -- number of nodes in each block of the grid file
+
+  // wait for previous write before overwriting staging buffer
+  this->FinishRestart();
+  restart_ = inp.RestartCompression()
+                 ? PackCompressedRestart(blks, phys, iter, decomp, inp,
+                                         residL2First, gridSizes, rank_)
+                 : PackRestart(blks, phys, iter, decomp, inp, residL2First,
+                               gridSizes);
+
+  // open binary restart file
+  const auto writeName = inp.SimNameRoot() + "_" + to_string(iter) + ".rst";
+  if (MPI_File_open(MPI_COMM_WORLD, writeName.c_str(),
+                    MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL,
+                    &restartFile_) != MPI_SUCCESS) {
+    cerr << "ERROR: Restart file " << writeName << " did not open correctly!!!"
+         << endl;
+    exit(EXIT_FAILURE);
+  }
+  // truncate in case file already exists
+  MPI_File_set_size(restartFile_, restart_.fileSize_);
+
+  if (rank_ == ROOTP) {
+    MPI_File_write_at(restartFile_, 0, restart_.header_.data(),
+                      restart_.header_.size(), MPI_BYTE, MPI_STATUS_IGNORE);
+  }
+
+  // each processor sees only the sections of the file that it writes
+  MPI_Type_create_hindexed(restart_.lengths_.size(), restart_.lengths_.data(),
+                           restart_.displacements_.data(), MPI_BYTE,
+                           &restartType_);
+  MPI_Type_commit(&restartType_);
+  MPI_File_set_view(restartFile_, 0, MPI_BYTE, restartType_, "native",
+                    MPI_INFO_NULL);
+
+  // the data may be larger than the largest MPI count, so it is written as a
+  // single element of a datatype covering the whole buffer; the datatype can
+  // be freed while the write is pending
+  auto bufferType = ByteBufferType(restart_.data_.size());
+#if MPI_VERSION > 3 || (MPI_VERSION == 3 && MPI_SUBVERSION >= 1)
+  if (isAsync_) {
+    MPI_File_iwrite_all(restartFile_, restart_.data_.data(), 1, bufferType,
+                        &restartRequest_);
+    MPI_Type_free(&bufferType);
+    restartPending_ = true;
+    return;
+  }
+#endif
+  MPI_File_write_all(restartFile_, restart_.data_.data(), 1, bufferType,
+                     MPI_STATUS_IGNORE);
+  MPI_Type_free(&bufferType);
+  restartPending_ = true;
+  this->FinishRestart();
+}
+
+// member function to wait for the function file write to finish
+void outputManager::FinishOutput() {
+  if (funWriter_.joinable()) {
+    funWriter_.join();
+  }
+  funBlocks_.clear();
+  funInput_.reset();
+}
+
+// member function to wait for the restart file write to finish
+void outputManager::FinishRestart() {
+  if (!restartPending_) {
+    return;
+  }
+  MPI_Wait(&restartRequest_, MPI_STATUS_IGNORE);
+  MPI_File_close(&restartFile_);
+  MPI_Type_free(&restartType_);
+  restart_ = restartData();
+  restartPending_ = false;
+}
+
+// member function to wait for all writes to finish
+void outputManager::Finish() {
+  this->FinishOutput();
+  this->FinishRestart();
+}
+
+// destructor
+// restart writes need MPI, so they must be finished before MPI_Finalize
+outputManager::~outputManager() noexcept {
+  if (funWriter_.joinable()) {
+    funWriter_.join();
+  }
+}
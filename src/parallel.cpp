@@ -41,7 +41,7 @@ using std::make_unique;
 decomposition assumes that each block will reside on it's own processor.
 The processor list tells how many procBlocks a processor will have.
 */
-decomposition ManualDecomposition(vector<plot3dBlock> &grid,
+decomposition ManualDecomposition(vector<plot3dBlockRange> &grid,
                                   vector<boundaryConditions> &bcs,
                                   const int &numProc) {
   // grid -- vector of procBlocks (no need to split procBlocks or combine them
@@ -92,7 +92,7 @@ decomposition ManualDecomposition(vector<plot3dBlock> &grid,
 /* Function to return processor list for cubic decomposition.
 The processor list tells how many procBlocks a processor will have.
 */
-decomposition CubicDecomposition(vector<plot3dBlock> &grid,
+decomposition CubicDecomposition(vector<plot3dBlockRange> &grid,
                                  vector<boundaryConditions> &bcs,
                                  const int &numProc) {
   // grid -- vector of procBlocks (no need to split procBlocks or combine them
@@ -177,13 +177,6 @@ decomposition CubicDecomposition(vector<plot3dBlock> &grid,
   return decomp;
 }
 
-// function to send each processor the number of procBlocks that it should
-// contain
-void SendNumProcBlocks(const vector<int> &loadBal, int &numProcBlock) {
-  MPI_Scatter(&loadBal[0], 1, MPI_INT, &numProcBlock, 1, MPI_INT, ROOTP,
-              MPI_COMM_WORLD);
-}
-
 /* Function to set custom MPI datatypes to allow for easier data transmission */
 void SetDataTypesMPI(MPI_Datatype &MPI_vec3d,
                      MPI_Datatype &MPI_procBlockInts,
@@ -427,8 +420,9 @@ decomposition::decomposition(const int &num, const int &nProcs) {
 
 /*Member function to determine the ideal load given the mesh. The ideal load the
  * the total number of cells divided by the number of processors.*/
-double decomposition::IdealLoad(const vector<plot3dBlock> &grid) const {
-  // grid -- vector of plot3dBlocks containing entire grid
+double decomposition::IdealLoad(
+    const vector<plot3dBlockRange> &grid) const {
+  // grid -- vector of plot3dBlockRanges containing entire grid
 
   auto totalCells = 0;
   for (auto ii = 0U; ii < grid.size(); ii++) {
@@ -441,8 +435,9 @@ double decomposition::IdealLoad(const vector<plot3dBlock> &grid) const {
 
 /*Member function to determine the maximum load (number of cells) on a
  * processor.*/
-double decomposition::MaxLoad(const vector<plot3dBlock> &grid) const {
-  // grid -- vector of plot3dBlocks containing entire grid (split for
+double decomposition::MaxLoad(
+    const vector<plot3dBlockRange> &grid) const {
+  // grid -- vector of plot3dBlockRanges containing entire grid (split for
   // decomposition)
 
   vector<int> load(numProcs_, 0);
@@ -455,8 +450,9 @@ double decomposition::MaxLoad(const vector<plot3dBlock> &grid) const {
 
 /*Member function to determine the minimum load (number of cells) on a
  * processor.*/
-double decomposition::MinLoad(const vector<plot3dBlock> &grid) const {
-  // grid -- vector of plot3dBlocks containing entire grid (split for
+double decomposition::MinLoad(
+    const vector<plot3dBlockRange> &grid) const {
+  // grid -- vector of plot3dBlockRanges containing entire grid (split for
   // decomposition)
 
   vector<int> load(numProcs_, 0);
@@ -469,9 +465,9 @@ double decomposition::MinLoad(const vector<plot3dBlock> &grid) const {
 
 /*Member function to determine the index of the maximum loaded (number of cells)
  * processor.*/
-int decomposition::MostOverloadedProc(const vector<plot3dBlock> &grid,
-                                      double &overload) const {
-  // grid -- vector of plot3dBlocks containing entire grid (split for
+int decomposition::MostOverloadedProc(
+    const vector<plot3dBlockRange> &grid, double &overload) const {
+  // grid -- vector of plot3dBlockRanges containing entire grid (split for
   // decomposition)
   // overload -- how much the processor is overloaded by
 
@@ -486,9 +482,9 @@ int decomposition::MostOverloadedProc(const vector<plot3dBlock> &grid,
 
 /*Member function to determine the index of the minimum loaded (number of cells)
  * processor.*/
-int decomposition::MostUnderloadedProc(const vector<plot3dBlock> &grid,
-                                       double &underload) const {
-  // grid -- vector of plot3dBlocks containing entire grid (split for
+int decomposition::MostUnderloadedProc(
+    const vector<plot3dBlockRange> &grid, double &underload) const {
+  // grid -- vector of plot3dBlockRanges containing entire grid (split for
   // decomposition)
   // underload -- how much processor is underloaded by
 
@@ -576,6 +572,44 @@ void decomposition::Split(const int &low, const int &ind, const string &dir) {
   localPos_.push_back(this->NumBlocksOnProc(rank_[low]) - 1);
 }
 
+/* Member function to find the range of nodes in its parent block that each
+procBlock covers. The splits are replayed in the order they were made, so the
+ranges can be found from the parent block sizes alone. Lower and upper blocks
+in a split share the plane of nodes at the split index.
+*/
+vector<std::array<range, 3>> decomposition::NodeRanges(
+    const vector<vector3d<int>> &parentSizes) const {
+  // parentSizes -- number of nodes in i, j, k directions of parent blocks
+
+  vector<std::array<range, 3>> ranges;
+  ranges.reserve(this->NumBlocks());
+  for (const auto &ps : parentSizes) {
+    ranges.push_back({range(0, ps.X()), range(0, ps.Y()), range(0, ps.Z())});
+  }
+  if (static_cast<int>(ranges.size()) + this->NumSplits() !=
+      this->NumBlocks()) {
+    cerr << "ERROR: Error in decomposition::NodeRanges(). Number of parent "
+            "blocks does not match decomposition!" << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  for (auto ii = 0; ii < this->NumSplits(); ++ii) {
+    MSG_ASSERT(this->SplitHistBlkUpper(ii) == static_cast<int>(ranges.size()),
+               "upper block of split out of order");
+    const auto lower = this->SplitHistBlkLower(ii);
+    const auto ind = this->SplitHistIndex(ii);
+    const auto dir = this->SplitHistDir(ii);
+    const auto dd = (dir == "i") ? 0 : (dir == "j") ? 1 : 2;
+
+    auto upperRange = ranges[lower];
+    const auto start = ranges[lower][dd].Start();
+    upperRange[dd] = range(start + ind, ranges[lower][dd].End());
+    ranges[lower][dd] = range(start, start + ind + 1);
+    ranges.push_back(upperRange);
+  }
+  return ranges;
+}
+
 int decomposition::GlobalPos(const int &rank, const int &localPos) const {
   auto globalPos = -1;
   for (auto ii = 0U; ii < rank_.size(); ++ii) {
@@ -609,9 +643,9 @@ ostream &operator<<(ostream &os, const decomposition &d) {
   return os;
 }
 
-double decomposition::ProcLoad(const vector<plot3dBlock> &grid,
+double decomposition::ProcLoad(const vector<plot3dBlockRange> &grid,
                                const int &proc) const {
-  // grid -- vector of plot3dBlocks making up entire grid
+  // grid -- vector of plot3dBlockRanges making up entire grid
   // proc -- rank of processor to calculate load for
 
   auto load = 0;
@@ -623,9 +657,9 @@ double decomposition::ProcLoad(const vector<plot3dBlock> &grid,
   return static_cast<double>(load);
 }
 
-double decomposition::LoadRatio(const vector<plot3dBlock> &grid,
+double decomposition::LoadRatio(const vector<plot3dBlockRange> &grid,
                                 const int &proc) const {
-  // grid -- vector of plot3dBlocks making up entire grid
+  // grid -- vector of plot3dBlockRanges making up entire grid
   // proc -- rank of processor to calculate ratio for
 
   auto ideal = this->IdealLoad(grid);
@@ -638,10 +672,10 @@ from a given processor. If it is determined to send a split block, the index of
 the split is returned, and the direction string is changed to the appropriate
 value. If a whole block is to be sent, the index returned is -1.
 */
-int decomposition::SendWholeOrSplit(const vector<plot3dBlock> &grid,
-                                    const int &send, const int &recv, int &blk,
-                                    string &dir) const {
-  // grid -- vector of plot3dBlocks making up entire grid
+int decomposition::SendWholeOrSplit(const vector<plot3dBlockRange> &grid,
+                                    const int &send, const int &recv,
+                                    int &blk, string &dir) const {
+  // grid -- vector of plot3dBlockRanges making up entire grid
   // send -- rank of processor to sending block
   // recv -- rank of process to receive block
   // blk -- block to split or send
@@ -725,7 +759,8 @@ int decomposition::SendWholeOrSplit(const vector<plot3dBlock> &grid,
 }
 
 
-void decomposition::PrintDiagnostics(const vector<plot3dBlock> &grid) const {
+void decomposition::PrintDiagnostics(
+    const vector<plot3dBlockRange> &grid) const {
   cout << "Decomposition for " << numProcs_ << " processors" << endl;
   for (auto ii = 0U; ii < rank_.size(); ii++) {
     cout << "Block: " << ii << "; Rank: " << rank_[ii]
@@ -798,15 +833,124 @@ void decomposition::Broadcast() {
   MPI_Bcast(&numProcs_, 1, MPI_INT, ROOTP, MPI_COMM_WORLD);
 }
 
-void BroadcastViscFaces(const MPI_Datatype &MPI_vec3d,
+/*Member function to find the size of the buffer needed to pack a
+ * decomposition*/
+int decomposition::PackSize() const {
+  // number of procBlocks, number of splits, and number of processors
+  auto bufSize = 0;
+  auto tempSize = 0;
+  MPI_Pack_size(3, MPI_INT, MPI_COMM_WORLD, &tempSize);
+  bufSize += tempSize;
+  // rank, parent block, and local position of each procBlock
+  MPI_Pack_size(3 * this->NumBlocks(), MPI_INT, MPI_COMM_WORLD, &tempSize);
+  bufSize += tempSize;
+  // lower block, upper block, and index of each split
+  MPI_Pack_size(3 * this->NumSplits(), MPI_INT, MPI_COMM_WORLD, &tempSize);
+  bufSize += tempSize;
+  // direction of each split is a single character
+  MPI_Pack_size(this->NumSplits(), MPI_CHAR, MPI_COMM_WORLD, &tempSize);
+  bufSize += tempSize;
+  return bufSize;
+}
+
+// member function to pack a decomposition into a buffer
+void decomposition::Pack(char *(&buffer), const int &bufSize,
+                         int &position) const {
+  // buffer -- buffer to pack data into
+  // bufSize -- size of buffer
+  // position -- location within buffer
+
+  const int sizes[3] = {this->NumBlocks(), this->NumSplits(), numProcs_};
+  MPI_Pack(sizes, 3, MPI_INT, buffer, bufSize, &position, MPI_COMM_WORLD);
+  MPI_Pack(rank_.data(), rank_.size(), MPI_INT, buffer, bufSize, &position,
+           MPI_COMM_WORLD);
+  MPI_Pack(parBlock_.data(), parBlock_.size(), MPI_INT, buffer, bufSize,
+           &position, MPI_COMM_WORLD);
+  MPI_Pack(localPos_.data(), localPos_.size(), MPI_INT, buffer, bufSize,
+           &position, MPI_COMM_WORLD);
+  MPI_Pack(splitHistBlkLow_.data(), splitHistBlkLow_.size(), MPI_INT, buffer,
+           bufSize, &position, MPI_COMM_WORLD);
+  MPI_Pack(splitHistBlkUp_.data(), splitHistBlkUp_.size(), MPI_INT, buffer,
+           bufSize, &position, MPI_COMM_WORLD);
+  MPI_Pack(splitHistIndex_.data(), splitHistIndex_.size(), MPI_INT, buffer,
+           bufSize, &position, MPI_COMM_WORLD);
+  for (const auto &dir : splitHistDir_) {
+    MPI_Pack(dir.data(), 1, MPI_CHAR, buffer, bufSize, &position,
+             MPI_COMM_WORLD);
+  }
+}
+
+// member function to unpack a decomposition from a buffer
+void decomposition::Unpack(char *(&buffer), const int &bufSize,
+                           int &position) {
+  // buffer -- buffer to unpack data from
+  // bufSize -- size of buffer
+  // position -- location within buffer
+
+  int sizes[3] = {0, 0, 0};
+  MPI_Unpack(buffer, bufSize, &position, sizes, 3, MPI_INT, MPI_COMM_WORLD);
+  numProcs_ = sizes[2];
+  rank_.resize(sizes[0]);
+  parBlock_.resize(sizes[0]);
+  localPos_.resize(sizes[0]);
+  MPI_Unpack(buffer, bufSize, &position, rank_.data(), sizes[0], MPI_INT,
+             MPI_COMM_WORLD);
+  MPI_Unpack(buffer, bufSize, &position, parBlock_.data(), sizes[0], MPI_INT,
+             MPI_COMM_WORLD);
+  MPI_Unpack(buffer, bufSize, &position, localPos_.data(), sizes[0], MPI_INT,
+             MPI_COMM_WORLD);
+  splitHistBlkLow_.resize(sizes[1]);
+  splitHistBlkUp_.resize(sizes[1]);
+  splitHistIndex_.resize(sizes[1]);
+  splitHistDir_.resize(sizes[1]);
+  MPI_Unpack(buffer, bufSize, &position, splitHistBlkLow_.data(), sizes[1],
+             MPI_INT, MPI_COMM_WORLD);
+  MPI_Unpack(buffer, bufSize, &position, splitHistBlkUp_.data(), sizes[1],
+             MPI_INT, MPI_COMM_WORLD);
+  MPI_Unpack(buffer, bufSize, &position, splitHistIndex_.data(), sizes[1],
+             MPI_INT, MPI_COMM_WORLD);
+  for (auto &dir : splitHistDir_) {
+    auto dirChar = 'i';
+    MPI_Unpack(buffer, bufSize, &position, &dirChar, 1, MPI_CHAR,
+               MPI_COMM_WORLD);
+    dir = string(1, dirChar);
+  }
+}
+
+/* Function to gather the viscous face centers found on each processor onto
+all processors. Each processor only has the faces of its own blocks, but the
+wall distance calculation needs all of them.
+*/
+void AllGatherViscFaces(const MPI_Datatype &MPI_vec3d,
                         vector<vector3d<double>> &viscFaces) {
-  // first determine the number of viscous faces and send that to all processors
+  // first determine the number of viscous faces on each processor
+  auto numProcs = 1;
+  MPI_Comm_size(MPI_COMM_WORLD, &numProcs);
   auto nFaces = static_cast<int>(viscFaces.size());
-  MPI_Bcast(&nFaces, 1, MPI_INT, ROOTP, MPI_COMM_WORLD);
+  vector<int> procFaces(numProcs, 0);
+  MPI_Allgather(&nFaces, 1, MPI_INT, procFaces.data(), 1, MPI_INT,
+                MPI_COMM_WORLD);
 
-  viscFaces.resize(nFaces);  // allocate space to receive the viscous faces
+  vector<int> displacements(numProcs, 0);
+  for (auto ii = 1; ii < numProcs; ++ii) {
+    displacements[ii] = displacements[ii - 1] + procFaces[ii - 1];
+  }
+  const auto totalFaces = displacements.back() + procFaces.back();
+
+  // gather all viscous faces on all processors
+  const auto localFaces = viscFaces;
+  viscFaces.resize(totalFaces);  // allocate space to receive the viscous faces
+  MPI_Allgatherv(localFaces.data(), nFaces, MPI_vec3d, viscFaces.data(),
+                 procFaces.data(), displacements.data(), MPI_vec3d,
+                 MPI_COMM_WORLD);
+}
 
-  // broadcast all viscous faces to all processors
-  MPI_Bcast(&viscFaces[0], viscFaces.size(), MPI_vec3d, ROOTP,
-            MPI_COMM_WORLD);
+// function to broadcast the number of nodes in each block of the grid file
+void BroadcastGridSizes(vector<vector3d<int>> &gridSizes) {
+  auto numBlks = static_cast<int>(gridSizes.size());
+  MPI_Bcast(&numBlks, 1, MPI_INT, ROOTP, MPI_COMM_WORLD);
+  gridSizes.resize(numBlks);
+  for (auto &gs : gridSizes) {
+    MPI_Bcast(&gs[0], 3, MPI_INT, ROOTP, MPI_COMM_WORLD);
+  }
 }
@@ -359,24 +359,13 @@ multiArray3d<vector3d<double>> plot3dBlock::FaceCenterK() const {
 }
 
 //------------------------------------------------------------------------------
-// function to read in a plot3d grid and assign it to a plot3dMesh data type
-vector<plot3dBlock> ReadP3dGrid(const string &gridName, const double &LRef,
-                                double &numCells) {
-  // open binary plot3d grid file
-  ifstream fName;
-  string fPostfix = ".xyz";
-  auto readName = gridName + fPostfix;
-  fName.open(readName, ios::in | ios::binary);
-
-  // check to see if file opened correctly
-  if (fName.fail()) {
-    cerr << "ERROR: Error in plot3d.cpp:ReadP3dGrid(). Grid file " << readName
-         << " did not open correctly!!!" << endl;
-    exit(EXIT_FAILURE);
-  }
+// function to read the number of nodes in each block from the header of a
+// plot3d grid file
+vector<vector3d<int>> ReadP3dBlockSizes(ifstream &fName, double &numCells) {
+  // fName -- grid file positioned at start of header
+  // numCells -- total number of cells in grid
 
   // read the number of plot3d blocks in the file
-  cout << "Reading grid file..." << endl << endl;
   auto numBlks = 1;
   fName.read(reinterpret_cast<char *>(&numBlks), sizeof(numBlks));
   cout << "Number of blocks: " << numBlks << endl << endl;
@@ -406,44 +395,180 @@ vector<plot3dBlock> ReadP3dGrid(const string &gridName, const double &LRef,
         (blkSize[ii][0] - 1) * (blkSize[ii][1] - 1) * (blkSize[ii][2] - 1);
   }
   cout << endl;
+  return blkSize;
+}
 
-  // read each block and add it to the vector of plot3dBlocks
-  auto tempDouble = 0.0;
-  vector<plot3dBlock> mesh;
-  mesh.reserve(numBlks);
+// constructor -- open a plot3d grid file and read its header
+plot3dFile::plot3dFile(const string &gridName, const double &LRef)
+    : lRef_(LRef), numCells_(0.0) {
+  // gridName -- name of grid file (without .xyz)
+  // LRef -- reference length to nondimensionalize coordinates by
 
-  for (auto ii = 0; ii < numBlks; ii++) {
-    multiArray3d<vector3d<double>> coordinates(blkSize[ii][0], blkSize[ii][1],
-                                               blkSize[ii][2], 0);
+  const auto readName = gridName + ".xyz";
+  file_.open(readName, ios::in | ios::binary);
+  if (file_.fail()) {
+    cerr << "ERROR: Error in plot3dFile::plot3dFile(). Grid file " << readName
+         << " did not open correctly!!!" << endl;
+    exit(EXIT_FAILURE);
+  }
 
-    for (auto jj = 0; jj < coordinates.Size(); jj++) {
-      fName.read(reinterpret_cast<char *>(&tempDouble), sizeof(tempDouble));
-      coordinates(jj)[0] = tempDouble / LRef;
-    }
-    for (auto jj = 0; jj < coordinates.Size(); jj++) {
-      fName.read(reinterpret_cast<char *>(&tempDouble), sizeof(tempDouble));
-      coordinates(jj)[1] = tempDouble / LRef;
-    }
-    for (auto jj = 0; jj < coordinates.Size(); jj++) {
-      fName.read(reinterpret_cast<char *>(&tempDouble), sizeof(tempDouble));
-      coordinates(jj)[2] = tempDouble / LRef;
-    }
+  cout << "Reading grid file header..." << endl << endl;
+  blkSize_ = ReadP3dBlockSizes(file_, numCells_);
+  cout << "Total number of cells is " << numCells_ << endl << endl;
+
+  // coordinates of each block follow the header
+  blkStart_.reserve(blkSize_.size());
+  std::streamoff offset = sizeof(int) * (1 + 3 * blkSize_.size());
+  for (const auto &size : blkSize_) {
+    blkStart_.push_back(offset);
+    offset += static_cast<std::streamoff>(3 * sizeof(double)) * size.X() *
+              size.Y() * size.Z();
+  }
+}
 
-    // create single plot3dBlock and assign it appropriate location in vector
-    mesh.push_back(plot3dBlock(coordinates));
+// member function to get the nondimensional coordinates of a node
+vector3d<double> plot3dFile::Coords(const int &blk, const int &ii,
+                                    const int &jj, const int &kk) const {
+  // blk -- block in grid file
+  // ii -- i-index of node
+  // jj -- j-index of node
+  // kk -- k-index of node
+
+  const std::array<int, 4> key = {blk, ii, jj, kk};
+  const auto found = nodes_.find(key);
+  if (found != nodes_.end()) {
+    return found->second;
+  }
 
-    cout << "Block " << ii << " read" << endl;
+  // each coordinate is stored contiguously for the whole block
+  const auto &size = blkSize_[blk];
+  const auto numNodes =
+      static_cast<std::streamoff>(size.X()) * size.Y() * size.Z();
+  const auto index =
+      (static_cast<std::streamoff>(kk) * size.Y() + jj) * size.X() + ii;
+  vector3d<double> coords;
+  for (auto dd = 0; dd < 3; ++dd) {
+    auto value = 0.0;
+    file_.seekg(blkStart_[blk] + (dd * numNodes + index) * sizeof(double));
+    file_.read(reinterpret_cast<char *>(&value), sizeof(value));
+    coords[dd] = value / lRef_;
+  }
+  if (file_.fail()) {
+    cerr << "ERROR: Error in plot3dFile::Coords(). Could not read node " << ii
+         << ", " << jj << ", " << kk << " of block " << blk << endl;
+    exit(EXIT_FAILURE);
   }
 
-  cout << endl << "Grid file read" << endl;
-  cout << "Total number of cells is " << numCells << endl;
+  nodes_.insert(std::make_pair(key, coords));
+  return coords;
+}
 
-  // close plot3d grid file
-  fName.close();
+// member function to get the node ranges of all blocks in the grid file
+vector<plot3dBlockRange> plot3dFile::Blocks() const {
+  vector<plot3dBlockRange> blks;
+  blks.reserve(blkSize_.size());
+  for (auto ii = 0U; ii < blkSize_.size(); ++ii) {
+    blks.emplace_back(*this, ii, vector3d<int>(0, 0, 0), blkSize_[ii]);
+  }
+  return blks;
+}
 
-  return mesh;
+/* Member function to split a plot3dBlockRange along a plane defined by a
+direction and an index. The calling instance becomes the lower portion of the
+split, and the upper portion is returned. This matches plot3dBlock::Split().
+*/
+plot3dBlockRange plot3dBlockRange::Split(const string &dir, const int &ind) {
+  // dir -- plane to split along, either i, j, or k
+  // ind -- index (face) to split at (w/o counting ghost cells)
+
+  const auto dd = (dir == "i") ? 0 : (dir == "j") ? 1 : (dir == "k") ? 2 : -1;
+  if (dd < 0) {
+    cerr << "ERROR: Error in plot3dBlockRange::Split(). Direction " << dir
+         << " is not recognized! Choose either i, j, or k." << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  auto upper = *this;
+  upper.start_[dd] += ind;
+  upper.size_[dd] -= ind;
+  size_[dd] = ind + 1;
+  return upper;
 }
 
+/* Function to read only the portions of a plot3d grid that are on the given
+processor. The decomposition is found on the ROOT processor, so here each
+processor reads the node ranges of its own blocks directly from the grid file
+with MPI-IO. The blocks are returned in order of local position.
+*/
+vector<plot3dBlock> ReadP3dGridPar(const string &gridName, const double &LRef,
+                                   const vector<vector3d<int>> &gridSizes,
+                                   const decomposition &decomp,
+                                   const int &rank) {
+  // gridName -- name of grid file (without .xyz)
+  // LRef -- reference length to nondimensionalize coordinates by
+  // gridSizes -- number of nodes in each parent block of the grid file
+  // decomp -- decomposition of grid onto processors
+  // rank -- processor rank
+
+  const auto readName = gridName + ".xyz";
+  MPI_File fh;
+  if (MPI_File_open(MPI_COMM_WORLD, readName.c_str(), MPI_MODE_RDONLY,
+                    MPI_INFO_NULL, &fh) != MPI_SUCCESS) {
+    cerr << "ERROR: Error in plot3d.cpp:ReadP3dGridPar(). Grid file "
+         << readName << " did not open correctly!!!" << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  // header has the number of blocks and the i, j, k dimensions of each block
+  vector<MPI_Offset> blockOffset(gridSizes.size());
+  MPI_Offset offset = sizeof(int) * (1 + 3 * gridSizes.size());
+  for (auto ii = 0U; ii < gridSizes.size(); ++ii) {
+    blockOffset[ii] = offset;
+    offset += static_cast<MPI_Offset>(3 * sizeof(double)) * gridSizes[ii].X() *
+              gridSizes[ii].Y() * gridSizes[ii].Z();
+  }
+
+  const auto ranges = decomp.NodeRanges(gridSizes);
+  vector<plot3dBlock> mesh(decomp.NumBlocksOnProc(rank));
+  for (auto gp = 0; gp < decomp.NumBlocks(); ++gp) {
+    if (decomp.Rank(gp) != rank) {
+      continue;
+    }
+    const auto par = decomp.ParentBlock(gp);
+    const auto &size = gridSizes[par];
+    const auto &ir = ranges[gp][0];
+    const auto &jr = ranges[gp][1];
+    const auto &kr = ranges[gp][2];
+    multiArray3d<vector3d<double>> coordinates(ir.Size(), jr.Size(),
+                                               kr.Size(), 0);
+
+    // read all rows of the block in each k-plane in one piece; nodes outside
+    // of the i-range are discarded
+    vector<double> buffer(size.X() * jr.Size());
+    const auto planeSize = static_cast<MPI_Offset>(size.X()) * size.Y();
+    for (auto dd = 0; dd < 3; ++dd) {
+      const auto dirOffset = blockOffset[par] + static_cast<MPI_Offset>(
+          dd * sizeof(double)) * planeSize * size.Z();
+      for (auto kk = kr.Start(); kk < kr.End(); ++kk) {
+        const auto readOffset =
+            dirOffset + static_cast<MPI_Offset>(sizeof(double)) *
+                            (kk * planeSize + jr.Start() * size.X());
+        MPI_File_read_at(fh, readOffset, buffer.data(), buffer.size(),
+                         MPI_DOUBLE, MPI_STATUS_IGNORE);
+        for (auto jj = jr.Start(); jj < jr.End(); ++jj) {
+          for (auto ii = ir.Start(); ii < ir.End(); ++ii) {
+            coordinates(ii - ir.Start(), jj - jr.Start(), kk - kr.Start())[dd] =
+                buffer[(jj - jr.Start()) * size.X() + ii] / LRef;
+          }
+        }
+      }
+    }
+    mesh[decomp.LocalPosition(gp)] = plot3dBlock(coordinates);
+  }
+
+  MPI_File_close(&fh);
+  return mesh;
+}
 
 /* Member function to split a plot3dBlock along a plane defined by a direction
 and an index.
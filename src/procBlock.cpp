@@ -21,6 +21,9 @@
 #include <memory>
 #include <utility>
 #include <map>
+#include <limits>                 // numeric_limits
+#include <array>                  // array
+#include <cmath>                  // isfinite
 #include "procBlock.hpp"
 #include "plot3d.hpp"              // plot3d
 #include "eos.hpp"                 // equation of state
@@ -44,6 +47,7 @@
 #include "matMultiArray3d.hpp"
 #include "physicsModels.hpp"
 #include "output.hpp"
+#include "haloExchange.hpp"
 
 using std::cout;
 using std::endl;
@@ -354,12 +358,17 @@ void procBlock::InitializeStates(const input &inp, const physics &phys) {
   }
 }
 
-/* Function to calculate the inviscid fluxes on the i-faces. All phyiscal
-(non-ghost) i-faces are looped over. The left and right states are
-calculated, and then the flux at the face is calculated. The flux at the
-face contributes to the residual of the cells to the left and right of
-the face. This contribution from the flux is added to the residuals and
-the wave speed is accumulated as well.
+/* Function to calculate the inviscid fluxes on the faces in the given
+direction. The block is swept one pencil at a time, where a pencil is a line of
+cells (including ghost cells) running in the flux direction. For each pencil
+the cell states, cell widths, and face areas are gathered into contiguous
+buffers. The left and right states are then reconstructed at all physical
+faces of the pencil, and the flux at each face is calculated and stored.
+Lastly, a single pass is made over the cells of the pencil to difference the
+face fluxes into the residual and accumulate the wave speed. Gathering the
+pencil first means that the reconstruction and flux calculations always operate
+on contiguous memory, even for the j and k directions where neighboring cells
+are strided in the block.
   ___________________________
   |            |            |
   |            |            |
@@ -370,121 +379,205 @@ Ui-1/2       Ui+1/2       Ui+3/2
 
 Using the above diagram, the flux is calculated at face Ui+1/2. Since the area
 vector at the face always points from lower indices to higher indices it
-points from Ui to Ui+1. For the residual calculation the convention is for the area
-vector to point out of the cell. Therefore it is in the correct position for the
-residual at Ui, but the sign needs to be flipped when adding the contribution of
-the flux to the residual at Ui+1.
-
-The spectral radius in the i-direction is also calculated. Since this is done on
-a cell basis instead of a face bases, it is only calculated for the upper cell
-(Ui+1 in this case). The spectral radius is added to the average wave speed
+points from Ui to Ui+1. For the residual calculation the convention is for the
+area vector to point out of the cell. Therefore it is in the correct position
+for the residual at Ui, but the sign needs to be flipped when adding the
+contribution of the flux to the residual at Ui+1. The residual contribution at
+Ui is therefore the flux at Ui+1/2 minus the flux at Ui-1/2.
+
+The spectral radius in the sweep direction is also calculated. Since this is
+done on a cell basis instead of a face bases, it uses the lower and upper face
+areas of each cell. The spectral radius is added to the average wave speed
 variable and is eventually used in the time step calculation if the time step
 isn't explicitly specified.
+
+The flux scheme, reconstruction method, and limiter are template parameters so
+that each combination is compiled into its own kernel. CalcInvFlux selects the
+kernel to use based on the methods chosen in the input file.
 */
-void procBlock::CalcInvFluxI(const physics &phys, const input &inp,
-                             matMultiArray3d &mainDiagonal) {
+template <inviscidFluxMethod F, reconstructionMethod R, limiterMethod L>
+void procBlock::CalcInvFluxPencils(const string &dir, const physics &phys,
+                                   const input &inp,
+                                   matMultiArray3d &mainDiagonal) {
+  // dir -- direction of faces to calculate fluxes on (i, j, k)
   // phys -- physics models
   // inp -- all input variables
   // mainDiagonal -- main diagonal of LHS to store flux jacobians for implicit
   //                 solver
 
-  // loop over all physical i-faces
-  for (auto kk = fAreaI_.PhysStartK(); kk < fAreaI_.PhysEndK(); kk++) {
-    for (auto jj = fAreaI_.PhysStartJ(); jj < fAreaI_.PhysEndJ(); jj++) {
-      for (auto ii = fAreaI_.PhysStartI(); ii < fAreaI_.PhysEndI(); ii++) {
-        primitive faceStateLower;
-        primitive faceStateUpper;
-
-        // use constant reconstruction (first order)
-        if (inp.OrderOfAccuracy() == "first") {
-          faceStateLower = FaceReconConst(state_(ii - 1, jj, kk));
-          faceStateUpper = FaceReconConst(state_(ii, jj, kk));
-        } else {  // second order accuracy
-          if (inp.UsingMUSCLReconstruction()) {
-            faceStateLower = FaceReconMUSCL(
-                state_(ii - 2, jj, kk), state_(ii - 1, jj, kk),
-                state_(ii, jj, kk), inp.Kappa(), inp.Limiter(),
-                cellWidthI_(ii - 2, jj, kk), cellWidthI_(ii - 1, jj, kk),
-                cellWidthI_(ii, jj, kk));
+  // direction 1 is the sweep direction, directions 2 and 3 are the remaining
+  // directions in cyclic order
+  auto d1Ind = 0;
+  if (dir == "i") {
+    d1Ind = 0;
+  } else if (dir == "j") {
+    d1Ind = 1;
+  } else if (dir == "k") {
+    d1Ind = 2;
+  } else {
+    cerr << "ERROR: Error in procBlock::CalcInvFlux. Direction " << dir
+         << " is not recognized!" << endl;
+    exit(EXIT_FAILURE);
+  }
+  // convert direction 1, 2, 3 indices to i, j, k indices
+  const auto ijk = [&d1Ind](const int &d1, const int &d2, const int &d3) {
+    std::array<int, 3> ind;
+    ind[d1Ind] = d1;
+    ind[(d1Ind + 1) % 3] = d2;
+    ind[(d1Ind + 2) % 3] = d3;
+    return ind;
+  };
+
+  const auto &fArea = (d1Ind == 0) ? fAreaI_ : (d1Ind == 1) ? fAreaJ_ : fAreaK_;
+  const auto &cellWidth =
+      (d1Ind == 0) ? cellWidthI_ : (d1Ind == 1) ? cellWidthJ_ : cellWidthK_;
+
+  const std::array<int, 3> numCells = {this->NumI(), this->NumJ(),
+                                       this->NumK()};
+  const auto numD1 = numCells[d1Ind];
+  const auto numD2 = numCells[(d1Ind + 1) % 3];
+  const auto numD3 = numCells[(d1Ind + 2) % 3];
+  const auto numPencilCells = numD1 + 2 * numGhosts_;
+  const auto numFaces = numD1 + 1;
+  const auto numEqns = state_.BlockSize();
+  const auto numSpecies = state_.BlockInfo().second;
+
+  const auto stateStride = state_.Stride(dir);
+  const auto widthStride = cellWidth.Stride(dir);
+  const auto areaStride = fArea.Stride(dir);
+  const auto residStride = residual_.Stride(dir);
+
+  // options are constant over all faces
+  constexpr auto isWenoZ = R == reconstructionMethod::wenoZ;
+  const auto kappa = inp.Kappa();
+  const auto isBlockMatrix = inp.IsBlockMatrix() && !mainDiagonal.IsEmpty();
+  const auto isImplicit = inp.IsImplicit() && !mainDiagonal.IsEmpty();
+
+  // pencils are independent of each other, so they are divided among threads;
+  // each thread has its own pencil buffers which are reused for all of its
+  // pencils
+#pragma omp parallel
+  {
+    vector<double> states(numPencilCells * numEqns);
+    vector<double> widths(numPencilCells);
+    vector<unitVec3dMag<double>> areas(numFaces);
+    vector<primitive> faceStateLower(numFaces);
+    vector<primitive> faceStateUpper(numFaces);
+    vector<varArray> faceFlux(numFaces);
+
+    // view of state in pencil buffer, cell index is relative to first physical
+    // cell
+    const auto pencilState = [&](const int &cc) {
+      const auto start = states.cbegin() + (cc + numGhosts_) * numEqns;
+      return primitiveView(start, start + numEqns, numSpecies);
+    };
+    const auto pencilWidth = [&](const int &cc) -> const double & {
+      return widths[cc + numGhosts_];
+    };
+
+    // loop over all pencils in sweep direction
+#pragma omp for collapse(2) schedule(static)
+    for (auto d3 = 0; d3 < numD3; ++d3) {
+      for (auto d2 = 0; d2 < numD2; ++d2) {
+        // gather states, widths, and face areas into pencil buffers
+        const auto ghost = ijk(-numGhosts_, d2, d3);
+        const auto stateStart = state_.GetLoc1D(ghost[0], ghost[1], ghost[2]);
+        const auto widthStart =
+            cellWidth.GetLoc1D(ghost[0], ghost[1], ghost[2]);
+        for (auto cc = 0; cc < numPencilCells; ++cc) {
+          std::copy_n(state_.begin() + stateStart + cc * stateStride, numEqns,
+                      states.begin() + cc * numEqns);
+          widths[cc] = cellWidth(widthStart + cc * widthStride);
+        }
 
-            faceStateUpper = FaceReconMUSCL(
-                state_(ii + 1, jj, kk), state_(ii, jj, kk),
-                state_(ii - 1, jj, kk), inp.Kappa(), inp.Limiter(),
-                cellWidthI_(ii + 1, jj, kk), cellWidthI_(ii, jj, kk),
-                cellWidthI_(ii - 1, jj, kk));
+        const auto first = ijk(0, d2, d3);
+        const auto areaStart = fArea.GetLoc1D(first[0], first[1], first[2]);
+        for (auto ff = 0; ff < numFaces; ++ff) {
+          areas[ff] = fArea(areaStart + ff * areaStride);
+        }
 
+        // reconstruct states at all faces in pencil
+        // face ff is between cells ff - 1 and ff
+        for (auto ff = 0; ff < numFaces; ++ff) {
+          if (R == reconstructionMethod::constant) {  // first order
+            faceStateLower[ff] = FaceReconConst(pencilState(ff - 1));
+            faceStateUpper[ff] = FaceReconConst(pencilState(ff));
+          } else if (R == reconstructionMethod::muscl) {  // second order
+            faceStateLower[ff] = FaceReconMUSCL<L>(
+                pencilState(ff - 2), pencilState(ff - 1), pencilState(ff),
+                kappa, pencilWidth(ff - 2), pencilWidth(ff - 1),
+                pencilWidth(ff));
+
+            faceStateUpper[ff] = FaceReconMUSCL<L>(
+                pencilState(ff + 1), pencilState(ff), pencilState(ff - 1),
+                kappa, pencilWidth(ff + 1), pencilWidth(ff),
+                pencilWidth(ff - 1));
           } else {  // using higher order reconstruction (weno, wenoz)
-            faceStateLower = FaceReconWENO(
-                state_(ii - 3, jj, kk), state_(ii - 2, jj, kk),
-                state_(ii - 1, jj, kk), state_(ii, jj, kk),
-                state_(ii + 1, jj, kk), cellWidthI_(ii - 3, jj, kk),
-                cellWidthI_(ii - 2, jj, kk), cellWidthI_(ii - 1, jj, kk),
-                cellWidthI_(ii, jj, kk), cellWidthI_(ii + 1, jj, kk),
-                inp.IsWenoZ());
-
-            faceStateUpper = FaceReconWENO(
-                state_(ii + 2, jj, kk), state_(ii + 1, jj, kk),
-                state_(ii, jj, kk), state_(ii - 1, jj, kk),
-                state_(ii - 2, jj, kk), cellWidthI_(ii + 2, jj, kk),
-                cellWidthI_(ii + 1, jj, kk), cellWidthI_(ii, jj, kk),
-                cellWidthI_(ii - 1, jj, kk), cellWidthI_(ii - 2, jj, kk),
-                inp.IsWenoZ());
+            faceStateLower[ff] = FaceReconWENO(
+                pencilState(ff - 3), pencilState(ff - 2), pencilState(ff - 1),
+                pencilState(ff), pencilState(ff + 1), pencilWidth(ff - 3),
+                pencilWidth(ff - 2), pencilWidth(ff - 1), pencilWidth(ff),
+                pencilWidth(ff + 1), isWenoZ);
+
+            faceStateUpper[ff] = FaceReconWENO(
+                pencilState(ff + 2), pencilState(ff + 1), pencilState(ff),
+                pencilState(ff - 1), pencilState(ff - 2), pencilWidth(ff + 2),
+                pencilWidth(ff + 1), pencilWidth(ff), pencilWidth(ff - 1),
+                pencilWidth(ff - 2), isWenoZ);
           }
+          MSG_ASSERT(faceStateLower[ff].Rho() > 0.0, "nonphysical density");
+          MSG_ASSERT(faceStateLower[ff].P() > 0.0, "nonphysical pressure");
+          MSG_ASSERT(faceStateUpper[ff].Rho() > 0.0, "nonphysical density");
+          MSG_ASSERT(faceStateUpper[ff].P() > 0.0, "nonphysical pressure");
         }
-        MSG_ASSERT(faceStateLower.Rho() > 0.0, "nonphysical density");
-        MSG_ASSERT(faceStateLower.P() > 0.0, "nonphysical pressure");
-        MSG_ASSERT(faceStateUpper.Rho() > 0.0, "nonphysical density");
-        MSG_ASSERT(faceStateUpper.P() > 0.0, "nonphysical pressure");
 
-        // calculate inviscid flux at face
-        const inviscidFlux tempFlux =
-            InviscidFlux(faceStateLower, faceStateUpper, phys,
-                         this->FAreaUnitI(ii, jj, kk), inp.InviscidFlux());
-
-        // area vector points from left to right, so add to left cell, subtract
-        // from right cell
-        // at left boundary there is no left cell to add to
-        if (ii > fAreaI_.PhysStartI()) {
-          this->AddToResidual(ii - 1, jj, kk,
-                              tempFlux * this->FAreaMagI(ii, jj, kk));
-
-          // if using a block matrix on main diagonal, accumulate flux jacobian
-          if (inp.IsBlockMatrix()) {
-            fluxJacobian fluxJac;
-            fluxJac.RusanovFluxJacobian(faceStateLower, phys,
-                                        this->FAreaI(ii, jj, kk), true, inp);
-            mainDiagonal.Add(ii - 1, jj, kk, fluxJac);
-          }
+        // calculate inviscid flux at all faces in pencil
+        for (auto ff = 0; ff < numFaces; ++ff) {
+          faceFlux[ff] = InviscidFlux<F>(faceStateLower[ff], faceStateUpper[ff],
+                                         phys, areas[ff].UnitVector()) *
+                         areas[ff].Mag();
         }
 
-        // at right boundary there is no right cell to add to
-        if (ii < fAreaI_.PhysEndI() - 1) {
-          this->SubtractFromResidual(ii, jj, kk,
-                                     tempFlux * this->FAreaMagI(ii, jj, kk));
+        // difference face fluxes into residual of physical cells
+        // area vector points from lower to upper cell, so flux at upper face is
+        // added, and flux at lower face is subtracted
+        const auto residStart =
+            residual_.GetLoc1D(first[0], first[1], first[2]);
+        for (auto cc = 0; cc < numD1; ++cc) {
+          const auto loc = residStart + cc * residStride;
+          for (auto bb = 0; bb < numEqns; ++bb) {
+            residual_[loc + bb] -= faceFlux[cc][bb];
+            residual_[loc + bb] += faceFlux[cc + 1][bb];
+          }
 
-          // calculate component of wave speed. This is done on a cell by cell
-          // basis, so only at the upper faces
+          // calculate component of wave speed
+          const auto state = pencilState(cc);
           const auto invSpecRad =
-              InvCellSpectralRadius(state_(ii, jj, kk), fAreaI_(ii, jj, kk),
-                                    fAreaI_(ii + 1, jj, kk), phys);
+              InvCellSpectralRadius(state, areas[cc], areas[cc + 1], phys);
 
           const auto turbInvSpecRad =
               isRANS_ ? phys.Turbulence()->InviscidCellSpecRad(
-                            state_(ii, jj, kk), fAreaI_(ii, jj, kk),
-                            fAreaI_(ii + 1, jj, kk))
+                            state, areas[cc], areas[cc + 1])
                       : 0.0;
 
           const uncoupledScalar specRad(invSpecRad, turbInvSpecRad);
-          specRadius_(ii, jj, kk) += specRad;
+          const auto cell = ijk(cc, d2, d3);
+          specRadius_(cell[0], cell[1], cell[2]) += specRad;
 
           // if using a block matrix on main diagonal, accumulate flux jacobian
-          if (inp.IsBlockMatrix()) {
-            fluxJacobian fluxJac;
-            fluxJac.RusanovFluxJacobian(faceStateUpper, phys,
-                                        this->FAreaI(ii, jj, kk), false, inp);
-            mainDiagonal.Subtract(ii, jj, kk, fluxJac);
-          } else if (inp.IsImplicit()) {
-            mainDiagonal.Add(ii, jj, kk, fluxJacobian(specRad, isRANS_));
+          if (isBlockMatrix) {
+            fluxJacobian lowerJac;
+            lowerJac.RusanovFluxJacobian(faceStateUpper[cc], phys, areas[cc],
+                                         false, inp);
+            mainDiagonal.Subtract(cell[0], cell[1], cell[2], lowerJac);
+
+            fluxJacobian upperJac;
+            upperJac.RusanovFluxJacobian(faceStateLower[cc + 1], phys,
+                                         areas[cc + 1], true, inp);
+            mainDiagonal.Add(cell[0], cell[1], cell[2], upperJac);
+          } else if (isImplicit) {
+            mainDiagonal.Add(cell[0], cell[1], cell[2],
+                             fluxJacobian(specRad, isRANS_));
           }
         }
       }
@@ -492,279 +585,67 @@ void procBlock::CalcInvFluxI(const physics &phys, const input &inp,
   }
 }
 
-/* Function to calculate the inviscid fluxes on the j-faces. All physical
-(non-ghost) j-faces are looped over. The left and right states are
-calculated, and then the flux at the face is calculated. The flux at the
-face contributes to the residual of the cells to the left and right of the
-face. This contribution from the flux is added to the residuals and the wave
-speed is accumulated as well.
-  ___________________________
-  |            |            |
-  |            |            |
-  |   Uj       -->   Uj+1   |
-  |            |            |
-  |____________|____________|
-Uj-1/2       Uj+1/2       Uj+3/2
-
-Using the above diagram, the flux is calculated at face Uj+1/2. Since the area
-vector at the face always points from lower indices to higher indices it points
-from Uj to Uj+1. For the residual calculation the convention is for the area
-vector to point out of the cell. Therefore it is in the correct position for the
-residual at Uj, but the sign needs to be flipped when adding the contribution of
-the flux to the residual at Uj+1.
-
-The spectral radius in the j-direction is also calculated. Since this is done on
-a cell basis instead of a face bases, it is only calculated for the upper cell
-(Uj+1 in this case). The spectral radius is added to the average wave speed
-variable and is eventually used in the time step calculation if the time step
-isn't explicitly specified.
-*/
-void procBlock::CalcInvFluxJ(const physics &phys,
-                             const input &inp,
-                             matMultiArray3d &mainDiagonal) {
-  // physics -- physics models
+// Function to select the inviscid flux kernel for the reconstruction method and
+// limiter chosen in the input file
+template <inviscidFluxMethod F>
+void procBlock::CalcInvFlux(const string &dir, const physics &phys,
+                            const input &inp, matMultiArray3d &mainDiagonal) {
+  // dir -- direction of faces to calculate fluxes on (i, j, k)
+  // phys -- physics models
   // inp -- all input variables
   // mainDiagonal -- main diagonal of LHS to store flux jacobians for implicit
   //                 solver
-
-  // loop over all physical j-faces
-  for (auto kk = fAreaJ_.PhysStartK(); kk < fAreaJ_.PhysEndK(); kk++) {
-    for (auto jj = fAreaJ_.PhysStartJ(); jj < fAreaJ_.PhysEndJ(); jj++) {
-      for (auto ii = fAreaJ_.PhysStartI(); ii < fAreaJ_.PhysEndI(); ii++) {
-        primitive faceStateLower;
-        primitive faceStateUpper;
-
-        // use constant reconstruction (first order)
-        if (inp.OrderOfAccuracy() == "first") {
-          faceStateLower = FaceReconConst(state_(ii, jj - 1, kk));
-          faceStateUpper = FaceReconConst(state_(ii, jj, kk));
-        } else {  // second order accuracy
-          if (inp.UsingMUSCLReconstruction()) {
-            faceStateLower = FaceReconMUSCL(
-                state_(ii, jj - 2, kk), state_(ii, jj - 1, kk),
-                state_(ii, jj, kk), inp.Kappa(), inp.Limiter(),
-                cellWidthJ_(ii, jj - 2, kk), cellWidthJ_(ii, jj - 1, kk),
-                cellWidthJ_(ii, jj, kk));
-
-            faceStateUpper = FaceReconMUSCL(
-                state_(ii, jj + 1, kk), state_(ii, jj, kk),
-                state_(ii, jj - 1, kk), inp.Kappa(), inp.Limiter(),
-                cellWidthJ_(ii, jj + 1, kk), cellWidthJ_(ii, jj, kk),
-                cellWidthJ_(ii, jj - 1, kk));
-
-          } else {  // using higher order reconstruction (weno, wenoz)
-            faceStateLower = FaceReconWENO(
-                state_(ii, jj - 3, kk), state_(ii, jj - 2, kk),
-                state_(ii, jj - 1, kk), state_(ii, jj, kk),
-                state_(ii, jj + 1, kk), cellWidthJ_(ii, jj - 3, kk),
-                cellWidthJ_(ii, jj - 2, kk), cellWidthJ_(ii, jj - 1, kk),
-                cellWidthJ_(ii, jj, kk), cellWidthJ_(ii, jj + 1, kk),
-                inp.IsWenoZ());
-
-            faceStateUpper = FaceReconWENO(
-                state_(ii, jj + 2, kk), state_(ii, jj + 1, kk),
-                state_(ii, jj, kk), state_(ii, jj - 1, kk),
-                state_(ii, jj - 2, kk), cellWidthJ_(ii, jj + 2, kk),
-                cellWidthJ_(ii, jj + 1, kk), cellWidthJ_(ii, jj, kk),
-                cellWidthJ_(ii, jj - 1, kk), cellWidthJ_(ii, jj - 2, kk),
-                inp.IsWenoZ());
-          }
-        }
-        MSG_ASSERT(faceStateLower.Rho() > 0.0, "nonphysical density");
-        MSG_ASSERT(faceStateLower.P() > 0.0, "nonphysical pressure");
-        MSG_ASSERT(faceStateUpper.Rho() > 0.0, "nonphysical density");
-        MSG_ASSERT(faceStateUpper.P() > 0.0, "nonphysical pressure");
-
-        // calculate inviscid flux at face
-        const inviscidFlux tempFlux =
-            InviscidFlux(faceStateLower, faceStateUpper, phys,
-                         this->FAreaUnitJ(ii, jj, kk), inp.InviscidFlux());
-
-        // area vector points from left to right, so add to left cell, subtract
-        // from right cell
-        // at left boundary no left cell to add to
-        if (jj > fAreaJ_.PhysStartJ()) {
-          this->AddToResidual(ii, jj - 1, kk,
-                              tempFlux * this->FAreaMagJ(ii, jj, kk));
-
-          // if using block matrix on main diagonal, calculate flux jacobian
-          if (inp.IsBlockMatrix()) {
-            fluxJacobian fluxJac;
-            fluxJac.RusanovFluxJacobian(faceStateLower, phys,
-                                        this->FAreaJ(ii, jj, kk), true, inp);
-            mainDiagonal.Add(ii, jj - 1, kk, fluxJac);
-          }
-        }
-        // at right boundary no right cell to add to
-        if (jj < fAreaJ_.PhysEndJ() - 1) {
-          this->SubtractFromResidual(ii, jj, kk,
-                                     tempFlux * this->FAreaMagJ(ii, jj, kk));
-
-          // calculate component of wave speed. This is done on a cell by cell
-          // basis, so only at the upper faces
-          const auto invSpecRad =
-              InvCellSpectralRadius(state_(ii, jj, kk), fAreaJ_(ii, jj, kk),
-                                    fAreaJ_(ii, jj + 1, kk), phys);
-
-          const auto turbInvSpecRad =
-              isRANS_ ? phys.Turbulence()->InviscidCellSpecRad(
-                            state_(ii, jj, kk), fAreaJ_(ii, jj, kk),
-                            fAreaJ_(ii, jj + 1, kk))
-                      : 0.0;
-
-          const uncoupledScalar specRad(invSpecRad, turbInvSpecRad);
-          specRadius_(ii, jj, kk) += specRad;
-
-          // if using block matrix on main diagonal, calculate flux jacobian
-          if (inp.IsBlockMatrix()) {
-            fluxJacobian fluxJac;
-            fluxJac.RusanovFluxJacobian(faceStateUpper, phys,
-                                        this->FAreaJ(ii, jj, kk), false, inp);
-            mainDiagonal.Subtract(ii, jj, kk, fluxJac);
-          } else if (inp.IsImplicit()) {
-            mainDiagonal.Add(ii, jj, kk, fluxJacobian(specRad, isRANS_));
-          }
-        }
+  switch (inp.ReconstructionMethod()) {
+    case reconstructionMethod::constant:
+      this->CalcInvFluxPencils<F, reconstructionMethod::constant,
+                               limiterMethod::none>(dir, phys, inp,
+                                                    mainDiagonal);
+      break;
+    case reconstructionMethod::muscl:
+      switch (inp.LimiterMethod()) {
+        case limiterMethod::none:
+          this->CalcInvFluxPencils<F, reconstructionMethod::muscl,
+                                   limiterMethod::none>(dir, phys, inp,
+                                                        mainDiagonal);
+          break;
+        case limiterMethod::vanAlbada:
+          this->CalcInvFluxPencils<F, reconstructionMethod::muscl,
+                                   limiterMethod::vanAlbada>(dir, phys, inp,
+                                                             mainDiagonal);
+          break;
+        case limiterMethod::minmod:
+          this->CalcInvFluxPencils<F, reconstructionMethod::muscl,
+                                   limiterMethod::minmod>(dir, phys, inp,
+                                                          mainDiagonal);
+          break;
       }
-    }
+      break;
+    case reconstructionMethod::weno:
+      this->CalcInvFluxPencils<F, reconstructionMethod::weno,
+                               limiterMethod::none>(dir, phys, inp,
+                                                    mainDiagonal);
+      break;
+    case reconstructionMethod::wenoZ:
+      this->CalcInvFluxPencils<F, reconstructionMethod::wenoZ,
+                               limiterMethod::none>(dir, phys, inp,
+                                                    mainDiagonal);
+      break;
   }
 }
 
-/* Function to calculate the inviscid fluxes on the k-faces. All phyiscal
-(non-ghost) k-faces are looped over. The left and right states are calculated,
-and then the flux at the face is calculated. The flux at the face contributes
-to the residual of the cells to the left and right of the face. This
-contribution from the flux is added to the residuals and the wave speed is
-accumulated as well.
-  ___________________________
-  |            |            |
-  |            |            |
-  |   Uk       -->   Uk+1   |
-  |            |            |
-  |____________|____________|
-Uk-1/2       Uk+1/2       Uk+3/2
-
-Using the above diagram, the flux is calculated at face Uk+1/2. Since the area
-vector at the face always points from lower indices to higher indices it points
-from Uk to Uk+1. For the residual calculation the convention is for the area
-vector to point out of the cell. Therefore it is in the correct position for the
-residual at Uk, but the sign needs to be flipped when adding the contribution of
-the flux to the residual at Uk+1.
-
-The spectral radius in the k-direction is also calculated. Since this is done on
-a cell basis instead of a face bases, it is only calculated for the upper cell
-(Uk+1 in this case). The spectral radius is added to the average wave speed
-variable and is eventually used in the time step calculation if the time step
-isn't explicitly specified.
-*/
-void procBlock::CalcInvFluxK(const physics &phys,
-                             const input &inp,
-                             matMultiArray3d &mainDiagonal) {
+// Function to calculate the inviscid fluxes on the faces in the given direction
+// using the kernel compiled for the methods chosen in the input file
+void procBlock::CalcInvFlux(const string &dir, const physics &phys,
+                            const input &inp, matMultiArray3d &mainDiagonal) {
+  // dir -- direction of faces to calculate fluxes on (i, j, k)
   // phys -- physics models
   // inp -- all input variables
   // mainDiagonal -- main diagonal of LHS to store flux jacobians for implicit
   //                 solver
-
-  // loop over all physical k-faces
-  for (auto kk = fAreaK_.PhysStartK(); kk < fAreaK_.PhysEndK(); kk++) {
-    for (auto jj = fAreaK_.PhysStartJ(); jj < fAreaK_.PhysEndJ(); jj++) {
-      for (auto ii = fAreaK_.PhysStartI(); ii < fAreaK_.PhysEndI(); ii++) {
-        primitive faceStateLower;
-        primitive faceStateUpper;
-
-        // use constant reconstruction (first order)
-        if (inp.OrderOfAccuracy() == "first") {
-          faceStateLower = FaceReconConst(state_(ii, jj, kk - 1));
-          faceStateUpper = FaceReconConst(state_(ii, jj, kk));
-        } else {  // second order accuracy
-          if (inp.UsingMUSCLReconstruction()) {
-            faceStateLower = FaceReconMUSCL(
-                state_(ii, jj, kk - 2), state_(ii, jj, kk - 1),
-                state_(ii, jj, kk), inp.Kappa(), inp.Limiter(),
-                cellWidthK_(ii, jj, kk - 2), cellWidthK_(ii, jj, kk - 1),
-                cellWidthK_(ii, jj, kk));
-
-            faceStateUpper = FaceReconMUSCL(
-                state_(ii, jj, kk + 1), state_(ii, jj, kk),
-                state_(ii, jj, kk - 1), inp.Kappa(), inp.Limiter(),
-                cellWidthK_(ii, jj, kk + 1), cellWidthK_(ii, jj, kk),
-                cellWidthK_(ii, jj, kk - 1));
-
-          } else {  // using higher order reconstruction (weno, wenoz)
-            faceStateLower = FaceReconWENO(
-                state_(ii, jj, kk - 3), state_(ii, jj, kk - 2),
-                state_(ii, jj, kk - 1), state_(ii, jj, kk),
-                state_(ii, jj, kk + 1), cellWidthK_(ii, jj, kk - 3),
-                cellWidthK_(ii, jj, kk - 2), cellWidthK_(ii, jj, kk - 1),
-                cellWidthK_(ii, jj, kk), cellWidthK_(ii, jj, kk + 1),
-                inp.IsWenoZ());
-
-            faceStateUpper = FaceReconWENO(
-                state_(ii, jj, kk + 2), state_(ii, jj, kk + 1),
-                state_(ii, jj, kk), state_(ii, jj, kk - 1),
-                state_(ii, jj, kk - 2), cellWidthK_(ii, jj, kk + 2),
-                cellWidthK_(ii, jj, kk + 1), cellWidthK_(ii, jj, kk),
-                cellWidthK_(ii, jj, kk - 1), cellWidthK_(ii, jj, kk - 2),
-                inp.IsWenoZ());
-          }
-        }
-        MSG_ASSERT(faceStateLower.Rho() > 0.0, "nonphysical density");
-        MSG_ASSERT(faceStateLower.P() > 0.0, "nonphysical pressure");
-        MSG_ASSERT(faceStateUpper.Rho() > 0.0, "nonphysical density");
-        MSG_ASSERT(faceStateUpper.P() > 0.0, "nonphysical pressure");        
-
-        // calculate inviscid flux at face
-        const inviscidFlux tempFlux =
-            InviscidFlux(faceStateLower, faceStateUpper, phys,
-                         this->FAreaUnitK(ii, jj, kk), inp.InviscidFlux());
-
-        // area vector points from left to right, so add to left cell, subtract
-        // from right cell
-        // at left boundary no left cell to add to
-        if (kk > fAreaK_.PhysStartK()) {
-          this->AddToResidual(ii, jj, kk - 1,
-                              tempFlux * this->FAreaMagK(ii, jj, kk));
-
-          // if using block matrix on main diagonal, calculate flux jacobian
-          if (inp.IsBlockMatrix()) {
-            fluxJacobian fluxJac;
-            fluxJac.RusanovFluxJacobian(faceStateLower, phys,
-                                        this->FAreaK(ii, jj, kk), true, inp);
-            mainDiagonal.Add(ii, jj, kk - 1, fluxJac);
-          }
-        }
-        // at right boundary no right cell to add to
-        if (kk < fAreaK_.PhysEndK() - 1) {
-          this->SubtractFromResidual(ii, jj, kk,
-                                     tempFlux * this->FAreaMagK(ii, jj, kk));
-
-          // calculate component of wave speed. This is done on a cell by cell
-          // basis, so only at the upper faces
-          const auto invSpecRad =
-              InvCellSpectralRadius(state_(ii, jj, kk), fAreaK_(ii, jj, kk),
-                                    fAreaK_(ii, jj, kk + 1), phys);
-
-          const auto turbInvSpecRad =
-              isRANS_ ? phys.Turbulence()->InviscidCellSpecRad(
-                            state_(ii, jj, kk), fAreaK_(ii, jj, kk),
-                            fAreaK_(ii, jj, kk + 1))
-                      : 0.0;
-
-          const uncoupledScalar specRad(invSpecRad, turbInvSpecRad);
-          specRadius_(ii, jj, kk) += specRad;
-
-          // if using block matrix on main diagonal, calculate flux jacobian
-          if (inp.IsBlockMatrix()) {
-            fluxJacobian fluxJac;
-            fluxJac.RusanovFluxJacobian(faceStateUpper, phys,
-                                        this->FAreaK(ii, jj, kk), false, inp);
-            mainDiagonal.Subtract(ii, jj, kk, fluxJac);
-          } else if (inp.IsImplicit()) {
-            mainDiagonal.Add(ii, jj, kk, fluxJacobian(specRad, isRANS_));
-          }
-        }
-      }
-    }
+  if (inp.InviscidFluxMethod() == inviscidFluxMethod::ausm) {
+    this->CalcInvFlux<inviscidFluxMethod::ausm>(dir, phys, inp, mainDiagonal);
+  } else {
+    this->CalcInvFlux<inviscidFluxMethod::roe>(dir, phys, inp, mainDiagonal);
   }
 }
 
@@ -821,17 +702,17 @@ void procBlock::CalcBlockTimeStep(const input &inp) {
 
 /* Member function to update the procBlock to advance to a new time step. For
 explicit methods it calls the appropriate explicit method to update. For
-implicit methods it uses the correction du and calls the implicit updater.
+implicit methods it uses the correction du and calls the implicit updater. The
+time integration method is a template parameter so that each method is compiled
+into its own cell loop.
 */
-void procBlock::UpdateBlock(const input &inputVars, const physics &phys,
-                            const blkMultiArray3d<varArray> &du, const int &rr,
-                            residual &l2, resid &linf) {
+template <timeIntegrationMethod T>
+void procBlock::UpdateBlockCells(const input &inputVars, const physics &phys,
+                                 const blkMultiArray3d<varArray> &du,
+                                 const int &rr, residual &l2, resid &linf) {
   // inputVars -- all input variables
-  // eos -- equation of state
-  // thermo -- thermodynamic model
-  // trans -- viscous transport model
+  // phys -- physics models
   // du -- updates to conservative variables (only used in implicit solver)
-  // turb -- turbulence model
   // rr -- nonlinear iteration number
   // l2 -- l-2 norm of residual
   // linf -- l-infinity norm of residual
@@ -841,17 +722,14 @@ void procBlock::UpdateBlock(const input &inputVars, const physics &phys,
     for (auto jj = this->StartJ(); jj < this->EndJ(); jj++) {
       for (auto ii = this->StartI(); ii < this->EndI(); ii++) {
         // explicit euler time integration
-        if (inputVars.TimeIntegration() == "explicitEuler") {
+        if (T == timeIntegrationMethod::explicitEuler) {
           this->ExplicitEulerTimeAdvance(phys, ii, jj, kk);
         // 4-stage runge-kutta method (explicit)
-        } else if (inputVars.TimeIntegration() == "rk4") {
+        } else if (T == timeIntegrationMethod::rk4) {
           // advance 1 RK stage
           this->RK4TimeAdvance(consVarsN_(ii, jj, kk), phys, ii, jj, kk, rr);
-        } else if (inputVars.IsImplicit()) {  // if implicit use update (du)
+        } else {  // implicit use update (du)
           this->ImplicitTimeAdvance(du(ii, jj, kk), phys, ii, jj, kk);
-        } else {
-          cerr << "ERROR: Time integration scheme " <<
-              inputVars.TimeIntegration() << " is not recognized!" << endl;
         }
 
         // accumulate l2 norm of residual
@@ -870,6 +748,41 @@ void procBlock::UpdateBlock(const input &inputVars, const physics &phys,
   }
 }
 
+// Member function to update the procBlock using the cell loop compiled for the
+// time integration method chosen in the input file
+void procBlock::UpdateBlock(const input &inputVars, const physics &phys,
+                            const blkMultiArray3d<varArray> &du, const int &rr,
+                            residual &l2, resid &linf) {
+  // inputVars -- all input variables
+  // phys -- physics models
+  // du -- updates to conservative variables (only used in implicit solver)
+  // rr -- nonlinear iteration number
+  // l2 -- l-2 norm of residual
+  // linf -- l-infinity norm of residual
+  switch (inputVars.TimeIntegrationMethod()) {
+    case timeIntegrationMethod::explicitEuler:
+      this->UpdateBlockCells<timeIntegrationMethod::explicitEuler>(
+          inputVars, phys, du, rr, l2, linf);
+      break;
+    case timeIntegrationMethod::rk4:
+      this->UpdateBlockCells<timeIntegrationMethod::rk4>(inputVars, phys, du,
+                                                         rr, l2, linf);
+      break;
+    case timeIntegrationMethod::implicitEuler:
+      this->UpdateBlockCells<timeIntegrationMethod::implicitEuler>(
+          inputVars, phys, du, rr, l2, linf);
+      break;
+    case timeIntegrationMethod::crankNicholson:
+      this->UpdateBlockCells<timeIntegrationMethod::crankNicholson>(
+          inputVars, phys, du, rr, l2, linf);
+      break;
+    case timeIntegrationMethod::bdf2:
+      this->UpdateBlockCells<timeIntegrationMethod::bdf2>(inputVars, phys, du,
+                                                          rr, l2, linf);
+      break;
+  }
+}
+
 /* Member function to advance the state vector to time n+1 using explicit Euler
 method. The following equation is used:
 
@@ -897,6 +810,51 @@ void procBlock::ExplicitEulerTimeAdvance(const physics &phys, const int &ii,
   MSG_ASSERT(state_(ii, jj, kk).P() > 0, "nonphysical pressure");
 }
 
+// member function to add an update to the state of all physical cells without
+// calculating residual norms. This is used to evaluate the residual at a
+// perturbed state.
+void procBlock::PerturbState(const blkMultiArray3d<varArray> &du,
+                             const physics &phys) {
+  // du -- perturbation to conservative variables
+  // phys -- physics models
+  for (auto kk = this->StartK(); kk < this->EndK(); kk++) {
+    for (auto jj = this->StartJ(); jj < this->EndJ(); jj++) {
+      for (auto ii = this->StartI(); ii < this->EndI(); ii++) {
+        this->ImplicitTimeAdvance(du(ii, jj, kk), phys, ii, jj, kk);
+      }
+    }
+  }
+}
+
+// member function to store the fields that are overwritten by a residual
+// calculation
+residualFields procBlock::ResidualFields() const {
+  return {state_, residual_, specRadius_, velocityGrad_, temperatureGrad_,
+          densityGrad_, pressureGrad_, tkeGrad_, omegaGrad_, mixtureGrad_,
+          temperature_, viscosity_, eddyViscosity_, f1_, f2_, wallData_};
+}
+
+// member function to restore the fields stored before a residual was
+// evaluated at a perturbed state
+void procBlock::RestoreResidualFields(residualFields &&fields) {
+  state_ = std::move(fields.state);
+  residual_ = std::move(fields.resid);
+  specRadius_ = std::move(fields.specRadius);
+  velocityGrad_ = std::move(fields.velocityGrad);
+  temperatureGrad_ = std::move(fields.temperatureGrad);
+  densityGrad_ = std::move(fields.densityGrad);
+  pressureGrad_ = std::move(fields.pressureGrad);
+  tkeGrad_ = std::move(fields.tkeGrad);
+  omegaGrad_ = std::move(fields.omegaGrad);
+  mixtureGrad_ = std::move(fields.mixtureGrad);
+  temperature_ = std::move(fields.temperature);
+  viscosity_ = std::move(fields.viscosity);
+  eddyViscosity_ = std::move(fields.eddyViscosity);
+  f1_ = std::move(fields.f1);
+  f2_ = std::move(fields.f2);
+  wallData_ = std::move(fields.walls);
+}
+
 // member function to advance the state vector to time n+1 (for implicit
 // methods)
 void procBlock::ImplicitTimeAdvance(const varArrayView &du, const physics &phys,
@@ -1012,6 +970,18 @@ double procBlock::SolDeltaNCoeff(const int &ii, const int &jj, const int &kk,
   return (vol_(ii, jj, kk) * (1.0 + inp.Zeta())) / (dt_(ii, jj, kk) * inp.Theta());
 }
 
+// member function to calculate the time terms on the main diagonal of the
+// implicit matrix, including the pseudo time term for dual time stepping
+double procBlock::ImplicitTimeDiagonal(const int &ii, const int &jj,
+                                       const int &kk, const input &inp) const {
+  auto diagVolTime = this->SolDeltaNCoeff(ii, jj, kk, inp);
+  if (inp.DualTimeCFL() > 0.0) {  // use dual time stepping
+    // equal to volume / tau
+    diagVolTime += specRadius_(ii, jj, kk).Max() / inp.DualTimeCFL();
+  }
+  return diagVolTime;
+}
+
 varArray procBlock::SolDeltaMmN(const int &ii, const int &jj, const int &kk,
                                 const input &inp, const physics &phys) const {
   const auto coeff = this->SolDeltaNCoeff(ii, jj, kk, inp);
@@ -1160,6 +1130,78 @@ varArray procBlock::ImplicitUpper(const int &ii, const int &jj, const int &kk,
   return U;
 }
 
+// member function to calculate the off diagonal jacobians of all physical
+// cells for use in the implicit solver; the lower i, j, k jacobians are
+// stored first, followed by the upper i, j, k jacobians. Jacobians with no
+// contribution (boundaries that are not connections) are left unchanged.
+void procBlock::CalcOffDiagonalJacobians(
+    const physics &phys, const input &inp,
+    vector<matMultiArray3d> &offDiag) const {
+  // phys -- physics models
+  // inp -- input variables
+  // offDiag -- off diagonal jacobians to assign
+
+  MSG_ASSERT(offDiag.size() == 6, "off diagonal size mismatch");
+
+  // jacobian across a face from the off diagonal cell (io, jo, ko)
+  const auto jacobian = [&](const int &io, const int &jo, const int &ko,
+                            const int &fi, const int &fj, const int &fk,
+                            const unitVec3dMag<double> &fArea,
+                            const string &dir, const bool &positive) {
+    return RusanovBlockOffDiagonalJacobian(
+        state_(io, jo, ko), fArea, this->Viscosity(io, jo, ko),
+        this->EddyViscosity(io, jo, ko), this->F1(io, jo, ko),
+        this->ProjC2CDist(fi, fj, fk, dir), phys, inp, positive,
+        this->VelGrad(io, jo, ko));
+  };
+
+  for (auto kk = this->StartK(); kk < this->EndK(); ++kk) {
+    for (auto jj = this->StartJ(); jj < this->EndJ(); ++jj) {
+      for (auto ii = this->StartI(); ii < this->EndI(); ++ii) {
+        // lower off diagonals
+        if (this->IsPhysical(ii - 1, jj, kk) ||
+            bc_.BCIsConnection(ii, jj, kk, 1)) {
+          offDiag[0].InsertJacobian(
+              ii, jj, kk, jacobian(ii - 1, jj, kk, ii, jj, kk,
+                                   fAreaI_(ii, jj, kk), "i", true));
+        }
+        if (this->IsPhysical(ii, jj - 1, kk) ||
+            bc_.BCIsConnection(ii, jj, kk, 3)) {
+          offDiag[1].InsertJacobian(
+              ii, jj, kk, jacobian(ii, jj - 1, kk, ii, jj, kk,
+                                   fAreaJ_(ii, jj, kk), "j", true));
+        }
+        if (this->IsPhysical(ii, jj, kk - 1) ||
+            bc_.BCIsConnection(ii, jj, kk, 5)) {
+          offDiag[2].InsertJacobian(
+              ii, jj, kk, jacobian(ii, jj, kk - 1, ii, jj, kk,
+                                   fAreaK_(ii, jj, kk), "k", true));
+        }
+
+        // upper off diagonals
+        if (this->IsPhysical(ii + 1, jj, kk) ||
+            bc_.BCIsConnection(ii + 1, jj, kk, 2)) {
+          offDiag[3].InsertJacobian(
+              ii, jj, kk, jacobian(ii + 1, jj, kk, ii + 1, jj, kk,
+                                   fAreaI_(ii + 1, jj, kk), "i", false));
+        }
+        if (this->IsPhysical(ii, jj + 1, kk) ||
+            bc_.BCIsConnection(ii, jj + 1, kk, 4)) {
+          offDiag[4].InsertJacobian(
+              ii, jj, kk, jacobian(ii, jj + 1, kk, ii, jj + 1, kk,
+                                   fAreaJ_(ii, jj + 1, kk), "j", false));
+        }
+        if (this->IsPhysical(ii, jj, kk + 1) ||
+            bc_.BCIsConnection(ii, jj, kk + 1, 6)) {
+          offDiag[5].InsertJacobian(
+              ii, jj, kk, jacobian(ii, jj, kk + 1, ii, jj, kk + 1,
+                                   fAreaK_(ii, jj, kk + 1), "k", false));
+        }
+      }
+    }
+  }
+}
+
 /* Function to calculate the viscous fluxes on the i-faces. All phyiscal
 (non-ghost) i-faces are looped over. The left and right states are
 calculated, and then the flux at the face is calculated. The flux at the
@@ -1230,6 +1272,7 @@ in/out of the page). The stencil for the gradients of all faces in a cell
 touches 15 cells. The gradient calculation with this stencil uses the "edge"
 ghost cells, but not the "corner" ghost cells.
 */
+template <viscousReconstructionMethod V>
 void procBlock::CalcViscFluxI(const physics &phys, const input &inp,
                               matMultiArray3d &mainDiagonal) {
   // phys -- physics models
@@ -1238,9 +1281,15 @@ void procBlock::CalcViscFluxI(const physics &phys, const input &inp,
   //                 implicit solver
 
   const auto viscCoeff = inp.ViscousCFLCoefficient();
+  const auto isBlockMatrix = inp.IsBlockMatrix() && !mainDiagonal.IsEmpty();
+  const auto isImplicit = inp.IsImplicit() && !mainDiagonal.IsEmpty();
   constexpr auto sixth = 1.0 / 6.0;
 
   // loop over all physical i-faces
+  // faces only contribute to the cells on either side of them, so lines of
+  // faces in the i-direction can be divided among threads without races; the
+  // j- and k-face loops and the gradient loops are threaded the same way
+#pragma omp parallel for collapse(2) schedule(static)
   for (auto kk = fAreaI_.PhysStartK(); kk < fAreaI_.PhysEndK(); kk++) {
     for (auto jj = fAreaI_.PhysStartJ(); jj < fAreaI_.PhysEndJ(); jj++) {
       for (auto ii = fAreaI_.PhysStartI(); ii < fAreaI_.PhysEndI(); ii++) {
@@ -1302,7 +1351,7 @@ void procBlock::CalcViscFluxI(const physics &phys, const input &inp,
               phys.Turbulence());
         } else {  // not boundary, or low Re wall boundary
           auto wDist = 0.0;
-          if (inp.ViscousFaceReconstruction() == "central") {
+          if (V == viscousReconstructionMethod::central) {
             // get cell widths
             const vector<double> cellWidth = {cellWidthI_(ii - 1, jj, kk),
                                               cellWidthI_(ii, jj, kk)};
@@ -1414,7 +1463,7 @@ void procBlock::CalcViscFluxI(const physics &phys, const input &inp,
           }
 
           // if using block matrix on main diagonal, accumulate flux jacobian
-          if (inp.IsBlockMatrix()) {
+          if (isBlockMatrix) {
             // using mu, mut, and f1 at face
             fluxJacobian fluxJac;
             fluxJac.ApproxTSLJacobian(state, mu, mut, f1, phys,
@@ -1465,14 +1514,14 @@ void procBlock::CalcViscFluxI(const physics &phys, const input &inp,
           specRadius_(ii, jj, kk) += specRad * viscCoeff;
 
           // if using block matrix on main diagonal, accumulate flux jacobian
-          if (inp.IsBlockMatrix()) {
+          if (isBlockMatrix) {
             // using mu, mut, and f1 at face
             fluxJacobian fluxJac;
             fluxJac.ApproxTSLJacobian(state, mu, mut, f1, phys,
                                       this->FAreaI(ii, jj, kk), c2cDist, inp,
                                       false, velGrad);
             mainDiagonal.Add(ii, jj, kk, fluxJac);
-          } else if (inp.IsImplicit()) {
+          } else if (isImplicit) {
             // factor 2 because visc spectral radius is not halved (Blazek 6.53)
             mainDiagonal.Add(ii, jj, kk, fluxJacobian(2.0 * specRad, isRANS_));
           }
@@ -1553,6 +1602,7 @@ In three dimensions each gradient calculation touches the values at 10 cells
 faces in a cell touches 15 cells. The gradient calculation with this stencil uses
 the "edge" ghost cells, but not the "corner" ghost cells.
 */
+template <viscousReconstructionMethod V>
 void procBlock::CalcViscFluxJ(const physics &phys, const input &inp,
                               matMultiArray3d &mainDiagonal) {
   // phys -- physics models
@@ -1561,12 +1611,15 @@ void procBlock::CalcViscFluxJ(const physics &phys, const input &inp,
   //                 implicit solver
 
   const auto viscCoeff = inp.ViscousCFLCoefficient();
+  const auto isBlockMatrix = inp.IsBlockMatrix() && !mainDiagonal.IsEmpty();
+  const auto isImplicit = inp.IsImplicit() && !mainDiagonal.IsEmpty();
   constexpr auto sixth = 1.0 / 6.0;
 
   // loop over all physical j-faces
+#pragma omp parallel for collapse(2) schedule(static)
   for (auto kk = fAreaJ_.PhysStartK(); kk < fAreaJ_.PhysEndK(); kk++) {
-    for (auto jj = fAreaJ_.PhysStartJ(); jj < fAreaJ_.PhysEndJ(); jj++) {
-      for (auto ii = fAreaJ_.PhysStartI(); ii < fAreaJ_.PhysEndI(); ii++) {
+    for (auto ii = fAreaJ_.PhysStartI(); ii < fAreaJ_.PhysEndI(); ii++) {
+      for (auto jj = fAreaJ_.PhysStartJ(); jj < fAreaJ_.PhysEndJ(); jj++) {
         // calculate gradients
         tensor<double> velGrad;
         vector3d<double> tempGrad, denGrad, pressGrad, tkeGrad, omegaGrad;
@@ -1625,7 +1678,7 @@ void procBlock::CalcViscFluxJ(const physics &phys, const input &inp,
               phys.Turbulence());
         } else {  // not boundary, or low Re wall boundary
           auto wDist = 0.0;
-          if (inp.ViscousFaceReconstruction() == "central") {
+          if (V == viscousReconstructionMethod::central) {
             // get cell widths
             const vector<double> cellWidth = {cellWidthJ_(ii, jj - 1, kk),
                                               cellWidthJ_(ii, jj, kk)};
@@ -1737,7 +1790,7 @@ void procBlock::CalcViscFluxJ(const physics &phys, const input &inp,
           }
 
           // if using block matrix on main diagonal, accumulate flux jacobian
-          if (inp.IsBlockMatrix()) {
+          if (isBlockMatrix) {
             // using mu, mut, and f1 at face
             fluxJacobian fluxJac;
             fluxJac.ApproxTSLJacobian(state, mu, mut, f1, phys,
@@ -1789,14 +1842,14 @@ void procBlock::CalcViscFluxJ(const physics &phys, const input &inp,
 
 
           // if using block matrix on main diagonal, accumulate flux jacobian
-          if (inp.IsBlockMatrix()) {
+          if (isBlockMatrix) {
             // using mu, mut, and f1 at face
             fluxJacobian fluxJac;
             fluxJac.ApproxTSLJacobian(state, mu, mut, f1, phys,
                                       this->FAreaJ(ii, jj, kk), c2cDist, inp,
                                       false, velGrad);
             mainDiagonal.Add(ii, jj, kk, fluxJac);
-          } else if (inp.IsImplicit()) {
+          } else if (isImplicit) {
             // factor 2 because visc spectral radius is not halved (Blazek 6.53)
             mainDiagonal.Add(ii, jj, kk, fluxJacobian(2.0 * specRad, isRANS_));
           }
@@ -1876,6 +1929,7 @@ In three dimensions each gradient calculation touches the values at 10 cells
 faces in a cell touches 15 cells. The gradient calculation with this stencil uses
 the "edge" ghost cells, but not the "corner" ghost cells.
 */
+template <viscousReconstructionMethod V>
 void procBlock::CalcViscFluxK(const physics &phys, const input &inp,
                               matMultiArray3d &mainDiagonal) {
   // trans -- viscous transport model
@@ -1889,12 +1943,15 @@ void procBlock::CalcViscFluxK(const physics &phys, const input &inp,
   //                 implicit solver
 
   const auto viscCoeff = inp.ViscousCFLCoefficient();
+  const auto isBlockMatrix = inp.IsBlockMatrix() && !mainDiagonal.IsEmpty();
+  const auto isImplicit = inp.IsImplicit() && !mainDiagonal.IsEmpty();
   constexpr auto sixth = 1.0 / 6.0;
 
   // loop over all physical k-faces
-  for (auto kk = fAreaK_.PhysStartK(); kk < fAreaK_.PhysEndK(); kk++) {
-    for (auto jj = fAreaK_.PhysStartJ(); jj < fAreaK_.PhysEndJ(); jj++) {
-      for (auto ii = fAreaK_.PhysStartI(); ii < fAreaK_.PhysEndI(); ii++) {
+#pragma omp parallel for collapse(2) schedule(static)
+  for (auto jj = fAreaK_.PhysStartJ(); jj < fAreaK_.PhysEndJ(); jj++) {
+    for (auto ii = fAreaK_.PhysStartI(); ii < fAreaK_.PhysEndI(); ii++) {
+      for (auto kk = fAreaK_.PhysStartK(); kk < fAreaK_.PhysEndK(); kk++) {
         // calculate gradients
         tensor<double> velGrad;
         vector3d<double> tempGrad, denGrad, pressGrad, tkeGrad, omegaGrad;
@@ -1953,7 +2010,7 @@ void procBlock::CalcViscFluxK(const physics &phys, const input &inp,
               phys.Turbulence());
         } else {  // not boundary, or low Re wall boundary
           auto wDist = 0.0;
-          if (inp.ViscousFaceReconstruction() == "central") {
+          if (V == viscousReconstructionMethod::central) {
             // get cell widths
             const vector<double> cellWidth = {cellWidthK_(ii, jj, kk - 1),
                                               cellWidthK_(ii, jj, kk)};
@@ -2066,7 +2123,7 @@ void procBlock::CalcViscFluxK(const physics &phys, const input &inp,
           }
 
           // if using block matrix on main diagonal, accumulate flux jacobian
-          if (inp.IsBlockMatrix()) {
+          if (isBlockMatrix) {
             // using mu, mut, and f1 at face
             fluxJacobian fluxJac;
             fluxJac.ApproxTSLJacobian(state, mu, mut, f1, phys,
@@ -2117,14 +2174,14 @@ void procBlock::CalcViscFluxK(const physics &phys, const input &inp,
           specRadius_(ii, jj, kk) += specRad * viscCoeff;
 
           // if using block matrix on main diagonal, accumulate flux jacobian
-          if (inp.IsBlockMatrix()) {
+          if (isBlockMatrix) {
             // using mu, mut, and f1 at face
             fluxJacobian fluxJac;
             fluxJac.ApproxTSLJacobian(state, mu, mut, f1, phys,
                                       this->FAreaK(ii, jj, kk), c2cDist, inp,
                                       false, velGrad);
             mainDiagonal.Add(ii, jj, kk, fluxJac);
-          } else if (inp.IsImplicit()) {
+          } else if (isImplicit) {
             // factor 2 because visc spectral radius is not halved (Blazek 6.53)
             mainDiagonal.Add(ii, jj, kk, fluxJacobian(2.0 * specRad, isRANS_));
           }
@@ -3054,14 +3111,6 @@ void procBlock::SwapStateSlice(const connection &inter, procBlock &blk) {
   state_.SwapSlice(inter, blk.state_);
 }
 
-void procBlock::SwapTurbSlice(const connection &inter, procBlock &blk) {
-  // inter -- connection boundary information
-  // blk -- second block involved in connection boundary
-
-  f1_.SwapSlice(inter, blk.f1_);
-  f2_.SwapSlice(inter, blk.f2_);
-}
-
 void procBlock::SwapWallDistSlice(const connection &inter, procBlock &blk) {
   // inter -- connection boundary information
   // blk -- second block involved in connection boundary
@@ -3069,56 +3118,142 @@ void procBlock::SwapWallDistSlice(const connection &inter, procBlock &blk) {
   wallDist_.SwapSlice(inter, blk.wallDist_);
 }
 
-// This is done for the implicit solver so the off diagonal data adjacent to
-// an interblock boundary condition can be accessed
-void procBlock::SwapEddyViscAndGradientSlice(const connection &inter,
-                                             procBlock &blk) {
+// member function to determine if the block stores the given field
+bool procBlock::HasField(const haloField &field) const {
+  // field -- field to check
+  switch (field) {
+    case haloField::turbulence:
+    case haloField::tkeGradient:
+    case haloField::omegaGradient:
+      return isRANS_;
+    case haloField::eddyViscosity:
+      return isTurbulent_;
+    case haloField::mixtureGradient:
+      return isMultiSpecies_;
+    default:
+      return true;
+  }
+}
+
+/* Function to swap the ghost cells of several fields at a connection boundary.
+The gradients and eddy viscosity are swapped for the implicit solver so the off
+diagonal data adjacent to an interblock boundary condition can be accessed.
+Fields the blocks do not store are skipped.
+*/
+void procBlock::SwapFieldSlices(const vector<haloField> &fields,
+                                const connection &inter, procBlock &blk) {
+  // fields -- fields to swap
   // inter -- connection boundary information
   // blk -- second block involved in connection boundary
-                                            
-  velocityGrad_.SwapSlice(inter, blk.velocityGrad_);
 
-  if (isTurbulent_) {
-    eddyViscosity_.SwapSlice(inter, blk.eddyViscosity_);
+  for (const auto &field : fields) {
+    if (!this->HasField(field)) {
+      continue;
+    }
+    switch (field) {
+      case haloField::turbulence:
+        f1_.SwapSlice(inter, blk.f1_);
+        f2_.SwapSlice(inter, blk.f2_);
+        break;
+      case haloField::eddyViscosity:
+        eddyViscosity_.SwapSlice(inter, blk.eddyViscosity_);
+        break;
+      case haloField::velocityGradient:
+        velocityGrad_.SwapSlice(inter, blk.velocityGrad_);
+        break;
+      case haloField::temperatureGradient:
+        temperatureGrad_.SwapSlice(inter, blk.temperatureGrad_);
+        break;
+      case haloField::densityGradient:
+        densityGrad_.SwapSlice(inter, blk.densityGrad_);
+        break;
+      case haloField::pressureGradient:
+        pressureGrad_.SwapSlice(inter, blk.pressureGrad_);
+        break;
+      case haloField::tkeGradient:
+        tkeGrad_.SwapSlice(inter, blk.tkeGrad_);
+        break;
+      case haloField::omegaGradient:
+        omegaGrad_.SwapSlice(inter, blk.omegaGrad_);
+        break;
+      case haloField::mixtureGradient:
+        mixtureGrad_.SwapSlice(inter, blk.mixtureGrad_);
+        break;
+    }
   }
 }
 
 
 /* Function to swap slice using MPI. This is similar to the SwapSlice
 function, but is called when the neighboring procBlocks are on different
-processors.
+processors. The swap is posted to the given exchange, and the ghost cells are
+assigned when the exchange is finished.
 */
-void procBlock::SwapStateSliceMPI(const connection &inter, const int &rank) {
+void procBlock::SwapStateSliceMPI(const connection &inter, const int &rank,
+                                  haloExchange &exchange) {
   // inter -- connection boundary information
   // rank -- processor rank
-  state_.SwapSliceMPI(inter, rank, MPI_DOUBLE);
+  // exchange -- exchange to post swap to
+  exchange.Post(state_, inter, rank, MPI_DOUBLE, 1);
 }
 
-void procBlock::SwapTurbSliceMPI(const connection &inter, const int &rank) {
+void procBlock::SwapWallDistSliceMPI(const connection &inter, const int &rank,
+                                     haloExchange &exchange) {
   // inter -- connection boundary information
   // rank -- processor rank
+  // exchange -- exchange to post swap to
 
-  f1_.SwapSliceMPI(inter, rank, MPI_DOUBLE, 2);
-  f2_.SwapSliceMPI(inter, rank, MPI_DOUBLE, 3);
+  exchange.Post(wallDist_, inter, rank, MPI_DOUBLE, 1);
 }
 
-void procBlock::SwapWallDistSliceMPI(const connection &inter, const int &rank) {
+// All fields are posted to the same exchange, so they are sent to the partner
+// processor together in one message
+void procBlock::SwapFieldSlicesMPI(const vector<haloField> &fields,
+                                   const connection &inter, const int &rank,
+                                   const MPI_Datatype &MPI_tensorDouble,
+                                   const MPI_Datatype &MPI_vec3d,
+                                   haloExchange &exchange) {
+  // fields -- fields to swap
   // inter -- connection boundary information
   // rank -- processor rank
+  // MPI_tensorDouble -- MPI datatype for tensor<double>
+  // MPI_vec3d -- MPI datatype for vector3d<double>
+  // exchange -- exchange to post swap to
 
-  wallDist_.SwapSliceMPI(inter, rank, MPI_DOUBLE, 1);
-}
-
-void procBlock::SwapEddyViscAndGradientSliceMPI(
-    const connection &inter, const int &rank,
-    const MPI_Datatype &MPI_tensorDouble, const MPI_Datatype &MPI_vec3d) {
-  // inter -- connection boundary information
-  // rank -- processor rank
-
-  velocityGrad_.SwapSliceMPI(inter, rank, MPI_tensorDouble, 1);
-
-  if (isTurbulent_) {
-    eddyViscosity_.SwapSliceMPI(inter, rank, MPI_DOUBLE, 5);
+  for (const auto &field : fields) {
+    if (!this->HasField(field)) {
+      continue;
+    }
+    switch (field) {
+      case haloField::turbulence:
+        exchange.Post(f1_, inter, rank, MPI_DOUBLE, 2);
+        exchange.Post(f2_, inter, rank, MPI_DOUBLE, 3);
+        break;
+      case haloField::eddyViscosity:
+        exchange.Post(eddyViscosity_, inter, rank, MPI_DOUBLE, 5);
+        break;
+      case haloField::velocityGradient:
+        exchange.Post(velocityGrad_, inter, rank, MPI_tensorDouble, 1);
+        break;
+      case haloField::temperatureGradient:
+        exchange.Post(temperatureGrad_, inter, rank, MPI_vec3d, 6);
+        break;
+      case haloField::densityGradient:
+        exchange.Post(densityGrad_, inter, rank, MPI_vec3d, 7);
+        break;
+      case haloField::pressureGradient:
+        exchange.Post(pressureGrad_, inter, rank, MPI_vec3d, 8);
+        break;
+      case haloField::tkeGradient:
+        exchange.Post(tkeGrad_, inter, rank, MPI_vec3d, 9);
+        break;
+      case haloField::omegaGradient:
+        exchange.Post(omegaGrad_, inter, rank, MPI_vec3d, 10);
+        break;
+      case haloField::mixtureGradient:
+        exchange.Post(mixtureGrad_, inter, rank, MPI_vec3d, 11);
+        break;
+    }
   }
 }
 
@@ -4038,8 +4173,8 @@ void procBlock::PutStateSlice(const blkMultiArray3d<primitive> &slice,
   state_.PutSlice(slice, inter, d3);
 }
 
-/*Member function to pack and send procBlock geometry data to appropriate
- * processor. */
+/*Member function to pack and send procBlock geometry data to the ROOT
+ * processor. The global position is used as the message tag. */
 void procBlock::PackSendGeomMPI(const MPI_Datatype &MPI_vec3d,
                                 const MPI_Datatype &MPI_vec3dMag) const {
   // MPI_vec3d -- MPI data type for a vector3d
@@ -4182,23 +4317,26 @@ void procBlock::PackSendGeomMPI(const MPI_Datatype &MPI_vec3d,
     wd.PackWallData(rawSendBuffer, sendBufSize, position, MPI_vec3d);
   }
 
-  // send buffer to appropriate processor
-  MPI_Send(rawSendBuffer, sendBufSize, MPI_PACKED, rank_, 2,
+  // send buffer to ROOT processor
+  MPI_Send(rawSendBuffer, sendBufSize, MPI_PACKED, ROOTP, globalPos_,
            MPI_COMM_WORLD);
 }
 
 void procBlock::RecvUnpackGeomMPI(const MPI_Datatype &MPI_vec3d,
                                   const MPI_Datatype &MPI_vec3dMag,
-                                  const input &inp) {
+                                  const input &inp, const int &sendRank,
+                                  const int &tag) {
   // MPI_vec3d -- MPI data type for a vector3d
   // MPI_vec3dMag -- MPI data type for a unitVect3dMag
   // input -- input variables
+  // sendRank -- processor that block is sent from
+  // tag -- message tag (global position of block)
 
   MPI_Status status;  // allocate MPI_Status structure
 
   // probe message to get correct data size
   auto recvBufSize = 0;
-  MPI_Probe(ROOTP, 2, MPI_COMM_WORLD, &status);
+  MPI_Probe(sendRank, tag, MPI_COMM_WORLD, &status);
   // use MPI_CHAR because sending buffer was allocated with chars
   MPI_Get_count(&status, MPI_CHAR, &recvBufSize);
 
@@ -4207,9 +4345,9 @@ void procBlock::RecvUnpackGeomMPI(const MPI_Datatype &MPI_vec3d,
   auto recvBuffer = std::make_unique<char[]>(recvBufSize);
   auto *rawRecvBuffer = recvBuffer.get();
 
-  // receive message from ROOT
-  MPI_Recv(rawRecvBuffer, recvBufSize, MPI_PACKED, ROOTP, 2, MPI_COMM_WORLD,
-           &status);
+  // receive message from sending processor
+  MPI_Recv(rawRecvBuffer, recvBufSize, MPI_PACKED, sendRank, tag,
+           MPI_COMM_WORLD, &status);
 
   auto numI = 0, numJ = 0, numK = 0;
   // unpack procBlock INTs
@@ -5792,6 +5930,7 @@ void procBlock::CalcGradsI() {
   constexpr auto sixth = 1.0 / 6.0;
 
   // loop over all physical i-faces
+#pragma omp parallel for collapse(2) schedule(static)
   for (auto kk = fAreaI_.PhysStartK(); kk < fAreaI_.PhysEndK(); kk++) {
     for (auto jj = fAreaI_.PhysStartJ(); jj < fAreaI_.PhysEndJ(); jj++) {
       for (auto ii = fAreaI_.PhysStartI(); ii < fAreaI_.PhysEndI(); ii++) {
@@ -5847,9 +5986,10 @@ void procBlock::CalcGradsJ() {
   constexpr auto sixth = 1.0 / 6.0;
 
   // loop over all physical j-faces
+#pragma omp parallel for collapse(2) schedule(static)
   for (auto kk = fAreaJ_.PhysStartK(); kk < fAreaJ_.PhysEndK(); kk++) {
-    for (auto jj = fAreaJ_.PhysStartJ(); jj < fAreaJ_.PhysEndJ(); jj++) {
-      for (auto ii = fAreaJ_.PhysStartI(); ii < fAreaJ_.PhysEndI(); ii++) {
+    for (auto ii = fAreaJ_.PhysStartI(); ii < fAreaJ_.PhysEndI(); ii++) {
+      for (auto jj = fAreaJ_.PhysStartJ(); jj < fAreaJ_.PhysEndJ(); jj++) {
         // calculate gradients
         tensor<double> velGrad;
         vector3d<double> tempGrad, denGrad, pressGrad, tkeGrad, omegaGrad;
@@ -5902,9 +6042,10 @@ void procBlock::CalcGradsK() {
   constexpr auto sixth = 1.0 / 6.0;
 
   // loop over all physical k-faces
-  for (auto kk = fAreaK_.PhysStartK(); kk < fAreaK_.PhysEndK(); kk++) {
-    for (auto jj = fAreaK_.PhysStartJ(); jj < fAreaK_.PhysEndJ(); jj++) {
-      for (auto ii = fAreaK_.PhysStartI(); ii < fAreaK_.PhysEndI(); ii++) {
+#pragma omp parallel for collapse(2) schedule(static)
+  for (auto jj = fAreaK_.PhysStartJ(); jj < fAreaK_.PhysEndJ(); jj++) {
+    for (auto ii = fAreaK_.PhysStartI(); ii < fAreaK_.PhysEndI(); ii++) {
+      for (auto kk = fAreaK_.PhysStartK(); kk < fAreaK_.PhysEndK(); kk++) {
         // calculate gradients
         tensor<double> velGrad;
         vector3d<double> tempGrad, denGrad, pressGrad, tkeGrad, omegaGrad;
@@ -5959,6 +6100,9 @@ void procBlock::CalcSrcTerms(const physics &phys, const input &inp,
   // mainDiagonal -- main diagonal of LHS used to store flux jacobians for
   //                 implicit solver
 
+  const auto isBlockMatrix = inp.IsBlockMatrix() && !mainDiagonal.IsEmpty();
+  const auto isImplicit = inp.IsImplicit() && !mainDiagonal.IsEmpty();
+
   // loop over all physical cells - no ghost cells needed for source terms
   for (auto kk = 0; kk < this->NumK(); kk++) {
     for (auto jj = 0; jj < this->NumJ(); jj++) {
@@ -5971,7 +6115,7 @@ void procBlock::CalcSrcTerms(const physics &phys, const input &inp,
           const auto chemJac = src.CalcChemSrc(phys, state_(ii, jj, kk),
                                                temperature_(ii, jj, kk), 
                                                vol_(ii, jj, kk),
-                                               inp.IsBlockMatrix(), 
+                                               isBlockMatrix, 
                                                chemSpecRad);
 
           // add source spectral radius for species equations
@@ -5979,9 +6123,9 @@ void procBlock::CalcSrcTerms(const physics &phys, const input &inp,
           specRadius_(ii, jj, kk).SubtractFromFlowVariable(chemSpecRad);
 
           // add contribution of source spectral radius to flux jacobian
-          if (inp.IsBlockMatrix()) {
+          if (isBlockMatrix) {
             mainDiagonal.SubtractFromFlow(ii, jj, kk, chemJac);
-          } else if (inp.IsImplicit()) {
+          } else if (isImplicit) {
             const uncoupledScalar srcJacScalar(chemSpecRad, 0.0);
             mainDiagonal.Subtract(ii, jj, kk,
                                   fluxJacobian(srcJacScalar, isRANS_));
@@ -6007,9 +6151,9 @@ void procBlock::CalcSrcTerms(const physics &phys, const input &inp,
           specRadius_(ii, jj, kk).SubtractFromTurbVariable(turbSpecRad);
 
           // add contribution of source spectral radius to flux jacobian
-          if (inp.IsBlockMatrix()) {
+          if (isBlockMatrix) {
             mainDiagonal.SubtractFromTurb(ii, jj, kk, srcJac);
-          } else if (inp.IsImplicit()) {
+          } else if (isImplicit) {
             const uncoupledScalar srcJacScalar(0.0, turbSpecRad);
             mainDiagonal.Subtract(ii, jj, kk,
                                   fluxJacobian(srcJacScalar, isRANS_));
@@ -6110,6 +6254,27 @@ void procBlock::CalcWallDistance(const kdtree &tree) {
 // from source terms
 void procBlock::CalcResidualNoSource(const physics &phys, const input &inp,
                                      matMultiArray3d &mainDiagonal) {
+  const std::array<bool, 3> deferred = {false, false, false};
+  this->StartResidualNoSource(phys, inp, mainDiagonal, deferred);
+  this->FinishResidualNoSource(phys, inp, mainDiagonal, deferred);
+}
+
+// member function to start the calculation of the residual (RHS) excluding any
+// contributions from source terms. Only the inviscid fluxes in the directions
+// that are not deferred are calculated. This allows the fluxes that do not use
+// ghost cells from other processors to be calculated while those ghost cells
+// are being exchanged. If the main diagonal is empty, no flux jacobians are
+// calculated.
+void procBlock::StartResidualNoSource(const physics &phys, const input &inp,
+                                      matMultiArray3d &mainDiagonal,
+                                      const std::array<bool, 3> &deferred) {
+  // phys -- physics models
+  // inp -- all input variables
+  // mainDiagonal -- main diagonal of LHS to store flux jacobians for implicit
+  //                 solver
+  // deferred -- flags for i, j, k directions to calculate inviscid fluxes for
+  //             when the residual calculation is finished
+
   // Zero spectral radii, residuals, gradients, turbulence variables
   this->ResetResidWS();
   this->ResetGradients();
@@ -6118,9 +6283,32 @@ void procBlock::CalcResidualNoSource(const physics &phys, const input &inp,
   }
 
   // Calculate inviscid fluxes
-  this->CalcInvFluxI(phys, inp, mainDiagonal);
-  this->CalcInvFluxJ(phys, inp, mainDiagonal);
-  this->CalcInvFluxK(phys, inp, mainDiagonal);
+  const std::array<string, 3> dirs = {"i", "j", "k"};
+  for (auto dd = 0U; dd < dirs.size(); ++dd) {
+    if (!deferred[dd]) {
+      this->CalcInvFlux(dirs[dd], phys, inp, mainDiagonal);
+    }
+  }
+}
+
+// member function to finish the calculation of the residual (RHS) excluding
+// any contributions from source terms. All ghost cells must be assigned.
+void procBlock::FinishResidualNoSource(const physics &phys, const input &inp,
+                                       matMultiArray3d &mainDiagonal,
+                                       const std::array<bool, 3> &deferred) {
+  // phys -- physics models
+  // inp -- all input variables
+  // mainDiagonal -- main diagonal of LHS to store flux jacobians for implicit
+  //                 solver
+  // deferred -- flags for i, j, k directions to calculate inviscid fluxes for
+
+  // Calculate deferred inviscid fluxes
+  const std::array<string, 3> dirs = {"i", "j", "k"};
+  for (auto dd = 0U; dd < dirs.size(); ++dd) {
+    if (deferred[dd]) {
+      this->CalcInvFlux(dirs[dd], phys, inp, mainDiagonal);
+    }
+  }
 
   // If viscous change ghost cells and calculate viscous fluxes
   if (isViscous_) {
@@ -6131,9 +6319,18 @@ void procBlock::CalcResidualNoSource(const physics &phys, const input &inp,
     this->UpdateAuxillaryVariables(phys);
 
     // Calculate viscous fluxes
-    this->CalcViscFluxI(phys, inp, mainDiagonal);
-    this->CalcViscFluxJ(phys, inp, mainDiagonal);
-    this->CalcViscFluxK(phys, inp, mainDiagonal);
+    if (inp.ViscousReconstructionMethod() ==
+        viscousReconstructionMethod::central) {
+      constexpr auto vr = viscousReconstructionMethod::central;
+      this->CalcViscFluxI<vr>(phys, inp, mainDiagonal);
+      this->CalcViscFluxJ<vr>(phys, inp, mainDiagonal);
+      this->CalcViscFluxK<vr>(phys, inp, mainDiagonal);
+    } else {
+      constexpr auto vr = viscousReconstructionMethod::centralFourth;
+      this->CalcViscFluxI<vr>(phys, inp, mainDiagonal);
+      this->CalcViscFluxJ<vr>(phys, inp, mainDiagonal);
+      this->CalcViscFluxK<vr>(phys, inp, mainDiagonal);
+    }
 
   } else {
     // Update temperature
@@ -6294,6 +6491,48 @@ blkMultiArray3d<primitive> procBlock::GetGhostStates(
   return ghostStates;
 }
 
+/* Member function to integrate the pressure and viscous forces, moment, and
+heat transfer rate over the viscous walls of the block. The face normal is
+flipped on upper surfaces so that the loads are those of the fluid acting on
+the wall.
+*/
+wallLoads procBlock::WallLoads(const physics &phys,
+                               const vector3d<double> &momentPoint) const {
+  // phys -- physics models
+  // momentPoint -- point to calculate moments about
+  wallLoads loads;
+  for (auto ll = 0; ll < this->WallDataSize(); ++ll) {
+    const auto surf = wallData_[ll].Surface();
+    // normal points from wall into fluid
+    const auto sign = surf.IsUpper() ? -1.0 : 1.0;
+    for (auto kk = surf.RangeK().Start(); kk < surf.RangeK().End(); kk++) {
+      for (auto jj = surf.RangeJ().Start(); jj < surf.RangeJ().End(); jj++) {
+        for (auto ii = surf.RangeI().Start(); ii < surf.RangeI().End(); ii++) {
+          const auto &area = (surf.SurfaceType() <= 2)
+                                 ? fAreaI_(ii, jj, kk)
+                                 : (surf.SurfaceType() <= 4)
+                                       ? fAreaJ_(ii, jj, kk)
+                                       : fAreaK_(ii, jj, kk);
+          const auto &center = (surf.SurfaceType() <= 2)
+                                   ? fCenterI_(ii, jj, kk)
+                                   : (surf.SurfaceType() <= 4)
+                                         ? fCenterJ_(ii, jj, kk)
+                                         : fCenterK_(ii, jj, kk);
+          const auto areaMag = sign * area.Mag();
+          const auto pressure =
+              wallData_[ll].WallPressure(ii, jj, kk, phys.EoS());
+          loads.AddFace(
+              -pressure * areaMag * area.UnitVector(),
+              areaMag * wallData_[ll].WallShearStress(ii, jj, kk),
+              center - momentPoint,
+              areaMag * wallData_[ll].WallHeatFlux(ii, jj, kk));
+        }
+      }
+    }
+  }
+  return loads;
+}
+
 int procBlock::WallDataIndex(const boundarySurface &surf) const {
   auto ind = -1;
   for (auto ii = 0U; ii < wallData_.size(); ++ii) {
@@ -6311,6 +6550,37 @@ int procBlock::WallDataIndex(const boundarySurface &surf) const {
   return ind;
 }
 
+// member function to return the index direction (0 = i, 1 = j, 2 = k) normal
+// to the viscous walls of the block. Blocks without walls use the direction
+// with the largest total face area, which is normal to the thinnest cells.
+int procBlock::WallNormalDirection() const {
+  std::array<int, 3> wallFaces = {0, 0, 0};
+  for (auto ii = 0; ii < bc_.NumSurfaces(); ++ii) {
+    if (bc_.GetBCTypes(ii) == "viscousWall") {
+      // surface types 1-2 are i-surfaces, 3-4 j-surfaces, 5-6 k-surfaces
+      wallFaces[(bc_.GetSurfaceType(ii) - 1) / 2] +=
+          bc_.GetSurface(ii).NumFaces();
+    }
+  }
+  const auto maxWall = std::max_element(wallFaces.begin(), wallFaces.end());
+  if (*maxWall > 0) {
+    return std::distance(wallFaces.begin(), maxWall);
+  }
+
+  std::array<double, 3> faceArea = {0.0, 0.0, 0.0};
+  for (auto kk = this->StartK(); kk < this->EndK(); ++kk) {
+    for (auto jj = this->StartJ(); jj < this->EndJ(); ++jj) {
+      for (auto ii = this->StartI(); ii < this->EndI(); ++ii) {
+        faceArea[0] += this->FAreaMagI(ii, jj, kk);
+        faceArea[1] += this->FAreaMagJ(ii, jj, kk);
+        faceArea[2] += this->FAreaMagK(ii, jj, kk);
+      }
+    }
+  }
+  return std::distance(faceArea.begin(),
+                       std::max_element(faceArea.begin(), faceArea.end()));
+}
+
 // member function to calculate the center to center distance across a cell face
 // projected along that face's area vector
 double procBlock::ProjC2CDist(const int &ii, const int &jj, const int &kk,
@@ -6419,6 +6689,48 @@ void procBlock::GetSolNm1FromRestart(const blkMultiArray3d<conserved> &restart)
   consVarsNm1_ = restart;
 }
 
+// member function to reset the solution to a previously stored checkpoint;
+// the time step and gradients are used by the boundary conditions before they
+// are recalculated, so they are restored too, and the auxillary variables are
+// recalculated from the restored state
+void procBlock::RestoreSolution(
+    const blkMultiArray3d<primitive> &state,
+    const blkMultiArray3d<conserved> &consVarsN,
+    const blkMultiArray3d<conserved> &consVarsNm1,
+    const multiArray3d<double> &dt,
+    const multiArray3d<vector3d<double>> &pressureGrad,
+    const multiArray3d<tensor<double>> &velocityGrad, const physics &phys) {
+  state_ = state;
+  consVarsN_ = consVarsN;
+  consVarsNm1_ = consVarsNm1;
+  dt_ = dt;
+  pressureGrad_ = pressureGrad;
+  velocityGrad_ = velocityGrad;
+  this->UpdateAuxillaryVariables(phys, false);
+}
+
+// member function to check that all physical cells have a positive density
+// and pressure, and finite values for all variables
+bool procBlock::IsSolutionPhysical() const {
+  for (auto kk = this->StartK(); kk < this->EndK(); kk++) {
+    for (auto jj = this->StartJ(); jj < this->EndJ(); jj++) {
+      for (auto ii = this->StartI(); ii < this->EndI(); ii++) {
+        const auto state = state_(ii, jj, kk);
+        // comparisons are false for NaN, so negate them
+        if (!(state.Rho() > 0.0) || !(state.P() > 0.0)) {
+          return false;
+        }
+        for (auto vv = 0; vv < state.Size(); ++vv) {
+          if (!std::isfinite(state[vv])) {
+            return false;
+          }
+        }
+      }
+    }
+  }
+  return true;
+}
+
 // split all wallData in procBlock
 // The calling instance keeps the lower wallData in the split, and the upper
 // wallData is returned
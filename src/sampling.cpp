@@ -0,0 +1,569 @@
+/*  This file is part of aither.
+    Copyright (C) 2015-19  Michael Nucci (mnucci@pm.me)
+
+    Aither is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Aither is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>. */
+
+
+#include <iostream>     // cout
+#include <iomanip>      // setprecision
+#include <algorithm>    // min, max
+#include <cstdlib>      // exit()
+#include <string>
+#include <vector>
+#include <memory>
+#include "sampling.hpp"
+#include "inputStates.hpp"  // Tokenize, Trim, ReadVector
+#include "input.hpp"
+#include "physicsModels.hpp"
+#include "gridLevel.hpp"
+#include "procBlock.hpp"
+#include "parallel.hpp"
+#include "kdtree.hpp"
+#include "macros.hpp"
+#include "mpi.h"
+
+using std::cout;
+using std::endl;
+using std::cerr;
+
+ostream &operator<<(ostream &os, const sampleSet &set) {
+  set.Print(os);
+  return os;
+}
+
+void sampleSet::Print(ostream &os) const {
+  os << type_ << "(name=" << name_;
+  if (type_ == "point") {
+    os << "; location=[" << start_ << "]";
+  } else if (type_ == "line") {
+    os << "; start=[" << start_ << "]; end=[" << end_
+       << "]; points=" << numPoints_;
+  } else {
+    os << "; block=" << block_ << "; i=[" << cellStart_.X() << ", "
+       << cellEnd_.X() - 1 << "]; j=[" << cellStart_.Y() << ", "
+       << cellEnd_.Y() - 1 << "]; k=[" << cellStart_.Z() << ", "
+       << cellEnd_.Z() - 1 << "]";
+  }
+  os << ")";
+}
+
+// construct sample set from string
+void sampleSet::Read(string &str) {
+  const auto start = str.find("(") + 1;
+  const auto end = str.find(")") - 1;
+  const auto range = end - start + 1;  // +/-1 to ignore ()
+  auto state = str.substr(start, range);
+  type_ = Trim(str.substr(0, start - 1));
+  if (type_ != "point" && type_ != "line" && type_ != "surface") {
+    cerr << "ERROR. Sample specifier " << type_ << " is not recognized!"
+         << endl;
+    exit(EXIT_FAILURE);
+  }
+  auto tokens = Tokenize(state, ";");
+
+  // erase portion used so multiple sets in same string can easily be found
+  str.erase(0, end);
+
+  // reads a cell index or an inclusive range of cell indices
+  const auto readCells = [](const string &val, int &first, int &last) {
+    if (val.find("[") == string::npos) {
+      first = stoi(val);
+      last = first + 1;
+    } else {
+      const auto inds = ReadVectorXd(val);
+      if (inds.size() != 2) {
+        cerr << "ERROR. Expected two indices for surface cell range, found "
+             << inds.size() << endl;
+        exit(EXIT_FAILURE);
+      }
+      first = static_cast<int>(inds[0]);
+      last = static_cast<int>(inds[1]) + 1;
+    }
+  };
+
+  // parameter counters
+  auto nameCount = 0;
+  auto locationCount = 0;
+  auto startCount = 0;
+  auto endCount = 0;
+  auto pointsCount = 0;
+  auto blockCount = 0;
+  vector3d<int> cellCount(0, 0, 0);
+
+  for (auto &token : tokens) {
+    auto param = Tokenize(token, "=", 1);
+    if (param.size() != 2) {
+      cerr << "ERROR. Problem with " << type_ << " parameter " << token
+           << endl;
+      exit(EXIT_FAILURE);
+    }
+
+    if (param[0] == "name") {
+      name_ = RemoveTrailing(param[1], ",");
+      nameCount++;
+    } else if (param[0] == "location" && type_ == "point") {
+      start_ = ReadVector(RemoveTrailing(param[1], ","));
+      end_ = start_;
+      locationCount++;
+    } else if (param[0] == "start" && type_ == "line") {
+      start_ = ReadVector(RemoveTrailing(param[1], ","));
+      startCount++;
+    } else if (param[0] == "end" && type_ == "line") {
+      end_ = ReadVector(RemoveTrailing(param[1], ","));
+      endCount++;
+    } else if (param[0] == "points" && type_ == "line") {
+      numPoints_ = stoi(RemoveTrailing(param[1], ","));
+      pointsCount++;
+    } else if (param[0] == "block" && type_ == "surface") {
+      block_ = stoi(RemoveTrailing(param[1], ","));
+      blockCount++;
+    } else if ((param[0] == "i" || param[0] == "j" || param[0] == "k") &&
+               type_ == "surface") {
+      const auto dd = param[0] == "i" ? 0 : (param[0] == "j" ? 1 : 2);
+      readCells(RemoveTrailing(param[1], ","), cellStart_[dd], cellEnd_[dd]);
+      cellCount[dd]++;
+    } else {
+      cerr << "ERROR. " << type_ << " specifier " << param[0]
+           << " is not recognized!" << endl;
+      exit(EXIT_FAILURE);
+    }
+  }
+
+  // sanity checks
+  if (nameCount != 1) {
+    cerr << "ERROR. For " << type_ << " name must be specified once." << endl;
+    exit(EXIT_FAILURE);
+  }
+  if (type_ == "point" && locationCount != 1) {
+    cerr << "ERROR. For point location must be specified once." << endl;
+    exit(EXIT_FAILURE);
+  }
+  if (type_ == "line" &&
+      (startCount != 1 || endCount != 1 || pointsCount != 1)) {
+    cerr << "ERROR. For line start, end, and points must be specified once."
+         << endl;
+    exit(EXIT_FAILURE);
+  }
+  if (type_ == "line" && numPoints_ < 2) {
+    cerr << "ERROR. For line points must be at least 2." << endl;
+    exit(EXIT_FAILURE);
+  }
+  if (type_ == "surface" &&
+      (blockCount != 1 || cellCount != vector3d<int>(1, 1, 1))) {
+    cerr << "ERROR. For surface block, i, j, and k must be specified once."
+         << endl;
+    exit(EXIT_FAILURE);
+  }
+  if (type_ == "surface" &&
+      (cellStart_.X() < 0 || cellStart_.Y() < 0 || cellStart_.Z() < 0 ||
+       cellEnd_.X() <= cellStart_.X() || cellEnd_.Y() <= cellStart_.Y() ||
+       cellEnd_.Z() <= cellStart_.Z())) {
+    cerr << "ERROR. For surface " << name_ << " cell range is not valid."
+         << endl;
+    exit(EXIT_FAILURE);
+  }
+}
+
+// member function to return the number of cells sampled
+int sampleSet::NumSamples() const {
+  if (type_ == "point") {
+    return 1;
+  } else if (type_ == "line") {
+    return numPoints_;
+  } else {
+    const auto numCells = cellEnd_ - cellStart_;
+    return numCells.X() * numCells.Y() * numCells.Z();
+  }
+}
+
+// member function to return the location of a point or line sample
+vector3d<double> sampleSet::Location(const int &ii) const {
+  MSG_ASSERT(!this->IsSurface(), "surface samples are located by index");
+  if (type_ == "point") {
+    return start_;
+  }
+  return start_ + (end_ - start_) * (static_cast<double>(ii) /
+                                     (numPoints_ - 1));
+}
+
+// function to read a list of sample sets
+vector<sampleSet> ReadSampleList(ifstream &inFile, string &str) {
+  vector<sampleSet> sampleList;
+  const vector<string> types = {"point(", "line(", "surface("};
+  // position of next sample set in string
+  const auto findSet = [&types](const string &s) {
+    auto pos = string::npos;
+    for (auto &type : types) {
+      pos = std::min(pos, s.find(type));
+    }
+    return pos;
+  };
+
+  auto openList = false;
+  do {
+    auto start = openList ? 0 : str.find("<");
+    auto listOpened = str.find("<") == string::npos ? false : true;
+    auto end = str.find(">");
+    openList = (end == string::npos) ? true : false;
+
+    // test for sample set on current line
+    // if < or > is alone on a line, should not look for sample set
+    if (findSet(str) != string::npos) {  // there is a set in current line
+      string list;
+      if (listOpened && openList) {  // list opened on current line, remains open
+        list = str.substr(start + 1, string::npos);
+      } else if (listOpened && !openList) {  // list opened/closed on current line
+        const auto range = end - start - 1;
+        list = str.substr(start + 1, range);  // +/- 1 to ignore <>
+      } else if (!listOpened && openList) {  // list was open and remains open
+        list = str.substr(start, string::npos);
+      } else {  // list was open and is now closed
+        const auto range = end - start;
+        list = str.substr(start, range);
+      }
+
+      auto nextSet = findSet(list);
+      while (nextSet != string::npos) {  // there are more sets to read
+        list.erase(0, nextSet);  // remove commas separating sets
+        sampleSet set;
+        set.Read(list);
+        for (auto &prev : sampleList) {
+          if (prev.Name() == set.Name()) {
+            cerr << "ERROR: Sample name " << set.Name() << " is repeated!"
+                 << endl;
+            exit(EXIT_FAILURE);
+          }
+        }
+        sampleList.push_back(set);
+        nextSet = findSet(list);
+      }
+    }
+
+    if (openList) {
+      getline(inFile, str);
+      str = Trim(str);
+    }
+  } while (openList);
+
+  return sampleList;
+}
+
+// function to resolve sample variable names into functions evaluating them
+// at a cell in dimensional units
+vector<sampleVariable> SampleVariables(const vector<string> &names,
+                                       const physics &phys,
+                                       const input &inp) {
+  // names -- names of variables to sample
+  // phys -- physics models
+  // inp -- input variables
+
+  // dimensional scaling factors
+  const auto rRef = inp.RRef();
+  const auto aRef = inp.ARef();
+  const auto tRef = inp.TRef();
+  const auto muRef = phys.Transport()->MuRef();
+  const auto pRef = rRef * aRef * aRef;
+  const auto eRef = aRef * aRef;
+  const auto sdrRef = aRef * aRef * rRef / muRef;
+
+  vector<sampleVariable> vars;
+  vars.reserve(names.size());
+  for (auto &var : names) {
+    if (var == "density") {
+      vars.push_back([=](const procBlock &blk, const int &ii, const int &jj,
+                         const int &kk) {
+        return blk.State(ii, jj, kk).Rho() * rRef;
+      });
+    } else if (var == "vel_x") {
+      vars.push_back([=](const procBlock &blk, const int &ii, const int &jj,
+                         const int &kk) {
+        return blk.State(ii, jj, kk).U() * aRef;
+      });
+    } else if (var == "vel_y") {
+      vars.push_back([=](const procBlock &blk, const int &ii, const int &jj,
+                         const int &kk) {
+        return blk.State(ii, jj, kk).V() * aRef;
+      });
+    } else if (var == "vel_z") {
+      vars.push_back([=](const procBlock &blk, const int &ii, const int &jj,
+                         const int &kk) {
+        return blk.State(ii, jj, kk).W() * aRef;
+      });
+    } else if (var == "pressure") {
+      vars.push_back([=](const procBlock &blk, const int &ii, const int &jj,
+                         const int &kk) {
+        return blk.State(ii, jj, kk).P() * pRef;
+      });
+    } else if (var == "temperature") {
+      vars.push_back([=](const procBlock &blk, const int &ii, const int &jj,
+                         const int &kk) {
+        return blk.Temperature(ii, jj, kk) * tRef;
+      });
+    } else if (var == "mach") {
+      vars.push_back([&phys](const procBlock &blk, const int &ii,
+                             const int &jj, const int &kk) {
+        const auto state = blk.State(ii, jj, kk);
+        return state.Velocity().Mag() / state.SoS(phys);
+      });
+    } else if (var == "sos") {
+      vars.push_back([=, &phys](const procBlock &blk, const int &ii,
+                                const int &jj, const int &kk) {
+        return blk.State(ii, jj, kk).SoS(phys) * aRef;
+      });
+    } else if (var == "tke") {
+      vars.push_back([=](const procBlock &blk, const int &ii, const int &jj,
+                         const int &kk) {
+        return blk.State(ii, jj, kk).Tke() * eRef;
+      });
+    } else if (var == "sdr") {
+      vars.push_back([=](const procBlock &blk, const int &ii, const int &jj,
+                         const int &kk) {
+        return blk.State(ii, jj, kk).Omega() * sdrRef;
+      });
+    } else {
+      cerr << "ERROR: Sample variable " << var << " is not defined!" << endl;
+      exit(EXIT_FAILURE);
+    }
+  }
+  return vars;
+}
+
+// constructor
+sampleManager::sampleManager(const input &inp, const physics &phys,
+                             const gridLevel &level,
+                             const decomposition &decomp,
+                             const vector<vector3d<int>> &gridSizes,
+                             const int &rank)
+    : rank_(rank), sets_(inp.Samples()) {
+  // inp -- input variables
+  // phys -- physics models
+  // level -- finest grid level on this processor
+  // decomp -- decomposition of grid onto processors
+  // gridSizes -- number of nodes in each block of the grid file
+  // rank -- processor rank
+  if (sets_.empty()) {
+    return;
+  }
+
+  offsets_.reserve(sets_.size() + 1);
+  offsets_.push_back(0);
+  for (auto &set : sets_) {
+    offsets_.push_back(offsets_.back() + set.NumSamples());
+  }
+  for (auto &var : inp.SampleVariables()) {
+    varNames_.push_back(var);
+  }
+  vars_ = SampleVariables(varNames_, phys, inp);
+
+  // locate point and line samples at nearest cell ------------------------
+  vector<int> pointSamples;
+  vector<vector3d<double>> locations;
+  for (auto ss = 0U; ss < sets_.size(); ++ss) {
+    if (!sets_[ss].IsSurface()) {
+      for (auto ii = 0; ii < sets_[ss].NumSamples(); ++ii) {
+        pointSamples.push_back(offsets_[ss] + ii);
+        locations.push_back(sets_[ss].Location(ii) / inp.LRef());
+      }
+    }
+  }
+
+  if (!pointSamples.empty()) {
+    // build k-d tree of cell centers on this processor
+    vector<vector3d<double>> centers;
+    vector<sampleCell> treeCells;
+    for (auto bb = 0; bb < level.NumBlocks(); ++bb) {
+      const auto &blk = level.Block(bb);
+      for (auto kk = blk.StartK(); kk < blk.EndK(); kk++) {
+        for (auto jj = blk.StartJ(); jj < blk.EndJ(); jj++) {
+          for (auto ii = blk.StartI(); ii < blk.EndI(); ii++) {
+            centers.push_back(blk.Center(ii, jj, kk));
+            treeCells.push_back({-1, bb, ii, jj, kk});
+          }
+        }
+      }
+    }
+    kdtree tree(centers);
+
+    // nearest cell on this processor, then processor with nearest cell
+    struct distRank {
+      double dist_;
+      int rank_;
+    };
+    vector<distRank> nearestCells(locations.size());
+    vector<int> nearestIds(locations.size());
+    for (auto pp = 0U; pp < locations.size(); ++pp) {
+      vector3d<double> neighbor;
+      nearestCells[pp].dist_ =
+          tree.NearestNeighbor(locations[pp], neighbor, nearestIds[pp]);
+      nearestCells[pp].rank_ = rank_;
+    }
+    MPI_Allreduce(MPI_IN_PLACE, nearestCells.data(), nearestCells.size(),
+                  MPI_DOUBLE_INT, MPI_MINLOC, MPI_COMM_WORLD);
+
+    for (auto pp = 0U; pp < locations.size(); ++pp) {
+      if (nearestCells[pp].rank_ == rank_) {
+        auto cell = treeCells[nearestIds[pp]];
+        cell.sample_ = pointSamples[pp];
+        cells_.push_back(cell);
+      }
+    }
+  }
+
+  // locate surface samples from cell ranges ------------------------------
+  const auto ranges = decomp.NodeRanges(gridSizes);
+  for (auto ss = 0U; ss < sets_.size(); ++ss) {
+    const auto &set = sets_[ss];
+    if (!set.IsSurface()) {
+      continue;
+    }
+    if (set.Block() < 0 ||
+        set.Block() >= static_cast<int>(gridSizes.size())) {
+      cerr << "ERROR: Block " << set.Block() << " of sample " << set.Name()
+           << " is not in grid!" << endl;
+      exit(EXIT_FAILURE);
+    }
+    const auto numCells = gridSizes[set.Block()] - 1;
+    if (set.CellEnd().X() > numCells.X() || set.CellEnd().Y() > numCells.Y() ||
+        set.CellEnd().Z() > numCells.Z()) {
+      cerr << "ERROR: Cell range of sample " << set.Name()
+           << " is outside of block " << set.Block() << endl;
+      exit(EXIT_FAILURE);
+    }
+
+    const auto setCells = set.CellEnd() - set.CellStart();
+    for (auto bb = 0; bb < level.NumBlocks(); ++bb) {
+      const auto &blk = level.Block(bb);
+      if (blk.ParentBlock() != set.Block()) {
+        continue;
+      }
+      // cells of parent block that this block covers
+      const auto &range = ranges[blk.GlobalPos()];
+      const vector3d<int> offset(range[0].Start(), range[1].Start(),
+                                 range[2].Start());
+      const vector3d<int> blkEnd(offset.X() + blk.NumI(),
+                                 offset.Y() + blk.NumJ(),
+                                 offset.Z() + blk.NumK());
+      for (auto kk = std::max(set.CellStart().Z(), offset.Z());
+           kk < std::min(set.CellEnd().Z(), blkEnd.Z()); kk++) {
+        for (auto jj = std::max(set.CellStart().Y(), offset.Y());
+             jj < std::min(set.CellEnd().Y(), blkEnd.Y()); jj++) {
+          for (auto ii = std::max(set.CellStart().X(), offset.X());
+               ii < std::min(set.CellEnd().X(), blkEnd.X()); ii++) {
+            const auto pos =
+                ((kk - set.CellStart().Z()) * setCells.Y() + jj -
+                 set.CellStart().Y()) * setCells.X() + ii - set.CellStart().X();
+            cells_.push_back({offsets_[ss] + pos, bb,
+                              blk.StartI() + ii - offset.X(),
+                              blk.StartJ() + jj - offset.Y(),
+                              blk.StartK() + kk - offset.Z()});
+          }
+        }
+      }
+    }
+  }
+
+  // get coordinates of sampled cells on ROOT
+  vector<double> coords(3 * this->NumSamples(), 0.0);
+  for (auto &cell : cells_) {
+    const auto center = level.Block(cell.block_).Center(cell.i_, cell.j_,
+                                                        cell.k_) * inp.LRef();
+    for (auto dd = 0; dd < 3; ++dd) {
+      coords[3 * cell.sample_ + dd] = center[dd];
+    }
+  }
+  if (rank_ == ROOTP) {
+    MPI_Reduce(MPI_IN_PLACE, coords.data(), coords.size(), MPI_DOUBLE,
+               MPI_SUM, ROOTP, MPI_COMM_WORLD);
+  } else {
+    MPI_Reduce(coords.data(), coords.data(), coords.size(), MPI_DOUBLE,
+               MPI_SUM, ROOTP, MPI_COMM_WORLD);
+    return;
+  }
+
+  // open sample files and write headers on ROOT
+  for (auto ss = 0U; ss < sets_.size(); ++ss) {
+    const auto fileName =
+        inp.SimNameRoot() + "_" + sets_[ss].Name() + ".sample";
+    files_.push_back(std::unique_ptr<ofstream>(new ofstream(
+        fileName, inp.IsRestart() ? std::ios::app : std::ios::out)));
+    auto &file = *files_.back();
+    if (file.fail()) {
+      cerr << "ERROR: Could not open sample file " << fileName << endl;
+      exit(EXIT_FAILURE);
+    }
+    if (inp.IsRestart()) {
+      continue;
+    }
+
+    file << "# " << sets_[ss] << endl;
+    file << "# sample cell centers (x y z)" << endl;
+    file << std::setprecision(10) << std::scientific;
+    for (auto pp = offsets_[ss]; pp < offsets_[ss + 1]; ++pp) {
+      file << "# " << pp - offsets_[ss] << " " << coords[3 * pp] << " "
+           << coords[3 * pp + 1] << " " << coords[3 * pp + 2] << endl;
+    }
+    file << "# iteration";
+    if (inp.IsTimeAccurate()) {
+      file << " time";
+    }
+    file << " then for each sample:";
+    for (auto &var : varNames_) {
+      file << " " << var;
+    }
+    file << endl;
+  }
+}
+
+// member function to write the sampled values
+void sampleManager::Write(const gridLevel &level, const input &inp,
+                          const int &iter) const {
+  // level -- finest grid level on this processor
+  // inp -- input variables
+  // iter -- iteration number
+  if (!this->HasSamples()) {
+    return;
+  }
+
+  // each sample is owned by one processor, so sum gives the owned value
+  const auto numVars = static_cast<int>(vars_.size());
+  vector<double> values(this->NumSamples() * numVars, 0.0);
+  for (auto &cell : cells_) {
+    const auto &blk = level.Block(cell.block_);
+    for (auto vv = 0; vv < numVars; ++vv) {
+      values[cell.sample_ * numVars + vv] =
+          vars_[vv](blk, cell.i_, cell.j_, cell.k_);
+    }
+  }
+  if (rank_ == ROOTP) {
+    MPI_Reduce(MPI_IN_PLACE, values.data(), values.size(), MPI_DOUBLE,
+               MPI_SUM, ROOTP, MPI_COMM_WORLD);
+  } else {
+    MPI_Reduce(values.data(), values.data(), values.size(), MPI_DOUBLE,
+               MPI_SUM, ROOTP, MPI_COMM_WORLD);
+    return;
+  }
+
+  for (auto ss = 0U; ss < sets_.size(); ++ss) {
+    auto &file = *files_[ss];
+    file << iter;
+    if (inp.IsTimeAccurate()) {
+      file << " " << iter * inp.Dt();
+    }
+    for (auto ii = offsets_[ss] * numVars; ii < offsets_[ss + 1] * numVars;
+         ++ii) {
+      file << " " << values[ii];
+    }
+    file << endl;
+  }
+}
@@ -255,14 +255,20 @@ void geomSlice::PackSwapUnpackMPI(const connection &inter,
   MPI_Pack(&(*std::begin(vol_)), vol_.Size(), MPI_DOUBLE, rawBuffer, bufSize,
            &position, MPI_COMM_WORLD);
 
+  // slices on either side of the connection are not necessarily the same size
+  // (i.e. at "t" intersections), so swap buffer sizes first
+  const auto partner =
+      (rank == inter.RankFirst()) ? inter.RankSecond() : inter.RankFirst();
+  auto recvBufSize = 0;
   MPI_Status status;
-  if (rank == inter.RankFirst()) {  // send/recv with second entry in connection
-    MPI_Sendrecv_replace(rawBuffer, bufSize, MPI_PACKED, inter.RankSecond(),
-                         tag, inter.RankSecond(), tag, MPI_COMM_WORLD, &status);
-  } else {  // send/recv with first entry in connection
-    MPI_Sendrecv_replace(rawBuffer, bufSize, MPI_PACKED, inter.RankFirst(), tag,
-                         inter.RankFirst(), tag, MPI_COMM_WORLD, &status);
-  }
+  MPI_Sendrecv(&bufSize, 1, MPI_INT, partner, tag, &recvBufSize, 1, MPI_INT,
+               partner, tag, MPI_COMM_WORLD, &status);
+  auto recvBuffer = std::make_unique<char[]>(recvBufSize);
+  auto *rawRecvBuffer = recvBuffer.get();
+  MPI_Sendrecv(rawBuffer, bufSize, MPI_PACKED, partner, tag, rawRecvBuffer,
+               recvBufSize, MPI_PACKED, partner, tag, MPI_COMM_WORLD, &status);
+  rawBuffer = rawRecvBuffer;
+  bufSize = recvBufSize;
 
   // put slice back into geomSlice
   position = 0;
@@ -274,8 +280,9 @@ void geomSlice::PackSwapUnpackMPI(const connection &inter,
   MPI_Unpack(rawBuffer, bufSize, &position, &parBlock_, 1, MPI_INT,
              MPI_COMM_WORLD);
 
-  // resize slice
-  this->SameSizeResize(numI, numJ, numK, numGhosts);
+  // resize slice to size of partner's slice
+  MSG_ASSERT(numGhosts == 0, "geomSlice should not have ghost cells");
+  *this = geomSlice(numI, numJ, numK, parBlock_);
   // unpack center
   MPI_Unpack(rawBuffer, bufSize, &position, &(*std::begin(center_)),
              center_.Size(), MPI_vec3d, MPI_COMM_WORLD);
@@ -31,6 +31,7 @@
 #include "matMultiArray3d.hpp"
 #include "kdtree.hpp"
 #include "resid.hpp"
+#include "haloExchange.hpp"
 #include "primitive.hpp"
 #include "macros.hpp"
 
@@ -298,9 +299,14 @@ void SwapGeomSliceMPI(connection &inter, procBlock &blk, const int &tag,
   const auto adjEdge = blk.PutGeomSlice(slice, interAdj, blk.NumGhosts());
 
   // if a connection border needs to be updated, update
+  // only the side of the connection on this processor is known here
   for (auto ii = 0U; ii < adjEdge.size(); ++ii) {
     if (adjEdge[ii]) {
-      inter.UpdateBorderFirst(ii);
+      if (rank == inter.RankFirst()) {
+        inter.UpdateBorderFirst(ii);
+      } else {
+        inter.UpdateBorderSecond(ii);
+      }
     }
   }
 }
@@ -376,20 +382,16 @@ calculating a flux jacobian. Ex. The solver must visit all points on hyperplane
 */
 vector<vector3d<int>> HyperplaneReorder(const int &imax, const int &jmax,
                                         const int &kmax) {
-  // total number of hyperplanes in a given block
-  const auto numPlanes = imax + jmax + kmax - 2;
-  vector<vector3d<int>> reorder;
-  reorder.reserve(imax * jmax * kmax);
-
-  for (auto pp = 0; pp < numPlanes; pp++) {
-    for (auto kk = 0; kk < kmax; kk++) {
-      for (auto jj = 0; jj < jmax; jj++) {
-        for (auto ii = 0; ii < imax; ii++) {
-          if (ii + jj + kk == pp) {  // if sum of ii, jj, and kk equals pp than
-                                     // point is on hyperplane pp
-            reorder.emplace_back(ii, jj, kk);
-          }
-        }
+  // location of the start of each hyperplane in the reordered cells
+  const auto planeStart = HyperplaneOffsets(imax, jmax, kmax);
+  auto next = planeStart;
+  vector<vector3d<int>> reorder(imax * jmax * kmax);
+
+  // within a hyperplane cells are ordered by k, then j, then i
+  for (auto kk = 0; kk < kmax; kk++) {
+    for (auto jj = 0; jj < jmax; jj++) {
+      for (auto ii = 0; ii < imax; ii++) {
+        reorder[next[ii + jj + kk]++] = vector3d<int>(ii, jj, kk);
       }
     }
   }
@@ -397,13 +399,36 @@ vector<vector3d<int>> HyperplaneReorder(const int &imax, const int &jmax,
   return reorder;
 }
 
+// function to find the start of each hyperplane in the cells reordered by
+// HyperplaneReorder; the last entry is the total number of cells, so the
+// cells of hyperplane pp are in the range [offsets[pp], offsets[pp + 1])
+vector<int> HyperplaneOffsets(const int &imax, const int &jmax,
+                              const int &kmax) {
+  // total number of hyperplanes in a given block
+  const auto numPlanes = imax + jmax + kmax - 2;
+  vector<int> offsets(numPlanes + 1, 0);
+
+  // count cells on each hyperplane
+  for (auto kk = 0; kk < kmax; kk++) {
+    for (auto jj = 0; jj < jmax; jj++) {
+      for (auto ii = 0; ii < imax; ii++) {
+        offsets[ii + jj + kk + 1]++;
+      }
+    }
+  }
+  std::partial_sum(std::begin(offsets), std::end(offsets),
+                   std::begin(offsets));
+  return offsets;
+}
+
 void SwapImplicitUpdate(vector<blkMultiArray3d<varArray>> &du,
                         const vector<connection> &connections, const int &rank,
-                        const int &numGhosts) {
+                        const int &numGhosts, haloExchange &exchange) {
   // du -- implicit update in conservative variables
   // conn -- connection boundary conditions
   // rank -- processor rank
   // numGhosts -- number of ghost cells
+  // exchange -- exchange to swap updates over mpi with
 
   // loop over all connections and swap connection updates when necessary
   for (auto &conn : connections) {
@@ -412,14 +437,16 @@ void SwapImplicitUpdate(vector<blkMultiArray3d<varArray>> &du,
       du[conn.LocalBlockFirst()].SwapSlice(conn, du[conn.LocalBlockSecond()]);
     } else if (conn.RankFirst() == rank) {
       // rank matches rank of first side of connection, swap over mpi
-      du[conn.LocalBlockFirst()].SwapSliceMPI(conn, rank, MPI_DOUBLE);
+      exchange.Post(du[conn.LocalBlockFirst()], conn, rank, MPI_DOUBLE, 1);
     } else if (conn.RankSecond() == rank) {
       // rank matches rank of second side of connection, swap over mpi
-      du[conn.LocalBlockSecond()].SwapSliceMPI(conn, rank, MPI_DOUBLE);
+      exchange.Post(du[conn.LocalBlockSecond()], conn, rank, MPI_DOUBLE, 1);
     }
     // if rank doesn't match either side of connection, then do nothing and
     // move on to the next connection
   }
+  // wait for swaps over mpi to complete
+  exchange.Finish();
 }
 
 
@@ -14,12 +14,56 @@
     You should have received a copy of the GNU General Public License
     along with this program.  If not, see <http://www.gnu.org/licenses/>. */
 
+#include <array>
 #include "wallData.hpp"
 #include "vector3d.hpp"
 #include "input.hpp"
 #include "eos.hpp"
 #include "primitive.hpp"
 
+// wallLoads functions
+// member function to add the loads on a wall face
+void wallLoads::AddFace(const vector3d<double> &pressureForce,
+                        const vector3d<double> &viscousForce,
+                        const vector3d<double> &arm, const double &heatFlux) {
+  // pressureForce -- pressure force on face
+  // viscousForce -- viscous force on face
+  // arm -- vector from moment reference point to face center
+  // heatFlux -- heat transfer rate into wall through face
+  pressureForce_ += pressureForce;
+  viscousForce_ += viscousForce;
+  moment_ += arm.CrossProd(pressureForce + viscousForce);
+  heatFlux_ += heatFlux;
+}
+
+// member function to sum the loads from all processors on ROOT
+void wallLoads::GlobalReduceMPI(const int &rank) {
+  std::array<double, 10> loads = {
+      pressureForce_.X(), pressureForce_.Y(), pressureForce_.Z(),
+      viscousForce_.X(),  viscousForce_.Y(),  viscousForce_.Z(),
+      moment_.X(),        moment_.Y(),        moment_.Z(),
+      heatFlux_};
+  if (rank == ROOTP) {
+    MPI_Reduce(MPI_IN_PLACE, loads.data(), loads.size(), MPI_DOUBLE, MPI_SUM,
+               ROOTP, MPI_COMM_WORLD);
+  } else {
+    MPI_Reduce(loads.data(), loads.data(), loads.size(), MPI_DOUBLE, MPI_SUM,
+               ROOTP, MPI_COMM_WORLD);
+  }
+  pressureForce_ = {loads[0], loads[1], loads[2]};
+  viscousForce_ = {loads[3], loads[4], loads[5]};
+  moment_ = {loads[6], loads[7], loads[8]};
+  heatFlux_ = loads[9];
+}
+
+wallLoads &wallLoads::operator+=(const wallLoads &other) {
+  pressureForce_ += other.pressureForce_;
+  viscousForce_ += other.viscousForce_;
+  moment_ += other.moment_;
+  heatFlux_ += other.heatFlux_;
+  return *this;
+}
+
 // wallVars functions
 void wallVars::Pack(char *(&sendBuffer), const int &sendBufSize, int &position,
                     const MPI_Datatype &MPI_vec3d) const {
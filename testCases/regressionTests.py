@@ -24,6 +24,8 @@ import sys
 import datetime
 import subprocess
 import time
+import filecmp
+import struct
 
 class regressionTest:
     def __init__(self):
@@ -41,6 +43,16 @@ class regressionTest:
         self.restartFile = "none"
         self.passedStatus = "none"
         self.isProfile = False
+        self.inputOptions = {}
+        self.savedFiles = []
+        self.savedTag = ""
+        self.matchingFiles = []
+        self.matchingTag = ""
+        self.functionFile = ""
+        self.functionMeans = []
+        self.lastLineValues = {}
+        self.expectedOutput = []
+        self.environment = {}
 
     def SetRegressionCase(self, name):
         self.caseName = name
@@ -87,6 +99,23 @@ class regressionTest:
     def SetRestartFile(self, resFile):
         self.restartFile = resFile
 
+    def SetInputOption(self, key, value):
+        self.inputOptions[key] = value
+
+    # environment variable set for the run, such as the number of threads
+    def SetEnvironment(self, key, value):
+        self.environment[key] = value
+
+    # copy output files after the run so a later test can compare with them
+    def SetSavedFiles(self, files, tag):
+        self.savedFiles = files
+        self.savedTag = tag
+
+    # output files that must be identical to ones saved by an earlier test
+    def SetMatchingFiles(self, files, tag):
+        self.matchingFiles = files
+        self.matchingTag = tag
+
     def ReturnToHomeDirectory(self):
         os.chdir(self.location)
 
@@ -114,25 +143,123 @@ class regressionTest:
             passing = [False for ii in resids]
         return passing, resids, truthResids
 
+    # mean of each variable in a plot3d function file written by the test
+    def SetFunctionFileMeans(self, fname, means):
+        self.functionFile = fname
+        self.functionMeans = means
+
+    def GetFunctionFileMeans(self):
+        with open(self.functionFile, "rb") as fin:
+            data = fin.read()
+        numBlocks = struct.unpack_from("i", data, 0)[0]
+        dims = struct.unpack_from(str(4 * numBlocks) + "i", data, 4)
+        offset = 4 + 16 * numBlocks
+        numVars = dims[3]
+        sums = [0.0] * numVars
+        numCells = 0
+        for bb in range(0, numBlocks):
+            size = dims[4 * bb] * dims[4 * bb + 1] * dims[4 * bb + 2]
+            for vv in range(0, numVars):
+                sums[vv] += sum(struct.unpack_from(str(size) + "d", data,
+                                                   offset))
+                offset += 8 * size
+            numCells += size
+        return [val / numCells for val in sums]
+
+    def CompareFunctionFileMeans(self):
+        if not self.functionFile:
+            return []
+        means = self.GetFunctionFileMeans()
+        # means that are only round off are given as None and not compared
+        passing = [self.functionMeans[ii] is None or
+                   abs(mean - self.functionMeans[ii]) <=
+                   self.percentTolerance * abs(self.functionMeans[ii])
+                   for ii, mean in enumerate(means)]
+        if len(means) != len(self.functionMeans) or not all(passing):
+            print("Function file means should be:", self.functionMeans)
+            print("Function file means are:", means)
+            passing.append(False)
+        return passing
+
+    # values on the last line of a text output file written by the test
+    def SetLastLineValues(self, fname, values):
+        self.lastLineValues[fname] = values
+
+    def CompareLastLineValues(self):
+        passing = []
+        for fname, truth in self.lastLineValues.items():
+            with open(fname, "r") as fin:
+                lastLine = fin.readlines()[-1]
+            values = [float(token) for token in lastLine.split()]
+            # values that are only round off are given as None and not compared
+            matches = [tt is None or
+                       abs(val - tt) <= self.percentTolerance * abs(tt)
+                       for val, tt in zip(values, truth)]
+            if len(values) != len(truth) or not all(matches):
+                print("Last line of", fname, "should be:", truth)
+                print("Last line of", fname, "is:", values)
+                matches.append(False)
+            passing += matches
+        return passing
+
+    # text that must be printed by the test
+    def SetExpectedOutput(self, text):
+        self.expectedOutput.append(text)
+
+    def CompareExpectedOutput(self):
+        with open(self.caseName + ".out", "r") as fin:
+            output = fin.read()
+        passing = [text in output for text in self.expectedOutput]
+        for text, found in zip(self.expectedOutput, passing):
+            if not found:
+                print("Output should contain:", text)
+        return passing
+
+    def SaveOutputFiles(self):
+        for fname in self.savedFiles:
+            shutil.copyfile(fname, fname + "." + self.savedTag)
+
+    def CompareOutputFiles(self):
+        passing = []
+        for fname in self.matchingFiles:
+            saved = fname + "." + self.matchingTag
+            same = filecmp.cmp(fname, saved, shallow=False)
+            if not same:
+                print("Output file", fname, "does not match", saved)
+            passing.append(same)
+        return passing
+
     def GetResiduals(self):
         return self.residuals
         
-    # change input file to have number of iterations specified for test
+    # change input file to have number of iterations and input options
+    # specified for test; the original input file is kept so that a case can
+    # be run more than once with different options
     def ModifyInputFile(self):
         fname = self.caseName + ".inp"
         fnameBackup = fname + ".old"
-        shutil.move(fname, fnameBackup)
+        if not os.path.exists(fnameBackup):
+            shutil.move(fname, fnameBackup)
+        with open(fnameBackup, "r") as fin:
+            lines = fin.readlines()
+        keys = [line.split(":")[0].strip() for line in lines]
+        newOptions = [key for key in self.inputOptions if key not in keys]
         with open(fname, "w") as fout:
-            with open(fnameBackup, "r") as fin:
-                for line in fin:
-                    if "iterations:" in line:
-                        fout.write("iterations: " + str(self.iterations) + "\n")
-                    elif "outputFrequency:" in line:
-                        fout.write("outputFrequency: " + str(self.iterations) + "\n")
-                    elif "restartFrequency:" in line and self.isProfile:
-                        fout.write("restartFrequency: " + str(self.iterations) + "\n")
-                    else:
-                        fout.write(line)
+            for key, line in zip(keys, lines):
+                if "iterations:" in line:
+                    fout.write("iterations: " + str(self.iterations) + "\n")
+                    # options not in input file go after iterations
+                    for option in newOptions:
+                        fout.write(option + ": " + self.inputOptions[option] + "\n")
+                    newOptions = []
+                elif "outputFrequency:" in line:
+                    fout.write("outputFrequency: " + str(self.iterations) + "\n")
+                elif "restartFrequency:" in line and self.isProfile:
+                    fout.write("restartFrequency: " + str(self.iterations) + "\n")
+                elif key in self.inputOptions:
+                    fout.write(key + ": " + self.inputOptions[key] + "\n")
+                else:
+                    fout.write(line)
 
     # modify the input file and run the test
     def RunCase(self):
@@ -151,7 +278,9 @@ class regressionTest:
         print(cmd)
         start = datetime.datetime.now()
         interval = start
-        process = subprocess.Popen(cmd, shell=True)
+        env = os.environ.copy()
+        env.update(self.environment)
+        process = subprocess.Popen(cmd, shell=True, env=env)
         while process.poll() is None:
             current = datetime.datetime.now()
             if (current - interval).total_seconds() > 60.:
@@ -162,9 +291,14 @@ class regressionTest:
 
         if (returnCode == 0):
             print("Simulation completed with no errors")
-            # test residuals for pass/fail
+            self.SaveOutputFiles()
+            # test residuals and output files for pass/fail
             if not self.isProfile:
                 passed, resids, truth = self.CompareResiduals(returnCode)
+                passed += self.CompareOutputFiles()
+                passed += self.CompareFunctionFileMeans()
+                passed += self.CompareLastLineValues()
+                passed += self.CompareExpectedOutput()
                 if all(passed):
                     print("All tests for", self.caseName, "PASSED!")
                     self.passedStatus = "PASSED"
@@ -242,14 +376,64 @@ def main():
         [1.8751e-01, 2.6727e-01, 3.1217e-01, 7.9662e-01, 1.8639e-01])
     subCyl.SetIgnoreIndices(3)
     subCyl.SetMpirunPath(options.mpirunPath)
+    subCyl.SetEnvironment("OMP_NUM_THREADS", "1")
+    subCylFiles = ["subsonicCylinder_" + str(numIterations) + "_center.fun"]
+    subCyl.SetSavedFiles(subCylFiles, "serial")
 
     # run regression case
     passed = subCyl.RunCase()
     totalPass = totalPass and all(passed)
 
+    # ------------------------------------------------------------------
+    # subsonic cylinder threaded
+    # laminar, inviscid, lu-sgs sweeps threaded over the cells of each
+    # hyperplane, solution must be identical to the serial one
+    subCylThreaded = regressionTest()
+    subCylThreaded.SetRegressionCase("subsonicCylinder")
+    subCylThreaded.SetAitherPath(options.aitherPath)
+    subCylThreaded.SetRunDirectory("subsonicCylinder")
+    subCylThreaded.SetProfile(isProfile)
+    subCylThreaded.SetNumberOfProcessors(1)
+    subCylThreaded.SetNumberOfIterations(numIterations)
+    subCylThreaded.SetResiduals(subCyl.GetResiduals())
+    subCylThreaded.SetIgnoreIndices(3)
+    subCylThreaded.SetMpirunPath(options.mpirunPath)
+    subCylThreaded.SetEnvironment("OMP_NUM_THREADS", "3")
+    subCylThreaded.SetMatchingFiles(subCylFiles, "serial")
+
+    # run regression case
+    passed = subCylThreaded.RunCase()
+    totalPass = totalPass and all(passed)
+
+    # ------------------------------------------------------------------
+    # subsonic cylinder rollback
+    # laminar, inviscid, explicit euler, cfl too high so solution diverges
+    # and is rolled back to in-memory checkpoints until it is stable
+    subCylRollback = regressionTest()
+    subCylRollback.SetRegressionCase("subsonicCylinder")
+    subCylRollback.SetAitherPath(options.aitherPath)
+    subCylRollback.SetRunDirectory("subsonicCylinder")
+    subCylRollback.SetProfile(isProfile)
+    subCylRollback.SetNumberOfProcessors(1)
+    subCylRollback.SetNumberOfIterations(numIterations)
+    subCylRollback.SetInputOption("timeIntegration", "explicitEuler")
+    subCylRollback.SetInputOption("cflStart", "4.0")
+    subCylRollback.SetInputOption("cflMax", "4.0")
+    subCylRollback.SetInputOption("checkpointFrequency", "20")
+    subCylRollback.SetInputOption("checkpointCflFactor", "0.5")
+    subCylRollback.SetResiduals(
+        [6.6686e+00, 6.1350e+00, 8.2196e+00, 5.5660e+00, 6.6540e+00])
+    subCylRollback.SetIgnoreIndices(3)
+    subCylRollback.SetMpirunPath(options.mpirunPath)
+
+    # run regression case
+    passed = subCylRollback.RunCase()
+    totalPass = totalPass and all(passed)
+
     # ------------------------------------------------------------------
     # multi-block subsonic cylinder
-    # laminar, inviscid, lusgs, multi-block, ausmpw+
+    # laminar, inviscid, lusgs, multi-block, ausmpw+, point, line and surface
+    # sampling
     multiCyl = regressionTest()
     multiCyl.SetRegressionCase("multiblockCylinder")
     multiCyl.SetAitherPath(options.aitherPath)
@@ -260,12 +444,90 @@ def main():
     multiCyl.SetResiduals(
         [2.0529e-01, 3.4540e-01, 5.0153e-01, 1.0180e+00, 1.9997e-01])
     multiCyl.SetIgnoreIndices(3)
+    multiCyl.SetInputOption(
+        "samples", "<point(name=probe; location=[0.0, 1.5, 1.0]), " +
+        "line(name=wake; start=[1.5, -1.0, 1.0]; end=[1.5, 1.2, 1.0]; " +
+        "points=3), surface(name=wall; block=1; i=31; j=0; k=[19, 20])>")
+    multiCyl.SetInputOption("sampleVariables", "<pressure, mach>")
+    # iteration, then mach and pressure at each sample
+    multiCyl.SetLastLineValues("multiblockCylinder_probe.sample",
+                               [100, 1.3716e-01, 1.0108e+05])
+    multiCyl.SetLastLineValues("multiblockCylinder_wake.sample",
+                               [100, 8.1371e-02, 1.0113e+05, 2.8421e-02,
+                                1.0136e+05, 9.6700e-02, 1.0119e+05])
+    multiCyl.SetLastLineValues("multiblockCylinder_wall.sample",
+                               [100, 1.1509e-01, 1.0000e+05, 1.1304e-01,
+                                9.9943e+04])
     multiCyl.SetMpirunPath(options.mpirunPath)
 
     # run regression case
     passed = multiCyl.RunCase()
     totalPass = totalPass and all(passed)
 
+    # ------------------------------------------------------------------
+    # multi-block subsonic cylinder with vtk output
+    # laminar, inviscid, lusgs, multi-block, parallel vtk output
+    multiCylVtk = regressionTest()
+    multiCylVtk.SetRegressionCase("multiblockCylinder")
+    multiCylVtk.SetAitherPath(options.aitherPath)
+    multiCylVtk.SetRunDirectory("multiblockCylinder")
+    multiCylVtk.SetProfile(isProfile)
+    multiCylVtk.SetNumberOfProcessors(maxProcs)
+    multiCylVtk.SetNumberOfIterations(numIterations)
+    multiCylVtk.SetInputOption("outputFormat", "vtk")
+    multiCylVtk.SetResiduals(
+        [2.0529e-01, 3.4540e-01, 5.0153e-01, 1.0180e+00, 1.9997e-01])
+    multiCylVtk.SetIgnoreIndices(3)
+    multiCylVtk.SetMpirunPath(options.mpirunPath)
+
+    # run regression case
+    passed = multiCylVtk.RunCase()
+    totalPass = totalPass and all(passed)
+
+    # ------------------------------------------------------------------
+    # multi-block subsonic cylinder with gmres
+    # laminar, inviscid, jacobian free bgmres, multi-block
+    multiCylGmres = regressionTest()
+    multiCylGmres.SetRegressionCase("multiblockCylinder")
+    multiCylGmres.SetAitherPath(options.aitherPath)
+    multiCylGmres.SetRunDirectory("multiblockCylinder")
+    multiCylGmres.SetProfile(isProfile)
+    multiCylGmres.SetNumberOfProcessors(maxProcs)
+    multiCylGmres.SetNumberOfIterations(numIterationsShort)
+    multiCylGmres.SetInputOption("matrixSolver", "bgmres")
+    if multiCylGmres.Processors() == 2:
+        multiCylGmres.SetResiduals(
+            [1.7660e-02, 1.8948e-02, 2.8543e-02, 7.4224e-01, 1.9335e-02])
+    else:
+        multiCylGmres.SetResiduals(
+            [1.7660e-02, 1.8948e-02, 2.8543e-02, 8.2547e-01, 1.9335e-02])
+    multiCylGmres.SetMpirunPath(options.mpirunPath)
+
+    # run regression case
+    passed = multiCylGmres.RunCase()
+    totalPass = totalPass and all(passed)
+
+    # ------------------------------------------------------------------
+    # multi-block subsonic cylinder with ilu
+    # laminar, inviscid, bilu, rusanov jacobian, multi-block
+    multiCylIlu = regressionTest()
+    multiCylIlu.SetRegressionCase("multiblockCylinder")
+    multiCylIlu.SetAitherPath(options.aitherPath)
+    multiCylIlu.SetRunDirectory("multiblockCylinder")
+    multiCylIlu.SetProfile(isProfile)
+    multiCylIlu.SetNumberOfProcessors(maxProcs)
+    multiCylIlu.SetNumberOfIterations(numIterations)
+    multiCylIlu.SetInputOption("matrixSolver", "bilu")
+    multiCylIlu.SetInputOption("inviscidFluxJacobian", "rusanov")
+    multiCylIlu.SetResiduals(
+        [2.4102e-01, 2.1600e-01, 3.5223e-01, 1.0520e+00, 2.3844e-01])
+    multiCylIlu.SetIgnoreIndices(3)
+    multiCylIlu.SetMpirunPath(options.mpirunPath)
+
+    # run regression case
+    passed = multiCylIlu.RunCase()
+    totalPass = totalPass and all(passed)
+
     # ------------------------------------------------------------------
     # sod shock tube
     # laminar, inviscid, bdf2, weno
@@ -298,6 +560,109 @@ def main():
     passed = shockTubeRestart.RunCase()
     totalPass = totalPass and all(passed)
 
+    # ------------------------------------------------------------------
+    # sod shock tube parallel
+    # laminar, inviscid, bdf2, weno, restart written by all processors
+    shockTubePar = regressionTest()
+    shockTubePar.SetRegressionCase("shockTube")
+    shockTubePar.SetAitherPath(options.aitherPath)
+    shockTubePar.SetRunDirectory("shockTube")
+    shockTubePar.SetProfile(isProfile)
+    shockTubePar.SetNumberOfProcessors(maxProcs)
+    shockTubePar.SetNumberOfIterations(numIterations)
+    shockTubePar.SetResiduals(
+        [4.8537e-01, 4.5855e-01, 1.0000e+00, 1.0000e+00, 2.6434e-01])
+    shockTubePar.SetIgnoreIndices(2)
+    shockTubePar.SetIgnoreIndices(3)
+    shockTubePar.SetMpirunPath(options.mpirunPath)
+    shockTubeFiles = ["shockTube_" + str(numIterations) + "_center.fun",
+                      "shockTube_" + str(numIterations) + ".rst"]
+    shockTubePar.SetSavedFiles(shockTubeFiles, "sync")
+
+    # run regression case
+    passed = shockTubePar.RunCase()
+    totalPass = totalPass and all(passed)
+
+    # ------------------------------------------------------------------
+    # sod shock tube asynchronous output
+    # laminar, inviscid, bdf2, weno, function and restart files written in
+    # the background must be identical to the synchronous ones
+    shockTubeAsync = regressionTest()
+    shockTubeAsync.SetRegressionCase("shockTube")
+    shockTubeAsync.SetAitherPath(options.aitherPath)
+    shockTubeAsync.SetRunDirectory("shockTube")
+    shockTubeAsync.SetProfile(isProfile)
+    shockTubeAsync.SetNumberOfProcessors(maxProcs)
+    shockTubeAsync.SetNumberOfIterations(numIterations)
+    shockTubeAsync.SetInputOption("asyncOutput", "yes")
+    shockTubeAsync.SetResiduals(
+        [4.8537e-01, 4.5855e-01, 1.0000e+00, 1.0000e+00, 2.6434e-01])
+    shockTubeAsync.SetIgnoreIndices(2)
+    shockTubeAsync.SetIgnoreIndices(3)
+    shockTubeAsync.SetMatchingFiles(shockTubeFiles, "sync")
+    shockTubeAsync.SetMpirunPath(options.mpirunPath)
+
+    # run regression case
+    passed = shockTubeAsync.RunCase()
+    totalPass = totalPass and all(passed)
+
+    # ------------------------------------------------------------------
+    # sod shock tube restart on one processor
+    # laminar, inviscid, bdf2, weno, restart written on a different number
+    # of processors
+    shockTubeRankRestart = regressionTest()
+    shockTubeRankRestart.SetRegressionCase("shockTube")
+    shockTubeRankRestart.SetAitherPath(options.aitherPath)
+    shockTubeRankRestart.SetRunDirectory("shockTube")
+    shockTubeRankRestart.SetProfile(isProfile)
+    shockTubeRankRestart.SetNumberOfProcessors(1)
+    shockTubeRankRestart.SetNumberOfIterations(numIterationsRestart)
+    shockTubeRankRestart.SetRestart(True)
+    shockTubeRankRestart.SetRestartFile(
+        "shockTube_" + str(numIterationsRestart) + ".rst")
+    shockTubeRankRestart.SetResiduals(
+        [4.8537e-01, 4.5855e-01, 1.0000e+00, 1.0000e+00, 2.6434e-01])
+    shockTubeRankRestart.SetIgnoreIndices(2)
+    shockTubeRankRestart.SetIgnoreIndices(3)
+    shockTubeRankRestart.SetMpirunPath(options.mpirunPath)
+
+    # run regression case
+    passed = shockTubeRankRestart.RunCase()
+    totalPass = totalPass and all(passed)
+
+    # ------------------------------------------------------------------
+    # sod shock tube compressed restart
+    # laminar, inviscid, bdf2, weno, compressed restart written in parallel
+    # and read on one processor
+    shockTubeCompressed = regressionTest()
+    shockTubeCompressed.SetRegressionCase("shockTube")
+    shockTubeCompressed.SetAitherPath(options.aitherPath)
+    shockTubeCompressed.SetRunDirectory("shockTube")
+    shockTubeCompressed.SetProfile(isProfile)
+    shockTubeCompressed.SetNumberOfProcessors(maxProcs)
+    shockTubeCompressed.SetNumberOfIterations(numIterations)
+    shockTubeCompressed.SetInputOption("restartCompression", "true")
+    shockTubeCompressed.SetResiduals(
+        [4.8537e-01, 4.5855e-01, 1.0000e+00, 1.0000e+00, 2.6434e-01])
+    shockTubeCompressed.SetIgnoreIndices(2)
+    shockTubeCompressed.SetIgnoreIndices(3)
+    shockTubeCompressed.SetMpirunPath(options.mpirunPath)
+
+    # run regression case
+    passed = shockTubeCompressed.RunCase()
+    totalPass = totalPass and all(passed)
+
+    shockTubeCompressedRestart = shockTubeCompressed
+    shockTubeCompressedRestart.SetNumberOfProcessors(1)
+    shockTubeCompressedRestart.SetNumberOfIterations(numIterationsRestart)
+    shockTubeCompressedRestart.SetRestart(True)
+    shockTubeCompressedRestart.SetRestartFile(
+        "shockTube_" + str(numIterationsRestart) + ".rst")
+
+    # run regression case
+    passed = shockTubeCompressedRestart.RunCase()
+    totalPass = totalPass and all(passed)
+
     # ------------------------------------------------------------------
     # supersonic wedge
     # laminar, inviscid, explicit euler
@@ -341,7 +706,7 @@ def main():
 
     # ------------------------------------------------------------------
     # viscous flat plate
-    # laminar, viscous, lu-sgs
+    # laminar, viscous, lu-sgs, wall loads
     viscPlate = regressionTest()
     viscPlate.SetRegressionCase("viscousFlatPlate")
     viscPlate.SetAitherPath(options.aitherPath)
@@ -356,12 +721,45 @@ def main():
         viscPlate.SetResiduals(
             [7.4673e-02, 2.4711e-01, 3.8960e-02, 1.0000e+00, 7.7683e-02])
     viscPlate.SetIgnoreIndices(3)
+    viscPlate.SetInputOption("wallLoads", "yes")
+    # step, nonlinear iteration, pressure and viscous forces, moments, heat
+    # rate, and force and moment coefficients; the plate is adiabatic and the
+    # z-components are round off
+    viscPlate.SetLastLineValues("viscousFlatPlate.loads", [
+        numIterations - 1, 0, 0.0, -4.0520e+02, 0.0, 3.6215e-01, 3.3609e-05,
+        None, 4.0520e+00, 3.6215e-03, -4.0520e+01, None, 5.1070e-06,
+        -5.7140e-03, None, 5.7140e-05, 5.1070e-08, -5.7140e-04])
     viscPlate.SetMpirunPath(options.mpirunPath)
 
     # run regression case
     passed = viscPlate.RunCase()
     totalPass = totalPass and all(passed)
 
+    # ------------------------------------------------------------------
+    # viscous flat plate with line solver
+    # laminar, viscous, blinesgs, rusanov jacobian
+    viscPlateLine = regressionTest()
+    viscPlateLine.SetRegressionCase("viscousFlatPlate")
+    viscPlateLine.SetAitherPath(options.aitherPath)
+    viscPlateLine.SetRunDirectory("viscousFlatPlate")
+    viscPlateLine.SetProfile(isProfile)
+    viscPlateLine.SetNumberOfProcessors(maxProcs)
+    viscPlateLine.SetNumberOfIterations(numIterations)
+    viscPlateLine.SetInputOption("matrixSolver", "blinesgs")
+    viscPlateLine.SetInputOption("inviscidFluxJacobian", "rusanov")
+    if viscPlateLine.Processors() == 2:
+        viscPlateLine.SetResiduals(
+            [3.6588e-02, 1.9440e-01, 9.3359e-02, 9.4925e-01, 3.9412e-02])
+    else:
+        viscPlateLine.SetResiduals(
+            [2.0000e-02, 1.9443e-01, 5.2042e-02, 9.9907e-01, 2.4409e-02])
+    viscPlateLine.SetIgnoreIndices(3)
+    viscPlateLine.SetMpirunPath(options.mpirunPath)
+
+    # run regression case
+    passed = viscPlateLine.RunCase()
+    totalPass = totalPass and all(passed)
+
     # ------------------------------------------------------------------
     # turbulent flat plate
     # viscous, lu-sgs, k-w wilcox
@@ -380,11 +778,40 @@ def main():
                                 2.1910e-01, 2.5208e-07, 3.3009e-06])
     turbPlate.SetIgnoreIndices(2)
     turbPlate.SetMpirunPath(options.mpirunPath)
+    turbPlateFiles = ["turbFlatPlate_" + str(numIterationsShort) +
+                      "_center.fun"]
+    turbPlate.SetSavedFiles(turbPlateFiles, "cold")
 
     # run regression case
     passed = turbPlate.RunCase()
     totalPass = totalPass and all(passed)
 
+    # ------------------------------------------------------------------
+    # turbulent flat plate with geometry cache
+    # turbulent, k-w sst, wall distances written to the geometry cache by the
+    # first run and read by the second, solution must be identical to the one
+    # calculated without the cache
+    turbPlateCache = regressionTest()
+    turbPlateCache.SetRegressionCase("turbFlatPlate")
+    turbPlateCache.SetAitherPath(options.aitherPath)
+    turbPlateCache.SetRunDirectory("turbFlatPlate")
+    turbPlateCache.SetProfile(isProfile)
+    turbPlateCache.SetNumberOfProcessors(maxProcs)
+    turbPlateCache.SetNumberOfIterations(numIterationsShort)
+    turbPlateCache.SetInputOption("geometryCache", "yes")
+    turbPlateCache.SetResiduals(turbPlate.GetResiduals())
+    turbPlateCache.SetIgnoreIndices(2)
+    turbPlateCache.SetMatchingFiles(turbPlateFiles, "cold")
+    turbPlateCache.SetMpirunPath(options.mpirunPath)
+
+    # run regression case
+    passed = turbPlateCache.RunCase()
+    totalPass = totalPass and all(passed)
+
+    turbPlateCache.SetExpectedOutput("Wall distances read from geometry cache")
+    passed = turbPlateCache.RunCase()
+    totalPass = totalPass and all(passed)
+
     # ------------------------------------------------------------------
     # rae2822
     # turbulent, k-w sst, c-grid
@@ -450,6 +877,26 @@ def main():
     passed = wallLaw.RunCase()
     totalPass = totalPass and all(passed)
 
+    # ------------------------------------------------------------------
+    # wall law with stored off-diagonal jacobians
+    # wall law bc, turbulent, blusgs, off-diagonal jacobians stored for all
+    # sweeps of an iteration
+    wallLawStored = regressionTest()
+    wallLawStored.SetRegressionCase("wallLaw")
+    wallLawStored.SetAitherPath(options.aitherPath)
+    wallLawStored.SetRunDirectory("wallLaw")
+    wallLawStored.SetProfile(isProfile)
+    wallLawStored.SetNumberOfProcessors(maxProcs)
+    wallLawStored.SetNumberOfIterations(numIterationsShort)
+    wallLawStored.SetInputOption("matrixStoreOffDiagonal", "yes")
+    wallLawStored.SetResiduals(wallLaw.GetResiduals())
+    wallLawStored.SetIgnoreIndices(1)
+    wallLawStored.SetMpirunPath(options.mpirunPath)
+
+    # run regression case
+    passed = wallLawStored.RunCase()
+    totalPass = totalPass and all(passed)
+
     # ------------------------------------------------------------------
     # thermally perfect gas
     # turbulent, thermally perfect, supersonic
@@ -523,14 +970,28 @@ def main():
     supersonicMixing.SetProfile(isProfile)
     supersonicMixing.SetNumberOfProcessors(maxProcs)
     supersonicMixing.SetNumberOfIterations(numIterationsShort)
+    # function file checks every output variable, including the ones that
+    # depend on the block split (rank, globalPosition); vel_z is round off
+    mixingFunFile = "supersonicMixing_" + str(numIterationsShort) + \
+        "_center.fun"
     if supersonicMixing.Processors() == 2:
         supersonicMixing.SetResiduals([2.1642e-01, 1.5503e-01, 1.3670e+00,
                                        8.2043e-02, 3.3908e-01, 3.6563e-04,
                                        1.2388e-05])
+        supersonicMixing.SetFunctionFileMeans(mixingFunFile, [
+            9.9662e-02, 2.6591e+00, 1.1177e+00, 9.1485e-01, 1.9859e-02,
+            6.5288e-02, 1.0628e+05, 4.9863e-01, 3.4951e+06, 3.6229e+02,
+            6.3149e+00, 1.3652e+03, -6.3704e+01, None, 9.2791e-01,
+            2.3150e-02, 4.8943e-02, 1.1388e-05, 7.5754e-03])
     else:
         supersonicMixing.SetResiduals([2.1360e-01, 1.5278e-01, 1.3632e+00,
                                        7.8807e-02, 3.3470e-01, 3.6610e-04,
                                        1.2393e-05])
+        supersonicMixing.SetFunctionFileMeans(mixingFunFile, [
+            1.0004e-01, 2.3085e+00, 1.1191e+00, 9.1365e-01, 2.0140e-02,
+            6.6211e-02, 1.0653e+05, 0.0000e+00, 3.4964e+06, 3.6341e+02,
+            6.3152e+00, 1.3659e+03, -6.3972e+01, None, 9.2688e-01,
+            2.3479e-02, 4.9639e-02, 1.1430e-05, 7.5964e-03])
     supersonicMixing.SetIgnoreIndices(3)
     supersonicMixing.SetMpirunPath(options.mpirunPath)
 
@@ -569,16 +1030,29 @@ def main():
         errorCode = 1
     print("--------------------------------------------------")
     print("subsonicCylinder:", subCyl.PassedStatus())
+    print("subsonicCylinderThreaded:", subCylThreaded.PassedStatus())
+    print("subsonicCylinderRollback:", subCylRollback.PassedStatus())
     print("multiblockCylinder:", multiCyl.PassedStatus())
+    print("multiblockCylinderVtk:", multiCylVtk.PassedStatus())
+    print("multiblockCylinderGmres:", multiCylGmres.PassedStatus())
+    print("multiblockCylinderIlu:", multiCylIlu.PassedStatus())
     print("shockTube:", shockTube.PassedStatus())
     print("shockTubeRestart:", shockTubeRestart.PassedStatus())
+    print("shockTubeParallel:", shockTubePar.PassedStatus())
+    print("shockTubeAsync:", shockTubeAsync.PassedStatus())
+    print("shockTubeRankRestart:", shockTubeRankRestart.PassedStatus())
+    print("shockTubeCompressedRestart:",
+          shockTubeCompressedRestart.PassedStatus())
     print("supersonicWedge:", supWedge.PassedStatus())
     print("transonicBump:", transBump.PassedStatus())
     print("viscousFlatPlate:", viscPlate.PassedStatus())
+    print("viscousFlatPlateLine:", viscPlateLine.PassedStatus())
     print("turbulentFlatPlate:", turbPlate.PassedStatus())
+    print("turbulentFlatPlateCache:", turbPlateCache.PassedStatus())
     print("rae2822:", rae2822.PassedStatus())
     print("couette:", couette.PassedStatus())
     print("wallLaw:", wallLaw.PassedStatus())
+    print("wallLawStored:", wallLawStored.PassedStatus())
     print("thermallyPerfect:", thermallyPerfect.PassedStatus())
     print("uniform:", uniform.PassedStatus())
     print("convectingVortex:", vortex.PassedStatus())